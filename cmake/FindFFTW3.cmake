@@ -33,6 +33,12 @@ find_library(FFTW3_LIBRARIES
     HINTS ${PC_FFTW3_LIBRARY_DIRS}
 )
 
+# optional multi-threaded FFTW
+find_library(FFTW3_THREADS_LIBRARIES
+    NAMES fftw3_threads
+    HINTS ${PC_FFTW3_LIBRARY_DIRS}
+)
+
 find_path(FFTW3_INCLUDE_DIR
     NAMES fftw3.h
     HINTS ${PC_FFTW3_INCLUDE_DIRS}
@@ -59,7 +65,7 @@ if(FFTW3_FOUND AND NOT TARGET FFTW3::FFTW3)
     )
 endif()
 
-mark_as_advanced(FFTW3_LIBRARIES FFTW3_INCLUDE_DIR FFTW3_VERSUON)
+mark_as_advanced(FFTW3_LIBRARIES FFTW3_THREADS_LIBRARIES FFTW3_INCLUDE_DIR FFTW3_VERSUON)
 
 include(FeatureSummary)
 set_package_properties(FFTW3 PROPERTIES
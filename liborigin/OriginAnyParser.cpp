@@ -22,6 +22,8 @@
 #include "OriginAnyParser.h"
 #include <sstream>
 #include <cinttypes>
+#include <cstring>
+#include <algorithm>
 
 /* define a macro to get an int (or uint) from a istringstream in binary mode */
 #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
@@ -37,6 +39,24 @@ void inline swap_bytes(unsigned char* data, int size) {int i = 0, j = size - 1;
 #define GET_DOUBLE(iss, ovalue) {iss.read(reinterpret_cast<char *>(&ovalue), 8); swap_bytes(reinterpret_cast<unsigned char *>(&ovalue), 8);};
 #endif
 
+/* get a value directly from the position pos of a binary data blob, without a stream */
+template <typename T> inline T getValue(const string& blob, size_t pos) {
+	T value;
+	memcpy(&value, blob.data() + pos, sizeof(T));
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+	swap_bytes(reinterpret_cast<unsigned char *>(&value), sizeof(T));
+#endif
+	return value;
+}
+
+/* append count values of type T stored one after another in blob to data */
+template <typename T> inline void appendValues(vector<double>& data, const string& blob, unsigned int count) {
+	count = min(count, (unsigned int)(blob.size()/sizeof(T)));
+	data.reserve(data.size() + count);
+	for (unsigned int i = 0; i < count; ++i)
+		data.push_back((double)getValue<T>(blob, i*sizeof(T)));
+}
+
 OriginAnyParser::OriginAnyParser(const string& fileName)
 :	file(fileName.c_str(),ios::binary),
 	logfile(nullptr),
@@ -215,6 +235,17 @@ string OriginAnyParser::readObjectAsString(unsigned int size) {
 	return string();
 }
 
+string OriginAnyParser::dataSetWindowName(const string& dse_header) const {
+	// the name of a data set is <window>_<column> for spreadsheets and <window>@<sheet> for matrices
+	string name = dse_header.substr(fileVersion == 350 ? 0x57 : 0x58, 25).c_str();
+	string::size_type pos = name.find_last_of("_");
+	if (pos == string::npos)
+		pos = name.find_first_of("@");
+	if (pos != string::npos)
+		name.resize(pos);
+	return name;
+}
+
 void OriginAnyParser::readFileVersion() {
 	// get file and program version, check it is a valid file
 	string sFileVersion;
@@ -295,7 +326,18 @@ bool OriginAnyParser::readDataSetElement() {
 	file.seekg(dsh_start+dse_header_size+1, ios_base::beg);
 	dse_data_size = readObjectSize();
 	dsd_start = file.tellg();
-	string dse_data = readObjectAsString(dse_data_size);
+
+	// read the data only if it is needed, the data of functions is their formula
+	bool readData = loadAllData;
+	if (!readData && dse_header_size > 0x17) {
+		short data_type;
+		istringstream stmp(dse_header.substr(0x16));
+		GET_SHORT(stmp, data_type)
+		readData = (data_type == 0x6081) || isDataToLoad(dataSetWindowName(dse_header));
+	}
+	string dse_data;
+	if (readData)
+		dse_data = readObjectAsString(dse_data_size);
 	curpos = file.tellg();
 	LOG_PRINT(logfile, "data size %d [0x%X], from %" PRId64 " [0x%" PRIx64 "] to %" PRId64 " [0x%" PRIx64 "],", dse_data_size, dse_data_size, dsd_start, dsd_start, curpos, curpos)
 
@@ -1096,13 +1138,17 @@ bool OriginAnyParser::getColumnInfoAndData(const string& col_header, unsigned in
 		LOG_PRINT(logfile, "n. of rows = %d\n\n", nr)
 
 		spreadSheets[spread].maxRows<nr ? spreadSheets[spread].maxRows=nr : 0;
-		stmp.str(col_data);
+		if (!isDataToLoad(name) || col_data.size() < col_data_size)
+			nr = 0;	// the values of this window are not needed
+		spreadSheets[spread].columns[(current_col-1)].data.reserve(nr);
 		for(unsigned int i = 0; i < nr; ++i)
 		{
 			double value;
 			if(valuesize <= 8)	// Numeric, Time, Date, Month, Day
 			{
-				GET_DOUBLE(stmp, value)
+				if ((i+1)*8 > col_data_size)
+					break;
+				value = getValue<double>(col_data, i*8);
 				if ((i < 5) || (i > (nr-5))) {
 					LOG_PRINT(logfile, "%g ", value)
 				} else if (i == 5) {
@@ -1113,10 +1159,9 @@ bool OriginAnyParser::getColumnInfoAndData(const string& col_header, unsigned in
 			else if((data_type & 0x100) == 0x100) // Text&Numeric
 			{
 				unsigned char c = col_data[i*valuesize];
-				stmp.seekg(i*valuesize+2, ios_base::beg);
 				if(c != 1) //value
 				{
-					GET_DOUBLE(stmp, value);
+					value = (i*valuesize+10 <= col_data_size) ? getValue<double>(col_data, i*valuesize+2) : 0.;
 					if ((i < 5) || (i > (nr-5))) {
 						LOG_PRINT(logfile, "%g ", value)
 					} else if (i == 5) {
@@ -1168,73 +1213,38 @@ void OriginAnyParser::getMatrixValues(const string& col_data, unsigned int col_d
 	if (matrixes.empty())
 		return;
 
-	istringstream stmp;
-	stmp.str(col_data);
-
 	if (mIndex < 0)
 		mIndex = (vector<Origin::Matrix>::difference_type)matrixes.size() - 1;
 
 	unsigned int size = col_data_size/valuesize;
+	if (!isDataToLoad(matrixes[mIndex].name))
+		size = 0;	// the values of this matrix are not needed
+	vector<double>& data = matrixes[mIndex].sheets.back().data;
 	bool logValues = true;
 	switch(data_type){
 		case 0x6001://double
-			for(unsigned int i = 0; i < size; ++i){
-				double value;
-				GET_DOUBLE(stmp, value)
-				matrixes[mIndex].sheets.back().data.push_back(value);
-			}
+			appendValues<double>(data, col_data, size);
 			break;
 		case 0x6003://float
-			for(unsigned int i = 0; i < size; ++i){
-				float value;
-				GET_FLOAT(stmp, value)
-				matrixes[mIndex].sheets.back().data.push_back((double)value);
-			}
+			appendValues<float>(data, col_data, size);
 			break;
 		case 0x6801://int
-			if (data_type_u == 8){//unsigned
-				for(unsigned int i = 0; i < size; ++i){
-					unsigned int value;
-					GET_INT(stmp, value)
-					matrixes[mIndex].sheets.back().data.push_back((double)value);
-				}
-			} else {
-				for(unsigned int i = 0; i < size; ++i){
-					int value;
-					GET_INT(stmp, value)
-					matrixes[mIndex].sheets.back().data.push_back((double)value);
-				}
-			}
+			if (data_type_u == 8)//unsigned
+				appendValues<unsigned int>(data, col_data, size);
+			else
+				appendValues<int>(data, col_data, size);
 			break;
 		case 0x6803://short
-			if (data_type_u == 8){//unsigned
-				for(unsigned int i = 0; i < size; ++i){
-					unsigned short value;
-					GET_SHORT(stmp, value)
-					matrixes[mIndex].sheets.back().data.push_back((double)value);
-				}
-			} else {
-				for(unsigned int i = 0; i < size; ++i){
-					short value;
-					GET_SHORT(stmp, value)
-					matrixes[mIndex].sheets.back().data.push_back((double)value);
-				}
-			}
+			if (data_type_u == 8)//unsigned
+				appendValues<unsigned short>(data, col_data, size);
+			else
+				appendValues<short>(data, col_data, size);
 			break;
 		case 0x6821://char
-			if (data_type_u == 8){//unsigned
-				for(unsigned int i = 0; i < size; ++i){
-					unsigned char value;
-					value = col_data[i];
-					matrixes[mIndex].sheets.back().data.push_back((double)value);
-				}
-			} else {
-				for(unsigned int i = 0; i < size; ++i){
-					char value;
-					value = col_data[i];
-					matrixes[mIndex].sheets.back().data.push_back((double)value);
-				}
-			}
+			if (data_type_u == 8)//unsigned
+				appendValues<unsigned char>(data, col_data, size);
+			else
+				appendValues<char>(data, col_data, size);
 			break;
 		default:
 			LOG_PRINT(logfile, "	UNKNOWN MATRIX DATATYPE: %02X SKIP DATA\n", data_type);
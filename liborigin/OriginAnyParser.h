@@ -38,6 +38,7 @@ public:
 protected:
 	unsigned int readObjectSize();
 	string readObjectAsString(unsigned int);
+	string dataSetWindowName(const string&) const;
 	void readFileVersion();
 	void readGlobalHeader();
 	bool readDataSetElement();
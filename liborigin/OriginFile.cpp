@@ -170,6 +170,17 @@ bool OriginFile::parse()
 	return parser->parse();
 }
 
+/* Only the values of the spreadsheets, workbooks and matrices in names are decoded when parsing,
+ * the data blocks of all other windows are skipped. With an empty set only the structure
+ * of the project (project tree, windows, columns) is read. Has to be called before parse(). */
+void OriginFile::setWindowsToLoad(const set<string>& names)
+{
+	if (!parser)
+		return;
+	parser->loadAllData = false;
+	parser->windowsToLoad = names;
+}
+
 double OriginFile::version() const
 {
 	return (parser->fileVersion)/100.0;
@@ -42,6 +42,7 @@ public:
 	explicit OriginFile(const string& fileName);
 
 	bool parse();																		//!< parse Origin file
+	void setWindowsToLoad(const set<string>& names);									//!< decode the data values of the windows in names only
 	double version() const;																//!< get version of Origin file
 
 	vector<Origin::SpreadColumn>::size_type datasetCount() const;						//!< get number of datasets
@@ -50,6 +50,17 @@ vector<Origin::SpreadSheet>::difference_type OriginParser::findSpreadByName(cons
 	return -1;
 }
 
+/* the data values are decoded for all windows or for the windows in windowsToLoad only */
+bool OriginParser::isDataToLoad(const string& windowName) const
+{
+	if (loadAllData) return true;
+	for (set<string>::const_iterator it = windowsToLoad.begin(); it != windowsToLoad.end(); ++it)
+	{
+		if (iequals(*it, windowName, locale())) return true;
+	}
+	return false;
+}
+
 vector<Origin::Excel>::difference_type OriginParser::findExcelByName(const string& name) const
 {
 	for (vector<Excel>::const_iterator it = excels.begin(); it != excels.end(); ++it)
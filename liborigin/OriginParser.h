@@ -31,6 +31,7 @@
 
 #include "OriginObj.h"
 #include "tree.hh"
+#include <set>
 
 #ifdef GENERATE_CODE_FOR_LOG
 #define LOG_PRINT( logfile, ... ) { fprintf(logfile, __VA_ARGS__); }
@@ -48,6 +49,7 @@ public:
 	vector<Origin::Matrix>::difference_type findMatrixByName(const string& name) const;
 	vector<Origin::Function>::difference_type findFunctionByName(const string& name) const;
 	vector<Origin::Excel>::difference_type findExcelByName(const string& name) const;
+	bool isDataToLoad(const string& windowName) const;
 
 protected:
 	vector<Origin::SpreadColumn>::difference_type findSpreadColumnByName(vector<Origin::SpreadSheet>::size_type spread, const string& name) const;
@@ -73,6 +75,8 @@ public:
 	string resultsLog;
 	unsigned int windowsCount;
 	unsigned int fileVersion, buildVersion;
+	bool loadAllData = true;
+	set<string> windowsToLoad;
 };
 
 OriginParser* createOriginAnyParser(const string& fileName);
@@ -43,6 +43,7 @@
 #endif
 
 #include <QMenu>
+#include <QThread>
 
 /**
  * \class AbstractAspect
@@ -559,6 +560,37 @@ const QVector<AbstractAspect*>& AbstractAspect::children() const {
 	return d->m_children;
 }
 
+/*!
+ * returns the children for which \p isOfType is \c true, i.e. the children of the type \p type.
+ * The lists are determined once per type and kept up to date in AbstractAspectPrivate::insertChild()
+ * and AbstractAspectPrivate::removeChild() so that the templates children<T>(), child<T>() etc.
+ * don't need to dynamic_cast all children on every call.
+ * The cache is only used in the thread of the aspect, the children are determined directly in other threads.
+ */
+QVector<AbstractAspect*> AbstractAspect::typedChildren(const std::type_info& type, bool (*isOfType)(const AbstractAspect*)) const {
+	if (d->m_children.isEmpty())
+		return QVector<AbstractAspect*>();
+
+	const bool cache = (QThread::currentThread() == thread());
+	if (cache) {
+		for (const auto& typed : qAsConst(d->m_typedChildren)) {
+			if (*typed.type == type)
+				return typed.children;
+		}
+	}
+
+	QVector<AbstractAspect*> result;
+	for (auto* child : d->m_children) {
+		if (isOfType(child))
+			result << child;
+	}
+
+	if (cache)
+		d->m_typedChildren << AbstractAspectPrivate::TypedChildren{&type, isOfType, result};
+
+	return result;
+}
+
 /**
  * \brief Remove me from my parent's list of children.
  */
@@ -891,6 +923,18 @@ AbstractAspectPrivate::~AbstractAspectPrivate() {
 void AbstractAspectPrivate::insertChild(int index, AbstractAspect* child) {
 	m_children.insert(index, child);
 
+	//appended children are added to the cached lists, the other lists are determined again on the next access
+	const bool appended = (index == m_children.size() - 1);
+	for (int i = m_typedChildren.size() - 1; i >= 0; --i) {
+		auto& typed = m_typedChildren[i];
+		if (!typed.isOfType(child))
+			continue;
+		if (appended)
+			typed.children << child;
+		else
+			m_typedChildren.remove(i);
+	}
+
 	// Always remove from any previous parent before adding to a new one!
 	// Can't handle this case here since two undo commands have to be created.
 	Q_ASSERT(child->parentAspect() == nullptr);
@@ -909,6 +953,8 @@ int AbstractAspectPrivate::removeChild(AbstractAspect* child) {
 	int index = indexOfChild(child);
 	Q_ASSERT(index != -1);
 	m_children.removeAll(child);
+	for (auto& typed : m_typedChildren)
+		typed.children.removeAll(child);
 	QObject::disconnect(child, nullptr, q, nullptr);
 	child->setParentAspect(nullptr);
 	return index;
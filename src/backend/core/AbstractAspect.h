@@ -33,6 +33,9 @@
 #include <QObject>
 #include <QVector>
 
+#include <type_traits>
+#include <typeinfo>
+
 class AbstractAspectPrivate;
 class Folder;
 class Project;
@@ -180,43 +183,35 @@ public:
 
 	template <class T> QVector<T*> children(ChildIndexFlags flags = {}) const {
 		QVector<T*> result;
-		for (auto* child: children()) {
-			if (flags & ChildIndexFlag::IncludeHidden || !child->hidden()) {
-				T* i = dynamic_cast<T*>(child);
-				if (i)
-					result << i;
-
-				if (child && flags & ChildIndexFlag::Recursive)
-					result << child->template children<T>(flags);
-			}
-		}
+		appendChildren<T>(result, flags);
 		return result;
 	}
 
 	template <class T> T* child(int index, ChildIndexFlags flags = {}) const {
 		int i = 0;
-		for (auto* child: children()) {
-			T* c = dynamic_cast<T*>(child);
-			if (c && (flags & ChildIndexFlag::IncludeHidden || !child->hidden()) && index == i++)
-				return c;
+		for (auto* child: typedChildren<T>()) {
+			if ((flags & ChildIndexFlag::IncludeHidden || !child->hidden()) && index == i++)
+				return castChild<T>(child);
 		}
 		return nullptr;
 	}
 
 	template <class T> T* child(const QString& name) const {
-		for (auto* child: children()) {
-			T* c = dynamic_cast<T*>(child);
-			if (c && child->name() == name)
-				return c;
+		for (auto* child: typedChildren<T>()) {
+			if (child->name() == name)
+				return castChild<T>(child);
 		}
 		return nullptr;
 	}
 
 	template <class T> int childCount(ChildIndexFlags flags = {}) const {
+		const auto& typed = typedChildren<T>();
+		if (flags & ChildIndexFlag::IncludeHidden)
+			return typed.size();
+
 		int result = 0;
-		for (auto* child: children()) {
-			T* i = dynamic_cast<T*>(child);
-			if (i && (flags & ChildIndexFlag::IncludeHidden || !child->hidden()))
+		for (auto* child: typed) {
+			if (!child->hidden())
 				result++;
 		}
 		return result;
@@ -224,6 +219,14 @@ public:
 
 	template <class T> int indexOfChild(const AbstractAspect* child, ChildIndexFlags flags = {}) const {
 		int index = 0;
+		for (auto* c: typedChildren<T>()) {
+			if (child == c) return index;
+			if (flags & ChildIndexFlag::IncludeHidden || !c->hidden())
+				index++;
+		}
+
+		//child is not of type T, count the children of type T in front of it
+		index = 0;
 		for (auto* c:	 children()) {
 			if (child == c) return index;
 			T* i = dynamic_cast<T*>(c);
@@ -263,6 +266,51 @@ private:
 
 	QString uniqueNameFor(const QString&) const;
 	const QVector<AbstractAspect*>& children() const;
+	QVector<AbstractAspect*> typedChildren(const std::type_info&, bool (*isOfType)(const AbstractAspect*)) const;
+
+	//the children of type T in the order of children(), cached per type in AbstractAspectPrivate
+	template <class T> static bool isOfType(const AbstractAspect* aspect) {
+		return dynamic_cast<const T*>(aspect) != nullptr;
+	}
+	template <class T> QVector<AbstractAspect*> typedChildren() const {
+		return typedChildren(typeid(T), &isOfType<T>);
+	}
+
+	//no dynamic_cast needed for the cached children if T is an aspect, cross cast to interfaces like Curve otherwise
+	template <class T> static T* castChild(AbstractAspect* aspect, std::true_type) {
+		return static_cast<T*>(aspect);
+	}
+	template <class T> static T* castChild(AbstractAspect* aspect, std::false_type) {
+		return dynamic_cast<T*>(aspect);
+	}
+	template <class T> static T* castChild(AbstractAspect* aspect) {
+		return castChild<T>(aspect, std::is_base_of<AbstractAspect, T>());
+	}
+
+	//appends the children of type T, recursively in pre-order if requested, to result
+	template <class T> void appendChildren(QVector<T*>& result, ChildIndexFlags flags) const {
+		const auto& typed = typedChildren<T>();
+		if (!(flags & ChildIndexFlag::Recursive)) {
+			for (auto* child: typed) {
+				if (flags & ChildIndexFlag::IncludeHidden || !child->hidden())
+					result << castChild<T>(child);
+			}
+			return;
+		}
+
+		//the children of type T are a subsequence of all children
+		int i = 0;
+		for (auto* child: children()) {
+			const bool matches = (i < typed.size() && typed.at(i) == child);
+			if (matches)
+				++i;
+			if (flags & ChildIndexFlag::IncludeHidden || !child->hidden()) {
+				if (matches)
+					result << castChild<T>(child);
+				child->appendChildren<T>(result, flags);
+			}
+		}
+	}
 	void connectChild(AbstractAspect*);
 
 public slots:
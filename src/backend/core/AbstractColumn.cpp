@@ -35,6 +35,7 @@
 
 #include <QDateTime>
 #include <QIcon>
+#include <limits>
 #include <KLocalizedString>
 
 /**
@@ -134,6 +135,28 @@ QIcon AbstractColumn::iconForMode(ColumnMode mode) {
 	return QIcon::fromTheme("x-shape-text");
 }
 
+/**
+ * Date-time values are stored as milliseconds since epoch (UTC).
+ * Invalid values are mapped to the smallest representable number.
+ */
+const qint64 AbstractColumn::invalidDateTime = std::numeric_limits<qint64>::min();
+
+/**
+ * \brief Convert \c dateTime to the milliseconds since epoch used for storing date-time values
+ */
+qint64 AbstractColumn::dateTimeToMSecs(const QDateTime& dateTime) {
+	return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : invalidDateTime;
+}
+
+/**
+ * \brief Convert the stored milliseconds since epoch \c msecs back to a QDateTime with the time spec \c spec
+ */
+QDateTime AbstractColumn::dateTimeFromMSecs(qint64 msecs, Qt::TimeSpec spec) {
+	if (msecs == invalidDateTime)
+		return QDateTime();
+	return QDateTime::fromMSecsSinceEpoch(msecs, spec);
+}
+
 /**
  * \fn bool AbstractColumn::isReadOnly() const
  * \brief Return whether the object is read-only
@@ -276,7 +299,7 @@ bool AbstractColumn::isValid(int row) const {
 	case ColumnMode::DateTime:
 	case ColumnMode::Month:
 	case ColumnMode::Day:
-		return dateTimeAt(row).isValid();
+		return dateTimeMSecsAt(row) != invalidDateTime;
 	}
 
 	return false;
@@ -472,6 +495,16 @@ QDateTime AbstractColumn::dateTimeAt(int row) const {
 	return QDateTime();
 }
 
+/**
+ * \brief Return the QDateTime in row 'row' as milliseconds since epoch
+ *
+ * Returns \c invalidDateTime for invalid values.
+ * Use this only when columnMode() is DateTime, Month or Day
+ */
+qint64 AbstractColumn::dateTimeMSecsAt(int row) const {
+	return dateTimeToMSecs(dateTimeAt(row));
+}
+
 /**
  * \brief Set the content of row 'row'
  *
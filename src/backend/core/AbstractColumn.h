@@ -153,6 +153,9 @@ public:
 	static QStringList timeFormats();	// supported time formats
 	static QStringList dateTimeFormats();	// supported datetime formats
 	static QIcon iconForMode(ColumnMode mode);
+	static const qint64 invalidDateTime;	// storage value of an invalid QDateTime
+	static qint64 dateTimeToMSecs(const QDateTime&);
+	static QDateTime dateTimeFromMSecs(qint64, Qt::TimeSpec = Qt::LocalTime);
 
 	virtual bool isReadOnly() const {
 		return true;
@@ -204,6 +207,7 @@ public:
 	virtual QTime timeAt(int row) const;
 	virtual void setTimeAt(int row, QTime new_value);
 	virtual QDateTime dateTimeAt(int row) const;
+	virtual qint64 dateTimeMSecsAt(int row) const;
 	virtual void setDateTimeAt(int row, const QDateTime& new_value);
 	virtual void replaceDateTimes(int first, const QVector<QDateTime>& new_values);
 	virtual double valueAt(int row) const;
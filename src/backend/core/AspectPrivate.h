@@ -33,6 +33,8 @@
 #include <QDateTime>
 #include <QList>
 
+#include <typeinfo>
+
 class AbstractAspect;
 
 class AbstractAspectPrivate {
@@ -54,6 +56,14 @@ public:
 	AbstractAspect* m_parent{nullptr};
 	bool m_undoAware{true};
 	bool m_isLoading{false};
+
+	//children of one type in the order of m_children, see AbstractAspect::typedChildren()
+	struct TypedChildren {
+		const std::type_info* type;
+		bool (*isOfType)(const AbstractAspect*);
+		QVector<AbstractAspect*> children;
+	};
+	QVector<TypedChildren> m_typedChildren;
 };
 
 #endif // ifndef ASPECT_PRIVATE_H
@@ -27,6 +27,8 @@
  *                                                                         *
  ***************************************************************************/
 #include "backend/core/Project.h"
+#include "backend/core/ProjectContainer.h"
+#include "backend/core/column/Column.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/datasources/LiveDataSource.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -44,7 +46,9 @@
 #include <QDateTime>
 #include <QFile>
 #include <QMenu>
+#include <QThread>
 #include <QThreadPool>
+#include <QtConcurrentRun>
 #include <QUndoStack>
 #include <QBuffer>
 
@@ -92,12 +96,35 @@ public:
 	MdiWindowVisibility mdiWindowVisibility{Project::MdiWindowVisibility::folderOnly};
 	QString fileName;
 	QString version;
+	int xmlVersion{currentXmlVersion};
 	QString author;
 	QDateTime modificationTime;
 	bool changed{false};
 	bool aspectAddedSignalSuppressed{false};
+	QHash<QString, QVector<AbstractAspect*>> aspectsByPath;	//path -> aspects in tree order, built in aspectByPath() on demand
+	bool aspectsByPathValid{false};
+
+	//encoding of the column data in worker threads during save()
+	void startColumnEncoding();
+	QVector<Column*> columnsToEncode;
+	int nextColumnToEncode{0};
+	QHash<const Column*, QFuture<QByteArray>> encodedColumns;
+
+	ProjectContainer* container{nullptr};	//container the column data is stored in during save(), if any
 };
 
+/*!
+ * starts the encoding of the data of the next columns in the order they are saved,
+ * the number of columns being encoded or waiting to be written is limited.
+ */
+void Project::Private::startColumnEncoding() {
+	const int maxPending = 2 * qMax(QThread::idealThreadCount(), 1);
+	while (encodedColumns.size() < maxPending && nextColumnToEncode < columnsToEncode.size()) {
+		const Column* column = columnsToEncode.at(nextColumnToEncode++);
+		encodedColumns[column] = QtConcurrent::run([column]() { return column->encodedData(); });
+	}
+}
+
 Project::Project() : Folder(i18n("Project"), AspectType::Project), d(new Private()) {
 	//load default values for name, comment and author from config
 	KConfig config;
@@ -117,6 +144,9 @@ Project::Project() : Folder(i18n("Project"), AspectType::Project), d(new Private
 
 	connect(this, &Project::aspectDescriptionChanged,this, &Project::descriptionChanged);
 	connect(this, &Project::aspectAdded,this, &Project::aspectAddedSlot);
+
+	//the paths of the aspects change when aspects are added, removed or renamed
+	connect(this, &Project::aspectRemoved, [=]() { d->aspectsByPathValid = false; });
 }
 
 Project::~Project() {
@@ -175,6 +205,20 @@ Project::MdiWindowVisibility Project::mdiWindowVisibility() const {
 
 CLASS_D_ACCESSOR_IMPL(Project, QString, fileName, FileName, fileName)
 BASIC_D_ACCESSOR_IMPL(Project, QString, version, Version, version)
+
+/*!
+ * version of the format of the project file, incremented on incompatible changes of the format:
+ * \li 0 - no version attribute, projects created before the versioning of the format
+ * \li 1 - the values of date-time columns are saved base64 encoded as milliseconds since epoch instead of "row" elements
+ */
+const int Project::currentXmlVersion = 1;
+
+/*!
+ * returns the version of the format of the loaded project file, \c currentXmlVersion for new projects.
+ */
+int Project::xmlVersion() const {
+	return d->xmlVersion;
+}
 CLASS_D_ACCESSOR_IMPL(Project, QString, author, Author, author)
 CLASS_D_ACCESSOR_IMPL(Project, QDateTime, modificationTime, ModificationTime, modificationTime)
 
@@ -200,6 +244,61 @@ bool Project::hasChanged() const {
 	return d->changed ;
 }
 
+/*!
+ * sets the columns in \p columns, indexed by their paths, in all curves and formulas
+ * referencing them by their paths.
+ */
+static void restoreColumnPointers(const QVector<XYCurve*>& curves, const QVector<Column*>& formulaColumns,
+		const QHash<QString, const AbstractColumn*>& columns) {
+	// setXColumnPath must not be set, because if curve->column matches column, there already exist a
+	// signal/slot connection between the curve and the column to update this. If they are not same,
+	// xColumnPath is set in setXColumn. Same for the yColumn.
+	for (auto* curve : curves) {
+		curve->setUndoAware(false);
+		auto* analysisCurve = dynamic_cast<XYAnalysisCurve*>(curve);
+		if (analysisCurve) {
+			if (const auto* column = columns.value(analysisCurve->xDataColumnPath()))
+				analysisCurve->setXDataColumn(column);
+			if (const auto* column = columns.value(analysisCurve->yDataColumnPath()))
+				analysisCurve->setYDataColumn(column);
+			if (const auto* column = columns.value(analysisCurve->y2DataColumnPath()))
+				analysisCurve->setY2DataColumn(column);
+
+			auto* fitCurve = dynamic_cast<XYFitCurve*>(curve);
+			if (fitCurve) {
+				if (const auto* column = columns.value(fitCurve->xErrorColumnPath()))
+					fitCurve->setXErrorColumn(column);
+				if (const auto* column = columns.value(fitCurve->yErrorColumnPath()))
+					fitCurve->setYErrorColumn(column);
+			}
+		} else {
+			if (const auto* column = columns.value(curve->xColumnPath()))
+				curve->setXColumn(column);
+			if (const auto* column = columns.value(curve->yColumnPath()))
+				curve->setYColumn(column);
+			if (const auto* column = columns.value(curve->valuesColumnPath()))
+				curve->setValuesColumn(column);
+			if (const auto* column = columns.value(curve->xErrorPlusColumnPath()))
+				curve->setXErrorPlusColumn(column);
+			if (const auto* column = columns.value(curve->xErrorMinusColumnPath()))
+				curve->setXErrorMinusColumn(column);
+			if (const auto* column = columns.value(curve->yErrorPlusColumnPath()))
+				curve->setYErrorPlusColumn(column);
+			if (const auto* column = columns.value(curve->yErrorMinusColumnPath()))
+				curve->setYErrorMinusColumn(column);
+		}
+		curve->setUndoAware(true);
+	}
+
+	for (auto* tempColumn : formulaColumns) {
+		const QStringList& formulaVariableColumnPaths = tempColumn->formulaVariableColumnPaths();
+		for (int i = 0; i < formulaVariableColumnPaths.count(); i++) {
+			if (const auto* column = columns.value(formulaVariableColumnPaths.at(i)))
+				tempColumn->setformulVariableColumn(i, const_cast<Column*>(static_cast<const Column*>(column)));
+		}
+	}
+}
+
 /*!
  * \brief Project::descriptionChanged
  * This function is called, when an object changes its name. When a column changed its name and wasn't connected before to the curve/column(formula) then
@@ -207,6 +306,7 @@ bool Project::hasChanged() const {
  * \param aspect
  */
 void Project::descriptionChanged(const AbstractAspect* aspect) {
+	d->aspectsByPathValid = false;
 	if (isLoading())
 		return;
 
@@ -217,58 +317,9 @@ void Project::descriptionChanged(const AbstractAspect* aspect) {
 
 		// When the column is created, it gets a random name and is eventually not connected to any curve.
 		// When changing the name it can match a curve and should than be connected to the curve.
-		const QVector<XYCurve*>& curves = children<XYCurve>(ChildIndexFlag::Recursive);
-		QString columnPath = column->path();
-
-		// setXColumnPath must not be set, because if curve->column matches column, there already exist a
-		// signal/slot connection between the curve and the column to update this. If they are not same,
-		// xColumnPath is set in setXColumn. Same for the yColumn.
-		for (auto* curve : curves) {
-			curve->setUndoAware(false);
-			auto* analysisCurve = dynamic_cast<XYAnalysisCurve*>(curve);
-			if (analysisCurve) {
-				if (analysisCurve->xDataColumnPath() == columnPath)
-					analysisCurve->setXDataColumn(column);
-				if (analysisCurve->yDataColumnPath() == columnPath)
-					analysisCurve->setYDataColumn(column);
-				if (analysisCurve->y2DataColumnPath() == columnPath)
-					analysisCurve->setY2DataColumn(column);
-
-				auto* fitCurve = dynamic_cast<XYFitCurve*>(curve);
-				if (fitCurve) {
-					if (fitCurve->xErrorColumnPath() == columnPath)
-						fitCurve->setXErrorColumn(column);
-					if (fitCurve->yErrorColumnPath() == columnPath)
-						fitCurve->setYErrorColumn(column);
-				}
-			} else {
-				if (curve->xColumnPath() == columnPath)
-					curve->setXColumn(column);
-				if (curve->yColumnPath() == columnPath)
-					curve->setYColumn(column);
-				if (curve->valuesColumnPath() == columnPath)
-					curve->setValuesColumn(column);
-				if (curve->xErrorPlusColumnPath() == columnPath)
-					curve->setXErrorPlusColumn(column);
-				if (curve->xErrorMinusColumnPath() == columnPath)
-					curve->setXErrorMinusColumn(column);
-				if (curve->yErrorPlusColumnPath() == columnPath)
-					curve->setYErrorPlusColumn(column);
-				if (curve->yErrorMinusColumnPath() == columnPath)
-					curve->setYErrorMinusColumn(column);
-			}
-			curve->setUndoAware(true);
-
-		}
-
-		const QVector<Column*>& columns = children<Column>(ChildIndexFlag::Recursive);
-		for (auto* tempColumn : columns) {
-			const QStringList& formulaVariableColumnsPath = tempColumn->formulaVariableColumnPaths();
-			for (int i = 0; i < formulaVariableColumnsPath.count(); i++) {
-				if (formulaVariableColumnsPath.at(i) == columnPath)
-					tempColumn->setformulVariableColumn(i, const_cast<Column*>(static_cast<const Column*>(column)));
-			}
-		}
+		QHash<QString, const AbstractColumn*> columns;
+		columns.insert(column->path(), column);
+		restoreColumnPointers(children<XYCurve>(ChildIndexFlag::Recursive), children<Column>(ChildIndexFlag::Recursive), columns);
 		return;
 	}
 
@@ -282,69 +333,62 @@ void Project::descriptionChanged(const AbstractAspect* aspect) {
  * \param aspect
  */
 void Project::aspectAddedSlot(const AbstractAspect* aspect) {
+	d->aspectsByPathValid = false;
+
+	//the pointers to the columns are restored in load() once all aspects are read
+	if (isLoading())
+		return;
 
 	const QVector<AbstractAspect*>& _children = aspect->children(AspectType::Column, ChildIndexFlag::Recursive);
-	QVector<const AbstractColumn*> columns;
+	QHash<QString, const AbstractColumn*> columns;
 	for (auto child : _children)
-		columns.append(static_cast<const AbstractColumn*>(child));
+		columns.insert(child->path(), static_cast<const AbstractColumn*>(child));
 
 	const auto* column = dynamic_cast<const AbstractColumn*>(aspect);
 	if (column)
-		columns.append(column);
+		columns.insert(column->path(), column);
 
 	if (columns.isEmpty())
 		return;
 
-	for (auto column : columns) {
-		const QVector<XYCurve*>& curves = children<XYCurve>(ChildIndexFlag::Recursive);
-		QString columnPath = column->path();
+	restoreColumnPointers(children<XYCurve>(ChildIndexFlag::Recursive), children<Column>(ChildIndexFlag::Recursive), columns);
+}
 
-		for (auto* curve : curves) {
-			curve->setUndoAware(false);
-			auto* analysisCurve = dynamic_cast<XYAnalysisCurve*>(curve);
-			if (analysisCurve) {
-				if (analysisCurve->xDataColumnPath() == columnPath)
-					analysisCurve->setXDataColumn(column);
-				if (analysisCurve->yDataColumnPath() == columnPath)
-					analysisCurve->setYDataColumn(column);
-				if (analysisCurve->y2DataColumnPath() == columnPath)
-					analysisCurve->setY2DataColumn(column);
+/*!
+ * adds all descendants of \p parent with the path \p parentPath to \p index, in the order of the project tree.
+ * The paths are built incrementally instead of calling AbstractAspect::path() for every aspect.
+ * Hidden aspects are indexed too since AbstractAspect::setHidden() doesn't notify about the change.
+ */
+static void indexAspects(const AbstractAspect* parent, const QString& parentPath, QHash<QString, QVector<AbstractAspect*>>& index) {
+	for (auto* child : parent->children<AbstractAspect>(AbstractAspect::ChildIndexFlag::IncludeHidden)) {
+		const QString path = parentPath + QLatin1Char('/') + child->name();
+		index[path] << child;
+		indexAspects(child, path, index);
+	}
+}
 
-				auto* fitCurve = dynamic_cast<XYFitCurve*>(curve);
-				if (fitCurve) {
-					if (fitCurve->xErrorColumnPath() == columnPath)
-						fitCurve->setXErrorColumn(column);
-					if (fitCurve->yErrorColumnPath() == columnPath)
-						fitCurve->setYErrorColumn(column);
-				}
-			} else {
-				if (curve->xColumnPath() == columnPath)
-					curve->setXColumn(column);
-				if (curve->yColumnPath() == columnPath)
-					curve->setYColumn(column);
-				if (curve->valuesColumnPath() == columnPath)
-					curve->setValuesColumn(column);
-				if (curve->xErrorPlusColumnPath() == columnPath)
-					curve->setXErrorPlusColumn(column);
-				if (curve->xErrorMinusColumnPath() == columnPath)
-					curve->setXErrorMinusColumn(column);
-				if (curve->yErrorPlusColumnPath() == columnPath)
-					curve->setYErrorPlusColumn(column);
-				if (curve->yErrorMinusColumnPath() == columnPath)
-					curve->setYErrorMinusColumn(column);
-			}
-			curve->setUndoAware(true);
-		}
-		const QVector<Column*>& columns = children<Column>(ChildIndexFlag::Recursive);
-		for (auto* tempColumn : columns) {
-			const QStringList& formulaVariableColumnPaths = tempColumn->formulaVariableColumnPaths();
-			for (int i = 0; i < formulaVariableColumnPaths.count(); i++) {
-				if (formulaVariableColumnPaths.at(i) == column->path())
-					tempColumn->setformulVariableColumn(i, const_cast<Column*>(static_cast<const Column*>(column)));
-			}
-		}
+/*!
+ * returns the first visible aspect with the path \p path in the project tree or \c nullptr if there is no such aspect.
+ * The lookup uses an index of all paths that is rebuilt on the first call after aspects were added,
+ * removed or renamed.
+ */
+AbstractAspect* Project::aspectByPath(const QString& path) const {
+	if (!d->aspectsByPathValid) {
+		d->aspectsByPath.clear();
+		indexAspects(this, this->path(), d->aspectsByPath);
+		d->aspectsByPathValid = true;
+	}
+
+	for (auto* aspect : d->aspectsByPath.value(path)) {
+		//an aspect is visible if neither it nor one of its ancestors is hidden
+		bool visible = true;
+		for (const AbstractAspect* a = aspect; a && visible; a = a->parentAspect())
+			visible = !a->hidden();
+		if (visible)
+			return aspect;
 	}
 
+	return nullptr;
 }
 
 void Project::navigateTo(const QString& path) {
@@ -365,9 +409,10 @@ QString Project::supportedExtensions() {
 //##################  Serialization/Deserialization  ###########################
 //##############################################################################
 
-void Project::save(const QPixmap& thumbnail, QXmlStreamWriter* writer) const {
+void Project::save(const QPixmap& thumbnail, QXmlStreamWriter* writer, ProjectContainer* container) const {
 	//set the version and the modification time to the current values
 	d->version = LVERSION;
+	d->xmlVersion = currentXmlVersion;
 	d->modificationTime = QDateTime::currentDateTime();
 
 	writer->setAutoFormatting(true);
@@ -376,29 +421,42 @@ void Project::save(const QPixmap& thumbnail, QXmlStreamWriter* writer) const {
 
 	writer->writeStartElement("project");
 	writer->writeAttribute("version", version());
+	writer->writeAttribute("xmlVersion", QString::number(currentXmlVersion));
 	writer->writeAttribute("fileName", fileName());
 	writer->writeAttribute("modificationTime", modificationTime().toString("yyyy-dd-MM hh:mm:ss:zzz"));
 	writer->writeAttribute("author", author());
 
-	QByteArray bArray;
-	QBuffer buffer(&bArray);
-	buffer.open(QIODevice::WriteOnly);
-	QPixmap scaledThumbnail = thumbnail.scaled(512,512, Qt::KeepAspectRatio);
-	scaledThumbnail.save(&buffer, "JPEG");
-	QString image = QString::fromLatin1(bArray.toBase64().data());
-	writer->writeAttribute("thumbnail", image);
+	if (!thumbnail.isNull()) {
+		QByteArray bArray;
+		QBuffer buffer(&bArray);
+		buffer.open(QIODevice::WriteOnly);
+		QPixmap scaledThumbnail = thumbnail.scaled(512,512, Qt::KeepAspectRatio);
+		scaledThumbnail.save(&buffer, "JPEG");
+		QString image = QString::fromLatin1(bArray.toBase64().data());
+		writer->writeAttribute("thumbnail", image);
+	}
 
 	writeBasicAttributes(writer);
 
 	writeCommentElement(writer);
 
+	d->container = container;
 	save(writer);
+	d->container = nullptr;
 }
 
 /**
  * \brief Save as XML
  */
 void Project::save(QXmlStreamWriter* writer) const {
+	//encode the data of the columns in worker threads while the XML is written,
+	//the columns pick up the results in Column::save() via saveColumnData()
+	if (!d->container) {
+		d->columnsToEncode = children<Column>(ChildIndexFlag::Recursive | ChildIndexFlag::IncludeHidden);
+		d->nextColumnToEncode = 0;
+		d->startColumnEncoding();
+	}
+
 	//save all children
 	for (auto* child : children<AbstractAspect>(ChildIndexFlag::IncludeHidden)) {
 		writer->writeStartElement("child_aspect");
@@ -410,14 +468,55 @@ void Project::save(QXmlStreamWriter* writer) const {
 	//and the state of the project explorer (expanded items, currently selected item)
 	emit requestSaveState(writer);
 
+	//columns that were not saved are possibly still being encoded
+	for (auto& future : d->encodedColumns)
+		future.waitForFinished();
+	d->encodedColumns.clear();
+	d->columnsToEncode.clear();
+
 	writer->writeEndElement();
 	writer->writeEndDocument();
 }
 
+/*!
+ * writes the data of the column \c column while the project is being saved. The data is either written
+ * encoded (see Column::encodedData()) into the project file, it was encoded in a worker thread already,
+ * or, if the project is saved into a ProjectContainer, stored in the container and referenced by its hash.
+ */
+void Project::saveColumnData(const Column* column, QXmlStreamWriter* writer) const {
+	if (d->container) {
+		writer->writeStartElement("data");
+		writer->writeAttribute("hash", d->container->storeColumnData(column));
+		writer->writeEndElement();
+		return;
+	}
+
+	auto it = d->encodedColumns.find(column);
+	if (it == d->encodedColumns.end()) {
+		column->writeEncodedData(writer);
+		return;
+	}
+
+	//the data of large columns is not encoded in the worker threads but written in blocks
+	const QByteArray& data = it->result();
+	if (data.isEmpty())
+		column->writeEncodedData(writer);
+	else
+		writer->writeCharacters(QString::fromLatin1(data));
+	d->encodedColumns.erase(it);
+	d->startColumnEncoding();
+}
+
 bool Project::load(const QString& filename, bool preview) {
 	QIODevice* file;
+	QString dataDirectory;
+	if (ProjectContainer::isContainer(filename)) {
+		// incrementally saved project, the column data is stored in separate files
+		file = new QFile(ProjectContainer::manifestFileName(filename));
+		dataDirectory = ProjectContainer::dataDirectory(filename);
+	}
 	// first try gzip compression, because projects can be gzipped and end with .lml
-	if (filename.endsWith(QLatin1String(".lml"), Qt::CaseInsensitive))
+	else if (filename.endsWith(QLatin1String(".lml"), Qt::CaseInsensitive))
 		file = new KCompressionDevice(filename,KFilterDev::compressionTypeForMimeType("application/x-gzip"));
 	else	// opens filename using file ending
 		file = new KFilterDev(filename);
@@ -442,6 +541,7 @@ bool Project::load(const QString& filename, bool preview) {
 
 	//parse XML
 	XmlStreamReader reader(file);
+	reader.setDataDirectory(dataDirectory);
 	setIsLoading(true);
 	rc = this->load(&reader, preview);
 	setIsLoading(false);
@@ -488,6 +588,10 @@ bool Project::load(XmlStreamReader* reader, bool preview) {
 			else
 				d->version = version;
 
+			d->xmlVersion = reader->attributes().value("xmlVersion").toInt();
+			if (d->xmlVersion > currentXmlVersion)
+				reader->raiseWarning(i18n("The project was created with a newer version of LabPlot (%1), not all data can be read.", version));
+
 			if (!readBasicAttributes(reader)) return false;
 			if (!readProjectAttributes(reader)) return false;
 
@@ -501,8 +605,11 @@ bool Project::load(XmlStreamReader* reader, bool preview) {
 						if (!readCommentElement(reader))
 							return false;
 					} else if (reader->name() == "child_aspect") {
-						if (!readChildAspectElement(reader, preview))
+						if (!readChildAspectElement(reader, preview)) {
+							//the columns read so far are possibly still decoded in the background
+							QThreadPool::globalInstance()->waitForDone();
 							return false;
+						}
 					} else if (reader->name() == "state") {
 						//load the state of the views (visible, maximized/minimized/geometry)
 						//and the state of the project explorer (expanded items, currently selected item)
@@ -522,6 +629,13 @@ bool Project::load(XmlStreamReader* reader, bool preview) {
 		//wait until all columns are decoded from base64-encoded data
 		QThreadPool::globalInstance()->waitForDone();
 
+		//the column data read from the data files of a project container is corrupted
+		const QStringList& dataErrors = reader->dataErrorStrings();
+		if (!dataErrors.isEmpty()) {
+			reader->raiseError(dataErrors.first());
+			return false;
+		}
+
 		//LiveDataSource:
 		//call finalizeLoad() to replace relative with absolute paths if required
 		//and to create columns during the initial read
@@ -533,6 +647,7 @@ bool Project::load(XmlStreamReader* reader, bool preview) {
 
 		//everything is read now.
 		//restore the pointer to the data sets (columns) in xy-curves etc.
+		//the aspects are looked up via their paths in aspectByPath()
 		auto columns = children<Column>(ChildIndexFlag::Recursive);
 
 		//xy-curves
@@ -568,7 +683,7 @@ bool Project::load(XmlStreamReader* reader, bool preview) {
 				RESTORE_COLUMN_POINTER(curve, yErrorMinusColumn, YErrorMinusColumn);
 			}
 			if (dynamic_cast<XYAnalysisCurve*>(curve))
-				RESTORE_POINTER(dynamic_cast<XYAnalysisCurve*>(curve), dataSourceCurve, DataSourceCurve, XYCurve, curves);
+				RESTORE_POINTER(dynamic_cast<XYAnalysisCurve*>(curve), dataSourceCurve, DataSourceCurve, XYCurve);
 
 			curve->suppressRetransform(false);
 		}
@@ -607,14 +722,10 @@ bool Project::load(XmlStreamReader* reader, bool preview) {
 				formulaVariableColumns.resize(col->formulaVariableColumnPaths().length());
 
 				for (int i = 0; i < col->formulaVariableColumnPaths().length(); i++) {
-					auto path = col->formulaVariableColumnPaths()[i];
-					for (Column* c : columns) {
-						if (!c) continue;
-						if (c->path() == path) {
-							formulaVariableColumns[i] = c;
-							col->finalizeLoad();
-							break;
-						}
+					auto* c = dynamic_cast<Column*>(aspectByPath(col->formulaVariableColumnPaths().at(i)));
+					if (c) {
+						formulaVariableColumns[i] = c;
+						col->finalizeLoad();
 					}
 				}
 			}
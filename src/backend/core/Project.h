@@ -33,6 +33,8 @@
 #include "backend/core/Folder.h"
 #include "backend/lib/macros.h"
 
+class Column;
+class ProjectContainer;
 class QString;
 
 class Project : public Folder {
@@ -75,11 +77,16 @@ public:
 
 	void setSuppressAspectAddedSignal(bool);
 	bool aspectAddedSignalSuppressed() const;
+	AbstractAspect* aspectByPath(const QString&) const;
 
-	void save(const QPixmap&, QXmlStreamWriter*) const;
+	void save(const QPixmap&, QXmlStreamWriter*, ProjectContainer* = nullptr) const;
+	void saveColumnData(const Column*, QXmlStreamWriter*) const;
 	bool load(XmlStreamReader*, bool preview) override;
 	bool load(const QString&, bool preview = false);
 
+	int xmlVersion() const;
+	static const int currentXmlVersion;
+
 	static bool isLabPlotProject(const QString& fileName);
 	static QString supportedExtensions();
 
@@ -0,0 +1,153 @@
+/***************************************************************************
+    File                 : ProjectContainer.cpp
+    Project              : LabPlot
+    Description          : Incrementally saved project
+    --------------------------------------------------------------------
+    Copyright            : (C) 2020 LabPlot developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "backend/core/ProjectContainer.h"
+#include "backend/core/Project.h"
+#include "backend/core/column/Column.h"
+#include "backend/lib/trace.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QPixmap>
+#include <QSaveFile>
+#include <QXmlStreamWriter>
+
+/**
+ * \class ProjectContainer
+ * \brief Directory containing a project that is saved incrementally.
+ *
+ * The project is saved into the manifest, an uncompressed project file without the data of the columns.
+ * The data of every column is stored in a separate file in the data directory, the name of the file is
+ * the hash of the data (see Column::dataHash()). On save, only the data not yet contained in the data
+ * directory is written, for the columns that were not modified since the last save only the manifest
+ * is rewritten.
+ *
+ * All files are written via QSaveFile, the data files prior to the manifest, and the data files that are not
+ * referenced anymore are only removed after the new manifest was written. If the saving is interrupted,
+ * the container still contains the previous manifest together with all the data referenced in it.
+ *
+ * Used for the auto save of projects, the container can be loaded with Project::load().
+ * The data files of large numeric columns are mapped on load instead of being read into memory, see Column::mapData().
+ */
+ProjectContainer::ProjectContainer(const QString& path) : m_path(path) {
+}
+
+/*!
+ * saves the project \c project into the container. Returns \c true on success.
+ */
+bool ProjectContainer::save(const Project* project) {
+	PERFTRACE("saving the project incrementally");
+	const QString& dataPath = dataDirectory(m_path);
+	if (!QDir().mkpath(dataPath)) {
+		DEBUG("Failed to create the directory " << STDSTRING(dataPath));
+		return false;
+	}
+
+	m_hashes.clear();
+	m_failed = false;
+
+	QSaveFile manifest(manifestFileName(m_path));
+	if (!manifest.open(QIODevice::WriteOnly)) {
+		DEBUG("Failed to open the manifest " << STDSTRING(manifest.fileName()));
+		return false;
+	}
+
+	QXmlStreamWriter writer(&manifest);
+	project->save(QPixmap(), &writer, this);
+	if (m_failed) {
+		manifest.cancelWriting();
+		return false;
+	}
+
+	if (!manifest.commit()) {
+		DEBUG("Failed to write the manifest " << STDSTRING(manifest.fileName()));
+		return false;
+	}
+
+	//remove the data of the previous saves that is not used anymore
+	QDir dir(dataPath);
+	for (const auto& name : dir.entryList(QDir::Files)) {
+		if (!m_hashes.contains(name))
+			dir.remove(name);
+	}
+
+	return true;
+}
+
+/*!
+ * stores the data of the column \c column in the container if it's not available there yet.
+ * Returns the hash of the data referencing the data in the manifest.
+ */
+QString ProjectContainer::storeColumnData(const Column* column) {
+	const QString& hash = column->dataHash();
+	m_hashes << hash;
+
+	//the data of the unmodified columns is stored already
+	const QString& fileName = dataDirectory(m_path) + QLatin1Char('/') + hash;
+	if (QFile::exists(fileName))
+		return hash;
+
+	QSaveFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly) || !column->writeRawData(&file) || !file.commit()) {
+		DEBUG("Failed to write the data file " << STDSTRING(fileName));
+		m_failed = true;
+	}
+
+	return hash;
+}
+
+/*!
+ * returns the path of the container used for the auto save of the project file \c fileName.
+ */
+QString ProjectContainer::autoSavePath(const QString& fileName) {
+	return fileName + QLatin1String(".autosave");
+}
+
+/*!
+ * returns \c true if \c path is a project container.
+ */
+bool ProjectContainer::isContainer(const QString& path) {
+	return QFileInfo(path).isDir() && QFile::exists(manifestFileName(path));
+}
+
+QString ProjectContainer::manifestFileName(const QString& path) {
+	return path + QLatin1String("/manifest.xml");
+}
+
+QString ProjectContainer::dataDirectory(const QString& path) {
+	return path + QLatin1String("/data");
+}
+
+/*!
+ * removes the container \c path together with all its content.
+ */
+bool ProjectContainer::remove(const QString& path) {
+	if (!isContainer(path))
+		return false;
+
+	return QDir(path).removeRecursively();
+}
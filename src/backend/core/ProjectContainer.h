@@ -0,0 +1,56 @@
+/***************************************************************************
+    File                 : ProjectContainer.h
+    Project              : LabPlot
+    Description          : Incrementally saved project
+    --------------------------------------------------------------------
+    Copyright            : (C) 2020 LabPlot developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PROJECTCONTAINER_H
+#define PROJECTCONTAINER_H
+
+#include <QSet>
+#include <QString>
+
+class Column;
+class Project;
+
+class ProjectContainer {
+public:
+	explicit ProjectContainer(const QString& path);
+
+	bool save(const Project*);
+	QString storeColumnData(const Column*);
+
+	static QString autoSavePath(const QString& fileName);
+	static bool isContainer(const QString& path);
+	static QString manifestFileName(const QString& path);
+	static QString dataDirectory(const QString& path);
+	static bool remove(const QString& path);
+
+private:
+	const QString m_path;
+	QSet<QString> m_hashes;	// hashes of the column data referenced in the manifest being written
+	bool m_failed{false};
+};
+
+#endif // PROJECTCONTAINER_H
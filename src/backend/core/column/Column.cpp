@@ -51,14 +51,24 @@ extern "C" {
 #include <array>
 
 #include <QClipboard>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
 #include <QFont>
 #include <QFontMetrics>
+#include <QFutureWatcher>
 #include <QIcon>
 #include <QMenu>
 #include <QThreadPool>
+#include <QtConcurrentRun>
 
 #include <KLocalizedString>
 
+//! numeric columns with more data are mapped from the data files of project containers instead of loading them into memory
+static const qint64 mappingThreshold = 64*1024*1024;
+//! the data of columns is base64 encoded in blocks of this size, a multiple of 3 so that the encoded blocks can be concatenated
+static const qint64 encodingBlockSize = 3*16*1024*1024;
+
 /**
  * \class Column
  * \brief Aspect that manages a column
@@ -81,6 +91,21 @@ Column::Column(const QString& name, ColumnMode mode)
 	init();
 }
 
+/**
+ * \brief Ctor for date-time data, the values are converted to milliseconds since epoch
+ */
+Column::Column(const QString& name, const QVector<QDateTime>& data, ColumnMode mode)
+	: AbstractColumn(name, AspectType::Column), d(new ColumnPrivate(this, mode, new QVector<qint64>(data.size()))) {
+
+	qint64* ptr = static_cast<QVector<qint64>*>(d->data())->data();
+	for (int i = 0; i < data.size(); ++i)
+		ptr[i] = dateTimeToMSecs(data.at(i));
+	if (!data.isEmpty() && data.constFirst().isValid())
+		d->setTimeSpec(data.constFirst().timeSpec());
+
+	init();
+}
+
 /**
  * \brief Common part of ctors
  */
@@ -100,6 +125,10 @@ void Column::init() {
 	m_usedInActionGroup = new QActionGroup(this);
 	connect(m_usedInActionGroup, &QActionGroup::triggered, this, &Column::navigateTo);
 	connect(this, &AbstractColumn::maskingChanged, this, [=]{d->invalidate();});
+	connect(this, &AbstractColumn::dataChanged, this, [=]{d->dataHash.clear();});
+	connect(this, &AbstractColumn::modeChanged, this, [=]{d->dataHash.clear();});
+	connect(this, &AbstractColumn::rowsInserted, this, [=]{d->dataHash.clear();});
+	connect(this, &AbstractColumn::rowsRemoved, this, [=]{d->dataHash.clear();});
 }
 
 Column::~Column() {
@@ -236,6 +265,10 @@ void Column::copyData() {
  */
 void Column::setSuppressDataChangedSignal(bool b) {
 	m_suppressDataChangedSignal = b;
+
+	//the data is going to be modified without notification
+	if (b)
+		d->dataHash.clear();
 }
 
 void Column::addUsedInPlots(QVector<CartesianPlot*>& plots) {
@@ -412,6 +445,22 @@ void Column::setWidth(int value) {
 	d->setWidth(value);
 }
 
+/**
+ * \brief Return the time spec used to show the date-time values of the column
+ */
+Qt::TimeSpec Column::timeSpec() const {
+	return d->timeSpec();
+}
+
+/**
+ * \brief Set the time spec used to show the date-time values of the column
+ *
+ * The stored values (milliseconds since epoch) are not modified.
+ */
+void Column::setTimeSpec(Qt::TimeSpec spec) {
+	d->setTimeSpec(spec);
+}
+
 /**
  * \brief Clear the whole column
  */
@@ -535,7 +584,7 @@ void Column::replaceTexts(int first, const QVector<QString>& new_values) {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 void Column::setDateAt(int row, QDate new_value) {
-	setDateTimeAt(row, QDateTime(new_value, timeAt(row)));
+	setDateTimeAt(row, QDateTime(new_value, timeAt(row), d->timeSpec()));
 }
 
 /**
@@ -544,7 +593,7 @@ void Column::setDateAt(int row, QDate new_value) {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 void Column::setTimeAt(int row, QTime new_value) {
-	setDateTimeAt(row, QDateTime(dateAt(row), new_value));
+	setDateTimeAt(row, QDateTime(dateAt(row), new_value, d->timeSpec()));
 }
 
 /**
@@ -673,12 +722,13 @@ void Column::calculateStatistics() const {
 	QVector<double> rowData;
 
 	if (columnMode() == ColumnMode::Numeric) {
-		auto* rowValues = reinterpret_cast<QVector<double>*>(data());
-		rowValuesSize = rowValues->size();
+		//access the values directly, the data of mapped columns is not loaded into memory
+		const double* rowValues = d->numericData();
+		rowValuesSize = d->rowCount();
 		rowData.reserve(rowValuesSize);
 
 		for (int row = 0; row < rowValuesSize; ++row) {
-			val = rowValues->value(row);
+			val = rowValues[row];
 			if (std::isnan(val) || isMasked(row))
 				continue;
 
@@ -853,10 +903,72 @@ void Column::calculateStatistics() const {
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * \brief Return the pointer to the data container
+ *
+ * The container may be modified directly. Mapped numeric data is loaded and the strings of
+ * dictionary encoded text columns are restored therefore, use textAt() and valueAt() to only read the data.
+ */
 void* Column::data() const {
 	return d->data();
 }
 
+/**
+ * \brief Return the numeric values for reading without loading mapped data into memory
+ *
+ * Returns \c nullptr if columnMode() is not Numeric. The values are only valid while the column is not modified,
+ * use numericValues() to access them in a worker thread.
+ */
+const double* Column::numericData() const {
+	if (columnMode() != ColumnMode::Numeric)
+		return nullptr;
+	return d->numericData();
+}
+
+/**
+ * \brief Return the numeric values for reading, they stay valid when the column is modified or deleted
+ *
+ * The values in memory are implicitly shared with the column, mapped values are not copied and
+ * stay mapped as long as the returned values exist. The values are empty if columnMode() is not Numeric.
+ */
+Column::NumericValues Column::numericValues() const {
+	NumericValues values;
+	if (columnMode() != ColumnMode::Numeric)
+		return values;
+
+	if (d->isMapped()) {
+		values.m_file = d->m_mappedFile;
+		values.m_data = d->m_mappedData;
+		values.m_size = d->m_mappedRowCount;
+	} else {
+		values.m_vector = *static_cast<QVector<double>*>(d->data());
+		values.m_data = values.m_vector.constData();
+		values.m_size = values.m_vector.size();
+	}
+
+	return values;
+}
+
+/**
+ * \brief Use the memory mapped file \c fileName as the storage of the numeric values
+ *
+ * The \c rows values are read from the file starting at \c offset on access only,
+ * see ColumnPrivate::mapData() for the details. Returns \c true on success.
+ * Only files owned by LabPlot that are never modified, like the data files of a ProjectContainer,
+ * may be mapped. Files of the user can be changed by other programs while they are mapped.
+ * With \c removeFile the file belongs to the column and is removed once it's not mapped anymore.
+ */
+bool Column::mapData(const QString& fileName, qint64 offset, int rows, bool removeFile) {
+	return d->mapData(fileName, offset, rows, removeFile);
+}
+
+/**
+ * \brief Return \c true if the numeric values are mapped from a file and not loaded into memory yet
+ */
+bool Column::isMapped() const {
+	return d->isMapped();
+}
+
 /*!
  * return \c true if the column has numeric values, \c false otherwise.
  */
@@ -893,7 +1005,7 @@ bool Column::hasValues() const {
 	case ColumnMode::Month:
 	case ColumnMode::Day: {
 		for (int row = 0; row < rowCount(); ++row) {
-			if (dateTimeAt(row).isValid()) {
+			if (dateTimeMSecsAt(row) != invalidDateTime) {
 				foundValues = true;
 				break;
 			}
@@ -946,6 +1058,38 @@ QString Column::textAt(int row) const {
 	return d->textAt(row);
 }
 
+/**
+ * \brief Dictionary encode the text data if the number of distinct values is low
+ *
+ * Returns \c true if the column is encoded. Use this only when columnMode() is Text
+ */
+bool Column::encodeText() {
+	return d->encodeText();
+}
+
+/**
+ * \brief Return whether the text data is dictionary encoded
+ */
+bool Column::isTextEncoded() const {
+	return d->isTextEncoded();
+}
+
+/**
+ * \brief Return the distinct strings of a dictionary encoded text column
+ */
+const QVector<QString>& Column::textDictionary() const {
+	return d->textDictionary();
+}
+
+/**
+ * \brief Return the code of row 'row' of a dictionary encoded text column
+ *
+ * The code is the index of the string in textDictionary() or -1 for empty rows.
+ */
+int Column::textCodeAt(int row) const {
+	return d->textCodeAt(row);
+}
+
 /**
  * \brief Return the date part of row 'row'
  *
@@ -973,6 +1117,15 @@ QDateTime Column::dateTimeAt(int row) const {
 	return d->dateTimeAt(row);
 }
 
+/**
+ * \brief Return the value in row 'row' as milliseconds since epoch
+ *
+ * Use this only when columnMode() is DateTime, Month or Day
+ */
+qint64 Column::dateTimeMSecsAt(int row) const {
+	return d->dateTimeMSecsAt(row);
+}
+
 /**
  * \brief Return the double value in row 'row'
  */
@@ -1001,6 +1154,7 @@ qint64 Column::bigIntAt(int row) const {
  */
 void Column::setChanged() {
     d->propertiesAvailable = false;
+	d->dataHash.clear();
 
 	if (!m_suppressDataChangedSignal)
 		emit dataChanged(this);
@@ -1036,6 +1190,9 @@ void Column::save(QXmlStreamWriter* writer) const {
 	writer->writeAttribute("designation", QString::number(static_cast<int>(plotDesignation())));
 	writer->writeAttribute("mode", QString::number(static_cast<int>(columnMode())));
 	writer->writeAttribute("width", QString::number(width()));
+	writer->writeAttribute("timeSpec", QString::number(static_cast<int>(timeSpec())));
+	if (d->isTextEncoded())
+		writer->writeAttribute("encoding", "dictionary");
 
 	//save the formula used to generate column values, if available
 	if (!formula().isEmpty() ) {
@@ -1078,63 +1235,189 @@ void Column::save(QXmlStreamWriter* writer) const {
 	// 		writer->writeEndElement();
 	// 	}
 
-	int i;
+	//the project writes the data, it is possibly encoded in the background already or stored separately
+	const Project* project = const_cast<Column*>(this)->project();
 	switch (columnMode()) {
-	case ColumnMode::Numeric: {
-			const char* data = reinterpret_cast<const char*>(static_cast< QVector<double>* >(d->data())->constData());
-			size_t size = d->rowCount() * sizeof(double);
-			writer->writeCharacters(QByteArray::fromRawData(data, (int)size).toBase64());
-			break;
-		}
-	case ColumnMode::Integer: {
-			const char* data = reinterpret_cast<const char*>(static_cast< QVector<int>* >(d->data())->constData());
-			size_t size = d->rowCount() * sizeof(int);
-			writer->writeCharacters(QByteArray::fromRawData(data, (int)size).toBase64());
-			break;
-		}
-	case ColumnMode::BigInt: {
-			const char* data = reinterpret_cast<const char*>(static_cast< QVector<qint64>* >(d->data())->constData());
-			size_t size = d->rowCount() * sizeof(qint64);
-			writer->writeCharacters(QByteArray::fromRawData(data, (int)size).toBase64());
+	case ColumnMode::Numeric:
+	case ColumnMode::Integer:
+	case ColumnMode::BigInt:
+	case ColumnMode::DateTime:
+	case ColumnMode::Month:
+	case ColumnMode::Day:
+		// date-time values are saved as milliseconds since epoch, older projects contain "row" elements
+		if (project)
+			project->saveColumnData(this, writer);
+		else
+			writeEncodedData(writer);
+		break;
+	case ColumnMode::Text:
+		if (d->isTextEncoded()) {
+			// save the distinct strings and the codes of the rows
+			writer->writeStartElement("dictionary");
+			for (const auto& value : d->textDictionary())
+				writer->writeTextElement("value", value);
+			writer->writeEndElement();
+
+			if (project)
+				project->saveColumnData(this, writer);
+			else
+				writeEncodedData(writer);
 			break;
 		}
-	case ColumnMode::Text:
-		for (i = 0; i < rowCount(); ++i) {
+		for (int i = 0; i < rowCount(); ++i) {
 			writer->writeStartElement("row");
 			writer->writeAttribute("index", QString::number(i));
 			writer->writeCharacters(textAt(i));
 			writer->writeEndElement();
 		}
 		break;
+	}
+
+	writer->writeEndElement(); // "column"
+}
+
+/*!
+ * writes rawData() to the device \c device, also for columns with more than 2GB of data.
+ * Returns \c true on success.
+ */
+bool Column::writeRawData(QIODevice* device) const {
+	qint64 size = 0;
+	const char* data = rawData(size);
+	while (size > 0) {
+		const qint64 written = device->write(data, size);
+		if (written <= 0)
+			return false;
+		data += written;
+		size -= written;
+	}
+
+	return true;
+}
+
+/*!
+ * returns the pointer to the values of the column as they are saved in the project file and their size in bytes in \c size,
+ * the codes of the rows for dictionary encoded text columns and \c nullptr for other text columns.
+ * The data of mapped columns is not loaded into memory, the data is only valid while the column is not modified.
+ * Only reads the data and can be called from a worker thread while the column is not modified.
+ */
+const char* Column::rawData(qint64& size) const {
+	const char* data = nullptr;
+	size = 0;
+	switch (columnMode()) {
+	case ColumnMode::Numeric:
+		data = reinterpret_cast<const char*>(d->numericData());
+		size = d->rowCount() * (qint64)sizeof(double);
+		break;
+	case ColumnMode::Integer:
+		data = reinterpret_cast<const char*>(static_cast< QVector<int>* >(d->data())->constData());
+		size = d->rowCount() * (qint64)sizeof(int);
+		break;
+	case ColumnMode::BigInt:
 	case ColumnMode::DateTime:
 	case ColumnMode::Month:
 	case ColumnMode::Day:
-		for (i = 0; i < rowCount(); ++i) {
-			writer->writeStartElement("row");
-			writer->writeAttribute("index", QString::number(i));
-			writer->writeCharacters(dateTimeAt(i).toString("yyyy-dd-MM hh:mm:ss:zzz"));
-			writer->writeEndElement();
-		}
+		data = reinterpret_cast<const char*>(static_cast< QVector<qint64>* >(d->data())->constData());
+		size = d->rowCount() * (qint64)sizeof(qint64);
+		break;
+	case ColumnMode::Text:
+		if (!d->isTextEncoded())
+			return nullptr;
+		data = reinterpret_cast<const char*>(d->textCodes().constData());
+		size = d->rowCount() * (qint64)sizeof(int);
 		break;
 	}
 
-	writer->writeEndElement(); // "column"
+	return data;
+}
+
+/*!
+ * returns rawData() base64 encoded as written into the project file.
+ * Only reads the data and can be called from a worker thread while the column is not modified.
+ * The data of large columns isn't encoded into one array, an empty array is returned
+ * for columns with more than \c encodingBlockSize bytes of data, use writeEncodedData() for them.
+ */
+QByteArray Column::encodedData() const {
+	qint64 size = 0;
+	const char* data = rawData(size);
+	if (size > encodingBlockSize)
+		return QByteArray();
+
+	return QByteArray::fromRawData(data, (int)size).toBase64();
+}
+
+/*!
+ * writes rawData() base64 encoded into the project file, the data is encoded and written in blocks.
+ * Also used for columns with more than 2GB of data which exceed the size of QByteArray.
+ */
+void Column::writeEncodedData(QXmlStreamWriter* writer) const {
+	qint64 size = 0;
+	const char* data = rawData(size);
+	for (qint64 pos = 0; pos < size; pos += encodingBlockSize) {
+		const int blockSize = (int)qMin(encodingBlockSize, size - pos);
+		writer->writeCharacters(QString::fromLatin1(QByteArray::fromRawData(data + pos, blockSize).toBase64()));
+	}
+}
+
+/*!
+ * returns the hash of rawData() identifying the content of the column.
+ * The hash is determined once and kept until the data of the column is changed.
+ */
+QString Column::dataHash() const {
+	if (d->dataHash.isEmpty()) {
+		QCryptographicHash hash(QCryptographicHash::Sha1);
+		qint64 size = 0;
+		const char* data = rawData(size);
+		//add the data in blocks, the data of large (mapped) columns exceeds the size of QByteArray
+		const int blockSize = 64*1024*1024;
+		for (qint64 pos = 0; pos < size; pos += blockSize)
+			hash.addData(data + pos, (int)qMin((qint64)blockSize, size - pos));
+		d->dataHash = QString::fromLatin1(hash.result().toHex());
+	}
+
+	return d->dataHash;
 }
 
 //TODO: extra header
 class DecodeColumnTask : public QRunnable {
 public:
-	DecodeColumnTask(ColumnPrivate* priv, const QString& content) {
+	DecodeColumnTask(ColumnPrivate* priv, const QString& content, const QVector<QString>& dictionary = QVector<QString>()) {
 		m_private = priv;
 		m_content = content;
+		m_dictionary = dictionary;
 	};
+	//read the not encoded data from the file \c fileName instead of decoding the content,
+	//the data is checked against \c hash and errors are reported to \c reader
+	void setDataFile(const QString& fileName, const QString& hash, XmlStreamReader* reader) {
+		m_fileName = fileName;
+		m_hash = hash;
+		m_reader = reader;
+	}
 	void run() override {
-		QByteArray bytes = QByteArray::fromBase64(m_content.toLatin1());
-		if (m_private->columnMode() == AbstractColumn::ColumnMode::Numeric) {
+		QByteArray bytes;
+		if (m_fileName.isEmpty())
+			bytes = QByteArray::fromBase64(m_content.toLatin1());
+		else {
+			QFile file(m_fileName);
+			if (file.open(QIODevice::ReadOnly))
+				bytes = file.readAll();
+			if (file.error() != QFileDevice::NoError
+				|| QString::fromLatin1(QCryptographicHash::hash(bytes, QCryptographicHash::Sha1).toHex()) != m_hash) {
+				m_reader->raiseDataError(i18n("The data file '%1' is corrupted.", m_fileName));
+				return;
+			}
+		}
+		if (m_private->columnMode() == AbstractColumn::ColumnMode::Text) {
+			QVector<int> codes(bytes.size()/(int)sizeof(int));
+			memcpy(codes.data(), bytes.data(), bytes.size());
+			m_private->replaceTextCodes(m_dictionary, codes);
+		} else if (m_private->columnMode() == AbstractColumn::ColumnMode::Numeric) {
 			auto* data = new QVector<double>(bytes.size()/(int)sizeof(double));
 			memcpy(data->data(), bytes.data(), bytes.size());
 			m_private->replaceData(data);
-		} else if (m_private->columnMode() == AbstractColumn::ColumnMode::BigInt) {
+		} else if (m_private->columnMode() == AbstractColumn::ColumnMode::BigInt
+			|| m_private->columnMode() == AbstractColumn::ColumnMode::DateTime
+			|| m_private->columnMode() == AbstractColumn::ColumnMode::Month
+			|| m_private->columnMode() == AbstractColumn::ColumnMode::Day) {
 			auto* data = new QVector<qint64>(bytes.size()/(int)sizeof(qint64));
 			memcpy(data->data(), bytes.data(), bytes.size());
 			m_private->replaceData(data);
@@ -1148,6 +1431,10 @@ public:
 private:
 	ColumnPrivate* m_private;
 	QString m_content;
+	QString m_fileName;
+	QString m_hash;
+	XmlStreamReader* m_reader{nullptr};
+	QVector<QString> m_dictionary;	// distinct strings of dictionary encoded text columns
 };
 
 /**
@@ -1163,8 +1450,7 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 	QString str = attribs.value("rows").toString();
 	if (str.isEmpty())
 		reader->raiseWarning(attributeWarning.subs("rows").toString());
-	else
-		d->resizeTo(str.toInt());
+	const int rows = str.toInt();
 
 	str = attribs.value("designation").toString();
 	if (str.isEmpty())
@@ -1178,12 +1464,25 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 	else
 		setColumnModeFast( AbstractColumn::ColumnMode(str.toInt()) );
 
+	//the data of large numeric columns in project containers is mapped in XmlReadData(), don't allocate the memory for it
+	if (columnMode() != ColumnMode::Numeric || reader->dataDirectory().isEmpty()
+		|| rows * (qint64)sizeof(double) < mappingThreshold)
+		d->resizeTo(rows);
+
 	str = attribs.value("width").toString();
 	if (str.isEmpty())
 		reader->raiseWarning(attributeWarning.subs("width").toString());
 	else
 		d->setWidth(str.toInt());
 
+	str = attribs.value("timeSpec").toString();
+	if (!str.isEmpty())
+		d->setTimeSpec(static_cast<Qt::TimeSpec>(str.toInt()));
+
+	//the data of dictionary encoded text columns is saved as the codes of the rows
+	const bool textEncoded = (columnMode() == ColumnMode::Text && attribs.value("encoding") == QLatin1String("dictionary"));
+	QVector<QString> dictionary;
+
 	// read child elements
 	while (!reader->atEnd()) {
 		reader->readNext();
@@ -1204,6 +1503,10 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 				ret_val = XmlReadFormula(reader);
 			else if (reader->name() == "row")
 				ret_val = XmlReadRow(reader);
+			else if (reader->name() == "dictionary")
+				ret_val = XmlReadDictionary(reader, dictionary);
+			else if (reader->name() == "data")
+				ret_val = XmlReadData(reader, rows, textEncoded, dictionary, preview);
 			else { // unknown element
 				reader->raiseWarning(i18n("unknown element '%1'", reader->name().toString()));
 				if (!reader->skipToEndElement()) return false;
@@ -1213,9 +1516,8 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 		}
 		if (!preview) {
 			QString content = reader->text().toString().trimmed();
-			if (!content.isEmpty() && ( columnMode() == ColumnMode::Numeric ||
-				columnMode() == ColumnMode::Integer || columnMode() == ColumnMode::BigInt)) {
-				auto* task = new DecodeColumnTask(d, content);
+			if (!content.isEmpty() && (columnMode() != ColumnMode::Text || textEncoded)) {
+				auto* task = new DecodeColumnTask(d, content, dictionary);
 				QThreadPool::globalInstance()->start(task);
 			}
 		}
@@ -1312,6 +1614,93 @@ bool Column::XmlReadFormula(XmlStreamReader* reader) {
 // }
 
 
+/**
+ * \brief Read the distinct strings of a dictionary encoded text column
+ */
+bool Column::XmlReadDictionary(XmlStreamReader* reader, QVector<QString>& dictionary) {
+	Q_ASSERT(reader->isStartElement() == true && reader->name() == "dictionary");
+
+	while (!reader->atEnd()) {
+		reader->readNext();
+		if (reader->isEndElement() && reader->name() == "dictionary")
+			break;
+
+		if (reader->isStartElement() && reader->name() == "value")
+			dictionary << reader->readElementText();
+	}
+
+	return !reader->error();
+}
+
+/**
+ * \brief Read the reference to the column data stored in a separate file (see ProjectContainer)
+ */
+bool Column::XmlReadData(XmlStreamReader* reader, int rows, bool textEncoded, const QVector<QString>& dictionary, bool preview) {
+	Q_ASSERT(reader->isStartElement() == true && reader->name() == "data");
+
+	const QString& hash = reader->attributes().value("hash").toString();
+	if (hash.isEmpty() || reader->dataDirectory().isEmpty()) {
+		reader->raiseError(i18n("invalid or missing data reference"));
+		return false;
+	}
+
+	if (!preview && (columnMode() != ColumnMode::Text || textEncoded)) {
+		const QString& fileName = reader->dataDirectory() + QLatin1Char('/') + hash;
+
+		//the data file contains the values of all rows, the codes of the rows for text columns
+		qint64 valueSize = sizeof(qint64);
+		if (columnMode() == ColumnMode::Integer || columnMode() == ColumnMode::Text)
+			valueSize = sizeof(int);
+		else if (columnMode() == ColumnMode::Numeric)
+			valueSize = sizeof(double);
+		const QFileInfo fileInfo(fileName);
+		if (!fileInfo.isFile() || fileInfo.size() != rows * valueSize) {
+			reader->raiseError(i18n("the data file '%1' of the column '%2' is missing or incomplete", hash, name()));
+			return false;
+		}
+
+		//map the data of large numeric columns instead of reading it, the data files are not modified anymore.
+		//the content of the data files is checked against the hash in the background without blocking the load
+		const qint64 size = fileInfo.size();
+		if (columnMode() == ColumnMode::Numeric && size >= mappingThreshold
+			&& d->mapData(fileName, 0, rows)) {
+			d->dataHash = hash;
+			verifyMappedData(fileName, hash);
+			return reader->skipToEndElement();
+		}
+
+		auto* task = new DecodeColumnTask(d, QString(), dictionary);
+		task->setDataFile(fileName, hash, reader);
+		QThreadPool::globalInstance()->start(task);
+	}
+
+	return reader->skipToEndElement();
+}
+
+/**
+ * \brief Check the content of the mapped data file against its hash
+ *
+ * The check runs in a worker thread and doesn't block the load of the project. If the data file is corrupted
+ * and still mapped, all values of the column are set to NaN and the problem is reported in the status bar.
+ */
+void Column::verifyMappedData(const QString& fileName, const QString& hash) {
+	auto* watcher = new QFutureWatcher<bool>(this);
+	connect(watcher, &QFutureWatcher<bool>::finished, this, [=]() {
+		const bool valid = watcher->result();
+		watcher->deleteLater();
+		if (valid || !d->isMapped())	//the data was replaced in the meantime
+			return;
+
+		d->invalidateMappedData();
+		info(i18n("The data file '%1' of the column '%2' is corrupted, its values are invalid.", fileName, name()));
+	});
+	watcher->setFuture(QtConcurrent::run([fileName, hash]() {
+		QFile file(fileName);
+		QCryptographicHash sha1(QCryptographicHash::Sha1);
+		return file.open(QIODevice::ReadOnly) && sha1.addData(&file) && QString::fromLatin1(sha1.result().toHex()) == hash;
+	}));
+}
+
 /**
  * \brief Read XML row element
  */
@@ -1563,12 +1952,12 @@ double Column::minimum(int startIndex, int endIndex) const {
 		// when there are invalid values the property must be Properties::No
 		switch (mode) {
 		case ColumnMode::Numeric: {
-			auto* vec = static_cast<QVector<double>*>(data());
+			const double* vec = d->numericData();
 			for (int row = startIndex; row < endIndex; ++row) {
 				if (!isValid(row) || isMasked(row))
 					continue;
 
-				const double val = vec->at(row);
+				const double val = vec[row];
 				if (std::isnan(val))
 					continue;
 
@@ -1606,12 +1995,12 @@ double Column::minimum(int startIndex, int endIndex) const {
 		case ColumnMode::Text:
 			break;
 		case ColumnMode::DateTime: {
-			auto* vec = static_cast<QVector<QDateTime>*>(data());
+			auto* vec = static_cast<QVector<qint64>*>(data());
 			for (int row = startIndex; row < endIndex; ++row) {
 				if (!isValid(row) || isMasked(row))
 					continue;
 
-				const qint64 val = vec->at(row).toMSecsSinceEpoch();
+				const qint64 val = vec->at(row);
 
 				if (val < min)
 					min = val;
@@ -1640,7 +2029,7 @@ double Column::minimum(int startIndex, int endIndex) const {
 		case ColumnMode::DateTime:
 		case ColumnMode::Month:
 		case ColumnMode::Day:
-			return dateTimeAt(foundIndex).toMSecsSinceEpoch();
+			return dateTimeMSecsAt(foundIndex);
 		case ColumnMode::Text:
 		default:
 			break;
@@ -1706,11 +2095,11 @@ double Column::maximum(int startIndex, int endIndex) const {
 	if (property == Properties::No) {
 		switch (mode) {
 		case ColumnMode::Numeric: {
-			auto* vec = static_cast<QVector<double>*>(data());
+			const double* vec = d->numericData();
 			for (int row = startIndex; row < endIndex; ++row) {
 				if (!isValid(row) || isMasked(row))
 					continue;
-				const double val = vec->at(row);
+				const double val = vec[row];
 				if (std::isnan(val))
 					continue;
 
@@ -1746,11 +2135,11 @@ double Column::maximum(int startIndex, int endIndex) const {
 		case ColumnMode::Text:
 			break;
 		case ColumnMode::DateTime: {
-			auto* vec = static_cast<QVector<QDateTime>*>(data());
+			auto* vec = static_cast<QVector<qint64>*>(data());
 			for (int row = startIndex; row < endIndex; ++row) {
 				if (!isValid(row) || isMasked(row))
 					continue;
-				const qint64 val = vec->at(row).toMSecsSinceEpoch();
+				const qint64 val = vec->at(row);
 
 				if (val > max)
 					max = val;
@@ -1779,7 +2168,7 @@ double Column::maximum(int startIndex, int endIndex) const {
 		case ColumnMode::DateTime:
 		case ColumnMode::Month:
 		case ColumnMode::Day:
-			return dateTimeAt(foundIndex).toMSecsSinceEpoch();
+			return dateTimeMSecsAt(foundIndex);
 		case ColumnMode::Text:
 		default:
 			break;
@@ -2084,10 +2473,10 @@ int Column::indexForValue(double x) const {
 			qint64 xInt64 = static_cast<qint64>(x);
 			for (unsigned int i = 0; i < maxSteps; i++) { // so no log_2(rowCount) needed
 				int index = lowerIndex + round(static_cast<double>(higherIndex - lowerIndex)/2);
-				qint64 value = dateTimeAt(index).toMSecsSinceEpoch();
+				qint64 value = dateTimeMSecsAt(index);
 
 				if (higherIndex - lowerIndex < 2) {
-					if (abs(dateTimeAt(lowerIndex).toMSecsSinceEpoch() - xInt64) < abs(dateTimeAt(higherIndex).toMSecsSinceEpoch() - xInt64))
+					if (abs(dateTimeMSecsAt(lowerIndex) - xInt64) < abs(dateTimeMSecsAt(higherIndex) - xInt64))
 						index = lowerIndex;
 					else
 						index = higherIndex;
@@ -2146,9 +2535,9 @@ int Column::indexForValue(double x) const {
 					continue;
 
 				if (row == 0)
-					prevValueDateTime = dateTimeAt(row).toMSecsSinceEpoch();
+					prevValueDateTime = dateTimeMSecsAt(row);
 
-				qint64 value = dateTimeAt(row).toMSecsSinceEpoch();
+				qint64 value = dateTimeMSecsAt(row);
 				if (abs(value - xInt64) <= abs(prevValueDateTime - xInt64)) { // "<=" prevents also that row - 1 become < 0
 					prevValueDateTime = value;
 					index = row;
@@ -2205,13 +2594,13 @@ bool Column::indicesMinMax(double v1, double v2, int& start, int& end) const {
 				qint64 v2int64 = v2;
 				qint64 value;
 				if (start > 0) {
-					value = dateTimeAt(start -1).toMSecsSinceEpoch();
+					value = dateTimeMSecsAt(start -1);
 					if (value <= v2int64 && value >= v1int64)
 						start--;
 				}
 
 				if (end > rowCount() - 1) {
-					value = dateTimeAt(end + 1).toMSecsSinceEpoch();
+					value = dateTimeMSecsAt(end + 1);
 					if (value <= v2int64 && value >= v1int64)
 						end++;
 				}
@@ -2254,7 +2643,7 @@ bool Column::indicesMinMax(double v1, double v2, int& start, int& end) const {
 			for (int i = 0; i < rowCount(); i++) {
 				if (!isValid(i) || isMasked(i))
 					continue;
-				value = dateTimeAt(i).toMSecsSinceEpoch();
+				value = dateTimeMSecsAt(i);
 				if (value <= v2int64 && value >= v1int64) {
 					end = i;
 					if (start < 0)
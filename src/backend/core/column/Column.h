@@ -43,6 +43,20 @@ class Column : public AbstractColumn {
 	Q_OBJECT
 
 public:
+	//! read-only numeric values of the column, see numericValues()
+	class NumericValues {
+	public:
+		const double* data() const { return m_data; }
+		int size() const { return m_size; }
+
+	private:
+		friend class Column;
+		QVector<double> m_vector;	//values in memory, shared with the column until it's modified
+		std::shared_ptr<QFile> m_file;	//keeps the mapped values valid
+		const double* m_data{nullptr};
+		int m_size{0};
+	};
+
 	explicit Column(const QString& name, AbstractColumn::ColumnMode = ColumnMode::Numeric);
 	// template constructor for all supported data types (AbstractColumn::ColumnMode) must be defined in header
 	template <typename T>
@@ -50,6 +64,8 @@ public:
 		: AbstractColumn(name, AspectType::Column), d(new ColumnPrivate(this, mode, new QVector<T>(data))) {
 		init();
 	}
+	// date-time values are stored as milliseconds since epoch, see AbstractColumn::dateTimeToMSecs()
+	Column(const QString& name, const QVector<QDateTime>& data, AbstractColumn::ColumnMode mode = ColumnMode::DateTime);
 	void init();
 	~Column() override;
 
@@ -75,6 +91,8 @@ public:
 	int availableRowCount() const override;
 	int width() const;
 	void setWidth(const int);
+	Qt::TimeSpec timeSpec() const;
+	void setTimeSpec(Qt::TimeSpec);
 	void clear() override;
 	AbstractSimpleFilter* outputFilter() const;
 	ColumnStringIO* asStringColumn() const;
@@ -97,17 +115,26 @@ public:
 
 	const AbstractColumn::ColumnStatistics& statistics() const;
 	void* data() const;
+	const double* numericData() const;
+	NumericValues numericValues() const;
 	bool hasValues() const;
+	bool mapData(const QString& fileName, qint64 offset, int rows, bool removeFile = false);
+	bool isMapped() const;
 
 	void setFromColumn(int, AbstractColumn*, int);
 	QString textAt(int) const override;
 	void setTextAt(int, const QString&) override;
 	void replaceTexts(int, const QVector<QString>&) override;
+	bool encodeText();
+	bool isTextEncoded() const;
+	const QVector<QString>& textDictionary() const;
+	int textCodeAt(int) const;
 	QDate dateAt(int) const override;
 	void setDateAt(int, QDate) override;
 	QTime timeAt(int) const override;
 	void setTimeAt(int, QTime) override;
 	QDateTime dateTimeAt(int) const override;
+	qint64 dateTimeMSecsAt(int) const override;
 	void setDateTimeAt(int, const QDateTime&) override;
 	void replaceDateTimes(int, const QVector<QDateTime>&) override;
 	double valueAt(int) const override;
@@ -140,6 +167,10 @@ public:
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*, bool preview) override;
 	void finalizeLoad();
+	bool writeRawData(QIODevice*) const;
+	QByteArray encodedData() const;
+	void writeEncodedData(QXmlStreamWriter*) const;
+	QString dataHash() const;
 
 public slots:
 	void updateFormula();
@@ -149,6 +180,10 @@ private:
 	bool XmlReadOutputFilter(XmlStreamReader*);
 	bool XmlReadFormula(XmlStreamReader*);
 	bool XmlReadRow(XmlStreamReader*);
+	bool XmlReadDictionary(XmlStreamReader*, QVector<QString>&);
+	bool XmlReadData(XmlStreamReader*, int rows, bool textEncoded, const QVector<QString>& dictionary, bool preview);
+	void verifyMappedData(const QString& fileName, const QString& hash);
+	const char* rawData(qint64& size) const;
 
 	void handleRowInsertion(int before, int count) override;
 	void handleRowRemoval(int first, int count) override;
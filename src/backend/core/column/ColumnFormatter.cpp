@@ -0,0 +1,108 @@
+/***************************************************************************
+    File                 : ColumnFormatter.cpp
+    Project              : LabPlot
+    Description          : Formats the values of columns as delimited text
+    --------------------------------------------------------------------
+    Copyright            : (C) 2020 LabPlot developers
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "backend/core/column/ColumnFormatter.h"
+#include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnStringIO.h"
+#include "backend/core/datatypes/Double2StringFilter.h"
+
+/*!
+ * \class ColumnFormatter
+ * \brief Formats the values of columns as UTF-8 encoded, delimited text.
+ *
+ * Used for the ASCII export and for copying spreadsheet cells to the clipboard. Numbers are formatted
+ * with the numeric format of the column and the shortest representation that is read back to the same value,
+ * for the C locale directly into the byte buffer. Date and time values are formatted with the format of the column.
+ * formatRows() only reads the column data and can be called from several threads at the same time.
+ */
+ColumnFormatter::ColumnFormatter(const QVector<const Column*>& columns, const QLocale& locale, const QByteArray& separator)
+	: m_columns(columns), m_locale(locale), m_cLocale(locale.language() == QLocale::C), m_separator(separator) {
+
+	m_formats.reserve(columns.size());
+	for (const auto* col : columns) {
+		if (col->columnMode() == AbstractColumn::ColumnMode::Numeric)
+			m_formats << static_cast<Double2StringFilter*>(col->outputFilter())->numericFormat();
+		else
+			m_formats << 'g';
+	}
+}
+
+/*!
+ * only the cells in \p selected are formatted, the other ones are left empty.
+ * \p selected contains one entry per cell row by row, starting at the row \p firstRow.
+ */
+void ColumnFormatter::setSelection(const QVector<bool>& selected, int firstRow) {
+	m_selected = selected;
+	m_firstRow = firstRow;
+}
+
+/*!
+ * returns the rows [\p start, \p end) of the columns, each row is terminated by a newline.
+ */
+QByteArray ColumnFormatter::formatRows(int start, int end) const {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 7, 0)
+	const int precision = QLocale::FloatingPointShortest;
+#else
+	const int precision = 17;
+#endif
+
+	const int cols = m_columns.size();
+	QByteArray output;
+	output.reserve((end - start) * cols * 12);
+	for (int row = start; row < end; ++row) {
+		for (int c = 0; c < cols; ++c) {
+			if (m_selected.isEmpty() || m_selected.at((row - m_firstRow) * cols + c)) {
+				const Column* col = m_columns.at(c);
+				switch (col->columnMode()) {
+				case AbstractColumn::ColumnMode::Numeric:
+					if (m_cLocale)
+						output += QByteArray::number(col->valueAt(row), m_formats.at(c), precision);
+					else
+						output += m_locale.toString(col->valueAt(row), m_formats.at(c), precision).toUtf8();
+					break;
+				case AbstractColumn::ColumnMode::Integer:
+					output += QByteArray::number(col->integerAt(row));
+					break;
+				case AbstractColumn::ColumnMode::BigInt:
+					output += QByteArray::number(col->bigIntAt(row));
+					break;
+				case AbstractColumn::ColumnMode::Text:
+				case AbstractColumn::ColumnMode::DateTime:
+				case AbstractColumn::ColumnMode::Month:
+				case AbstractColumn::ColumnMode::Day:
+					output += col->asStringColumn()->textAt(row).toUtf8();
+				}
+			}
+			if (c != cols - 1)
+				output += m_separator;
+		}
+		output += '\n';
+	}
+
+	return output;
+}
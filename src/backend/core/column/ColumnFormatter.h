@@ -0,0 +1,55 @@
+/***************************************************************************
+    File                 : ColumnFormatter.h
+    Project              : LabPlot
+    Description          : Formats the values of columns as delimited text
+    --------------------------------------------------------------------
+    Copyright            : (C) 2020 LabPlot developers
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef COLUMNFORMATTER_H
+#define COLUMNFORMATTER_H
+
+#include <QByteArray>
+#include <QLocale>
+#include <QVector>
+
+class Column;
+
+class ColumnFormatter {
+public:
+	ColumnFormatter(const QVector<const Column*>&, const QLocale&, const QByteArray& separator);
+
+	void setSelection(const QVector<bool>& selected, int firstRow);
+	QByteArray formatRows(int start, int end) const;
+
+private:
+	QVector<const Column*> m_columns;
+	QVector<char> m_formats;
+	QLocale m_locale;
+	bool m_cLocale;
+	QByteArray m_separator;
+	QVector<bool> m_selected;
+	int m_firstRow{0};
+};
+
+#endif
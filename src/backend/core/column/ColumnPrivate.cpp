@@ -34,6 +34,17 @@
 #include "backend/core/datatypes/filter.h"
 #include "backend/gsl/ExpressionParser.h"
 
+#include <QFile>
+
+#include <KLocalizedString>
+
+#include <limits>
+
+//! maximal number of distinct strings of a dictionary encoded text column
+static const int maxTextDictionarySize = 65536;
+//! maximal number of values of a numeric column loaded into memory, QVector is limited to 2GB
+static const int maxVectorSize = (std::numeric_limits<int>::max() - 1024) / (int)sizeof(double);
+
 ColumnPrivate::ColumnPrivate(Column* owner, AbstractColumn::ColumnMode mode) :
 	m_column_mode(mode), m_owner(owner) {
 	Q_ASSERT(owner != nullptr);
@@ -57,24 +68,24 @@ ColumnPrivate::ColumnPrivate(Column* owner, AbstractColumn::ColumnMode mode) :
 	case AbstractColumn::ColumnMode::Text:
 		m_input_filter = new SimpleCopyThroughFilter();
 		m_output_filter = new SimpleCopyThroughFilter();
-		m_data = new QStringList();
+		m_data = new QVector<QString>();
 		break;
 	case AbstractColumn::ColumnMode::DateTime:
 		m_input_filter = new String2DateTimeFilter();
 		m_output_filter = new DateTime2StringFilter();
-		m_data = new QVector<QDateTime>();
+		m_data = new QVector<qint64>();
 		break;
 	case AbstractColumn::ColumnMode::Month:
 		m_input_filter = new String2MonthFilter();
 		m_output_filter = new DateTime2StringFilter();
 		static_cast<DateTime2StringFilter*>(m_output_filter)->setFormat("MMMM");
-		m_data = new QVector<QDateTime>();
+		m_data = new QVector<qint64>();
 		break;
 	case AbstractColumn::ColumnMode::Day:
 		m_input_filter = new String2DayOfWeekFilter();
 		m_output_filter = new DateTime2StringFilter();
 		static_cast<DateTime2StringFilter*>(m_output_filter)->setFormat("dddd");
-		m_data = new QVector<QDateTime>();
+		m_data = new QVector<qint64>();
 		break;
 	}
 
@@ -140,6 +151,7 @@ ColumnPrivate::ColumnPrivate(Column* owner, AbstractColumn::ColumnMode mode, voi
 }
 
 ColumnPrivate::~ColumnPrivate() {
+	releaseMapping();
 	if (!m_data) return;
 
 	switch (m_column_mode) {
@@ -158,7 +170,7 @@ ColumnPrivate::~ColumnPrivate() {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
-		delete static_cast<QVector<QDateTime>*>(m_data);
+		delete static_cast<QVector<qint64>*>(m_data);
 		break;
 	}
 }
@@ -180,8 +192,11 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 		<< " -> " << ENUM_TO_STRING(AbstractColumn, ColumnMode, mode))
 	if (mode == m_column_mode) return;
 
+	if (!unmapData())
+		return;
 	void* old_data = m_data;
 	// remark: the deletion of the old data will be done in the dtor of a command
+	decodeText();
 
 	AbstractSimpleFilter* filter = nullptr, *new_in_filter = nullptr, *new_out_filter = nullptr;
 	bool filter_is_temporary = false; // it can also become outputFilter(), which we may not delete here
@@ -219,19 +234,19 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter = new Double2DateTimeFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<double>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			filter = new Double2MonthFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<double>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Day:
 			filter = new Double2DayOfWeekFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<double>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
 
@@ -265,19 +280,19 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter = new Integer2DateTimeFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<int>* >(old_data)), m_column_mode);
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			filter = new Integer2MonthFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<int>* >(old_data)), m_column_mode);
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Day:
 			filter = new Integer2DayOfWeekFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<int>* >(old_data)), m_column_mode);
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
 
@@ -311,19 +326,19 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter = new BigInt2DateTimeFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<qint64>* >(old_data)), m_column_mode);
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			filter = new BigInt2MonthFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<qint64>* >(old_data)), m_column_mode);
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Day:
 			filter = new BigInt2DayOfWeekFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<qint64>* >(old_data)), m_column_mode);
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
 
@@ -355,19 +370,19 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter = new String2DateTimeFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast<QVector<QString>*>(old_data)), m_column_mode);
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			filter = new String2MonthFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast<QVector<QString>*>(old_data)), m_column_mode);
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Day:
 			filter = new String2DayOfWeekFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast<QVector<QString>*>(old_data)), m_column_mode);
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
 
@@ -386,8 +401,8 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 		case AbstractColumn::ColumnMode::Text:
 			filter = outputFilter();
 			filter_is_temporary = false;
-			temp_col = new Column("temp_col", *(static_cast< QVector<QDateTime>* >(old_data)), m_column_mode);
-			m_data = new QStringList();
+			temp_col = new Column("temp_col", *(static_cast<QVector<qint64>*>(old_data)), m_column_mode);
+			m_data = new QVector<QString>();
 			break;
 		case AbstractColumn::ColumnMode::Numeric:
 			if (m_column_mode == AbstractColumn::ColumnMode::Month)
@@ -397,7 +412,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			else
 				filter = new DateTime2DoubleFilter();
 			filter_is_temporary = true;
-			temp_col = new Column("temp_col", *(static_cast< QVector<QDateTime>* >(old_data)), m_column_mode);
+			temp_col = new Column("temp_col", *(static_cast<QVector<qint64>*>(old_data)), m_column_mode);
 			m_data = new QVector<double>();
 			break;
 		case AbstractColumn::ColumnMode::Integer:
@@ -408,7 +423,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			else
 				filter = new DateTime2IntegerFilter();
 			filter_is_temporary = true;
-			temp_col = new Column("temp_col", *(static_cast< QVector<QDateTime>* >(old_data)), m_column_mode);
+			temp_col = new Column("temp_col", *(static_cast<QVector<qint64>*>(old_data)), m_column_mode);
 			m_data = new QVector<int>();
 			break;
 		case AbstractColumn::ColumnMode::BigInt:
@@ -419,7 +434,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			else
 				filter = new DateTime2BigIntFilter();
 			filter_is_temporary = true;
-			temp_col = new Column("temp_col", *(static_cast< QVector<QDateTime>* >(old_data)), m_column_mode);
+			temp_col = new Column("temp_col", *(static_cast<QVector<qint64>*>(old_data)), m_column_mode);
 			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
@@ -489,6 +504,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 	if (temp_col) { // if temp_col == 0, only the input/output filters need to be changed
 		// copy the filtered, i.e. converted, column (mode is orig mode)
 		DEBUG("	temp_col column mode = " << ENUM_TO_STRING(AbstractColumn, ColumnMode, temp_col->columnMode()));
+		temp_col->setTimeSpec(m_timeSpec);
 		filter->input(0, temp_col);
 		DEBUG("	filter->output size = " << filter->output(0)->rowCount());
 		copy(filter->output(0));
@@ -509,7 +525,10 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void* data,
 				AbstractSimpleFilter* in_filter, AbstractSimpleFilter* out_filter) {
 	DEBUG("ColumnPrivate::replaceModeData()");
+	if (!unmapData())
+		return;
 	emit m_owner->modeAboutToChange(m_owner);
+	decodeText();
 	// disconnect formatChanged()
 	switch (m_column_mode) {
 	case AbstractColumn::ColumnMode::Numeric:
@@ -577,6 +596,12 @@ void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void* data,
 void ColumnPrivate::replaceData(void* data) {
 	DEBUG("ColumnPrivate::replaceData()")
 	emit m_owner->dataAboutToChange(m_owner);
+	if (data != m_data) {
+		//the data is replaced completely, the mapped values of too large columns are dropped
+		if (!unmapData())
+			releaseMapping();
+		releaseTextEncoding();
+	}
 	m_data = data;
 	invalidate();
 	if (!m_owner->m_suppressDataChangedSignal)
@@ -597,6 +622,8 @@ bool ColumnPrivate::copy(const AbstractColumn* other) {
 	int num_rows = other->rowCount();
 // 	DEBUG("	rows " << num_rows);
 
+	if (!unmapData())
+		return false;
 	emit m_owner->dataAboutToChange(m_owner);
 	resizeTo(num_rows);
 
@@ -621,17 +648,18 @@ bool ColumnPrivate::copy(const AbstractColumn* other) {
 		break;
 	}
 	case AbstractColumn::ColumnMode::Text: {
-		auto* vec = static_cast<QVector<QString>*>(m_data);
+		QVector<QString> values(num_rows);
 		for (int i = 0; i < num_rows; ++i)
-			vec->replace(i, other->textAt(i));
+			values[i] = other->textAt(i);
+		replaceTextRows(0, values);
 		break;
 	}
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day: {
-		auto* vec = static_cast<QVector<QDateTime>*>(m_data);
+		qint64* ptr = static_cast<QVector<qint64>*>(m_data)->data();
 		for (int i = 0; i < num_rows; ++i)
-			vec->replace(i, other->dateTimeAt(i));
+			ptr[i] = other->dateTimeMSecsAt(i);
 		break;
 	}
 	}
@@ -657,6 +685,8 @@ bool ColumnPrivate::copy(const AbstractColumn* source, int source_start, int des
 	if (source->columnMode() != m_column_mode) return false;
 	if (num_rows == 0) return true;
 
+	if (!unmapData())
+		return false;
 	emit m_owner->dataAboutToChange(m_owner);
 	if (dest_start + num_rows > rowCount())
 		resizeTo(dest_start + num_rows);
@@ -681,17 +711,22 @@ bool ColumnPrivate::copy(const AbstractColumn* source, int source_start, int des
 			ptr[dest_start+i] = source->bigIntAt(source_start + i);
 		break;
 	}
-	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::Text: {
+		QVector<QString> values(num_rows);
 		for (int i = 0; i < num_rows; i++)
-			static_cast<QVector<QString>*>(m_data)->replace(dest_start+i, source->textAt(source_start + i));
+			values[i] = source->textAt(source_start + i);
+		replaceTextRows(dest_start, values);
 		break;
+	}
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Day: {
+		qint64* ptr = static_cast<QVector<qint64>*>(m_data)->data();
 		for (int i = 0; i < num_rows; i++)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(dest_start+i, source->dateTimeAt(source_start + i));
+			ptr[dest_start+i] = source->dateTimeMSecsAt(source_start + i);
 		break;
 	}
+	}
 
 	if (!m_owner->m_suppressDataChangedSignal)
 		emit m_owner->dataChanged(m_owner);
@@ -709,6 +744,8 @@ bool ColumnPrivate::copy(const ColumnPrivate* other) {
 	if (other->columnMode() != m_column_mode) return false;
 	int num_rows = other->rowCount();
 
+	if (!unmapData())
+		return false;
 	emit m_owner->dataAboutToChange(m_owner);
 	resizeTo(num_rows);
 
@@ -732,17 +769,22 @@ bool ColumnPrivate::copy(const ColumnPrivate* other) {
 			ptr[i] = other->bigIntAt(i);
 		break;
 	}
-	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::Text: {
+		QVector<QString> values(num_rows);
 		for (int i = 0; i < num_rows; ++i)
-			static_cast<QVector<QString>*>(m_data)->replace(i, other->textAt(i));
+			values[i] = other->textAt(i);
+		replaceTextRows(0, values);
 		break;
+	}
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Day: {
+		qint64* ptr = static_cast<QVector<qint64>*>(m_data)->data();
 		for (int i = 0; i < num_rows; ++i)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(i, other->dateTimeAt(i));
+			ptr[i] = other->dateTimeMSecsAt(i);
 		break;
 	}
+	}
 
 	if (!m_owner->m_suppressDataChangedSignal)
 		emit m_owner->dataChanged(m_owner);
@@ -764,6 +806,8 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
 	if (source->columnMode() != m_column_mode) return false;
 	if (num_rows == 0) return true;
 
+	if (!unmapData())
+		return false;
 	emit m_owner->dataAboutToChange(m_owner);
 	if (dest_start + num_rows > rowCount())
 		resizeTo(dest_start + num_rows);
@@ -788,17 +832,22 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
 			ptr[dest_start+i] = source->bigIntAt(source_start + i);
 		break;
 	}
-	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::Text: {
+		QVector<QString> values(num_rows);
 		for (int i = 0; i < num_rows; ++i)
-			static_cast<QVector<QString>*>(m_data)->replace(dest_start+i, source->textAt(source_start + i));
+			values[i] = source->textAt(source_start + i);
+		replaceTextRows(dest_start, values);
 		break;
+	}
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::Day:
-		for (int i = 0; i  <num_rows; ++i)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(dest_start+i, source->dateTimeAt(source_start + i));
+	case AbstractColumn::ColumnMode::Day: {
+		qint64* ptr = static_cast<QVector<qint64>*>(m_data)->data();
+		for (int i = 0; i < num_rows; ++i)
+			ptr[dest_start+i] = source->dateTimeMSecsAt(source_start + i);
 		break;
 	}
+	}
 
 	invalidate();
 
@@ -816,6 +865,8 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
 int ColumnPrivate::rowCount() const {
 	switch (m_column_mode) {
 	case AbstractColumn::ColumnMode::Numeric:
+		if (m_mappedData)
+			return m_mappedRowCount;
 		return static_cast<QVector<double>*>(m_data)->size();
 	case AbstractColumn::ColumnMode::Integer:
 		return static_cast<QVector<int>*>(m_data)->size();
@@ -824,8 +875,10 @@ int ColumnPrivate::rowCount() const {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
-		return static_cast<QVector<QDateTime>*>(m_data)->size();
+		return static_cast<QVector<qint64>*>(m_data)->size();
 	case AbstractColumn::ColumnMode::Text:
+		if (m_textEncoded)
+			return m_textCodes.size();
 		return static_cast<QVector<QString>*>(m_data)->size();
 	}
 
@@ -865,6 +918,9 @@ void ColumnPrivate::resizeTo(int new_size) {
 	if (new_size == old_size)
 		return;
 
+	if (!unmapData())
+		return;
+
 // 	DEBUG("ColumnPrivate::resizeTo() " << old_size << " -> " << new_size);
 
 	switch (m_column_mode) {
@@ -885,7 +941,12 @@ void ColumnPrivate::resizeTo(int new_size) {
 	}
 	case AbstractColumn::ColumnMode::Text: {
 		int new_rows = new_size - old_size;
-		if (new_rows > 0) {
+		if (m_textEncoded) {
+			if (new_rows > 0)
+				m_textCodes.insert(m_textCodes.end(), new_rows, -1);
+			else
+				m_textCodes.resize(new_size);
+		} else if (new_rows > 0) {
 			for (int i = 0; i < new_rows; ++i)
 				static_cast<QVector<QString>*>(m_data)->append(QString());
 		} else {
@@ -897,14 +958,11 @@ void ColumnPrivate::resizeTo(int new_size) {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day: {
-		int new_rows = new_size - old_size;
-		if (new_rows > 0) {
-			for (int i = 0; i < new_rows; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->append(QDateTime());
-		} else {
-			for (int i = 0; i < -new_rows; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->removeLast();
-		}
+		auto* dateTime_data = static_cast<QVector<qint64>*>(m_data);
+		if (new_size > old_size)
+			dateTime_data->insert(dateTime_data->end(), new_size - old_size, AbstractColumn::invalidDateTime);
+		else
+			dateTime_data->resize(new_size);
 		break;
 	}
 	}
@@ -916,6 +974,9 @@ void ColumnPrivate::resizeTo(int new_size) {
 void ColumnPrivate::insertRows(int before, int count) {
 	if (count == 0) return;
 
+	if (!unmapData())
+		return;
+
 	m_formulas.insertRows(before, count);
 
 	if (before <= rowCount()) {
@@ -932,12 +993,15 @@ void ColumnPrivate::insertRows(int before, int count) {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			for (int i = 0; i < count; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->insert(before, QDateTime());
+			static_cast<QVector<qint64>*>(m_data)->insert(before, count, AbstractColumn::invalidDateTime);
 			break;
 		case AbstractColumn::ColumnMode::Text:
-			for (int i = 0; i < count; ++i)
-				static_cast<QVector<QString>*>(m_data)->insert(before, QString());
+			if (m_textEncoded)
+				m_textCodes.insert(before, count, -1);
+			else {
+				for (int i = 0; i < count; ++i)
+					static_cast<QVector<QString>*>(m_data)->insert(before, QString());
+			}
 			break;
 		}
 	}
@@ -949,6 +1013,9 @@ void ColumnPrivate::insertRows(int before, int count) {
 void ColumnPrivate::removeRows(int first, int count) {
 	if (count == 0) return;
 
+	if (!unmapData())
+		return;
+
 	m_formulas.removeRows(first, count);
 
 	if (first < rowCount()) {
@@ -969,12 +1036,15 @@ void ColumnPrivate::removeRows(int first, int count) {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			for (int i = 0; i < corrected_count; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->removeAt(first);
+			static_cast<QVector<qint64>*>(m_data)->remove(first, corrected_count);
 			break;
 		case AbstractColumn::ColumnMode::Text:
-			for (int i = 0; i < corrected_count; ++i)
-				static_cast<QVector<QString>*>(m_data)->removeAt(first);
+			if (m_textEncoded)
+				m_textCodes.remove(first, corrected_count);
+			else {
+				for (int i = 0; i < corrected_count; ++i)
+					static_cast<QVector<QString>*>(m_data)->removeAt(first);
+			}
 			break;
 		}
 	}
@@ -1015,13 +1085,157 @@ void ColumnPrivate::setWidth(int value) {
 	m_width = value;
 }
 
+/**
+ * \brief Return the time spec used to convert the stored values to QDateTime
+ */
+Qt::TimeSpec ColumnPrivate::timeSpec() const {
+	return m_timeSpec;
+}
+
+/**
+ * \brief Set the time spec used to convert the stored values to QDateTime
+ *
+ * The stored values (milliseconds since epoch) are not modified.
+ */
+void ColumnPrivate::setTimeSpec(Qt::TimeSpec spec) {
+	m_timeSpec = spec;
+}
+
 /**
  * \brief Return the data pointer
+ *
+ * The data container can be modified via the returned pointer, mapped data is loaded into memory first.
+ * Mapped data exceeding the size of QVector stays mapped and the container is empty, see unmapData().
  */
 void* ColumnPrivate::data() const {
+	if (m_mappedData)
+		const_cast<ColumnPrivate*>(this)->unmapData();
+	if (m_textEncoded)
+		const_cast<ColumnPrivate*>(this)->decodeText();
 	return m_data;
 }
 
+/**
+ * \brief Map the file \c fileName as the storage of the numeric data
+ *
+ * The column uses \c rows double values in the byte order of the host starting at \c offset in the file
+ * without reading them into memory. The values are paged in by the operating system on access and can be
+ * dropped again under memory pressure, so columns larger than the available memory can be used.
+ * The mapped data is read-only, it's loaded into memory once the column is modified or data() is called.
+ * The file must not be modified while it's mapped.
+ *
+ * If \c removeFile is \c true, the file is removed when the mapping is released or if the mapping fails.
+ *
+ * Returns \c true on success, the data of the column is not changed otherwise.
+ */
+bool ColumnPrivate::mapData(const QString& fileName, qint64 offset, int rows, bool removeFile) {
+	std::shared_ptr<QFile> file;
+	if (removeFile)
+		file.reset(new QFile(fileName), [](QFile* f) {
+			const QString name = f->fileName();
+			delete f;	//also unmaps the data
+			QFile::remove(name);
+		});
+	else
+		file.reset(new QFile(fileName));
+
+	if (m_column_mode != AbstractColumn::ColumnMode::Numeric || rows <= 0 || offset < 0)
+		return false;
+
+	//the values are accessed in place and need to be aligned
+	if (offset % (qint64)sizeof(double) != 0)
+		return false;
+
+	const qint64 size = (qint64)rows * (qint64)sizeof(double);
+	uchar* data = nullptr;
+	if (file->open(QIODevice::ReadOnly) && offset + size <= file->size())
+		data = file->map(offset, size);
+	if (!data) {
+		DEBUG("ColumnPrivate::mapData() failed to map " << STDSTRING(fileName));
+		return false;
+	}
+
+	emit m_owner->dataAboutToChange(m_owner);
+	releaseMapping();
+	*static_cast<QVector<double>*>(m_data) = QVector<double>();
+	m_mappedFile = file;
+	m_mappedData = reinterpret_cast<const double*>(data);
+	m_mappedRowCount = rows;
+	invalidate();
+	if (!m_owner->m_suppressDataChangedSignal)
+		emit m_owner->dataChanged(m_owner);
+
+	return true;
+}
+
+/**
+ * \brief Return whether the numeric data is mapped from a file, see mapData()
+ */
+bool ColumnPrivate::isMapped() const {
+	return m_mappedData != nullptr;
+}
+
+/**
+ * \brief Load the mapped data into memory and release the mapping
+ *
+ * Returns \c false if the data is mapped and exceeds the size of QVector, the column can only be read then
+ * and is not modified. The problem is reported in the status bar.
+ */
+bool ColumnPrivate::unmapData() {
+	if (!m_mappedData)
+		return true;
+
+	DEBUG("ColumnPrivate::unmapData() rows = " << m_mappedRowCount);
+	if (m_mappedRowCount > maxVectorSize) {
+		DEBUG("ColumnPrivate::unmapData() too many rows to load the data into memory");
+		m_owner->info(i18n("The column '%1' is too large to be loaded into memory and can't be modified.", m_owner->name()));
+		return false;
+	}
+
+	auto* vec = static_cast<QVector<double>*>(m_data);
+	vec->resize(m_mappedRowCount);
+	memcpy(vec->data(), m_mappedData, m_mappedRowCount * sizeof(double));
+	releaseMapping();
+	return true;
+}
+
+/**
+ * \brief Release the mapping and set all values to NaN, used if the mapped file turned out to be corrupted
+ */
+void ColumnPrivate::invalidateMappedData() {
+	if (!m_mappedData)
+		return;
+
+	const int rows = m_mappedRowCount;
+	emit m_owner->dataAboutToChange(m_owner);
+	releaseMapping();
+	static_cast<QVector<double>*>(m_data)->fill(NAN, qMin(rows, maxVectorSize));
+	invalidate();
+	if (!m_owner->m_suppressDataChangedSignal)
+		emit m_owner->dataChanged(m_owner);
+}
+
+void ColumnPrivate::releaseMapping() {
+	if (!m_mappedFile)
+		return;
+
+	//the file is closed and the data unmapped once the values obtained via Column::numericValues() are released too
+	m_mappedFile.reset();
+	m_mappedData = nullptr;
+	m_mappedRowCount = 0;
+}
+
+/**
+ * \brief Return the numeric values without loading mapped data into memory
+ *
+ * Use this only when columnMode() is Numeric. The values are only valid while the column is not modified.
+ */
+const double* ColumnPrivate::numericData() const {
+	if (m_mappedData)
+		return m_mappedData;
+	return static_cast<QVector<double>*>(m_data)->constData();
+}
+
 /**
  * \brief Return the input filter (for string -> data type conversion)
  */
@@ -1297,6 +1511,10 @@ void ColumnPrivate::clearFormulas() {
  */
 QString ColumnPrivate::textAt(int row) const {
 	if (m_column_mode != AbstractColumn::ColumnMode::Text) return QString();
+	if (m_textEncoded) {
+		const int code = m_textCodes.value(row, -1);
+		return (code != -1) ? m_textDictionary.at(code) : QString();
+	}
 	return static_cast<QVector<QString>*>(m_data)->value(row);
 }
 
@@ -1336,7 +1554,20 @@ QDateTime ColumnPrivate::dateTimeAt(int row) const {
 		m_column_mode != AbstractColumn::ColumnMode::Month &&
 		m_column_mode != AbstractColumn::ColumnMode::Day)
 		return QDateTime();
-	return static_cast<QVector<QDateTime>*>(m_data)->value(row);
+	return AbstractColumn::dateTimeFromMSecs(static_cast<QVector<qint64>*>(m_data)->value(row, AbstractColumn::invalidDateTime), m_timeSpec);
+}
+
+/**
+ * \brief Return the value in row 'row' as milliseconds since epoch
+ *
+ * Use this only when columnMode() is DateTime, Month or Day
+ */
+qint64 ColumnPrivate::dateTimeMSecsAt(int row) const {
+	if (m_column_mode != AbstractColumn::ColumnMode::DateTime &&
+		m_column_mode != AbstractColumn::ColumnMode::Month &&
+		m_column_mode != AbstractColumn::ColumnMode::Day)
+		return AbstractColumn::invalidDateTime;
+	return static_cast<QVector<qint64>*>(m_data)->value(row, AbstractColumn::invalidDateTime);
 }
 
 /**
@@ -1345,8 +1576,11 @@ QDateTime ColumnPrivate::dateTimeAt(int row) const {
  * For cases where the integer value is needed without any implicit conversions, \sa integerAt() has to be used.
  */
 double ColumnPrivate::valueAt(int row) const {
-	if (m_column_mode == AbstractColumn::ColumnMode::Numeric)
+	if (m_column_mode == AbstractColumn::ColumnMode::Numeric) {
+		if (m_mappedData)
+			return (row >= 0 && row < m_mappedRowCount) ? m_mappedData[row] : NAN;
 		return static_cast<QVector<double>*>(m_data)->value(row, NAN);
+	}
 	else if (m_column_mode == AbstractColumn::ColumnMode::Integer)
 		return static_cast<QVector<int>*>(m_data)->value(row, 0);
 	else if (m_column_mode == AbstractColumn::ColumnMode::BigInt)
@@ -1375,6 +1609,7 @@ void ColumnPrivate::invalidate() {
 	statisticsAvailable = false;
 	hasValuesAvailable = false;
 	propertiesAvailable = false;
+	dataHash.clear();
 }
 
 /**
@@ -1391,7 +1626,7 @@ void ColumnPrivate::setTextAt(int row, const QString& new_value) {
 	if (row >= rowCount())
 		resizeTo(row + 1);
 
-	static_cast<QVector<QString>*>(m_data)->replace(row, new_value);
+	replaceTextRows(row, {new_value});
 	if (!m_owner->m_suppressDataChangedSignal)
 		emit m_owner->dataChanged(m_owner);
 }
@@ -1411,13 +1646,193 @@ void ColumnPrivate::replaceTexts(int first, const QVector<QString>& new_values)
 	if (first + num_rows > rowCount())
 		resizeTo(first + num_rows);
 
-	for (int i = 0; i < num_rows; ++i)
-		static_cast<QVector<QString>*>(m_data)->replace(first+i, new_values.at(i));
+	replaceTextRows(first, new_values);
 
 	if (!m_owner->m_suppressDataChangedSignal)
 		emit m_owner->dataChanged(m_owner);
 }
 
+/**
+ * \brief Return whether the text data is dictionary encoded
+ *
+ * The rows of a dictionary encoded text column are represented by integer codes
+ * pointing to the distinct strings of the column. The container returned by data()
+ * is empty while the column is encoded, it's filled with the strings on access.
+ */
+bool ColumnPrivate::isTextEncoded() const {
+	return m_textEncoded;
+}
+
+/**
+ * \brief Dictionary encode the text data if the number of distinct values is low
+ *
+ * Returns \c true if the column is encoded.
+ */
+bool ColumnPrivate::encodeText() {
+	if (m_column_mode != AbstractColumn::ColumnMode::Text)
+		return false;
+	if (m_textEncoded)
+		return true;
+
+	auto* vec = static_cast<QVector<QString>*>(m_data);
+	const int rows = vec->size();
+	const int maxSize = qMin(maxTextDictionarySize, rows/2);
+
+	QVector<QString> dictionary;
+	QHash<QString, int> index;
+	QVector<int> codes(rows);
+	for (int i = 0; i < rows; ++i) {
+		const QString& value = vec->at(i);
+		if (value.isNull()) {
+			codes[i] = -1;
+			continue;
+		}
+
+		auto it = index.constFind(value);
+		if (it == index.constEnd()) {
+			if (dictionary.size() >= maxSize)
+				return false;	// too many distinct values
+			it = index.insert(value, dictionary.size());
+			dictionary << value;
+		}
+		codes[i] = it.value();
+	}
+
+	// only the codes and the distinct strings are kept
+	vec->clear();
+	vec->squeeze();
+
+	m_textDictionary = std::move(dictionary);
+	m_textDictionaryIndex = std::move(index);
+	m_textCodes = std::move(codes);
+	m_textEncoded = true;
+
+	return true;
+}
+
+/**
+ * \brief Drop the dictionary encoding and fill the text data with the strings of the rows
+ */
+void ColumnPrivate::decodeText() {
+	if (!m_textEncoded)
+		return;
+
+	auto* vec = static_cast<QVector<QString>*>(m_data);
+	const int rows = m_textCodes.size();
+	vec->resize(rows);
+	QString* data = vec->data();
+	for (int i = 0; i < rows; ++i) {
+		const int code = m_textCodes.at(i);
+		if (code != -1)
+			data[i] = m_textDictionary.at(code);
+	}
+
+	releaseTextEncoding();
+}
+
+/**
+ * \brief Drop the dictionary encoding without restoring the text data, used when the data is replaced
+ */
+void ColumnPrivate::releaseTextEncoding() {
+	m_textEncoded = false;
+	m_textDictionary.clear();
+	m_textDictionaryIndex.clear();
+	m_textCodes.clear();
+}
+
+/**
+ * \brief Return the distinct strings of a dictionary encoded text column
+ */
+const QVector<QString>& ColumnPrivate::textDictionary() const {
+	return m_textDictionary;
+}
+
+/**
+ * \brief Return the codes of all rows of a dictionary encoded text column
+ */
+const QVector<int>& ColumnPrivate::textCodes() const {
+	return m_textCodes;
+}
+
+/**
+ * \brief Return the code of the string in row 'row' of a dictionary encoded text column
+ *
+ * The code is the index of the string in textDictionary() or -1 for null strings.
+ */
+int ColumnPrivate::textCodeAt(int row) const {
+	return m_textCodes.value(row, -1);
+}
+
+/**
+ * \brief Replace the text data by the strings of \c dictionary given by \c codes
+ *
+ * Used when loading dictionary encoded text columns, invalid codes result in null strings.
+ */
+void ColumnPrivate::replaceTextCodes(const QVector<QString>& dictionary, const QVector<int>& codes) {
+	if (m_column_mode != AbstractColumn::ColumnMode::Text)
+		return;
+
+	emit m_owner->dataAboutToChange(m_owner);
+	auto* vec = static_cast<QVector<QString>*>(m_data);
+	vec->clear();
+	vec->squeeze();
+
+	m_textDictionary = dictionary;
+	m_textDictionaryIndex.clear();
+	for (int i = 0; i < dictionary.size(); ++i)
+		m_textDictionaryIndex.insert(dictionary.at(i), i);
+	m_textCodes = codes;
+	for (auto& code : m_textCodes)
+		if (code < -1 || code >= dictionary.size())
+			code = -1;
+	m_textEncoded = true;
+
+	invalidate();
+	if (!m_owner->m_suppressDataChangedSignal)
+		emit m_owner->dataChanged(m_owner);
+}
+
+/**
+ * \brief Set the strings of the rows starting at \c first, the rows have to exist already
+ *
+ * The encoding is kept and only dropped if the dictionary becomes too large.
+ */
+void ColumnPrivate::replaceTextRows(int first, const QVector<QString>& values) {
+	if (m_textEncoded && setTextCodes(first, values))
+		return;
+
+	decodeText();
+	auto* vec = static_cast<QVector<QString>*>(m_data);
+	for (int i = 0; i < values.size(); ++i)
+		vec->replace(first + i, values.at(i));
+}
+
+/**
+ * \brief Set the strings of the rows starting at \c first of a dictionary encoded text column
+ *
+ * Returns \c false if the dictionary becomes too large, the column has to be decoded then.
+ */
+bool ColumnPrivate::setTextCodes(int first, const QVector<QString>& values) {
+	for (int i = 0; i < values.size(); ++i) {
+		const QString& value = values.at(i);
+		if (value.isNull()) {
+			m_textCodes[first + i] = -1;
+			continue;
+		}
+
+		auto it = m_textDictionaryIndex.constFind(value);
+		if (it == m_textDictionaryIndex.constEnd()) {
+			if (m_textDictionary.size() >= maxTextDictionarySize)
+				return false;
+			it = m_textDictionaryIndex.insert(value, m_textDictionary.size());
+			m_textDictionary << value;
+		}
+		m_textCodes[first + i] = it.value();
+	}
+
+	return true;
+}
+
 /**
  * \brief Set the content of row 'row'
  *
@@ -1429,7 +1844,7 @@ void ColumnPrivate::setDateAt(int row, QDate new_value) {
 		m_column_mode != AbstractColumn::ColumnMode::Day)
 		return;
 
-	setDateTimeAt(row, QDateTime(new_value, timeAt(row)));
+	setDateTimeAt(row, QDateTime(new_value, timeAt(row), m_timeSpec));
 }
 
 /**
@@ -1443,7 +1858,7 @@ void ColumnPrivate::setTimeAt(int row, QTime new_value) {
 		m_column_mode != AbstractColumn::ColumnMode::Day)
 		return;
 
-	setDateTimeAt(row, QDateTime(dateAt(row), new_value));
+	setDateTimeAt(row, QDateTime(dateAt(row), new_value, m_timeSpec));
 }
 
 /**
@@ -1463,7 +1878,7 @@ void ColumnPrivate::setDateTimeAt(int row, const QDateTime& new_value) {
 	if (row >= rowCount())
 		resizeTo(row+1);
 
-	static_cast< QVector<QDateTime>* >(m_data)->replace(row, new_value);
+	static_cast<QVector<qint64>*>(m_data)->replace(row, AbstractColumn::dateTimeToMSecs(new_value));
 	if (!m_owner->m_suppressDataChangedSignal)
 		emit m_owner->dataChanged(m_owner);
 }
@@ -1486,9 +1901,9 @@ void ColumnPrivate::replaceDateTimes(int first, const QVector<QDateTime>& new_va
 	if (first + num_rows > rowCount())
 		resizeTo(first + num_rows);
 
+	qint64* ptr = static_cast<QVector<qint64>*>(m_data)->data();
 	for (int i = 0; i < num_rows; ++i)
-		static_cast<QVector<QDateTime>*>(m_data)->replace(first+i, new_values.at(i));
-
+		ptr[first+i] = AbstractColumn::dateTimeToMSecs(new_values.at(i));
 
 	if (!m_owner->m_suppressDataChangedSignal)
 		emit m_owner->dataChanged(m_owner);
@@ -1503,6 +1918,9 @@ void ColumnPrivate::setValueAt(int row, double new_value) {
 //	DEBUG("ColumnPrivate::setValueAt()");
 	if (m_column_mode != AbstractColumn::ColumnMode::Numeric) return;
 
+	if (!unmapData())
+		return;
+
 	invalidate();
 
 	emit m_owner->dataAboutToChange(m_owner);
@@ -1524,6 +1942,9 @@ void ColumnPrivate::replaceValues(int first, const QVector<double>& new_values)
 
 	if (m_column_mode != AbstractColumn::ColumnMode::Numeric) return;
 
+	if (!unmapData())
+		return;
+
 	invalidate();
 
 	emit m_owner->dataAboutToChange(m_owner);
@@ -1655,7 +2076,7 @@ void ColumnPrivate::updateProperties() {
 	else if (m_column_mode == AbstractColumn::ColumnMode::DateTime ||
 			m_column_mode == AbstractColumn::ColumnMode::Month ||
 			m_column_mode == AbstractColumn::ColumnMode::Day)
-		prevValueDatetime = dateTimeAt(0).toMSecsSinceEpoch();
+		prevValueDatetime = dateTimeMSecsAt(0);
 	else {
 		properties = AbstractColumn::Properties::No;
 		propertiesAvailable = true;
@@ -1767,7 +2188,7 @@ void ColumnPrivate::updateProperties() {
 				   m_column_mode == AbstractColumn::ColumnMode::Month ||
 				   m_column_mode == AbstractColumn::ColumnMode::Day) {
 
-			valueDateTime = dateTimeAt(row).toMSecsSinceEpoch();
+			valueDateTime = dateTimeMSecsAt(row);
 
 			if (valueDateTime > prevValueDatetime) {
 				monotonic_decreasing = 0;
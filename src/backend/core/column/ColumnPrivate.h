@@ -33,8 +33,12 @@
 
 #include "backend/core/AbstractColumn.h"
 #include "backend/lib/IntervalAttribute.h"
+#include <QHash>
+
+#include <memory>
 
 class Column;
+class QFile;
 
 class ColumnPrivate : public QObject {
 	Q_OBJECT
@@ -66,8 +70,17 @@ public:
 	int width() const;
 	void setWidth(int);
 
+	Qt::TimeSpec timeSpec() const;
+	void setTimeSpec(Qt::TimeSpec);
+
 	void* data() const;
 
+	bool mapData(const QString& fileName, qint64 offset, int rows, bool removeFile = false);
+	bool isMapped() const;
+	bool unmapData();
+	void invalidateMappedData();
+	const double* numericData() const;
+
 	AbstractSimpleFilter* inputFilter() const;
 	AbstractSimpleFilter* outputFilter() const;
 
@@ -102,11 +115,20 @@ public:
 	void setTextAt(int row, const QString&);
 	void replaceTexts(int first, const QVector<QString>&);
 
+	bool isTextEncoded() const;
+	bool encodeText();
+	void decodeText();
+	const QVector<QString>& textDictionary() const;
+	const QVector<int>& textCodes() const;
+	int textCodeAt(int row) const;
+	void replaceTextCodes(const QVector<QString>& dictionary, const QVector<int>& codes);
+
 	QDate dateAt(int row) const;
 	void setDateAt(int row, QDate);
 	QTime timeAt(int row) const;
 	void setTimeAt(int row, QTime);
 	QDateTime dateTimeAt(int row) const;
+	qint64 dateTimeMSecsAt(int row) const;
 	void setDateTimeAt(int row, const QDateTime&);
 	void replaceDateTimes(int first, const QVector<QDateTime>&);
 
@@ -135,6 +157,8 @@ public:
 	mutable bool propertiesAvailable{false}; //is 'properties' already available (true) or needs to be (re-)calculated (false)?
 	mutable AbstractColumn::Properties properties{AbstractColumn::Properties::No}; // declares the properties of the curve (monotonic increasing/decreasing ...). Speed up algorithms
 
+	mutable QString dataHash;	//hash of the data determined in Column::dataHash(), empty if not determined yet or the data was changed
+
 private:
 	AbstractColumn::ColumnMode m_column_mode;	// type of column data
 	void* m_data{nullptr};	//pointer to the data container (QVector<T>)
@@ -148,11 +172,25 @@ private:
 	IntervalAttribute<QString> m_formulas;
 	AbstractColumn::PlotDesignation m_plot_designation{AbstractColumn::PlotDesignation::NoDesignation};
 	int m_width{0}; //column width in the view
+	Qt::TimeSpec m_timeSpec{Qt::LocalTime};	//time spec used to convert the stored milliseconds since epoch to QDateTime
+	//dictionary encoding of text data, m_data is empty while the text is encoded
+	bool m_textEncoded{false};
+	QVector<QString> m_textDictionary;	//distinct strings of the column
+	QHash<QString, int> m_textDictionaryIndex;	//string -> code
+	QVector<int> m_textCodes;	//index into m_textDictionary for every row, -1 for null strings
+	//memory mapped numeric data, m_data is empty while the data is mapped
+	std::shared_ptr<QFile> m_mappedFile;	//shared with the values obtained via Column::numericValues()
+	const double* m_mappedData{nullptr};
+	int m_mappedRowCount{0};
 	Column* m_owner{nullptr};
 	QVector<QMetaObject::Connection> m_connectionsUpdateFormula;
 
 private:
 	void connectFormulaColumn(const AbstractColumn* column);
+	void replaceTextRows(int first, const QVector<QString>&);
+	bool setTextCodes(int first, const QVector<QString>&);
+	void releaseTextEncoding();
+	void releaseMapping();
 
 private slots:
 	void formulaVariableColumnRemoved(const AbstractAspect*);
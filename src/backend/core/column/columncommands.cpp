@@ -122,7 +122,7 @@ ColumnSetModeCmd::~ColumnSetModeCmd() {
 			case AbstractColumn::ColumnMode::DateTime:
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day:
-				delete static_cast<QVector<QDateTime>*>(m_new_data);
+				delete static_cast<QVector<qint64>*>(m_new_data);
 				break;
 			}
 	} else {
@@ -143,7 +143,7 @@ ColumnSetModeCmd::~ColumnSetModeCmd() {
 			case AbstractColumn::ColumnMode::DateTime:
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day:
-				delete static_cast<QVector<QDateTime>*>(m_old_data);
+				delete static_cast<QVector<qint64>*>(m_old_data);
 				break;
 			}
 	}
@@ -579,7 +579,7 @@ ColumnClearCmd::~ColumnClearCmd() {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			delete static_cast<QVector<QDateTime>*>(m_empty_data);
+			delete static_cast<QVector<qint64>*>(m_empty_data);
 			break;
 		}
 	} else {
@@ -600,7 +600,7 @@ ColumnClearCmd::~ColumnClearCmd() {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			delete static_cast<QVector<QDateTime>*>(m_data);
+			delete static_cast<QVector<qint64>*>(m_data);
 			break;
 		}
 	}
@@ -637,9 +637,7 @@ void ColumnClearCmd::redo() {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			m_empty_data = new QVector<QDateTime>();
-			for (int i = 0; i < rowCount; ++i)
-				static_cast< QVector<QDateTime>*>(m_empty_data)->append(QDateTime());
+			m_empty_data = new QVector<qint64>(rowCount, AbstractColumn::invalidDateTime);
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			m_empty_data = new QVector<QString>();
@@ -1068,7 +1066,11 @@ ColumnReplaceTextsCmd::ColumnReplaceTextsCmd(ColumnPrivate* col, int first, cons
  */
 void ColumnReplaceTextsCmd::redo() {
 	if (!m_copied) {
-		m_old_values = static_cast<QVector<QString>*>(m_col->data())->mid(m_first, m_new_values.count());
+		//read the old strings via textAt(), data() would decode dictionary encoded columns
+		const int count = qBound(0, m_col->rowCount() - m_first, m_new_values.count());
+		m_old_values.resize(count);
+		for (int i = 0; i < count; ++i)
+			m_old_values[i] = m_col->textAt(m_first + i);
 		m_row_count = m_col->rowCount();
 		m_copied = true;
 	}
@@ -1258,7 +1260,10 @@ ColumnReplaceDateTimesCmd::ColumnReplaceDateTimesCmd(ColumnPrivate* col, int fir
  */
 void ColumnReplaceDateTimesCmd::redo() {
 	if (!m_copied) {
-		m_old_values = static_cast<QVector<QDateTime>*>(m_col->data())->mid(m_first, m_new_values.count());
+		const int count = qMax(0, qMin(m_new_values.count(), m_col->rowCount() - m_first));
+		m_old_values.reserve(count);
+		for (int i = 0; i < count; ++i)
+			m_old_values << m_col->dateTimeAt(m_first + i);
 		m_row_count = m_col->rowCount();
 		m_copied = true;
 	}
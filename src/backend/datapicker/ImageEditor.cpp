@@ -28,7 +28,9 @@
 #include "ImageEditor.h"
 #include <QThreadPool>
 #include <QElapsedTimer>
-#include <QMutex>
+
+#include <cmath>
+#include <climits>
 
 extern "C" {
 #include <gsl/gsl_math.h>
@@ -45,46 +47,144 @@ static const int maxHue = 360;
 static const int maxSaturation = 100;
 static const int maxValue = 100;
 
-QMutex mutex;
+// helpers converting the raw color quantities to the ranges used in the editor settings,
+// used for single pixels and for the lookup tables in discretize()
+static inline int hueValue(int h) {
+	//QColor::hue() can return -1
+	return qBound(0, h * maxHue / 359, maxHue);
+}
+
+static inline int saturationValue(int s) {
+	return qMin(s * maxSaturation / 255, maxSaturation);
+}
+
+static inline int valueValue(int v) {
+	return qMin(v * maxValue / 255, maxValue);
+}
+
+static inline int distanceValue(double distance, int max) {
+	return qMin((int) (distance * max / colorScale + 0.5), max);
+}
+
+/*!
+ * hue and saturation of the color \p r, \p g, \p b computed the same way as
+ * in QColor::hue() and QColor::saturation() without creating a QColor for every pixel.
+ */
+static inline void hueSaturation(int r, int g, int b, int& hue, int& saturation) {
+	const int max = qMax(r, qMax(g, b));
+	const int min = qMin(r, qMin(g, b));
+	if (max == min) {
+		hue = -1;
+		saturation = 0;
+		return;
+	}
+
+	const float rf = (r * 0x101) / float(USHRT_MAX);
+	const float gf = (g * 0x101) / float(USHRT_MAX);
+	const float bf = (b * 0x101) / float(USHRT_MAX);
+	const float maxf = (max * 0x101) / float(USHRT_MAX);
+	const float delta = maxf - (min * 0x101) / float(USHRT_MAX);
+
+	float h;
+	if (r == max)
+		h = (gf - bf) / delta;
+	else if (g == max)
+		h = 2.0f + (bf - rf) / delta;
+	else
+		h = 4.0f + (rf - gf) / delta;
+	h *= 60.0f;
+	if (h < 0.0f)
+		h += 360.0f;
+	hue = qRound(h * 100.0f) / 100;
+
+	const int s = qRound((delta / maxf) * USHRT_MAX);
+	saturation = (s - (s >> 8) + 0x80) >> 8; //division by 257 as in QColor
+}
+
+//largest squared distance between two colors in the rgb cube
+static const int maxSquaredDistance = 3 * 255 * 255;
+
+/*!
+ * lookup tables telling whether a pixel is on, indexed by the raw color quantities
+ * so that DiscretizeTask needs neither QColor nor the thresholds for every pixel.
+ */
+struct DiscretizeTables {
+	explicit DiscretizeTables(const DatapickerImage::EditorSettings& settings) :
+		hue(maxHue + 2),
+		saturation(256),
+		value(256),
+		intensity(maxSquaredDistance + 1),
+		foreground(maxSquaredDistance + 1) {
+
+		for (int h = -1; h <= maxHue; ++h)
+			hue[h + 1] = ImageEditor::pixelIsOn(hueValue(h), DatapickerImage::ColorAttributes::Hue, settings);
+
+		for (int i = 0; i < 256; ++i) {
+			saturation[i] = ImageEditor::pixelIsOn(saturationValue(i), DatapickerImage::ColorAttributes::Saturation, settings);
+			value[i] = ImageEditor::pixelIsOn(valueValue(i), DatapickerImage::ColorAttributes::Value, settings);
+		}
+
+		for (int d = 0; d <= maxSquaredDistance; ++d) {
+			const double distance = std::sqrt((double)d);
+			intensity[d] = ImageEditor::pixelIsOn(distanceValue(distance, maxIntensity), DatapickerImage::ColorAttributes::Intensity, settings);
+			foreground[d] = ImageEditor::pixelIsOn(distanceValue(distance, maxForeground), DatapickerImage::ColorAttributes::Foreground, settings);
+		}
+	}
+
+	QVector<bool> hue;		//hue in degrees + 1
+	QVector<bool> saturation;	//saturation from 0 to 255
+	QVector<bool> value;		//value from 0 to 255
+	QVector<bool> intensity;	//squared length of the rgb vector
+	QVector<bool> foreground;	//squared distance to the background color
+};
 
 class DiscretizeTask : public QRunnable {
 public:
-	DiscretizeTask(int start, int end, QImage* plotImage, QImage* originalImage, const DatapickerImage::EditorSettings& settings, QColor background) :
+	DiscretizeTask(int start, int end, uchar* plotBits, int bytesPerLine, const QImage* originalImage, const DiscretizeTables* tables, QRgb background) :
 		m_start(start),
 		m_end(end),
-		m_plotImage(plotImage),
+		m_plotBits(plotBits),
+		m_bytesPerLine(bytesPerLine),
 		m_originalImage(originalImage),
-		m_settings(settings),
-		m_background(std::move(background))
+		m_tables(tables),
+		m_background(background)
 		{};
 
 	void run() override {
-		for (int y = m_start; y < m_end; ++y) {
-			mutex.lock();
-			QRgb* line = reinterpret_cast<QRgb*>(m_plotImage->scanLine(y));
-			mutex.unlock();
-			for (int x = 0; x < m_plotImage->width(); ++x) {
-				int value = ImageEditor::discretizeHue(x, y, m_originalImage);
-				if (!ImageEditor::pixelIsOn(value, DatapickerImage::ColorAttributes::Hue, m_settings))
-					continue;
+		const int width = m_originalImage->width();
+		const int rBg = qRed(m_background);
+		const int gBg = qGreen(m_background);
+		const int bBg = qBlue(m_background);
+		const bool* hueOn = m_tables->hue.constData();
+		const bool* saturationOn = m_tables->saturation.constData();
+		const bool* valueOn = m_tables->value.constData();
+		const bool* intensityOn = m_tables->intensity.constData();
+		const bool* foregroundOn = m_tables->foreground.constData();
 
-				value = ImageEditor::discretizeSaturation(x, y, m_originalImage);
-				if (!ImageEditor::pixelIsOn(value, DatapickerImage::ColorAttributes::Saturation, m_settings))
-					continue;
-
-				value = ImageEditor::discretizeValue(x, y, m_originalImage);
-				if (!ImageEditor::pixelIsOn(value, DatapickerImage::ColorAttributes::Value, m_settings))
+		for (int y = m_start; y < m_end; ++y) {
+			const QRgb* in = reinterpret_cast<const QRgb*>(m_originalImage->constScanLine(y));
+			QRgb* out = reinterpret_cast<QRgb*>(m_plotBits + y * m_bytesPerLine);
+			for (int x = 0; x < width; ++x) {
+				const int r = qRed(in[x]);
+				const int g = qGreen(in[x]);
+				const int b = qBlue(in[x]);
+
+				//cheap checks first, hue and saturation only for the remaining pixels
+				if (!valueOn[qMax(r, qMax(g, b))] || !intensityOn[r*r + g*g + b*b])
 					continue;
 
-				value = ImageEditor::discretizeIntensity(x, y, m_originalImage);
-				if (!ImageEditor::pixelIsOn(value, DatapickerImage::ColorAttributes::Saturation, m_settings))
+				const int dr = r - rBg;
+				const int dg = g - gBg;
+				const int db = b - bBg;
+				if (!foregroundOn[dr*dr + dg*dg + db*db])
 					continue;
 
-				value = ImageEditor::discretizeForeground(x, y, m_background, m_originalImage);
-				if (!ImageEditor::pixelIsOn(value, DatapickerImage::ColorAttributes::Foreground, m_settings))
+				int h, s;
+				hueSaturation(r, g, b, h, s);
+				if (!hueOn[h + 1] || !saturationOn[s])
 					continue;
 
-				line[x] = black;
+				out[x] = black;
 			}
 		}
 	}
@@ -92,25 +192,41 @@ public:
 private:
 	int m_start;
 	int m_end;
-	QImage* m_plotImage;
-	QImage* m_originalImage;
-	DatapickerImage::EditorSettings m_settings;
-	QColor m_background;
+	uchar* m_plotBits;
+	int m_bytesPerLine;
+	const QImage* m_originalImage;
+	const DiscretizeTables* m_tables;
+	QRgb m_background;
 };
 
 /*!
- *
+ * sets all pixels of \p plotImage to black whose color in \p originalImage
+ * satisfies all thresholds in \p settings, all other pixels to white.
  */
 void ImageEditor::discretize(QImage* plotImage, QImage* originalImage,
                              const DatapickerImage::EditorSettings& settings, QColor background) {
 	plotImage->fill(white);
+
+	//the tasks read the 32bit pixels of the original image directly
+	QImage image;
+	const QImage::Format format = originalImage->format();
+	if (format == QImage::Format_RGB32 || format == QImage::Format_ARGB32)
+		image = *originalImage;
+	else
+		image = originalImage->convertToFormat(QImage::Format_ARGB32);
+
+	//detach the plot image here once, the tasks only write into their own rows
+	uchar* plotBits = plotImage->bits();
+	const int bytesPerLine = plotImage->bytesPerLine();
+	const DiscretizeTables tables(settings);
+
 	QThreadPool* pool = QThreadPool::globalInstance();
 	int range = ceil(double(plotImage->height())/pool->maxThreadCount());
 	for (int i = 0; i < pool->maxThreadCount(); ++i) {
 		const int start = i*range;
 		int end = (i+1)*range;
 		if (end > plotImage->height()) end = plotImage->height();
-		auto* task = new DiscretizeTask(start, end, plotImage, originalImage, settings, background);
+		auto* task = new DiscretizeTask(start, end, plotBits, bytesPerLine, &image, &tables, background.rgb());
 		pool->start(task);
 	}
 	pool->waitForDone();
@@ -204,37 +320,17 @@ bool ImageEditor::colorCompare(QRgb color1, QRgb color2) {
 
 int ImageEditor::discretizeHue(int x, int y, const QImage* originalImage) {
 	const QColor color(originalImage->pixel(x,y));
-	const int h = color.hue();
-	int value = h * maxHue / 359;
-
-	if (value < 0) //QColor::hue() can return -1
-		value = 0;
-	if (maxHue < value)
-		value = maxHue;
-
-	return value;
+	return hueValue(color.hue());
 }
 
 int ImageEditor::discretizeSaturation(int x, int y, const QImage* originalImage) {
 	const QColor color(originalImage->pixel(x,y));
-	const int s = color.saturation();
-	int value = s * maxSaturation / 255;
-
-	if (maxSaturation < value)
-		value = maxSaturation;
-
-	return value;
+	return saturationValue(color.saturation());
 }
 
 int ImageEditor::discretizeValue(int x, int y, const QImage* originalImage) {
 	const QColor color(originalImage->pixel(x,y));
-	const int v = color.value();
-	int value = v * maxValue / 255;
-
-	if (maxValue < value)
-		value = maxValue;
-
-	return value;
+	return valueValue(color.value());
 }
 
 int ImageEditor::discretizeIntensity(int x, int y, const QImage* originalImage) {
@@ -28,6 +28,7 @@ Copyright            : (C) 2009-2019 Alexander Semke (alexander.semke@web.de)
 ***************************************************************************/
 #include "backend/datasources/LiveDataSource.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnFormatter.h"
 #include "backend/core/Project.h"
 #include "backend/datasources/filters/AsciiFilter.h"
 #include "backend/datasources/filters/AsciiFilterPrivate.h"
@@ -43,6 +44,7 @@ Copyright            : (C) 2009-2019 Alexander Semke (alexander.semke@web.de)
 
 #include <KLocalizedString>
 #include <KFilterDev>
+#include <karchive_version.h>
 #include <QDateTime>
 
 #if defined(Q_OS_LINUX) || defined(Q_OS_BSD4)
@@ -51,6 +53,8 @@ Copyright            : (C) 2009-2019 Alexander Semke (alexander.semke@web.de)
 #endif
 
 #include <QRegularExpression>
+#include <QThread>
+#include <QtConcurrentRun>
 
 /*!
 \class AsciiFilter
@@ -156,6 +160,13 @@ void AsciiFilter::write(const QString& fileName, AbstractDataSource* dataSource)
 // 	emit()
 }
 
+/*!
+  returns the error of the last export or an empty string if it was successful.
+*/
+QString AsciiFilter::lastError() const {
+	return d->lastError;
+}
+
 /*!
   loads the predefined filter settings for \c filterName
 */
@@ -796,7 +807,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 				break;
 			}
 			case AbstractColumn::ColumnMode::DateTime: {
-				QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(n)->data());
+				QVector<qint64>* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(n)->data());
 				vector->resize(m_actualRows);
 				m_dataContainer[n] = static_cast<void *>(vector);
 				break;
@@ -1027,7 +1038,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 				break;
 			}
 			case AbstractColumn::ColumnMode::DateTime: {
-				QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(n)->data());
+				QVector<qint64>* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(n)->data());
 				vector->resize(m_actualRows);
 				m_dataContainer[n] = static_cast<void *>(vector);
 				break;
@@ -1103,7 +1114,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 						break;
 					}
 					case AbstractColumn::ColumnMode::DateTime: {
-						QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(col)->data());
+						QVector<qint64>* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(col)->data());
 						vector->pop_front();
 						vector->resize(m_actualRows);
 						m_dataContainer[col] = static_cast<void *>(vector);
@@ -1237,7 +1248,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 					}
 					case AbstractColumn::ColumnMode::DateTime: {
 						QDateTime valueDateTime = parseDateTime(valueString, dateTimeFormat);
-						static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](currentRow) = valueDateTime.isValid() ? valueDateTime : QDateTime();
+						static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](currentRow) = AbstractColumn::dateTimeToMSecs(valueDateTime);
 						break;
 					}
 					case AbstractColumn::ColumnMode::Text:
@@ -1263,7 +1274,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 						static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](currentRow) = 0;
 						break;
 					case AbstractColumn::ColumnMode::DateTime:
-						static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](currentRow) = QDateTime();
+						static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](currentRow) = AbstractColumn::invalidDateTime;
 						break;
 					case AbstractColumn::ColumnMode::Text:
 						static_cast<QVector<QString>*>(m_dataContainer[n])->operator[](currentRow).clear();
@@ -1431,7 +1442,7 @@ void AsciiFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSourc
 				}
 				case AbstractColumn::ColumnMode::DateTime: {
 					QDateTime valueDateTime = parseDateTime(valueString, dateTimeFormat);
-					static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](currentRow) = valueDateTime.isValid() ? valueDateTime : QDateTime();
+					static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](currentRow) = AbstractColumn::dateTimeToMSecs(valueDateTime);
 					break;
 				}
 				case AbstractColumn::ColumnMode::Text: {
@@ -1455,7 +1466,7 @@ void AsciiFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSourc
 					static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](currentRow) = 0;
 					break;
 				case AbstractColumn::ColumnMode::DateTime:
-					static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](currentRow) = QDateTime();
+					static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](currentRow) = AbstractColumn::invalidDateTime;
 					break;
 				case AbstractColumn::ColumnMode::Text:
 					static_cast<QVector<QString>*>(m_dataContainer[n])->operator[](currentRow).clear();
@@ -1738,12 +1749,96 @@ QVector<QStringList> AsciiFilterPrivate::preview(const QString& fileName, int li
 
 /*!
     writes the content of \c dataSource to the file \c fileName.
+
+    The rows are formatted in blocks in parallel and the blocks are written in order.
+    The file is compressed if its extension is that of a compressed file type (.gz, .bz2, .xz etc.).
 */
 void AsciiFilterPrivate::write(const QString& fileName, AbstractDataSource* dataSource) {
-	Q_UNUSED(fileName);
-	Q_UNUSED(dataSource);
+	DEBUG("AsciiFilterPrivate::write()");
+	lastError.clear();
+	auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
+	if (!spreadsheet)
+		return;
+
+	KFilterDev device(fileName);
+	if (!device.open(QIODevice::WriteOnly)) {
+		DEBUG("	could not open file " << STDSTRING(fileName) << " for writing");
+		lastError = i18n("Failed to open the file \"%1\" for writing: %2", fileName, device.errorString());
+		return;
+	}
 
-	//TODO: save data to ascii file
+	PERFTRACE("export to ASCII file");
+	const int firstRow = qMax(startRow, 1) - 1;
+	const int lastRow = (endRow == -1 || endRow > spreadsheet->rowCount()) ? spreadsheet->rowCount() : endRow;
+	const int firstColumn = qMax(startColumn, 1) - 1;
+	const int lastColumn = (endColumn == -1 || endColumn > spreadsheet->columnCount()) ? spreadsheet->columnCount() : endColumn;
+
+	QVector<const Column*> columns;
+	for (int c = firstColumn; c < lastColumn; ++c)
+		columns << spreadsheet->column(c);
+	const int cols = columns.size();
+
+	QString sep = (separatingCharacter == QLatin1String("auto")) ? QLatin1String("TAB") : separatingCharacter;
+	sep.replace(QLatin1String("2xTAB"), QLatin1String("\t\t"), Qt::CaseInsensitive);
+	sep.replace(QLatin1String("TAB"), QLatin1String("\t"), Qt::CaseInsensitive);
+	sep.replace(QLatin1String("2xSPACE"), QLatin1String("  "), Qt::CaseInsensitive);
+	sep.replace(QLatin1String("3xSPACE"), QLatin1String("   "), Qt::CaseInsensitive);
+	sep.replace(QLatin1String("4xSPACE"), QLatin1String("    "), Qt::CaseInsensitive);
+	sep.replace(QLatin1String("SPACE"), QLatin1String(" "), Qt::CaseInsensitive);
+	const QByteArray separator = sep.toUtf8();
+
+	//header (column names)
+	if (headerEnabled) {
+		QByteArray header;
+		for (int c = 0; c < cols; ++c) {
+			header += '"' + columns.at(c)->name().toUtf8() + '"';
+			if (c != cols - 1)
+				header += separator;
+		}
+		header += '\n';
+		if (device.write(header) != header.size()) {
+			lastError = i18n("Failed to write to the file \"%1\": %2", fileName, device.errorString());
+			return;
+		}
+	}
+
+	const ColumnFormatter formatter(columns, QLocale(numberFormat), separator);
+	auto formatRows = [&formatter](int start, int end) {
+		return formatter.formatRows(start, end);
+	};
+
+	//format blocks of rows in parallel and write them in order as soon as they are ready,
+	//the number of blocks in flight is limited to keep the memory consumption bounded
+	const qint64 rows = lastRow - firstRow;
+	const int blockSize = 10000;
+	const int maxBlocks = 2 * qMax(QThread::idealThreadCount(), 1);
+	QVector<QFuture<QByteArray>> blocks;
+	int next = firstRow;
+	int written = 0;
+	while (next < lastRow || written < blocks.size()) {
+		while (next < lastRow && blocks.size() - written < maxBlocks) {
+			blocks << QtConcurrent::run(formatRows, next, qMin(next + blockSize, lastRow));
+			next += blockSize;
+		}
+
+		const QByteArray& block = blocks.at(written).result();
+		if (device.write(block) != block.size()) {
+			lastError = i18n("Failed to write to the file \"%1\": %2", fileName, device.errorString());
+			for (auto& b : blocks)	//wait for the blocks in flight, they reference the columns
+				b.waitForFinished();
+			return;
+		}
+		blocks[written] = QFuture<QByteArray>();	//release the buffer
+		++written;
+		emit q->completed(static_cast<int>(100 * qMin(static_cast<qint64>(written) * blockSize, rows) / rows));
+	}
+
+	//the remaining compressed data is written on close()
+	device.close();
+#if KARCHIVE_VERSION >= QT_VERSION_CHECK(5, 80, 0)
+	if (device.error() != QFileDevice::NoError)
+		lastError = i18n("Failed to write to the file \"%1\": %2", fileName, device.errorString());
+#endif
 }
 
 /*!
@@ -2148,7 +2243,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 				break;
 			}
 			case AbstractColumn::ColumnMode::DateTime: {
-				QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(n)->data());
+				QVector<qint64>* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(n)->data());
 				vector->reserve(m_actualRows);
 				vector->resize(m_actualRows);
 				m_dataContainer[n] = static_cast<void *>(vector);
@@ -2356,15 +2451,15 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 						break;
 					}
 					case AbstractColumn::ColumnMode::DateTime: {
-						QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(n)->data());
+						QVector<qint64>* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(n)->data());
 						m_dataContainer[n] = static_cast<void *>(vector);
 
 						//if the keepNValues got smaller then we move the last keepNValues count of data
 						//in the first keepNValues places
 						if (m_actualRows > spreadsheet->mqttClient()->keepNValues()) {
 							for (int i = 0; i < spreadsheet->mqttClient()->keepNValues(); i++) {
-								static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[] (i) =
-								    static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](m_actualRows - spreadsheet->mqttClient()->keepNValues() + i);
+								static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[] (i) =
+								    static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](m_actualRows - spreadsheet->mqttClient()->keepNValues() + i);
 							}
 						}
 
@@ -2374,11 +2469,11 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 							vector->reserve( spreadsheet->mqttClient()->keepNValues());
 							vector->resize( spreadsheet->mqttClient()->keepNValues());
 							for (int i = 1; i <= m_actualRows; i++) {
-								static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[] (spreadsheet->mqttClient()->keepNValues() - i) =
-								    static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](spreadsheet->mqttClient()->keepNValues() - i - rowDiff);
+								static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[] (spreadsheet->mqttClient()->keepNValues() - i) =
+								    static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](spreadsheet->mqttClient()->keepNValues() - i - rowDiff);
 							}
 							for (int i = 0; i < rowDiff; i++)
-								static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](i) = QDateTime();
+								static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](i) = AbstractColumn::invalidDateTime;
 						}
 						break;
 					}
@@ -2495,7 +2590,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 				break;
 			}
 			case AbstractColumn::ColumnMode::DateTime: {
-				QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(n)->data());
+				QVector<qint64>* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(n)->data());
 				vector->reserve(m_actualRows);
 				vector->resize(m_actualRows);
 				m_dataContainer[n] = static_cast<void *>(vector);
@@ -2565,7 +2660,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 						break;
 					}
 					case AbstractColumn::ColumnMode::DateTime: {
-						QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(col)->data());
+						QVector<qint64>* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(col)->data());
 						vector->pop_front();
 						vector->reserve(m_actualRows);
 						vector->resize(m_actualRows);
@@ -2627,7 +2722,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 
 			//add current timestamp if required
 			if (createTimestampEnabled) {
-				static_cast<QVector<QDateTime>*>(m_dataContainer[offset])->operator[](currentRow) = QDateTime::currentDateTime();
+				static_cast<QVector<qint64>*>(m_dataContainer[offset])->operator[](currentRow) = QDateTime::currentMSecsSinceEpoch();
 				++offset;
 			}
 
@@ -2664,7 +2759,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 					}
 					case AbstractColumn::ColumnMode::DateTime: {
 						QDateTime valueDateTime = parseDateTime(valueString, dateTimeFormat);
-						static_cast<QVector<QDateTime>*>(m_dataContainer[col])->operator[](currentRow) = valueDateTime.isValid() ? valueDateTime : QDateTime();
+						static_cast<QVector<qint64>*>(m_dataContainer[col])->operator[](currentRow) = AbstractColumn::dateTimeToMSecs(valueDateTime);
 						break;
 					}
 					case AbstractColumn::ColumnMode::Text:
@@ -2692,7 +2787,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 						static_cast<QVector<qint64>*>(m_dataContainer[col])->operator[](currentRow) = 0;
 						break;
 					case AbstractColumn::ColumnMode::DateTime:
-						static_cast<QVector<QDateTime>*>(m_dataContainer[col])->operator[](currentRow) = QDateTime();
+						static_cast<QVector<qint64>*>(m_dataContainer[col])->operator[](currentRow) = AbstractColumn::invalidDateTime;
 						break;
 					case AbstractColumn::ColumnMode::Text:
 						static_cast<QVector<QString>*>(m_dataContainer[col])->operator[](currentRow).clear();
@@ -2800,7 +2895,7 @@ void AsciiFilterPrivate::setPreparedForMQTT(bool prepared, MQTTTopic* topic, con
 				break;
 			}
 			case AbstractColumn::ColumnMode::DateTime: {
-				QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(topic->child<Column>(n)->data());
+				QVector<qint64>* vector = static_cast<QVector<qint64>* >(topic->child<Column>(n)->data());
 				vector->reserve(m_actualRows);
 				vector->resize(m_actualRows);
 				m_dataContainer[n] = static_cast<void *>(vector);
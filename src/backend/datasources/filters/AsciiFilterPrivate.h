@@ -88,6 +88,7 @@ public:
 	int startColumn{1};
 	int endColumn{-1};
 	int mqttPreviewFirstEmptyColCount{0};
+	QString lastError;	// error of the last export, empty on success
 
 	int isPrepared();
 
@@ -29,13 +29,20 @@ Copyright            : (C) 2017 Alexander Semke (alexander.semke@web.de)
 #include "backend/datasources/filters/BinaryFilterPrivate.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/core/column/Column.h"
+#include "backend/spreadsheet/Spreadsheet.h"
 
 #include <QDataStream>
+#include <QDir>
+#include <QStandardPaths>
+#include <QTemporaryFile>
 #include <KLocalizedString>
 #include <KFilterDev>
 #include <array>
 #include <cmath>
 
+//! numeric columns with more data are read into files mapped into the columns instead of the memory, see BinaryFilterPrivate::spillData()
+static const qint64 spillThreshold = 64*1024*1024;
+
 /*!
 \class BinaryFilter
 \brief Manages the import/export of data organized as columns (vectors) from/to a binary file.
@@ -409,6 +416,13 @@ void BinaryFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSour
 		return;
 	}
 
+	//large data is read into files instead of the memory, not for live data sources which are updated continuously
+	auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
+	if (spreadsheet && spreadsheet->type() != AspectType::LiveDataSource && !createIndexEnabled && (lines == -1 || lines >= m_actualRows)
+		&& m_actualRows * (qint64)sizeof(double) >= spillThreshold
+		&& spillData(in, spreadsheet, importMode))
+		return;
+
 	if (createIndexEnabled)
 		m_actualCols++;
 
@@ -446,69 +460,7 @@ void BinaryFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSour
 
 		for (int n = startColumn; n < m_actualCols; ++n) {
 			DEBUG("reading column " << n);
-			//TODO: use ColumnMode when it supports all types
-			switch (dataType) {
-			case BinaryFilter::DataType::INT8: {
-					qint8 value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			case BinaryFilter::DataType::INT16: {
-					qint16 value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			case BinaryFilter::DataType::INT32: {
-					qint32 value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			case BinaryFilter::DataType::INT64: {
-					qint64 value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			case BinaryFilter::DataType::UINT8: {
-					quint8 value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			case BinaryFilter::DataType::UINT16: {
-					quint16 value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			case BinaryFilter::DataType::UINT32: {
-					quint32 value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			case BinaryFilter::DataType::UINT64: {
-					quint64 value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			case BinaryFilter::DataType::REAL32: {
-					float value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			case BinaryFilter::DataType::REAL64: {
-					double value;
-					in >> value;
-					static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = value;
-					break;
-				}
-			}
+			static_cast<QVector<double>*>(dataContainer[n])->operator[](i) = readValue(in);
 		}
 		if (m_actualRows > 0)
 			emit q->completed(100*i/m_actualRows);
@@ -517,6 +469,124 @@ void BinaryFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSour
 	dataSource->finalizeImport(columnOffset, 1, m_actualCols, QString(), importMode);
 }
 
+/*!
+ * reads the next value of the type \c dataType from the stream \c in.
+ */
+double BinaryFilterPrivate::readValue(QDataStream& in) const {
+	//TODO: use ColumnMode when it supports all types
+	switch (dataType) {
+	case BinaryFilter::DataType::INT8: {
+			qint8 value;
+			in >> value;
+			return value;
+		}
+	case BinaryFilter::DataType::INT16: {
+			qint16 value;
+			in >> value;
+			return value;
+		}
+	case BinaryFilter::DataType::INT32: {
+			qint32 value;
+			in >> value;
+			return value;
+		}
+	case BinaryFilter::DataType::INT64: {
+			qint64 value;
+			in >> value;
+			return value;
+		}
+	case BinaryFilter::DataType::UINT8: {
+			quint8 value;
+			in >> value;
+			return value;
+		}
+	case BinaryFilter::DataType::UINT16: {
+			quint16 value;
+			in >> value;
+			return value;
+		}
+	case BinaryFilter::DataType::UINT32: {
+			quint32 value;
+			in >> value;
+			return value;
+		}
+	case BinaryFilter::DataType::UINT64: {
+			quint64 value;
+			in >> value;
+			return value;
+		}
+	case BinaryFilter::DataType::REAL32: {
+			float value;
+			in >> value;
+			return value;
+		}
+	case BinaryFilter::DataType::REAL64: {
+			double value;
+			in >> value;
+			return value;
+		}
+	}
+
+	return NAN;
+}
+
+/*!
+ * reads the vectors from the stream \c in into files in the cache directory and maps them into the columns of
+ * \c spreadsheet (see Column::mapData()) instead of keeping the values in memory, so that files larger than the
+ * available memory can be imported. The files are owned by the columns and removed once they don't use them anymore.
+ * Returns \c false if the files can't be created, nothing was read from the stream then.
+ */
+bool BinaryFilterPrivate::spillData(QDataStream& in, Spreadsheet* spreadsheet, AbstractFileFilter::ImportMode importMode) {
+	const QString& path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/columns");
+	if (!QDir().mkpath(path))
+		return false;
+
+	std::vector<std::unique_ptr<QTemporaryFile>> files;
+	for (int n = 0; n < m_actualCols; ++n) {
+		files.emplace_back(new QTemporaryFile(path + QLatin1String("/labplot_column_XXXXXX")));
+		if (!files.back()->open())
+			return false;
+	}
+	DEBUG("BinaryFilterPrivate::spillData() rows = " << m_actualRows << ", path = " << STDSTRING(path));
+
+	//convert the values in blocks of rows, the files are written once and not modified afterwards
+	const int blockSize = 1024*1024;
+	QVector<QVector<double>> blocks(m_actualCols);
+	for (int first = 0; first < m_actualRows; first += blockSize) {
+		const int rows = qMin(blockSize, m_actualRows - first);
+		for (auto& block : blocks)
+			block.resize(rows);
+		for (int i = 0; i < rows; ++i)
+			for (int n = 0; n < m_actualCols; ++n)
+				blocks[n][i] = readValue(in);
+
+		const qint64 size = rows * (qint64)sizeof(double);
+		for (int n = 0; n < m_actualCols; ++n) {
+			if (files[n]->write(reinterpret_cast<const char*>(blocks.at(n).constData()), size) != size) {
+				DEBUG("	failed to write " << STDSTRING(files[n]->fileName()));
+				spreadsheet->clear();
+				return true;
+			}
+		}
+		emit q->completed(100*first/m_actualRows);
+	}
+
+	std::vector<void*> dataContainer;
+	columnModes.fill(AbstractColumn::ColumnMode::Numeric, m_actualCols);
+	const int columnOffset = spreadsheet->prepareImport(dataContainer, importMode, 0, m_actualCols, QStringList(), columnModes);
+	for (int n = 0; n < m_actualCols; ++n) {
+		files[n]->close();
+		files[n]->setAutoRemove(false);	//the column removes the file, also if it can't be mapped
+		if (!spreadsheet->column(columnOffset + n)->mapData(files[n]->fileName(), 0, m_actualRows, true))
+			DEBUG("	failed to map " << STDSTRING(files[n]->fileName()));
+	}
+
+	spreadsheet->finalizeImport(columnOffset, 1, m_actualCols, QString(), importMode);
+	emit q->completed(100);
+
+	return true;
+}
+
 /*!
     writes the content of \c dataSource to the file \c fileName.
 */
@@ -31,6 +31,7 @@ Copyright            : (C) 2015-2017 Stefan Gerlach (stefan.gerlach@uni.kn)
 
 class AbstractDataSource;
 class AbstractColumn;
+class Spreadsheet;
 
 class BinaryFilterPrivate {
 
@@ -44,6 +45,8 @@ public:
 			AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
 	void write(const QString& fileName, AbstractDataSource*);
 	QVector<QStringList> preview(const QString& fileName, int lines);
+	double readValue(QDataStream&) const;
+	bool spillData(QDataStream&, Spreadsheet*, AbstractFileFilter::ImportMode);
 
 	const BinaryFilter* q;
 
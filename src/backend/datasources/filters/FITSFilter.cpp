@@ -41,6 +41,9 @@ Copyright            : (C) 2017 Alexander Semke (alexander.semke@web.de)
 #include <QFile>
 #include <QDebug>
 
+#include <algorithm>
+#include <limits>
+
 /*! \class FITSFilter
  * \brief Manages the import/export of data from/to a FITS file.
  * \since 2.2.0
@@ -435,26 +438,15 @@ QVector<QStringList> FITSFilterPrivate::readCHDU(const QString& fileName, Abstra
 
 		if (endRow != -1)
 			lines = endRow;
-		QVector<QStringList*> stringDataPointers;
-		std::vector<void*> numericDataPointers;
 		QList<bool> columnNumericTypes;
-
-		int startCol = 0;
-		if (startColumn != 1)
-			startCol = startColumn;
-		int startRrow = 0;
-		if (startRow != 1)
-			startRrow = startRow;
+		int firstCol = 1;
+		if (startColumn > 1)
+			firstCol = startColumn;
 
 		columnNumericTypes.reserve(actualCols);
 		int datatype;
-		int c = 1;
-		if (startColumn != 1) {
-			if (startColumn != 0)
-				c = startColumn;
-		}
 		QList<int> matrixNumericColumnIndices;
-		for (; c <= actualCols; ++c) {
+		for (int c = firstCol; c <= actualCols; ++c) {
 			fits_get_coltype(m_fitsFile, c, &datatype, nullptr, nullptr, &status);
 
 			switch (datatype) {
@@ -493,112 +485,118 @@ QVector<QStringList> FITSFilterPrivate::readCHDU(const QString& fileName, Abstra
 				matrixNumericColumnIndices.append(c);
 		}
 
+		//rows to read (1-based as in CFITSIO)
+		long firstRow = 1;
+		if (startRow > 1)
+			firstRow = startRow;
+		const long rowCount = qMax(0L, lines - firstRow + 1);
+
+		//the columns to read and the buffers the values are read into
+		QList<int> columnNumbers;
+		if (dynamic_cast<Matrix*>(dataSource))
+			columnNumbers = matrixNumericColumnIndices;
+		else {
+			for (int c = firstCol; c <= actualCols; ++c)
+				columnNumbers << c;
+		}
+
+		QVector<TableColumn> columns(columnNumbers.size());
+		for (int n = 0; n < columns.size(); ++n) {
+			auto& column = columns[n];
+			column.number = columnNumbers.at(n);
+			long width = 0;
+			fits_get_coltype(m_fitsFile, column.number, &column.type, &column.repeat, &width, &status);
+			int displayWidth = 0;
+			fits_get_col_display_width(m_fitsFile, column.number, &displayWidth, &status);
+			column.width = qMax(qMax(static_cast<int>(width), displayWidth), FLEN_VALUE - 1);
+			if (column.type == TSTRING && width > 0)
+				column.repeat /= width; //number of strings per row
+		}
+
 		if (noDataSource)
 			*okToMatrix = matrixNumericColumnIndices.isEmpty() ? false : true;
+
+		//buffers for the preview, all columns are read as strings formatted by CFITSIO (TDISPn etc.)
+		QVector<QVector<QString>> previewStrings;
+
 		if (!noDataSource) {
 			DEBUG("HAS DataSource");
 			auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
 			if (spreadsheet) {
-				numericDataPointers.reserve(actualCols - startCol);
-
-				stringDataPointers.reserve(actualCols - startCol);
 				spreadsheet->setUndoAware(false);
-				columnOffset = spreadsheet->resize(importMode, columnNames, actualCols - startCol);
+				columnOffset = spreadsheet->resize(importMode, columnNames, columns.size());
 
 				if (importMode == AbstractFileFilter::ImportMode::Replace) {
 					spreadsheet->clear();
-					spreadsheet->setRowCount(lines - startRrow);
+					spreadsheet->setRowCount(rowCount);
 				} else {
-					if (spreadsheet->rowCount() < (lines - startRrow))
-						spreadsheet->setRowCount(lines - startRrow);
+					if (spreadsheet->rowCount() < rowCount)
+						spreadsheet->setRowCount(rowCount);
 				}
 				DEBUG("Reading columns ...");
-				for (int n = 0; n < actualCols - startCol; ++n) {
+				for (int n = 0; n < columns.size(); ++n) {
+					Column* col = spreadsheet->column(columnOffset + n);
 					if (columnNumericTypes.at(n)) {
-						spreadsheet->column(columnOffset+ n)->setColumnMode(AbstractColumn::ColumnMode::Numeric);
-						auto* datap = static_cast<QVector<double>* >(spreadsheet->column(columnOffset+n)->data());
-						numericDataPointers.push_back(datap);
-						if (importMode == AbstractFileFilter::ImportMode::Replace)
-							datap->clear();
+						col->setColumnMode(AbstractColumn::ColumnMode::Numeric);
+						auto* datap = static_cast<QVector<double>* >(col->data());
+						if (datap->size() < rowCount)
+							datap->resize(rowCount);
+						columns[n].numeric = datap->data();
 					} else {
-						spreadsheet->column(columnOffset+ n)->setColumnMode(AbstractColumn::ColumnMode::Text);
-						auto* list = static_cast<QStringList*>(spreadsheet->column(columnOffset+n)->data());
-						stringDataPointers.push_back(list);
-						if (importMode == AbstractFileFilter::ImportMode::Replace)
-							list->clear();
+						col->setColumnMode(AbstractColumn::ColumnMode::Text);
+						auto* datap = static_cast<QVector<QString>*>(col->data());
+						if (datap->size() < rowCount)
+							datap->resize(rowCount);
+						columns[n].strings = datap->data();
 					}
 				}
 				DEBUG("	... DONE");
-				stringDataPointers.squeeze();
 			} else {
-				numericDataPointers.reserve(matrixNumericColumnIndices.size());
-
-				columnOffset = dataSource->prepareImport(numericDataPointers, importMode, lines - startRrow, matrixNumericColumnIndices.size());
+				std::vector<void*> numericDataPointers;
+				numericDataPointers.reserve(columns.size());
+				columnOffset = dataSource->prepareImport(numericDataPointers, importMode, rowCount, columns.size());
+				for (int n = 0; n < columns.size(); ++n) {
+					auto* datap = static_cast<QVector<double>*>(numericDataPointers[n]);
+					if (datap->size() < rowCount)
+						datap->resize(rowCount);
+					columns[n].numeric = datap->data();
+				}
+			}
+		} else {
+			previewStrings.resize(columns.size());
+			for (int n = 0; n < columns.size(); ++n) {
+				previewStrings[n].resize(rowCount);
+				columns[n].strings = previewStrings[n].data();
 			}
 		}
 
-		int row = 1;
-		if (startRow != 1) {
-			if (startRow != 0)
-				row = startRow;
+		//read blocks of rows of the size CFITSIO considers optimal, all columns of a block one after another
+		long blockSize = 0;
+		if (fits_get_rowsize(m_fitsFile, &blockSize, &status) || blockSize < 1) {
+			status = 0;
+			blockSize = 1000;
 		}
 
-		int coll = 1;
-		if (startColumn != 1) {
-			if (startColumn != 0)
-				coll = startColumn;
-		}
-		bool isMatrix = false;
-		if (dynamic_cast<Matrix*>(dataSource)) {
-			isMatrix = true;
-			coll = matrixNumericColumnIndices.first();
-			actualCols = matrixNumericColumnIndices.last();
-			if (importMode == AbstractFileFilter::ImportMode::Replace) {
-				for (auto* col : numericDataPointers)
-					static_cast<QVector<double>*>(col)->clear();
+		DEBUG("	Import " << rowCount << " lines in blocks of " << blockSize << " rows");
+		for (long offset = 0; offset < rowCount; offset += blockSize) {
+			const long rows = qMin(blockSize, rowCount - offset);
+			for (const auto& column : qAsConst(columns)) {
+				if (column.numeric)
+					readNumericColumn(column, firstRow + offset, rows, column.numeric + offset);
+				else
+					readStringColumn(column, firstRow + offset, rows, column.strings + offset);
 			}
 		}
 
-		char array[FLEN_VALUE];
-		char* tmpArr[1] = {array};
-		for (; row <= lines; ++row) {
-			int numericixd = 0;
-			int stringidx = 0;
-			QStringList line;
-			line.reserve(actualCols-coll);
-			for (int col = coll; col <= actualCols; ++col) {
-				if (isMatrix) {
-					if (!matrixNumericColumnIndices.contains(col))
-						continue;
-				}
-				if (fits_read_col_str(m_fitsFile, col, row, 1, 1, nullptr, tmpArr, nullptr, &status))
-					printError(status);
-				if (!noDataSource) {
-					QString str = QString::fromLatin1(array);
-					if (str.isEmpty()) {
-						if (columnNumericTypes.at(col - 1))
-							static_cast<QVector<double>*>(numericDataPointers[numericixd++])->push_back(0);
-						else
-							stringDataPointers[stringidx++]->append(QLatin1String("NULL"));
-					} else {
-						if (columnNumericTypes.at(col - 1))
-							static_cast<QVector<double>*>(numericDataPointers[numericixd++])->push_back(str.toDouble());
-						else {
-							if (!stringDataPointers.isEmpty())
-								stringDataPointers[stringidx++]->operator<<(str.simplified());
-						}
-
-					}
-				} else {
-					QString tmpColstr = QString::fromLatin1(array);
-					tmpColstr = tmpColstr.simplified();
-					if (tmpColstr.isEmpty())
-						line << QLatin1String("NULL");
-					else
-						line << tmpColstr;
-				}
+		if (noDataSource) {
+			dataStrings.reserve(rowCount);
+			for (long r = 0; r < rowCount; ++r) {
+				QStringList line;
+				line.reserve(columns.size());
+				for (int n = 0; n < columns.size(); ++n)
+					line << previewStrings.at(n).at(r);
+				dataStrings << line;
 			}
-			dataStrings << line;
 		}
 
 		if (!noDataSource)
@@ -621,6 +619,80 @@ QVector<QStringList> FITSFilterPrivate::readCHDU(const QString& fileName, Abstra
 	return dataStrings;
 }
 
+#ifdef HAVE_FITS
+/*!
+ * reads the values of \p rows rows starting at row \p firstRow of the numeric table column \p column into \p data.
+ * Only the first element is imported for vector columns and the real part for complex numbers.
+ * Undefined values are imported as NaN.
+ */
+void FITSFilterPrivate::readNumericColumn(const TableColumn& column, long firstRow, long rows, double* data) const {
+	int status = 0;
+	double nullValue = std::numeric_limits<double>::quiet_NaN();
+	int anyNull;
+
+	if (column.type == TBIT) {
+		//bits are read as strings, one row after another
+		QVector<QString> strings(rows);
+		readStringColumn(column, firstRow, rows, strings.data());
+		for (long i = 0; i < rows; ++i)
+			data[i] = strings.at(i).toDouble();
+		return;
+	}
+
+	//columns without elements (e.g. TFORMn = 0D)
+	if (column.repeat < 1) {
+		std::fill(data, data + rows, nullValue);
+		return;
+	}
+
+	const bool complex = (column.type == TCOMPLEX || column.type == TDBLCOMPLEX);
+	if (column.repeat == 1 && !complex) {
+		if (fits_read_col(m_fitsFile, TDOUBLE, column.number, firstRow, 1, rows, &nullValue, data, &anyNull, &status))
+			printError(status);
+		return;
+	}
+
+	//read all elements of the rows and take the first one of each row
+	const long stride = column.repeat * (complex ? 2 : 1);
+	QVector<double> buffer(rows * stride);
+	if (fits_read_col(m_fitsFile, complex ? TDBLCOMPLEX : TDOUBLE, column.number, firstRow, 1, rows * column.repeat,
+			&nullValue, buffer.data(), &anyNull, &status)) {
+		printError(status);
+		return;
+	}
+	for (long i = 0; i < rows; ++i)
+		data[i] = buffer.at(i * stride);
+}
+
+/*!
+ * reads the values of \p rows rows starting at row \p firstRow of the table column \p column as strings into \p data.
+ * Columns with one string per row are read with one call, for columns with more elements per row the first element of each row is read.
+ */
+void FITSFilterPrivate::readStringColumn(const TableColumn& column, long firstRow, long rows, QString* data) const {
+	int status = 0;
+	char nullString[] = "";
+	int anyNull;
+
+	const int width = column.width + 1;
+	const long count = (column.repeat == 1) ? rows : 1;
+	QByteArray buffer(count * width, '\0');
+	QVector<char*> strings(count);
+	for (long i = 0; i < count; ++i)
+		strings[i] = buffer.data() + i * width;
+
+	for (long row = 0; row < rows; row += count) {
+		if (fits_read_col_str(m_fitsFile, column.number, firstRow + row, 1, count, nullString, strings.data(), &anyNull, &status)) {
+			printError(status);
+			status = 0;
+		}
+		for (long i = 0; i < count; ++i) {
+			const QString str = QString::fromLatin1(strings.at(i)).simplified();
+			data[row + i] = str.isEmpty() ? QLatin1String("NULL") : str;
+		}
+	}
+}
+#endif
+
 /*!
  * \brief Export from data source \a dataSource to file \a fileName
  * \param fileName the name of the file to be exported to
@@ -70,6 +70,19 @@ private:
 	void printError(int status) const;
 
 #ifdef HAVE_FITS
+	//table column to be read in readCHDU()
+	struct TableColumn {
+		int number{0};		//column number in the table, starting at 1
+		int type{0};		//CFITSIO data type code
+		long repeat{1};		//number of elements per row
+		int width{0};		//length of the strings when read as strings
+		double* numeric{nullptr};	//buffer for numeric columns
+		QString* strings{nullptr};	//buffer for all other columns
+	};
+
+	void readNumericColumn(const TableColumn&, long firstRow, long rows, double* data) const;
+	void readStringColumn(const TableColumn&, long firstRow, long rows, QString* data) const;
+
 	fitsfile* m_fitsFile{nullptr};
 #endif
 };
@@ -35,12 +35,18 @@ Copyright            : (C) 2017 Alexander Semke (alexander.semke@web.de)
 #include "backend/datasources/filters/HDF5FilterPrivate.h"
 #include "backend/datasources/LiveDataSource.h"
 #include "backend/core/column/Column.h"
+#include "backend/matrix/Matrix.h"
 
 #include <KLocalizedString>
 #include <QTreeWidgetItem>
 #include <QProcess>
 #include <QFile>
 
+#ifdef HAVE_HDF5
+//! maximal number of rows of a column converted and written at once during the export
+static const int writeBlockSize = 1024*1024;
+#endif
+
 /*!
 	\class HDF5Filter
 	\brief Manages the import/export of data from/to a HDF5 file.
@@ -136,6 +142,57 @@ int HDF5Filter::endColumn() const {
 	return d->endColumn;
 }
 
+void HDF5Filter::setCompression(const Compression c) {
+	d->compression = c;
+}
+
+HDF5Filter::Compression HDF5Filter::compression() const {
+	return d->compression;
+}
+
+void HDF5Filter::setCompressionLevel(const int l) {
+	d->compressionLevel = l;
+}
+
+int HDF5Filter::compressionLevel() const {
+	return d->compressionLevel;
+}
+
+void HDF5Filter::setShuffle(const bool s) {
+	d->shuffle = s;
+}
+
+bool HDF5Filter::shuffle() const {
+	return d->shuffle;
+}
+
+void HDF5Filter::setChunkSize(const int s) {
+	d->chunkSize = s;
+}
+
+int HDF5Filter::chunkSize() const {
+	return d->chunkSize;
+}
+
+/*!
+  if \c append is \c true, the exported rows are appended to the data sets of an already existing file
+  instead of overwriting the file. Together with the start row this allows to archive new rows incrementally.
+*/
+void HDF5Filter::setAppendMode(const bool append) {
+	d->appendMode = append;
+}
+
+bool HDF5Filter::appendMode() const {
+	return d->appendMode;
+}
+
+/*!
+  returns the error of the last call of write() or an empty string if the data was written successfully.
+*/
+QString HDF5Filter::lastError() const {
+	return d->lastError;
+}
+
 QString HDF5Filter::fileInfoString(const QString& fileName) {
 	DEBUG("HDF5Filter::fileInfoString()");
 	QString info;
@@ -1903,12 +1960,395 @@ void HDF5FilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSo
 
 /*!
     writes the content of \c dataSource to the file \c fileName.
+
+    Every column of a spreadsheet is written to a one-dimensional data set, a matrix to one two-dimensional data set
+    named after the matrix. The data sets are chunked and extendible in the number of rows, so that rows can be
+    appended later in the append mode. Date and time values are written as milliseconds since the epoch,
+    the unit is stored in the attribute "units" of the data set.
+    Errors are available via HDF5Filter::lastError().
 */
 void HDF5FilterPrivate::write(const QString & fileName, AbstractDataSource* dataSource) {
-	Q_UNUSED(fileName);
-	Q_UNUSED(dataSource);
-	//TODO: writing HDF5 not implemented yet
+	DEBUG("HDF5FilterPrivate::write()");
+	lastError.clear();
+#ifdef HAVE_HDF5
+	auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
+	auto* matrix = dynamic_cast<Matrix*>(dataSource);
+	if (matrix && matrix->mode() != AbstractColumn::ColumnMode::Numeric && matrix->mode() != AbstractColumn::ColumnMode::Integer
+			&& matrix->mode() != AbstractColumn::ColumnMode::BigInt) {
+		lastError = i18n("Only matrices with numeric values can be exported to HDF5.");
+		return;
+	}
+
+	QByteArray bafileName = fileName.toLatin1();
+	DEBUG("fileName = " << bafileName.data());
+
+	hid_t file;
+	if (appendMode && QFile::exists(fileName)) {
+		if (H5Fis_hdf5(bafileName.data()) <= 0) {
+			DEBUG(bafileName.data() << " is not a HDF5 file! Giving up.");
+			lastError = i18n("The file \"%1\" is not a HDF5 file, the data can't be appended to it.", fileName);
+			return;
+		}
+		file = H5Fopen(bafileName.data(), H5F_ACC_RDWR, H5P_DEFAULT);
+		handleError((int)file, "H5Fopen", fileName);
+	} else {
+		file = H5Fcreate(bafileName.data(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+		handleError((int)file, "H5Fcreate", fileName);
+	}
+	if (file < 0) {
+		DEBUG("Opening file " << bafileName.data() << " failed! Giving up.");
+		lastError = i18n("Failed to open the file \"%1\" for writing.", fileName);
+		return;
+	}
+
+	const int rowCount = spreadsheet ? spreadsheet->rowCount() : (matrix ? matrix->rowCount() : 0);
+	const int columnCount = spreadsheet ? spreadsheet->columnCount() : (matrix ? matrix->columnCount() : 0);
+
+	const int firstRow = qMax(startRow, 1) - 1;
+	const int rows = qMax((endRow == -1 || endRow > rowCount ? rowCount : endRow) - firstRow, 0);
+	const int firstColumn = qMax(startColumn, 1) - 1;
+	const int columns = qMax((endColumn == -1 || endColumn > columnCount ? columnCount : endColumn) - firstColumn, 0);
+	DEBUG("	rows " << firstRow + 1 << " to " << firstRow + rows << ", columns " << firstColumn + 1 << " to " << firstColumn + columns);
+
+	if (spreadsheet) {
+		for (int c = firstColumn; c < firstColumn + columns; ++c) {
+			Column* column = spreadsheet->column(c);
+			QString name = column->name();
+			name.replace(QLatin1Char('/'), QLatin1Char('_'));
+
+			switch (column->columnMode()) {
+			case AbstractColumn::ColumnMode::Numeric: {
+				// the values are written directly, mapped data is not loaded into memory
+				const int count = qBound(0, column->rowCount() - firstRow, rows);
+				writeHDF5DataSet(file, name, H5T_NATIVE_DOUBLE, 1, count,
+					QVector<const void*>() << (count > 0 ? column->numericData() + firstRow : nullptr));
+				break;
+			}
+			case AbstractColumn::ColumnMode::Integer:
+				writeHDF5Column<int>(file, name, H5T_NATIVE_INT, column, &Column::integerAt, firstRow, rows);
+				break;
+			case AbstractColumn::ColumnMode::BigInt:
+				writeHDF5Column<qint64>(file, name, H5T_NATIVE_INT64, column, &Column::bigIntAt, firstRow, rows);
+				break;
+			case AbstractColumn::ColumnMode::DateTime:
+			case AbstractColumn::ColumnMode::Month:
+			case AbstractColumn::ColumnMode::Day:
+				writeHDF5Column<qint64>(file, name, H5T_NATIVE_INT64, column, &Column::dateTimeMSecsAt, firstRow, rows);
+				writeHDF5DateTimeAttributes(file, name, column->timeSpec());
+				break;
+			case AbstractColumn::ColumnMode::Text: {
+				// variable length strings need an array of pointers to the UTF-8 encoded strings
+				const int count = qBound(0, column->rowCount() - firstRow, rows);
+				QVector<QByteArray> utf8;
+				QVector<const char*> strings;
+				hid_t type = H5Tcopy(H5T_C_S1);
+				H5Tset_size(type, H5T_VARIABLE);
+				H5Tset_cset(type, H5T_CSET_UTF8);
+				writeHDF5Blocks(file, name, type, count, [&](int first, int blockRows) {
+					utf8.resize(blockRows);
+					strings.resize(blockRows);
+					for (int i = 0; i < blockRows; ++i) {
+						utf8[i] = column->textAt(firstRow + first + i).toUtf8();
+						strings[i] = utf8.at(i).constData();
+					}
+					return static_cast<const void*>(strings.constData());
+				});
+				H5Tclose(type);
+				break;
+			}
+			}
+		}
+	} else if (matrix && columns > 0) {
+		QString name = matrix->name();
+		name.replace(QLatin1Char('/'), QLatin1Char('_'));
+
+		switch (matrix->mode()) {
+		case AbstractColumn::ColumnMode::Numeric:
+			writeHDF5Matrix<double>(file, name, H5T_NATIVE_DOUBLE, matrix->data(), firstRow, rows, firstColumn, columns);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			writeHDF5Matrix<int>(file, name, H5T_NATIVE_INT, matrix->data(), firstRow, rows, firstColumn, columns);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			writeHDF5Matrix<qint64>(file, name, H5T_NATIVE_INT64, matrix->data(), firstRow, rows, firstColumn, columns);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;	// handled above
+		}
+	}
+
+	m_status = H5Fclose(file);
+	handleError(m_status, "H5Fclose", fileName);
+	if (m_status < 0)
+		setWriteError(i18n("Failed to write the file \"%1\".", fileName));
+#else
+	Q_UNUSED(fileName)
+	Q_UNUSED(dataSource)
+#endif
+}
+
+#ifdef HAVE_HDF5
+/*!
+  writes \c rows rows starting at \c firstRow of the column \c column to the data set \c name.
+  The values are read with the accessor \c valueAt and written in blocks, see writeHDF5Blocks().
+*/
+template <typename T>
+void HDF5FilterPrivate::writeHDF5Column(hid_t file, const QString& name, hid_t type, const Column* column,
+		T (Column::*valueAt)(int) const, int firstRow, int rows) {
+	const int count = qBound(0, column->rowCount() - firstRow, rows);
+	QVector<T> values;
+	writeHDF5Blocks(file, name, type, count, [&](int first, int blockRows) {
+		values.resize(blockRows);
+		for (int i = 0; i < blockRows; ++i)
+			values[i] = (column->*valueAt)(firstRow + first + i);
+		return static_cast<const void*>(values.constData());
+	});
+}
+
+/*!
+  writes \c rows values of the type \c type to the one-dimensional data set \c name in blocks of at most
+  \c writeBlockSize rows to limit the memory used for large columns. \c block converts the \c blockRows values
+  starting at \c first and returns the pointer to them, valid until the next call.
+  Returns \c false on failure, the error is available in lastError.
+*/
+bool HDF5FilterPrivate::writeHDF5Blocks(hid_t file, const QString& name, hid_t type, int rows,
+		const std::function<const void*(int first, int blockRows)>& block) {
+	hsize_t offset = 0;
+	hid_t dataset = openHDF5DataSet(file, name, type, 1, rows, 1, offset);
+	if (dataset < 0)
+		return false;
+
+	hid_t fileSpace = H5Dget_space(dataset);
+	bool success = true;
+	for (int first = 0; first < rows && success; first += writeBlockSize) {
+		const int blockRows = qMin(rows - first, writeBlockSize);
+		const void* data = block(first, blockRows);
+
+		const hsize_t start = offset + first;
+		const hsize_t count = blockRows;
+		hid_t memSpace = H5Screate_simple(1, &count, nullptr);
+		H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &start, nullptr, &count, nullptr);
+		m_status = H5Dwrite(dataset, type, memSpace, fileSpace, H5P_DEFAULT, data);
+		handleError(m_status, "H5Dwrite", name);
+		H5Sclose(memSpace);
+		success = (m_status >= 0);
+	}
+	H5Sclose(fileSpace);
+
+	return closeHDF5DataSet(dataset, name, success);
+}
+
+/*!
+  writes the block of \c rows rows and \c columns columns of the matrix data \c data (QVector<QVector<T>>)
+  to the two-dimensional data set \c name. Each matrix column is written directly from the matrix data.
+*/
+template <typename T>
+void HDF5FilterPrivate::writeHDF5Matrix(hid_t file, const QString& name, hid_t type, void* data,
+		int firstRow, int rows, int firstColumn, int columns) {
+	const auto* matrixData = static_cast<QVector<QVector<T>>*>(data);
+	QVector<const void*> columnData;
+	columnData.reserve(columns);
+	for (int c = firstColumn; c < firstColumn + columns; ++c)
+		columnData << matrixData->at(c).constData() + firstRow;
+	writeHDF5DataSet(file, name, type, 2, rows, columnData);
+}
+
+/*!
+  writes \c rows rows of the column buffers \c columns of the type \c type to the data set \c name.
+  For \c rank 1 the data set is a vector, for \c rank 2 a matrix with one column per buffer.
+  If the data set already exists (append mode), it's extended by the number of rows and the rows are written at its end.
+  Returns \c false on failure, the error is available in lastError.
+*/
+bool HDF5FilterPrivate::writeHDF5DataSet(hid_t file, const QString& name, hid_t type, int rank, hsize_t rows, const QVector<const void*>& columns) {
+	const hsize_t cols = columns.size();
+	hsize_t offset = 0;	// first row of the data set to write to
+	hid_t dataset = openHDF5DataSet(file, name, type, rank, rows, cols, offset);
+	if (dataset < 0)
+		return false;
+
+	bool success = true;
+	if (rows > 0) {
+		hid_t fileSpace = H5Dget_space(dataset);
+		hid_t memSpace = H5Screate_simple(1, &rows, nullptr);
+		for (hsize_t c = 0; c < cols; ++c) {
+			const hsize_t start[2] = {offset, c};
+			const hsize_t count[2] = {rows, 1};
+			H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+			m_status = H5Dwrite(dataset, type, memSpace, fileSpace, H5P_DEFAULT, columns.at(c));
+			handleError(m_status, "H5Dwrite", name);
+			if (m_status < 0)
+				success = false;
+		}
+		H5Sclose(memSpace);
+		H5Sclose(fileSpace);
+	}
+
+	return closeHDF5DataSet(dataset, name, success);
+}
+
+/*!
+  creates the data set \c name of the type \c type with \c rows rows and \c cols columns (\c rank 2) to be written.
+  If the data set already exists (append mode), it's extended by the number of rows and \c offset is set to the
+  first row to write to. Returns the data set or a negative value on failure, the error is available in lastError.
+*/
+hid_t HDF5FilterPrivate::openHDF5DataSet(hid_t file, const QString& name, hid_t type, int rank, hsize_t rows, hsize_t cols, hsize_t& offset) {
+	const QByteArray baName = name.toUtf8();
+	hsize_t dims[2] = {rows, cols};
+	offset = 0;
+
+	hid_t dataset;
+	if (H5Lexists(file, baName.constData(), H5P_DEFAULT) > 0) {
+		dataset = H5Dopen(file, baName.constData(), H5P_DEFAULT);
+		handleError((int)dataset, "H5Dopen", name);
+		if (dataset < 0) {
+			setWriteError(i18n("Failed to open the data set \"%1\".", name));
+			return -1;
+		}
+
+		hid_t space = H5Dget_space(dataset);
+		hsize_t currentDims[2] = {0, 0};
+		const int currentRank = H5Sget_simple_extent_dims(space, currentDims, nullptr);
+		H5Sclose(space);
+		if (currentRank != rank || (rank == 2 && currentDims[1] != cols)) {
+			DEBUG("	data set " << baName.constData() << " has a different shape. Skipping it.");
+			setWriteError(i18n("The data set \"%1\" has a different shape, the data can't be appended to it.", name));
+			H5Dclose(dataset);
+			return -1;
+		}
+
+		offset = currentDims[0];
+		dims[0] = offset + rows;
+		m_status = H5Dset_extent(dataset, dims);
+		handleError(m_status, "H5Dset_extent", name);
+		if (m_status < 0) {	// data set is not extendible
+			setWriteError(i18n("The data set \"%1\" is not extendible, the data can't be appended to it.", name));
+			H5Dclose(dataset);
+			return -1;
+		}
+	} else {
+		const hsize_t maxDims[2] = {H5S_UNLIMITED, cols};
+		hid_t space = H5Screate_simple(rank, dims, maxDims);
+		hid_t plist = createHDF5PropertyList(rank);
+		dataset = H5Dcreate(file, baName.constData(), type, space, H5P_DEFAULT, plist, H5P_DEFAULT);
+		handleError((int)dataset, "H5Dcreate", name);
+		H5Pclose(plist);
+		H5Sclose(space);
+		if (dataset < 0)
+			setWriteError(i18n("Failed to create the data set \"%1\".", name));
+	}
+
+	return dataset;
+}
+
+/*!
+  closes the data set \c name written before, \c success is \c false if writing the data failed.
+  Returns \c false on failure, the error is available in lastError.
+*/
+bool HDF5FilterPrivate::closeHDF5DataSet(hid_t dataset, const QString& name, bool success) {
+	m_status = H5Dclose(dataset);
+	handleError(m_status, "H5Dclose", name);
+	if (!success || m_status < 0) {
+		setWriteError(i18n("Failed to write the data set \"%1\".", name));
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+  adds the attributes describing the date and time values (milliseconds since the epoch) to the data set \c name:
+  "units" in the notation of the CF conventions, "time_spec" ("UTC" or "local") and "_FillValue", the value of invalid dates.
+  Existing attributes are kept in the append mode.
+*/
+void HDF5FilterPrivate::writeHDF5DateTimeAttributes(hid_t file, const QString& name, Qt::TimeSpec timeSpec) {
+	const QByteArray baName = name.toUtf8();
+	if (H5Lexists(file, baName.constData(), H5P_DEFAULT) <= 0)
+		return;	// data set wasn't written
+
+	hid_t dataset = H5Dopen(file, baName.constData(), H5P_DEFAULT);
+	handleError((int)dataset, "H5Dopen", name);
+	if (dataset < 0)
+		return;
+
+	const QByteArray units("milliseconds since 1970-01-01 00:00:00 UTC");
+	const QByteArray spec(timeSpec == Qt::UTC ? "UTC" : "local");
+	hid_t stringType = H5Tcopy(H5T_C_S1);
+
+	H5Tset_size(stringType, units.size());
+	writeHDF5Attribute(dataset, "units", stringType, units.constData());
+	H5Tset_size(stringType, spec.size());
+	writeHDF5Attribute(dataset, "time_spec", stringType, spec.constData());
+	writeHDF5Attribute(dataset, "_FillValue", H5T_NATIVE_INT64, &AbstractColumn::invalidDateTime);
+
+	H5Tclose(stringType);
+	m_status = H5Dclose(dataset);
+	handleError(m_status, "H5Dclose", name);
+}
+
+/*!
+  writes the scalar attribute \c name of the type \c type with the value \c value to the data set \c dataset
+  if the data set doesn't have this attribute yet.
+*/
+void HDF5FilterPrivate::writeHDF5Attribute(hid_t dataset, const char* name, hid_t type, const void* value) {
+	if (H5Aexists(dataset, name) > 0)
+		return;
+
+	hid_t space = H5Screate(H5S_SCALAR);
+	hid_t attr = H5Acreate(dataset, name, type, space, H5P_DEFAULT, H5P_DEFAULT);
+	handleError((int)attr, "H5Acreate", QLatin1String(name));
+	if (attr >= 0) {
+		m_status = H5Awrite(attr, type, value);
+		handleError(m_status, "H5Awrite", QLatin1String(name));
+		if (m_status < 0)
+			setWriteError(i18n("Failed to write the attribute \"%1\".", QString::fromLatin1(name)));
+		H5Aclose(attr);
+	} else
+		setWriteError(i18n("Failed to write the attribute \"%1\".", QString::fromLatin1(name)));
+	H5Sclose(space);
+}
+
+/*!
+  keeps the first error of write() in lastError.
+*/
+void HDF5FilterPrivate::setWriteError(const QString& error) {
+	if (lastError.isEmpty())
+		lastError = error;
+}
+
+/*!
+  creates the property list for new data sets: chunks of \c chunkSize rows and one column
+  and the selected compression. LZ4 is only used if the filter plugin is available, deflate otherwise.
+*/
+hid_t HDF5FilterPrivate::createHDF5PropertyList(int rank) const {
+	const H5Z_filter_t lz4Filter = 32004;	// registered id of the LZ4 filter plugin
+
+	hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+	const hsize_t chunk[2] = {static_cast<hsize_t>(qMax(chunkSize, 1)), 1};
+	H5Pset_chunk(plist, rank, chunk);
+
+	HDF5Filter::Compression c = compression;
+	if (c == HDF5Filter::Compression::LZ4 && H5Zfilter_avail(lz4Filter) <= 0) {
+		DEBUG("	LZ4 filter not available, using deflate");
+		c = HDF5Filter::Compression::Deflate;
+	}
+	if (c == HDF5Filter::Compression::Deflate && H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0) {
+		DEBUG("	deflate filter not available, writing uncompressed data");
+		c = HDF5Filter::Compression::None;
+	}
+
+	if (c != HDF5Filter::Compression::None && shuffle)
+		H5Pset_shuffle(plist);
+	if (c == HDF5Filter::Compression::Deflate)
+		H5Pset_deflate(plist, qBound(0, compressionLevel, 9));
+	else if (c == HDF5Filter::Compression::LZ4)
+		H5Pset_filter(plist, lz4Filter, H5Z_FLAG_OPTIONAL, 0, nullptr);
+
+	return plist;
 }
+#endif
 
 //##############################################################################
 //##################  Serialization/Deserialization  ###########################
@@ -64,6 +64,19 @@ public:
 	void setEndColumn(const int);
 	int endColumn() const;
 
+	enum class Compression {None, Deflate, LZ4};
+	void setCompression(const Compression);
+	Compression compression() const;
+	void setCompressionLevel(const int);
+	int compressionLevel() const;
+	void setShuffle(const bool);
+	bool shuffle() const;
+	void setChunkSize(const int);
+	int chunkSize() const;
+	void setAppendMode(const bool);
+	bool appendMode() const;
+	QString lastError() const;
+
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*) override;
 
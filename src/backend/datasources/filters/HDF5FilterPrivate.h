@@ -28,11 +28,13 @@ Copyright            : (C) 2015-2018 Stefan Gerlach (stefan.gerlach@uni.kn)
 #define HDF5FILTERPRIVATE_H
 
 #include <QList>
+#include <functional>
 #ifdef HAVE_HDF5
 #include <hdf5.h>
 #endif
 
 class AbstractDataSource;
+class Column;
 
 class HDF5FilterPrivate {
 
@@ -56,6 +58,12 @@ public:
 	int endRow{-1};
 	int startColumn{1};
 	int endColumn{-1};
+	HDF5Filter::Compression compression{HDF5Filter::Compression::Deflate};
+	int compressionLevel{4};
+	bool shuffle{true};
+	int chunkSize{16384};	// number of rows per chunk
+	bool appendMode{false};
+	QString lastError;	// error of the last write()
 
 private:
 #ifdef HAVE_HDF5
@@ -84,6 +92,19 @@ private:
 	void scanHDF5Link(hid_t gid, char* linkName,  QTreeWidgetItem* parentItem);
 	void scanHDF5DataSet(hid_t dsid, char* dataSetName,  QTreeWidgetItem* parentItem);
 	void scanHDF5Group(hid_t gid, char* groupName, QTreeWidgetItem* parentItem);
+	template <typename T> void writeHDF5Column(hid_t file, const QString& name, hid_t type, const Column*,
+							T (Column::*valueAt)(int) const, int firstRow, int rows);
+	template <typename T> void writeHDF5Matrix(hid_t file, const QString& name, hid_t type, void* data,
+							int firstRow, int rows, int firstColumn, int columns);
+	bool writeHDF5DataSet(hid_t file, const QString& name, hid_t type, int rank, hsize_t rows, const QVector<const void*>& columns);
+	bool writeHDF5Blocks(hid_t file, const QString& name, hid_t type, int rows,
+							const std::function<const void*(int first, int blockRows)>& block);
+	hid_t openHDF5DataSet(hid_t file, const QString& name, hid_t type, int rank, hsize_t rows, hsize_t cols, hsize_t& offset);
+	bool closeHDF5DataSet(hid_t dataset, const QString& name, bool success);
+	void writeHDF5DateTimeAttributes(hid_t file, const QString& name, Qt::TimeSpec);
+	void writeHDF5Attribute(hid_t dataset, const char* name, hid_t type, const void* value);
+	void setWriteError(const QString&);
+	hid_t createHDF5PropertyList(int rank) const;
 #endif
 };
 
@@ -355,7 +355,7 @@ void JsonFilterPrivate::setEmptyValue(int column, int row) {
 			static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = 0;
 			break;
 		case AbstractColumn::ColumnMode::DateTime:
-			static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) = QDateTime();
+			static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = AbstractColumn::invalidDateTime;
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			static_cast<QVector<QString>*>(m_dataContainer[column])->operator[](row) = QString();
@@ -389,8 +389,7 @@ void JsonFilterPrivate::setValueFromString(int column, int row, const QString& v
 		}
 		case AbstractColumn::ColumnMode::DateTime: {
 			const QDateTime valueDateTime = QDateTime::fromString(valueString, dateTimeFormat);
-			static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) =
-					valueDateTime.isValid() ? valueDateTime : QDateTime();
+			static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = AbstractColumn::dateTimeToMSecs(valueDateTime);
 			break;
 		}
 		case AbstractColumn::ColumnMode::Text:
@@ -31,6 +31,11 @@ Copyright            : (C) 2018 Stefan Gerlach (stefan.gerlach@uni.kn)
 #include "backend/lib/trace.h"
 
 #include <QFile>
+#include <QThread>
+#include <QtConcurrentRun>
+#include <QtEndian>
+
+#include <cstring>
 
 /*!
 \class NgspiceRawBinaryFilter
@@ -146,6 +151,20 @@ int NgspiceRawBinaryFilter::endRow() const {
 	return d->endRow;
 }
 
+void NgspiceRawBinaryFilter::setStartColumn(const int c) {
+	d->startColumn = c;
+}
+int NgspiceRawBinaryFilter::startColumn() const {
+	return d->startColumn;
+}
+
+void NgspiceRawBinaryFilter::setEndColumn(const int c) {
+	d->endColumn = c;
+}
+int NgspiceRawBinaryFilter::endColumn() const {
+	return d->endColumn;
+}
+
 QStringList NgspiceRawBinaryFilter::vectorNames() const {
 	return d->vectorNames;
 }
@@ -161,18 +180,10 @@ NgspiceRawBinaryFilterPrivate::NgspiceRawBinaryFilterPrivate(NgspiceRawBinaryFil
 }
 
 /*!
-    reads the content of the file \c fileName to the data source \c dataSource. Uses the settings defined in the data source.
+    reads the header of the file and determines the number of variables and points,
+    the names of the vectors and the position of the binary data in the file.
 */
-void NgspiceRawBinaryFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
-	DEBUG("NgspiceRawBinaryFilterPrivate::readDataFromFile(): fileName = \'" << STDSTRING(fileName) << "\', dataSource = "
-	      << dataSource << ", mode = " << ENUM_TO_STRING(AbstractFileFilter, ImportMode, importMode));
-
-	QFile file(fileName);
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-		DEBUG("Failed to open the file " << STDSTRING(fileName));
-		return;
-	}
-
+bool NgspiceRawBinaryFilterPrivate::readHeader(QFile& file) {
 	//skip the first three lines in the header
 	file.readLine(); //"Title"
 	file.readLine(); //"Date"
@@ -180,25 +191,31 @@ void NgspiceRawBinaryFilterPrivate::readDataFromFile(const QString& fileName, Ab
 
 	//evaluate the "Flags" line to check whether we have complex numbers
 	QString line = file.readLine();
-	bool hasComplexValues = line.endsWith(QLatin1String("complex\n"));
+	m_hasComplexValues = line.endsWith(QLatin1String("complex\n"));
 
 	//number of variables
 	line = file.readLine();
-	const int vars = line.rightRef(line.length() - 15).toInt(); //remove the "No. Variables: " sub-string
+	m_variables = line.rightRef(line.length() - 15).toInt(); //remove the "No. Variables: " sub-string
+	DEBUG("	vars = " << m_variables);
 
 	//number of points
 	line = file.readLine();
-	const int points = line.rightRef(line.length() - 12).toInt(); //remove the "No. Points: " sub-string
+	m_points = line.rightRef(line.length() - 12).toInt(); //remove the "No. Points: " sub-string
+	DEBUG("	points = " << m_points);
 
 	//add names of the variables
 	vectorNames.clear();
 	columnModes.clear();
 	file.readLine();
-	for (int i = 0; i<vars; ++i) {
+	for (int i = 0; i < m_variables; ++i) {
 		line = file.readLine();
 		QStringList tokens = line.split('\t');
+		if (tokens.size() < 4) {
+			DEBUG("Invalid definition of the variable " << i);
+			return false;
+		}
 		QString name = tokens.at(2) + QLatin1String(", ") + tokens.at(3).simplified();
-		if (hasComplexValues) {
+		if (m_hasComplexValues) {
 			vectorNames << name + QLatin1String(" REAL");
 			vectorNames << name + QLatin1String(" IMAGINARY");
 			columnModes << AbstractColumn::ColumnMode::Numeric;
@@ -210,46 +227,123 @@ void NgspiceRawBinaryFilterPrivate::readDataFromFile(const QString& fileName, Ab
 	}
 
 	file.readLine(); //skip the line with "Binary:"
+	m_dataOffset = file.pos();
+	m_pointSize = vectorNames.size() * BYTE_SIZE;
+	if (m_pointSize == 0)
+		return false;
+
+	//the simulation might still be running, use only the points completely available in the file
+	const qint64 availablePoints = (file.size() - m_dataOffset) / m_pointSize;
+	if (availablePoints < m_points) {
+		DEBUG("	only " << availablePoints << " points available in the file");
+		m_points = static_cast<int>(availablePoints);
+	}
+
+	return true;
+}
+
+/*!
+    copies the values of the vectors with the indices \c columns out of \c rows points starting at \c data
+    into the data containers, starting at the position \c offset in the containers.
+    The vectors are distributed over the available threads.
+*/
+void NgspiceRawBinaryFilterPrivate::readValues(const char* data, int rows, const QVector<int>& columns, int offset) {
+	auto copyValues = [=](int first, int step) {
+		for (int c = first; c < columns.size(); c += step) {
+			const char* source = data + columns.at(c) * BYTE_SIZE;
+			double* target = static_cast<QVector<double>*>(m_dataContainer[c])->data() + offset;
+			for (int i = 0; i < rows; ++i) {
+				//the data is stored in little endian byte order
+				quint64 bytes;
+				memcpy(&bytes, source, BYTE_SIZE);
+				bytes = qFromLittleEndian(bytes);
+				memcpy(target + i, &bytes, BYTE_SIZE);
+				source += m_pointSize;
+			}
+		}
+	};
+
+	const int threads = qMax(1, qMin(QThread::idealThreadCount(), columns.size()));
+	QVector<QFuture<void>> futures;
+	for (int t = 1; t < threads; ++t)
+		futures << QtConcurrent::run([=]() { copyValues(t, threads); });
+	copyValues(0, threads);
+	for (auto& future : futures)
+		future.waitForFinished();
+}
+
+/*!
+    reads the content of the file \c fileName to the data source \c dataSource. Uses the settings defined in the data source.
+*/
+void NgspiceRawBinaryFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
+	DEBUG("NgspiceRawBinaryFilterPrivate::readDataFromFile(): fileName = \'" << STDSTRING(fileName) << "\', dataSource = "
+	      << dataSource << ", mode = " << ENUM_TO_STRING(AbstractFileFilter, ImportMode, importMode));
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		DEBUG("Failed to open the file " << STDSTRING(fileName));
+		return;
+	}
+
+	if (!readHeader(file))
+		return;
 	file.setTextModeEnabled(false);	// the rest is binary
 
+	//import the vectors in the range of the start and end column
+	const int firstColumn = qMax(startColumn, 1) - 1;
+	const int lastColumn = (endColumn == -1 || endColumn > vectorNames.size()) ? vectorNames.size() : endColumn;
+	QVector<int> columns;
+	QStringList names;
+	QVector<AbstractColumn::ColumnMode> modes;
+	for (int c = firstColumn; c < lastColumn; ++c) {
+		columns << c;
+		names << vectorNames.at(c);
+		modes << columnModes.at(c);
+	}
+
 	//prepare the data container
-	const int actualEndRow = (endRow == -1 || endRow > points) ? points : endRow;
+	const int actualEndRow = (endRow == -1 || endRow > m_points) ? m_points : endRow;
 	const int actualRows = actualEndRow - startRow + 1;
-	const int actualCols = hasComplexValues ? 2 * vars : vars;
-	const int columnOffset = dataSource->prepareImport(m_dataContainer, importMode, actualRows, actualCols, vectorNames, columnModes);
-
-	//skip data lines, if required
-	const int skip = hasComplexValues ? 2 * vars * (startRow - 1) : vars * (startRow - 1);
-	if (skip > 0) {
-		DEBUG("	Skipping " << startRow - 1 << " lines");
-		file.read(BYTE_SIZE * skip);
+	const int actualCols = columns.size();
+	if (actualRows <= 0 || actualCols == 0) {
+		DEBUG("	Nothing to import");
+		return;
+	}
+	const int columnOffset = dataSource->prepareImport(m_dataContainer, importMode, actualRows, actualCols, names, modes);
+
+	//map the required part of the data section, read it block-wise if the mapping is not possible
+	const qint64 firstByte = m_dataOffset + static_cast<qint64>(startRow - 1) * m_pointSize;
+	const qint64 size = static_cast<qint64>(actualRows) * m_pointSize;
+	const char* data = reinterpret_cast<const char*>(file.map(firstByte, size));
+	if (!data) {
+		DEBUG("	Mapping of the file failed, reading the data block-wise");
+		file.seek(firstByte);
 	}
 
-	//read the data points
-	int currentRow = 0;	// indexes the position in the vector(column)
-	for (int i = 0; i < actualRows; ++i) {
-		for (int j = 0; j < vars; ++j) {
-			double value;
-			QDataStream s(file.read(BYTE_SIZE));
-			s.setByteOrder(QDataStream::LittleEndian);
-			s >> value;
-			if (hasComplexValues) {
-				//real part
-				static_cast<QVector<double>*>(m_dataContainer[2*j])->operator[](currentRow) = value;
-
-				//imaginary part
-				QDataStream sim(file.read(BYTE_SIZE));
-				sim.setByteOrder(QDataStream::LittleEndian);
-				sim >> value;
-				static_cast<QVector<double>*>(m_dataContainer[2*j+1])->operator[](currentRow) = value;
-			} else
-				static_cast<QVector<double>*>(m_dataContainer[j])->operator[](currentRow) = value;
+	//copy the data points, block by block to report the progress
+	const int blockSize = 10000;
+	QByteArray buffer;
+	for (int row = 0; row < actualRows; row += blockSize) {
+		const int rows = qMin(blockSize, actualRows - row);
+		const char* block;
+		if (data)
+			block = data + static_cast<qint64>(row) * m_pointSize;
+		else {
+			buffer = file.read(static_cast<qint64>(rows) * m_pointSize);
+			if (buffer.size() < static_cast<qint64>(rows) * m_pointSize) {
+				DEBUG("	Unexpected end of the file");
+				break;
+			}
+			block = buffer.constData();
 		}
 
-		currentRow++;
-		emit q->completed(100 * currentRow/actualRows);
+		readValues(block, rows, columns, row);
+		emit q->completed(100 * (row + rows) / actualRows);
 	}
 
+	if (data)
+		file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(data)));
+
 	dataSource->finalizeImport(columnOffset, 1, actualCols, QString(), importMode);
 }
 
@@ -266,63 +360,27 @@ QVector<QStringList> NgspiceRawBinaryFilterPrivate::preview(const QString& fileN
 		return dataStrings;
 	}
 
-	//skip the first three lines in the header
-	file.readLine(); //"Title"
-	file.readLine(); //"Date"
-	file.readLine(); //"Plotname"
-
-	//evaluate the "Flags" line to check whether we have complex numbers
-	QString line = file.readLine();
-	bool hasComplexValues = line.endsWith(QLatin1String("complex\n"));
-
-	//number of variables
-	line = file.readLine();
-	const int vars = line.rightRef(line.length() - 15).toInt(); //remove the "No. Variables: " sub-string
-	DEBUG("	vars = " << vars);
-
-	//number of points
-	line = file.readLine();
-	const int points = line.rightRef(line.length() - 12).toInt(); //remove the "No. Points: " sub-string
-	DEBUG("	points = " << points);
-
-	//add names of the variables
-	vectorNames.clear();
-	columnModes.clear();
-	file.readLine();
-	for (int i = 0; i < vars; ++i) {
-		line = file.readLine();
-		QStringList tokens = line.split('\t');
-		QString name = tokens.at(2) + QLatin1String(", ") + tokens.at(3).simplified();
-		if (hasComplexValues) {
-			vectorNames << name + QLatin1String(" REAL");
-			vectorNames << name + QLatin1String(" IMAGINARY");
-			columnModes << AbstractColumn::ColumnMode::Numeric;
-			columnModes << AbstractColumn::ColumnMode::Numeric;
-		} else {
-			vectorNames << name;
-			columnModes << AbstractColumn::ColumnMode::Numeric;
-		}
-	}
-
-	file.readLine(); //skip the line with "Binary"
+	if (!readHeader(file))
+		return dataStrings;
 
-	//read the binary data
+	//read the binary data of the first points only
 	file.setTextModeEnabled(false);
+	const int rows = qMin(lines, m_points);
+	if (rows <= 0)
+		return dataStrings;
+	const QByteArray data = file.read(static_cast<qint64>(rows) * m_pointSize);
+	const char* source = data.constData();
 	QStringList lineString;
-	for (int i = 0; i < qMin(lines, points); ++i) {
+	for (int i = 0; i < rows; ++i) {
 		lineString.clear();
-		for (int j = 0; j < vars; ++j) {
-			double v;
-			QDataStream s(file.read(BYTE_SIZE));
-			s.setByteOrder(QDataStream::LittleEndian);
-			s >> v;
-			lineString << QString::number(v, 'e', 15); //real part
-			if (hasComplexValues) {
-				QDataStream sim(file.read(BYTE_SIZE));
-				sim.setByteOrder(QDataStream::LittleEndian);
-				sim >> v;
-				lineString << QString::number(v, 'e', 15); //imaginary part
-			}
+		for (int j = 0; j < vectorNames.size(); ++j) {
+			quint64 bytes;
+			memcpy(&bytes, source, BYTE_SIZE);
+			bytes = qFromLittleEndian(bytes);
+			double value;
+			memcpy(&value, &bytes, BYTE_SIZE);
+			lineString << QString::number(value, 'e', 15);
+			source += BYTE_SIZE;
 		}
 
 		dataStrings << lineString;
@@ -29,6 +29,7 @@ Copyright            : (C) 2018 Alexander Semke (alexander.semke@web.de)
 #define NGSPICERAWBINARYFILTERPRIVATE_H
 
 class AbstractDataSource;
+class QFile;
 
 class NgspiceRawBinaryFilterPrivate {
 
@@ -46,10 +47,20 @@ public:
 	QVector<AbstractColumn::ColumnMode> columnModes;
 	int startRow{1};
 	int endRow{-1};
+	int startColumn{1};	// first vector to import
+	int endColumn{-1};	// last vector to import (-1 = all vectors)
 
 private:
 	const static int BYTE_SIZE = 8;
 
+	bool readHeader(QFile&);
+	void readValues(const char* data, int rows, const QVector<int>& columns, int offset);
+
+	int m_variables{0};
+	int m_points{0};
+	bool m_hasComplexValues{false};
+	int m_pointSize{0};	// size of one point (values of all variables) in bytes
+	qint64 m_dataOffset{0};	// position of the binary data in the file
 	std::vector<void*> m_dataContainer; // pointers to the actual data containers
 };
 
@@ -0,0 +1,515 @@
+/***************************************************************************
+File                 : SQLDatabaseFilter.cpp
+Project              : LabPlot
+Description          : SQL database filter
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+***************************************************************************/
+
+/***************************************************************************
+*                                                                         *
+*  This program is free software; you can redistribute it and/or modify   *
+*  it under the terms of the GNU General Public License as published by   *
+*  the Free Software Foundation; either version 2 of the License, or      *
+*  (at your option) any later version.                                    *
+*                                                                         *
+*  This program is distributed in the hope that it will be useful,        *
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+*  GNU General Public License for more details.                           *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program; if not, write to the Free Software           *
+*   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+*   Boston, MA  02110-1301  USA                                           *
+*                                                                         *
+***************************************************************************/
+
+#include "backend/datasources/filters/SQLDatabaseFilter.h"
+#include "backend/datasources/filters/SQLDatabaseFilterPrivate.h"
+#include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnStringIO.h"
+#include "backend/datasources/AbstractDataSource.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+#include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+#include <KLocalizedString>
+
+/*!
+\class SQLDatabaseFilter
+\brief Import of the result of SQL queries and export of spreadsheets to SQLite databases.
+
+The result of a query is read forward-only, the native numeric and date-time values are read directly
+without converting them to strings first.
+On export, the rows are inserted with one prepared statement and typed bindings in transactions of \c batchSize rows,
+numeric columns are stored as numbers and not as text.
+
+\ingroup datasources
+*/
+SQLDatabaseFilter::SQLDatabaseFilter() : d(new SQLDatabaseFilterPrivate(this)) {}
+
+SQLDatabaseFilter::~SQLDatabaseFilter() = default;
+
+/*!
+  reads the result of \c query executed on the database \c db into \c dataSource.
+  Returns the number of read rows or -1 on failure, the error is available via lastError().
+*/
+int SQLDatabaseFilter::read(const QSqlDatabase& db, const QString& query, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
+	return d->read(db, query, dataSource, importMode);
+}
+
+/*!
+  exports the data of \c spreadsheet to the new SQLite database \c fileName.
+  Returns \c false on failure, the error is available via lastError().
+*/
+bool SQLDatabaseFilter::write(const QString& fileName, const Spreadsheet* spreadsheet) {
+	return d->write(fileName, spreadsheet);
+}
+
+/*!
+  sets the column modes used on import. If not set, the modes are determined from the first record.
+*/
+void SQLDatabaseFilter::setColumnModes(const QVector<AbstractColumn::ColumnMode>& modes) {
+	d->columnModes = modes;
+}
+
+QVector<AbstractColumn::ColumnMode> SQLDatabaseFilter::columnModes() const {
+	return d->columnModes;
+}
+
+/*!
+  sets the format used to parse date-time values that are provided as strings by the database.
+*/
+void SQLDatabaseFilter::setDateTimeFormat(const QString& format) {
+	d->dateTimeFormat = format;
+}
+
+QString SQLDatabaseFilter::dateTimeFormat() const {
+	return d->dateTimeFormat;
+}
+
+/*!
+  sets the number format used to parse numbers that are provided as strings by the database.
+*/
+void SQLDatabaseFilter::setNumberFormat(QLocale::Language format) {
+	d->numberFormat = format;
+}
+
+QLocale::Language SQLDatabaseFilter::numberFormat() const {
+	return d->numberFormat;
+}
+
+/*!
+  sets the number of rows fetched in one batch on import and inserted in one transaction on export.
+*/
+void SQLDatabaseFilter::setBatchSize(int size) {
+	d->batchSize = qMax(size, 1);
+}
+
+int SQLDatabaseFilter::batchSize() const {
+	return d->batchSize;
+}
+
+/*!
+  sets the last row to export, -1 exports all rows.
+*/
+void SQLDatabaseFilter::setEndRow(int row) {
+	d->endRow = row;
+}
+
+int SQLDatabaseFilter::endRow() const {
+	return d->endRow;
+}
+
+/*!
+  returns the number of rows per second inserted by the last successful export.
+*/
+double SQLDatabaseFilter::rowsPerSecond() const {
+	return d->rowsPerSecond;
+}
+
+QString SQLDatabaseFilter::lastError() const {
+	return d->lastError;
+}
+
+//#####################################################################
+//################### Private implementation ##########################
+//#####################################################################
+
+SQLDatabaseFilterPrivate::SQLDatabaseFilterPrivate(SQLDatabaseFilter* owner) : q(owner) {
+}
+
+// column mode for the native type of \c value, for strings the mode is determined from the content
+static AbstractColumn::ColumnMode columnMode(const QVariant& value, const QString& dateTimeFormat, QLocale::Language numberFormat) {
+	switch (static_cast<QMetaType::Type>(value.type())) {
+	case QMetaType::Double:
+	case QMetaType::Float:
+		return AbstractColumn::ColumnMode::Numeric;
+	case QMetaType::Bool:
+	case QMetaType::Short:
+	case QMetaType::UShort:
+	case QMetaType::Int:
+		return AbstractColumn::ColumnMode::Integer;
+	case QMetaType::UInt:
+	case QMetaType::Long:
+	case QMetaType::ULong:
+	case QMetaType::LongLong:
+	case QMetaType::ULongLong:
+		return AbstractColumn::ColumnMode::BigInt;
+	case QMetaType::QDate:
+	case QMetaType::QDateTime:
+		return AbstractColumn::ColumnMode::DateTime;
+	default:
+		return AbstractFileFilter::columnMode(value.toString(), dateTimeFormat, numberFormat);
+	}
+}
+
+// typed buffer for the values of one column of the query result
+struct ColumnBuffer {
+	QVector<double> numeric;
+	QVector<int> integer;
+	QVector<qint64> bigInt;
+	QVector<qint64> dateTime;	// milliseconds since epoch, see AbstractColumn::dateTimeToMSecs()
+	QVector<QString> text;
+
+	// reserves the space for \c size values in the vector used for \c mode
+	void reserve(AbstractColumn::ColumnMode mode, int size) {
+		switch (mode) {
+		case AbstractColumn::ColumnMode::Numeric:
+			numeric.reserve(size);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			integer.reserve(size);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			bigInt.reserve(size);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+			dateTime.reserve(size);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			text.reserve(size);
+			break;
+		case AbstractColumn::ColumnMode::Month:	// never happens
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+	}
+};
+
+// moves the content of \c buffer into the data container \c data of the data source having at least \c rows rows
+template <typename T>
+static void moveBuffer(QVector<T>& buffer, void* data) {
+	auto* vector = static_cast<QVector<T>*>(data);
+	const int size = vector->size();
+	*vector = std::move(buffer);
+	vector->resize(size);
+}
+
+int SQLDatabaseFilterPrivate::read(const QSqlDatabase& db, const QString& queryString, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
+	PERFTRACE("import from SQL database");
+	lastError.clear();
+	if (!dataSource)
+		return -1;
+
+	//forward-only: the driver doesn't need to cache the result set
+	QSqlQuery query(db);
+	query.setForwardOnly(true);
+	if (!query.exec(queryString) || !query.isActive()) {
+		lastError = query.lastError().databaseText();
+		return -1;
+	}
+
+	const QSqlRecord record = query.record();
+	const int cols = record.count();
+	QStringList columnNames;
+	for (int col = 0; col < cols; ++col)
+		columnNames << record.fieldName(col);
+
+	//the size of the result is only known if the driver supports it (not for SQLite),
+	//otherwise the capacity of the buffers is doubled whenever they are full
+	const int resultSize = db.driver()->hasFeature(QSqlDriver::QuerySize) ? query.size() : -1;
+
+	const QLocale locale(numberFormat);
+	QVector<AbstractColumn::ColumnMode> modes = columnModes;
+	QVector<ColumnBuffer> buffers(cols);
+	int rows = 0;
+	int capacity = 0;
+	while (query.next()) {
+		if (rows == capacity) {
+			//determine the column modes from the first record if they were not set
+			if (rows == 0 && modes.size() < cols) {
+				for (int col = modes.size(); col < cols; ++col)
+					modes << columnMode(query.value(col), dateTimeFormat, numberFormat);
+			}
+
+			//reserve the space for the next rows in the buffers of all columns
+			capacity = (resultSize > 0) ? qMax(resultSize, rows + 1) : qMax(batchSize, 2 * capacity);
+			for (int col = 0; col < cols; ++col)
+				buffers[col].reserve(modes.at(col), capacity);
+
+			if (resultSize > 0 && rows > 0)
+				emit q->completed(static_cast<int>(100. * rows / resultSize));
+		}
+
+		for (int col = 0; col < cols; ++col) {
+			const QVariant value = query.value(col);
+			const bool isString = (value.type() == QVariant::String);
+			auto& buffer = buffers[col];
+			switch (modes.at(col)) {
+			case AbstractColumn::ColumnMode::Numeric: {
+				bool ok = !value.isNull();
+				double number = NAN;
+				if (ok)
+					number = isString ? locale.toDouble(value.toString(), &ok) : value.toDouble(&ok);
+				buffer.numeric << (ok ? number : NAN);
+				break;
+			}
+			case AbstractColumn::ColumnMode::Integer: {
+				bool ok = !value.isNull();
+				int number = 0;
+				if (ok)
+					number = isString ? locale.toInt(value.toString(), &ok) : value.toInt(&ok);
+				buffer.integer << (ok ? number : 0);
+				break;
+			}
+			case AbstractColumn::ColumnMode::BigInt: {
+				bool ok = !value.isNull();
+				qint64 number = 0;
+				if (ok)
+					number = isString ? locale.toLongLong(value.toString(), &ok) : value.toLongLong(&ok);
+				buffer.bigInt << (ok ? number : 0);
+				break;
+			}
+			case AbstractColumn::ColumnMode::DateTime: {
+				const QDateTime dateTime = isString ? QDateTime::fromString(value.toString(), dateTimeFormat) : value.toDateTime();
+				buffer.dateTime << AbstractColumn::dateTimeToMSecs(dateTime);
+				break;
+			}
+			case AbstractColumn::ColumnMode::Text:
+				buffer.text << value.toString();
+				break;
+			case AbstractColumn::ColumnMode::Month:	// never happens
+			case AbstractColumn::ColumnMode::Day:
+				break;
+			}
+		}
+
+		++rows;
+	}
+	DEBUG("	Read " << rows << " rows");
+
+	if (modes.size() < cols) {	// empty result, no record to determine the column modes from
+		for (int col = modes.size(); col < cols; ++col)
+			modes << AbstractColumn::ColumnMode::Numeric;
+	}
+
+	//the number of rows is known now, move the buffers to the data source
+	std::vector<void*> dataContainer;
+	const int columnOffset = dataSource->prepareImport(dataContainer, importMode, rows, cols, columnNames, modes);
+	if (columnOffset == -1) {
+		lastError = i18n("Failed to prepare the import.");
+		return -1;
+	}
+
+	for (int col = 0; col < cols; ++col) {
+		auto& buffer = buffers[col];
+		switch (modes.at(col)) {
+		case AbstractColumn::ColumnMode::Numeric:
+			moveBuffer(buffer.numeric, dataContainer[col]);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			moveBuffer(buffer.integer, dataContainer[col]);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			moveBuffer(buffer.bigInt, dataContainer[col]);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+			moveBuffer(buffer.dateTime, dataContainer[col]);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			moveBuffer(buffer.text, dataContainer[col]);
+			break;
+		case AbstractColumn::ColumnMode::Month:	// never happens
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+	}
+
+	dataSource->finalizeImport(columnOffset, 1, cols, dateTimeFormat, importMode);
+	emit q->completed(100);
+
+	return rows;
+}
+
+// quotes an identifier (table or column name) for the usage in SQL statements
+static QString quotedIdentifier(const QString& name) {
+	QString quoted = name;
+	quoted.replace(QLatin1Char('"'), QLatin1String("\"\""));
+	return QLatin1Char('"') + quoted + QLatin1Char('"');
+}
+
+bool SQLDatabaseFilterPrivate::write(const QString& fileName, const Spreadsheet* spreadsheet) {
+	lastError.clear();
+
+	//the database is created from scratch
+	QFile file(fileName);
+	if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+		lastError = i18n("Couldn't create the SQLite database %1.", fileName);
+		return false;
+	}
+	file.close();
+
+	const QStringList& drivers = QSqlDatabase::drivers();
+	QString driver;
+	if (drivers.contains(QLatin1String("QSQLITE3")))
+		driver = QLatin1String("QSQLITE3");
+	else
+		driver = QLatin1String("QSQLITE");
+
+	//use a separate connection, the default connection may be in use
+	const QString connectionName = QLatin1String("SQLDatabaseFilter_") + QString::number(reinterpret_cast<quintptr>(this));
+	bool rc = false;
+	{
+		QSqlDatabase db = QSqlDatabase::addDatabase(driver, connectionName);
+		db.setDatabaseName(fileName);
+		if (db.open()) {
+			rc = write(db, spreadsheet);
+			db.close();
+		} else
+			lastError = i18n("Couldn't create the SQLite database %1.", fileName) + QLatin1Char('\n') + db.lastError().databaseText();
+	}
+	QSqlDatabase::removeDatabase(connectionName);
+
+	return rc;
+}
+
+bool SQLDatabaseFilterPrivate::write(QSqlDatabase& db, const Spreadsheet* spreadsheet) {
+	PERFTRACE("export spreadsheet to SQLite database");
+	QElapsedTimer timer;
+	timer.start();
+	rowsPerSecond = 0.;
+	QSqlQuery query(db);
+
+	//the database is newly created and useless if the export fails, no syncing to the disk is needed for the bulk load.
+	//the rollback journal is kept, it's needed to roll back a failed batch
+	query.exec(QLatin1String("PRAGMA synchronous = OFF"));
+	query.exec(QLatin1String("PRAGMA locking_mode = EXCLUSIVE"));
+	query.exec(QLatin1String("PRAGMA temp_store = MEMORY"));
+	query.exec(QLatin1String("PRAGMA cache_size = -65536"));	// 64 MiB
+
+	//create table
+	const int cols = spreadsheet->columnCount();
+	const QString table = quotedIdentifier(spreadsheet->name());
+	QString statement = QLatin1String("CREATE TABLE ") + table + QLatin1String(" (");
+	QString insert = QLatin1String("INSERT INTO ") + table + QLatin1String(" VALUES (");
+	for (int i = 0; i < cols; ++i) {
+		const Column* col = spreadsheet->column(i);
+		if (i != 0) {
+			statement += QLatin1String(", ");
+			insert += QLatin1String(", ");
+		}
+
+		statement += quotedIdentifier(col->name()) + QLatin1Char(' ');
+		switch (col->columnMode()) {
+		case AbstractColumn::ColumnMode::Numeric:
+			statement += QLatin1String("REAL");
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+		case AbstractColumn::ColumnMode::BigInt:
+			statement += QLatin1String("INTEGER");
+			break;
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::DateTime:
+			statement += QLatin1String("TEXT");
+			break;
+		}
+		insert += QLatin1Char('?');
+	}
+	statement += QLatin1Char(')');
+	insert += QLatin1Char(')');
+
+	if (!query.exec(statement)) {
+		lastError = i18n("Failed to create table in the SQLite database %1.", db.databaseName()) + QLatin1Char('\n') + query.lastError().databaseText();
+		return false;
+	}
+
+	int rows = spreadsheet->rowCount();
+	if (endRow >= 0)
+		rows = qMin(rows, endRow + 1);
+	if (cols == 0 || rows <= 0)
+		return true;
+
+	//insert the values with one prepared statement, the values of each column are bound as typed lists
+	if (!query.prepare(insert)) {
+		lastError = i18n("Failed to insert values into the table.") + QLatin1Char('\n') + query.lastError().databaseText();
+		return false;
+	}
+
+	for (int start = 0; start < rows; start += batchSize) {
+		const int end = qMin(start + batchSize, rows);
+		for (int j = 0; j < cols; ++j) {
+			const Column* col = spreadsheet->column(j);
+			QVariantList values;
+			values.reserve(end - start);
+			switch (col->columnMode()) {
+			case AbstractColumn::ColumnMode::Numeric:
+				for (int i = start; i < end; ++i) {
+					const double value = col->valueAt(i);
+					values << (std::isnan(value) ? QVariant(QVariant::Double) : QVariant(value));
+				}
+				break;
+			case AbstractColumn::ColumnMode::Integer:
+				for (int i = start; i < end; ++i)
+					values << col->integerAt(i);
+				break;
+			case AbstractColumn::ColumnMode::BigInt:
+				for (int i = start; i < end; ++i)
+					values << QVariant(static_cast<qlonglong>(col->bigIntAt(i)));
+				break;
+			case AbstractColumn::ColumnMode::DateTime:
+				//ISO 8601, understood by the date and time functions of SQLite
+				for (int i = start; i < end; ++i) {
+					const QDateTime& dateTime = col->dateTimeAt(i);
+					values << (dateTime.isValid() ? QVariant(dateTime.toString(QLatin1String("yyyy-MM-dd hh:mm:ss.zzz"))) : QVariant(QVariant::String));
+				}
+				break;
+			case AbstractColumn::ColumnMode::Month:
+			case AbstractColumn::ColumnMode::Day:
+				for (int i = start; i < end; ++i)
+					values << col->asStringColumn()->textAt(i);
+				break;
+			case AbstractColumn::ColumnMode::Text:
+				for (int i = start; i < end; ++i)
+					values << col->textAt(i);
+				break;
+			}
+			query.addBindValue(values);
+		}
+
+		db.transaction();
+		if (!query.execBatch()) {
+			lastError = i18n("Failed to insert values into the table.") + QLatin1Char('\n') + query.lastError().databaseText();
+			db.rollback();
+			return false;
+		}
+		db.commit();
+		emit q->completed(static_cast<int>(100. * end / rows));
+	}
+
+	rowsPerSecond = 1000. * rows / qMax(timer.elapsed(), (qint64)1);
+	DEBUG("SQLDatabaseFilterPrivate::write(): " << rows << " rows inserted, " << rowsPerSecond << " rows/s");
+
+	return true;
+}
@@ -0,0 +1,74 @@
+/***************************************************************************
+File                 : SQLDatabaseFilter.h
+Project              : LabPlot
+Description          : SQL database filter
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+***************************************************************************/
+
+/***************************************************************************
+*                                                                         *
+*  This program is free software; you can redistribute it and/or modify   *
+*  it under the terms of the GNU General Public License as published by   *
+*  the Free Software Foundation; either version 2 of the License, or      *
+*  (at your option) any later version.                                    *
+*                                                                         *
+*  This program is distributed in the hope that it will be useful,        *
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+*  GNU General Public License for more details.                           *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program; if not, write to the Free Software           *
+*   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+*   Boston, MA  02110-1301  USA                                           *
+*                                                                         *
+***************************************************************************/
+
+#ifndef SQLDATABASEFILTER_H
+#define SQLDATABASEFILTER_H
+
+#include "backend/datasources/filters/AbstractFileFilter.h"
+
+#include <QObject>
+#include <memory>
+
+class AbstractDataSource;
+class QSqlDatabase;
+class Spreadsheet;
+class SQLDatabaseFilterPrivate;
+
+class SQLDatabaseFilter : public QObject {
+	Q_OBJECT
+
+public:
+	SQLDatabaseFilter();
+	~SQLDatabaseFilter() override;
+
+	int read(const QSqlDatabase&, const QString& query, AbstractDataSource*,
+		AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
+	bool write(const QString& fileName, const Spreadsheet*);
+
+	void setColumnModes(const QVector<AbstractColumn::ColumnMode>&);
+	QVector<AbstractColumn::ColumnMode> columnModes() const;
+	void setDateTimeFormat(const QString&);
+	QString dateTimeFormat() const;
+	void setNumberFormat(QLocale::Language);
+	QLocale::Language numberFormat() const;
+	void setBatchSize(int);
+	int batchSize() const;
+	void setEndRow(int);
+	int endRow() const;
+
+	double rowsPerSecond() const;
+	QString lastError() const;
+
+signals:
+	void completed(int) const; //!< int ranging from 0 to 100 notifies about the status of the read/write process
+
+private:
+	std::unique_ptr<SQLDatabaseFilterPrivate> const d;
+	friend class SQLDatabaseFilterPrivate;
+};
+
+#endif
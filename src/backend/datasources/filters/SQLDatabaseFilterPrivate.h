@@ -0,0 +1,63 @@
+/***************************************************************************
+File                 : SQLDatabaseFilterPrivate.h
+Project              : LabPlot
+Description          : SQL database filter
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+***************************************************************************/
+
+/***************************************************************************
+*                                                                         *
+*  This program is free software; you can redistribute it and/or modify   *
+*  it under the terms of the GNU General Public License as published by   *
+*  the Free Software Foundation; either version 2 of the License, or      *
+*  (at your option) any later version.                                    *
+*                                                                         *
+*  This program is distributed in the hope that it will be useful,        *
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+*  GNU General Public License for more details.                           *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program; if not, write to the Free Software           *
+*   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+*   Boston, MA  02110-1301  USA                                           *
+*                                                                         *
+***************************************************************************/
+
+#ifndef SQLDATABASEFILTERPRIVATE_H
+#define SQLDATABASEFILTERPRIVATE_H
+
+#include "backend/datasources/filters/AbstractFileFilter.h"
+#include "backend/core/AbstractColumn.h"
+
+#include <QLocale>
+#include <QString>
+#include <QVector>
+
+class AbstractDataSource;
+class QSqlDatabase;
+class Spreadsheet;
+class SQLDatabaseFilter;
+
+class SQLDatabaseFilterPrivate {
+
+public:
+	explicit SQLDatabaseFilterPrivate(SQLDatabaseFilter*);
+
+	int read(const QSqlDatabase&, const QString& query, AbstractDataSource*, AbstractFileFilter::ImportMode);
+	bool write(const QString& fileName, const Spreadsheet*);
+	bool write(QSqlDatabase&, const Spreadsheet*);
+
+	const SQLDatabaseFilter* q;
+
+	QVector<AbstractColumn::ColumnMode> columnModes;	// determined from the first record if not set
+	QString dateTimeFormat;
+	QLocale::Language numberFormat{QLocale::C};
+	int batchSize{100000};	// number of rows fetched in one batch on import and inserted in one transaction on export
+	int endRow{-1};		// last row to export (-1 = all rows)
+	double rowsPerSecond{0.};	// throughput of the last export
+	QString lastError;
+};
+
+#endif
@@ -77,31 +77,33 @@ void OriginProjectParser::setImportUnusedObjects(bool importUnusedObjects) {
 
 bool OriginProjectParser::hasUnusedObjects() {
 	m_originFile = new OriginFile((const char*)m_projectFileName.toLocal8Bit());
+	m_originFile->setWindowsToLoad(std::set<std::string>()); //the structure of the project is sufficient here
 	if (!m_originFile->parse()) {
 		delete m_originFile;
 		m_originFile = nullptr;
 		return false;
 	}
 
-	for (unsigned int i = 0; i < m_originFile->spreadCount(); i++) {
+	bool unused = false;
+	for (unsigned int i = 0; i < m_originFile->spreadCount() && !unused; i++) {
 		const Origin::SpreadSheet& spread = m_originFile->spread(i);
 		if (spread.objectID < 0)
-			return true;
+			unused = true;
 	}
-	for (unsigned int i = 0; i < m_originFile->excelCount(); i++) {
+	for (unsigned int i = 0; i < m_originFile->excelCount() && !unused; i++) {
 		const Origin::Excel& excel = m_originFile->excel(i);
 		if (excel.objectID < 0)
-			return true;
+			unused = true;
 	}
-	for (unsigned int i = 0; i < m_originFile->matrixCount(); i++) {
+	for (unsigned int i = 0; i < m_originFile->matrixCount() && !unused; i++) {
 		const Origin::Matrix& originMatrix = m_originFile->matrix(i);
 		if (originMatrix.objectID < 0)
-			return true;
+			unused = true;
 	}
 
 	delete m_originFile;
 	m_originFile = nullptr;
-	return false;
+	return unused;
 }
 
 QString OriginProjectParser::supportedExtensions() {
@@ -169,6 +171,20 @@ bool OriginProjectParser::load(Project* project, bool preview) {
 
 	//read and parse the m_originFile-file
 	m_originFile = new OriginFile((const char*)m_projectFileName.toLocal8Bit());
+
+	//decode the data only for the windows to be imported, the preview only needs the structure of the project
+	if (preview)
+		m_originFile->setWindowsToLoad(std::set<std::string>());
+	else {
+		const QStringList& pathes = project->pathesToLoad();
+		if (!pathes.isEmpty() && !(pathes.size() == 1 && pathes.first() == project->path())) {
+			std::set<std::string> windows;
+			for (const auto& path : pathes)
+				windows.insert(path.mid(path.lastIndexOf(QLatin1Char('/')) + 1).toLatin1().constData());
+			m_originFile->setWindowsToLoad(windows);
+		}
+	}
+
 	if (!m_originFile->parse()) {
 		delete m_originFile;
 		m_originFile = nullptr;
@@ -203,48 +219,35 @@ bool OriginProjectParser::load(Project* project, bool preview) {
 
 	//restore column pointers:
 	//1. extend the pathes to contain the parent structures first
-	//2. restore the pointers from the pathes
-	const QVector<Column*> columns = project->children<Column>(AbstractAspect::ChildIndexFlag::Recursive);
-	const QVector<Spreadsheet*> spreadsheets = project->children<Spreadsheet>(AbstractAspect::ChildIndexFlag::Recursive);
+	//2. restore the pointers from the pathes via the path index of the project
+	QHash<QString, const Spreadsheet*> spreadsheets;
+	for (const auto* spreadsheet : project->children<Spreadsheet>(AbstractAspect::ChildIndexFlag::Recursive)) {
+		if (!spreadsheets.contains(spreadsheet->name()))
+			spreadsheets.insert(spreadsheet->name(), spreadsheet);
+	}
 	for (auto* curve : project->children<XYCurve>(AbstractAspect::ChildIndexFlag::Recursive)) {
 		curve->suppressRetransform(true);
 
 		//x-column
 		QString spreadsheetName = curve->xColumnPath().left(curve->xColumnPath().indexOf(QLatin1Char('/')));
-		for (const auto* spreadsheet : spreadsheets) {
-			if (spreadsheet->name() == spreadsheetName) {
-				const QString& newPath = spreadsheet->parentAspect()->path() + '/' + curve->xColumnPath();
-				curve->setXColumnPath(newPath);
-
-				for (auto* column : columns) {
-					if (!column)
-						continue;
-					if (column->path() == newPath) {
-						curve->setXColumn(column);
-						break;
-					}
-				}
-				break;
-			}
+		const Spreadsheet* spreadsheet = spreadsheets.value(spreadsheetName);
+		if (spreadsheet) {
+			const QString& newPath = spreadsheet->parentAspect()->path() + '/' + curve->xColumnPath();
+			curve->setXColumnPath(newPath);
+			auto* column = dynamic_cast<Column*>(project->aspectByPath(newPath));
+			if (column)
+				curve->setXColumn(column);
 		}
 
-		//x-column
+		//y-column
 		spreadsheetName = curve->yColumnPath().left(curve->yColumnPath().indexOf(QLatin1Char('/')));
-		for (const auto* spreadsheet : spreadsheets) {
-			if (spreadsheet->name() == spreadsheetName) {
-				const QString& newPath = spreadsheet->parentAspect()->path() + '/' + curve->yColumnPath();
-				curve->setYColumnPath(newPath);
-
-				for (auto* column : columns) {
-					if (!column)
-						continue;
-					if (column->path() == newPath) {
-						curve->setYColumn(column);
-						break;
-					}
-				}
-				break;
-			}
+		spreadsheet = spreadsheets.value(spreadsheetName);
+		if (spreadsheet) {
+			const QString& newPath = spreadsheet->parentAspect()->path() + '/' + curve->yColumnPath();
+			curve->setYColumnPath(newPath);
+			auto* column = dynamic_cast<Column*>(project->aspectByPath(newPath));
+			if (column)
+				curve->setYColumn(column);
 		}
 
 		//TODO: error columns
@@ -599,14 +602,10 @@ bool OriginProjectParser::loadSpreadsheet(Spreadsheet* spreadsheet, bool preview
 	DEBUG("loadSpreadsheet() sheetIndex = " << sheetIndex);
 
 	//load spreadsheet data
-	Origin::SpreadSheet spread;
-	Origin::Excel excel;
-	if (sheetIndex == -1)	// spread
-		spread = m_originFile->spread(findSpreadByName(name));
-	else {
-		excel = m_originFile->excel(findExcelByName(name));
-		spread = excel.sheets[sheetIndex];
-	}
+	const Origin::Excel* excel = nullptr;
+	if (sheetIndex != -1)	// excel
+		excel = &m_originFile->excel(findExcelByName(name));
+	const Origin::SpreadSheet& spread = excel ? excel->sheets[sheetIndex] : m_originFile->spread(findSpreadByName(name));
 
 	const size_t cols = spread.columns.size();
 	int rows = 0;
@@ -622,7 +621,7 @@ bool OriginProjectParser::loadSpreadsheet(Spreadsheet* spreadsheet, bool preview
 	if (sheetIndex == -1)
 		spreadsheet->setComment(QString::fromLatin1(spread.label.c_str()));
 	else
-		spreadsheet->setComment(QString::fromLatin1(excel.label.c_str()));
+		spreadsheet->setComment(QString::fromLatin1(excel->label.c_str()));
 
 	//in Origin column width is measured in characters, we need to convert to pixels
 	//TODO: determine the font used in Origin in order to get the same column width as in Origin
@@ -631,7 +630,7 @@ bool OriginProjectParser::loadSpreadsheet(Spreadsheet* spreadsheet, bool preview
 	const int scaling_factor = fm.maxWidth();
 
 	for (size_t j = 0; j < cols; ++j) {
-		Origin::SpreadColumn column = spread.columns[j];
+		const Origin::SpreadColumn& column = spread.columns[j];
 		Column* col = spreadsheet->column((int)j);
 
 		QString name(column.name.c_str());
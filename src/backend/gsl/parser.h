@@ -84,6 +84,19 @@ symrec* assign_variable(const char* symb_name, double value);
 double parse(const char *str);
 double parse_with_vars(const char[], const parser_var[], int nvars);
 
+/* compiled expressions
+ * the expression is translated once into a program that is evaluated for many values of the variables at once.
+ * evaluation does not use the symbol table and is thread-safe.
+ */
+typedef struct parser_program parser_program;
+/* compile expression str with variables varnames[0..nvars-1]. returns NULL if the expression
+ * cannot be compiled (syntax error, unknown symbol, assignment or function without arguments) */
+parser_program* parser_compile(const char* str, const char* const varnames[], int nvars);
+void parser_program_free(parser_program*);
+/* evaluate the program for n points: variable k has the values values[k][i*strides[k]] (stride 0: same value for all points)
+ * returns 0 on success */
+int parser_program_eval(const parser_program*, const double* const values[], const size_t strides[], size_t n, double out[]);
+
 extern struct con _constants[];
 extern struct func _functions[];
 
@@ -261,6 +261,411 @@ double parse_with_vars(const char *str, const parser_var *vars, int nvars) {
 	return parse(str);
 }
 
+/* compiled expressions */
+
+typedef enum {PROG_NUM, PROG_VAR, PROG_ADD, PROG_SUB, PROG_MUL, PROG_DIV, PROG_NEG, PROG_POW, PROG_FNCT} prog_opcode;
+
+typedef struct prog_instr {
+	prog_opcode op;
+	int index;	/* variable index or number of function arguments */
+	double value;	/* value of a number or constant */
+	func_t fnct;	/* function pointer */
+} prog_instr;
+
+struct parser_program {
+	prog_instr *code;
+	int ncode, size;
+	int depth;	/* maximum stack depth */
+};
+
+/* tokens of the compiler (single characters otherwise) */
+#define PROG_TOKEN_END 0
+#define PROG_TOKEN_NUM 256
+#define PROG_TOKEN_VAR 257
+#define PROG_TOKEN_FNCT 258
+#define PROG_TOKEN_ERROR 259
+
+/* precedences of the grammar */
+#define PROG_PREC_ADD 1
+#define PROG_PREC_MUL 2
+#define PROG_PREC_POW 4
+
+typedef struct compiler {
+	param p;
+	const char* const *varnames;
+	int nvars;
+	int token;	/* current token */
+	double value;	/* value of NUM token */
+	int index;	/* variable index of VAR token (-1: constant) */
+	func_t fnct;	/* function of FNCT token */
+	parser_program *prog;
+	int stack;	/* current stack depth */
+	int error;
+} compiler;
+
+/* same lexical rules as yylex(), but without using the symbol table */
+static void compiler_next(compiler *c) {
+	char ch;
+	while ((ch = getcharstr(&c->p)) == ' ' || ch == '\t');
+
+	if (ch == EOF) {
+		c->token = PROG_TOKEN_END;
+		return;
+	}
+	if (!isascii(ch) || ch == '\n') {
+		c->token = PROG_TOKEN_ERROR;
+		return;
+	}
+
+	if (isdigit(ch)) {
+		ungetcstr(&(c->p.pos));
+		char *s = &(c->p.string[c->p.pos]);
+		char *remain;
+#if defined(_WIN32) || defined(__APPLE__)
+		double result = strtod(s, &remain);
+#else
+		locale_t locale = newlocale(LC_NUMERIC_MASK, "C", NULL);
+		double result = strtod_l(s, &remain, locale);
+		freelocale(locale);
+#endif
+		if (remain == s) {
+			c->token = PROG_TOKEN_ERROR;
+			return;
+		}
+		c->p.pos += remain - s;
+		c->value = result;
+		c->token = PROG_TOKEN_NUM;
+		return;
+	}
+
+	if (isalpha(ch) || ch == '.') {
+		size_t start = c->p.pos - 1;
+		do
+			ch = getcharstr(&c->p);
+		while (ch != EOF && (isalnum(ch) || ch == '_' || ch == '.'));
+		if (ch != EOF)
+			ungetcstr(&(c->p.pos));
+		const char *name = &(c->p.string[start]);
+		const size_t len = c->p.pos - start;
+
+		/* variables hide constants and functions, constants hide functions (see putsym()) */
+		int i;
+		for (i = 0; i < c->nvars; i++) {
+			if (strlen(c->varnames[i]) == len && strncmp(c->varnames[i], name, len) == 0) {
+				c->index = i;
+				c->token = PROG_TOKEN_VAR;
+				return;
+			}
+		}
+		for (i = 0; _constants[i].name != 0; i++) {
+			if (strlen(_constants[i].name) == len && strncmp(_constants[i].name, name, len) == 0) {
+				c->value = _constants[i].value;
+				c->token = PROG_TOKEN_NUM;
+				return;
+			}
+		}
+		for (i = 0; _functions[i].name != 0; i++) {
+			if (strlen(_functions[i].name) == len && strncmp(_functions[i].name, name, len) == 0) {
+				c->fnct = _functions[i].fnct;
+				c->token = PROG_TOKEN_FNCT;
+				return;
+			}
+		}
+		pdebug("PARSER: compile: symbol UNKNOWN\n");
+		c->token = PROG_TOKEN_ERROR;
+		return;
+	}
+
+	c->token = ch;
+}
+
+static void compiler_emit(compiler *c, prog_opcode op, int index, double value, func_t fnct) {
+	parser_program *prog = c->prog;
+	if (prog->ncode == prog->size) {
+		prog->size = prog->size ? 2 * prog->size : 16;
+		prog_instr *code = (prog_instr *) realloc(prog->code, prog->size * sizeof(prog_instr));
+		if (code == NULL) {
+			c->error = 1;
+			return;
+		}
+		prog->code = code;
+	}
+
+	prog_instr *instr = &(prog->code[prog->ncode++]);
+	instr->op = op;
+	instr->index = index;
+	instr->value = value;
+	instr->fnct = fnct;
+
+	/* track the stack depth */
+	switch (op) {
+	case PROG_NUM:
+	case PROG_VAR:
+		c->stack++;
+		break;
+	case PROG_ADD:
+	case PROG_SUB:
+	case PROG_MUL:
+	case PROG_DIV:
+	case PROG_POW:
+		c->stack--;
+		break;
+	case PROG_NEG:
+		break;
+	case PROG_FNCT:
+		c->stack += 1 - index;
+	}
+	if (c->stack > prog->depth)
+		prog->depth = c->stack;
+}
+
+static void compiler_expr(compiler *c, int minprec);
+
+static void compiler_primary(compiler *c) {
+	switch (c->token) {
+	case PROG_TOKEN_NUM:
+		compiler_emit(c, PROG_NUM, 0, c->value, 0);
+		compiler_next(c);
+		break;
+	case PROG_TOKEN_VAR:
+		compiler_emit(c, PROG_VAR, c->index, 0, 0);
+		compiler_next(c);
+		break;
+	case PROG_TOKEN_FNCT: {
+		func_t fnct = c->fnct;
+		int nargs = 0;
+		compiler_next(c);
+		if (c->token != '(') {
+			c->error = 1;
+			return;
+		}
+		compiler_next(c);
+		if (c->token != ')') {
+			while (!c->error) {
+				compiler_expr(c, PROG_PREC_ADD);
+				nargs++;
+				if (c->token != ',')
+					break;
+				compiler_next(c);
+			}
+		}
+		/* functions without arguments are random number generators, which are not thread-safe */
+		if (c->token != ')' || nargs == 0 || nargs > 4) {
+			c->error = 1;
+			return;
+		}
+		compiler_emit(c, PROG_FNCT, nargs, 0, fnct);
+		compiler_next(c);
+		break;
+	}
+	case '(':
+		compiler_next(c);
+		compiler_expr(c, PROG_PREC_ADD);
+		if (c->token != ')') {
+			c->error = 1;
+			return;
+		}
+		compiler_next(c);
+		break;
+	default:
+		c->error = 1;
+	}
+}
+
+/* precedence climbing with the precedences and associativities of the grammar above:
+ * '+','-' < '*','/','**' (all left) < unary minus < '^' (right) */
+static void compiler_expr(compiler *c, int minprec) {
+	if (c->token == '-') {
+		compiler_next(c);
+		compiler_expr(c, PROG_PREC_POW);
+		compiler_emit(c, PROG_NEG, 0, 0, 0);
+	} else
+		compiler_primary(c);
+
+	while (!c->error) {
+		prog_opcode op;
+		int prec;
+		switch (c->token) {
+		case '+':
+			op = PROG_ADD;
+			prec = PROG_PREC_ADD;
+			break;
+		case '-':
+			op = PROG_SUB;
+			prec = PROG_PREC_ADD;
+			break;
+		case '*':
+			op = PROG_MUL;
+			prec = PROG_PREC_MUL;
+			break;
+		case '/':
+			op = PROG_DIV;
+			prec = PROG_PREC_MUL;
+			break;
+		case '^':
+			op = PROG_POW;
+			prec = PROG_PREC_POW;
+			break;
+		default:
+			return;
+		}
+		if (prec < minprec)
+			return;
+
+		compiler_next(c);
+		if (op == PROG_MUL && c->token == '*') {	/* "**" */
+			op = PROG_POW;
+			compiler_next(c);
+		}
+
+		/* '^' is right associative */
+		compiler_expr(c, op == PROG_POW && prec == PROG_PREC_POW ? prec : prec + 1);
+		compiler_emit(c, op, 0, 0, 0);
+	}
+}
+
+parser_program* parser_compile(const char *str, const char* const varnames[], int nvars) {
+	pdebug("\nPARSER: parser_compile(\"%s\")\n", str);
+
+	compiler c;
+	c.p.pos = 0;
+	c.p.string = strdup(str);
+	c.prog = (parser_program *) calloc(1, sizeof(parser_program));
+	if (c.p.string == NULL || c.prog == NULL) {
+		free(c.p.string);
+		free(c.prog);
+		return NULL;
+	}
+	c.varnames = varnames;
+	c.nvars = nvars;
+	c.stack = 0;
+	c.error = 0;
+
+	compiler_next(&c);
+	compiler_expr(&c, PROG_PREC_ADD);
+	if (c.token != PROG_TOKEN_END)
+		c.error = 1;
+
+	free(c.p.string);
+	if (c.error) {
+		pdebug("PARSER: parser_compile() failed\n");
+		parser_program_free(c.prog);
+		return NULL;
+	}
+
+	pdebug("PARSER: parser_compile() DONE (%d instructions, stack depth %d)\n", c.prog->ncode, c.prog->depth);
+	return c.prog;
+}
+
+void parser_program_free(parser_program *prog) {
+	if (prog == NULL)
+		return;
+	free(prog->code);
+	free(prog);
+}
+
+/* number of points evaluated together (every instruction runs over a chunk of points) */
+#define PROG_CHUNK 256
+
+int parser_program_eval(const parser_program *prog, const double* const values[], const size_t strides[], size_t n, double out[]) {
+	double *stack = (double *) malloc(prog->depth * PROG_CHUNK * sizeof(double));
+	if (stack == NULL) {
+		printf("ERROR: out of memory for evaluating expression\n");
+		return -1;
+	}
+
+	size_t start, i;
+	for (start = 0; start < n; start += PROG_CHUNK) {
+		const size_t len = (n - start < PROG_CHUNK) ? n - start : PROG_CHUNK;
+		int sp = 0;	/* number of values on the stack */
+
+		int k;
+		for (k = 0; k < prog->ncode; k++) {
+			const prog_instr *instr = &(prog->code[k]);
+			/* top: next free stack slot, a and b: last two values on the stack */
+			double *top = stack + sp * PROG_CHUNK, *a = top - 2 * PROG_CHUNK, *b = top - PROG_CHUNK;
+			switch (instr->op) {
+			case PROG_NUM:
+				for (i = 0; i < len; i++)
+					top[i] = instr->value;
+				sp++;
+				break;
+			case PROG_VAR: {
+				const double *v = values[instr->index];
+				const size_t stride = strides[instr->index];
+				if (stride == 0)
+					for (i = 0; i < len; i++)
+						top[i] = v[0];
+				else
+					for (i = 0; i < len; i++)
+						top[i] = v[(start + i) * stride];
+				sp++;
+				break;
+			}
+			case PROG_ADD:
+				for (i = 0; i < len; i++)
+					a[i] = a[i] + b[i];
+				sp--;
+				break;
+			case PROG_SUB:
+				for (i = 0; i < len; i++)
+					a[i] = a[i] - b[i];
+				sp--;
+				break;
+			case PROG_MUL:
+				for (i = 0; i < len; i++)
+					a[i] = a[i] * b[i];
+				sp--;
+				break;
+			case PROG_DIV:
+				for (i = 0; i < len; i++)
+					a[i] = a[i] / b[i];
+				sp--;
+				break;
+			case PROG_POW:
+				for (i = 0; i < len; i++)
+					a[i] = pow(a[i], b[i]);
+				sp--;
+				break;
+			case PROG_NEG:
+				for (i = 0; i < len; i++)
+					b[i] = -b[i];
+				break;
+			case PROG_FNCT: {
+				/* the arguments are the last values on the stack, the result replaces the first one */
+				double *arg = top - instr->index * PROG_CHUNK;
+				switch (instr->index) {
+				case 1:
+					for (i = 0; i < len; i++)
+						arg[i] = (*((func_t1)instr->fnct))(arg[i]);
+					break;
+				case 2:
+					for (i = 0; i < len; i++)
+						arg[i] = (*((func_t2)instr->fnct))(arg[i], arg[i + PROG_CHUNK]);
+					break;
+				case 3:
+					for (i = 0; i < len; i++)
+						arg[i] = (*((func_t3)instr->fnct))(arg[i], arg[i + PROG_CHUNK], arg[i + 2*PROG_CHUNK]);
+					break;
+				case 4:
+					for (i = 0; i < len; i++)
+						arg[i] = (*((func_t4)instr->fnct))(arg[i], arg[i + PROG_CHUNK], arg[i + 2*PROG_CHUNK], arg[i + 3*PROG_CHUNK]);
+					break;
+				}
+				sp -= instr->index - 1;
+				break;
+			}
+			}
+		}
+
+		for (i = 0; i < len; i++)
+			out[start + i] = stack[i];
+	}
+
+	free(stack);
+	return 0;
+}
+
 int yylex(param *p) {
 	pdebug("PARSER: yylex()\n");
 	char c;
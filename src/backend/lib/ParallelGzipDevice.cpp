@@ -0,0 +1,205 @@
+/***************************************************************************
+    File                 : ParallelGzipDevice.cpp
+    Project              : LabPlot
+    Description          : Write-only device compressing the data in parallel into a gzip file
+    --------------------------------------------------------------------
+    Copyright            : (C) 2020 LabPlot developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "backend/lib/ParallelGzipDevice.h"
+
+#include <QThread>
+#include <QtConcurrentRun>
+
+#include <zlib.h>
+
+#include <cstring>
+
+/**
+ * \class ParallelGzipDevice
+ * \brief Write-only device writing the data into a gzip compressed file.
+ *
+ * The data is split into chunks that are compressed independently of each other in worker threads.
+ * Every chunk is terminated with a sync flush, the compressed chunks are written to the file in the
+ * order of the data. This results in one regular gzip stream that can be read with every gzip
+ * implementation. Compared to the compression in one stream the compression ratio is slightly worse,
+ * since the chunks don't share the dictionary.
+ */
+
+namespace {
+ParallelGzipDevice::Block compress(const QByteArray& data, bool last) {
+	ParallelGzipDevice::Block block;
+	block.crc = crc32(0L, reinterpret_cast<const Bytef*>(data.constData()), static_cast<uInt>(data.size()));
+	block.size = data.size();
+	block.ok = false;
+
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	//raw deflate, the gzip header and trailer are written by the device
+	if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return block;
+
+	//deflateBound() doesn't account for the empty block of the sync flush
+	block.data.resize(static_cast<int>(deflateBound(&stream, static_cast<uLong>(data.size()))) + 64);
+	stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+	stream.avail_in = static_cast<uInt>(data.size());
+	stream.next_out = reinterpret_cast<Bytef*>(block.data.data());
+	stream.avail_out = static_cast<uInt>(block.data.size());
+
+	const int rc = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+	block.ok = last ? (rc == Z_STREAM_END) : (rc == Z_OK && stream.avail_in == 0 && stream.avail_out > 0);
+	block.data.resize(static_cast<int>(stream.total_out));
+	deflateEnd(&stream);
+
+	return block;
+}
+}
+
+ParallelGzipDevice::ParallelGzipDevice(const QString& fileName) : m_file(fileName) {
+}
+
+ParallelGzipDevice::~ParallelGzipDevice() {
+	if (isOpen())
+		close();
+}
+
+bool ParallelGzipDevice::open(OpenMode mode) {
+	if ((mode & ReadOnly) || !m_file.open(WriteOnly)) {
+		setErrorString(m_file.errorString());
+		return false;
+	}
+
+	m_chunk.clear();
+	m_blocks.clear();
+	m_crc = crc32(0L, Z_NULL, 0);
+	m_size = 0;
+	m_failed = false;
+
+	//gzip header: magic, deflate, no flags, no modification time, no extra flags, unix
+	static const char header[10] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, 3};
+	if (m_file.write(header, sizeof(header)) != sizeof(header)) {
+		setErrorString(m_file.errorString());
+		m_file.close();
+		return false;
+	}
+
+	return QIODevice::open(mode);
+}
+
+void ParallelGzipDevice::close() {
+	if (!isOpen())
+		return;
+
+	//compress the remaining data as the final block and write all outstanding blocks
+	compressChunk(true);
+	while (!m_blocks.isEmpty())
+		writeBlock();
+
+	//gzip trailer: CRC-32 and size of the uncompressed data, little endian
+	char trailer[8];
+	for (int i = 0; i < 4; ++i) {
+		trailer[i] = static_cast<char>((m_crc >> (8*i)) & 0xff);
+		trailer[4 + i] = static_cast<char>((static_cast<quint64>(m_size) >> (8*i)) & 0xff);
+	}
+	if (!m_failed && (m_file.write(trailer, sizeof(trailer)) != sizeof(trailer) || !m_file.flush())) {
+		setErrorString(m_file.errorString());
+		m_failed = true;
+	}
+
+	m_file.close();
+	QIODevice::close();
+}
+
+bool ParallelGzipDevice::isSequential() const {
+	return true;
+}
+
+/*!
+ * returns \c true if writing or compressing the data failed, the error is available via errorString().
+ * The file is incomplete in this case. Check it after close(), the last blocks are written there.
+ */
+bool ParallelGzipDevice::failed() const {
+	return m_failed;
+}
+
+qint64 ParallelGzipDevice::readData(char*, qint64) {
+	return -1;
+}
+
+qint64 ParallelGzipDevice::writeData(const char* data, qint64 len) {
+	if (m_failed)
+		return -1;
+
+	const int maxBlocks = 2 * qMax(QThread::idealThreadCount(), 1);
+	qint64 written = 0;
+	while (written < len) {
+		const int size = static_cast<int>(qMin(static_cast<qint64>(CHUNK_SIZE - m_chunk.size()), len - written));
+		m_chunk.append(data + written, size);
+		written += size;
+		if (m_chunk.size() < CHUNK_SIZE)
+			break;
+
+		compressChunk(false);
+
+		//limit the number of blocks in memory, write the oldest one if too many are pending
+		while (m_blocks.size() > maxBlocks || (!m_blocks.isEmpty() && m_blocks.head().isFinished()))
+			if (!writeBlock())
+				return -1;
+	}
+
+	return len;
+}
+
+/*!
+ * hands over the collected data to a worker thread for compression.
+ */
+void ParallelGzipDevice::compressChunk(bool last) {
+	const QByteArray chunk = m_chunk;
+	m_chunk = QByteArray();
+	m_chunk.reserve(CHUNK_SIZE);
+	m_blocks.enqueue(QtConcurrent::run([chunk, last]() { return compress(chunk, last); }));
+}
+
+/*!
+ * waits for the oldest pending block to be compressed and writes it to the file.
+ */
+bool ParallelGzipDevice::writeBlock() {
+	const Block block = m_blocks.dequeue().result();
+	if (m_failed)
+		return false;
+
+	if (!block.ok) {
+		setErrorString(QLatin1String("compression failed"));
+		m_failed = true;
+		return false;
+	}
+
+	if (m_file.write(block.data) != block.data.size()) {
+		setErrorString(m_file.errorString());
+		m_failed = true;
+		return false;
+	}
+
+	m_crc = crc32_combine(m_crc, block.crc, block.size);
+	m_size += block.size;
+	return true;
+}
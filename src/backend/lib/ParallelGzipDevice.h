@@ -0,0 +1,70 @@
+/***************************************************************************
+    File                 : ParallelGzipDevice.h
+    Project              : LabPlot
+    Description          : Write-only device compressing the data in parallel into a gzip file
+    --------------------------------------------------------------------
+    Copyright            : (C) 2020 LabPlot developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PARALLELGZIPDEVICE_H
+#define PARALLELGZIPDEVICE_H
+
+#include <QFile>
+#include <QFuture>
+#include <QQueue>
+
+class ParallelGzipDevice : public QIODevice {
+public:
+	explicit ParallelGzipDevice(const QString& fileName);
+	~ParallelGzipDevice() override;
+
+	bool open(OpenMode) override;
+	void close() override;
+	bool isSequential() const override;
+	bool failed() const;
+
+	static const int CHUNK_SIZE = 1024*1024;	// size of the uncompressed data compressed in one block
+
+	struct Block {
+		QByteArray data;	// compressed data
+		quint32 crc;	// CRC-32 of the uncompressed data
+		qint64 size;	// size of the uncompressed data
+		bool ok;
+	};
+
+protected:
+	qint64 readData(char*, qint64) override;
+	qint64 writeData(const char*, qint64) override;
+
+private:
+	void compressChunk(bool last);
+	bool writeBlock();
+
+	QFile m_file;
+	QByteArray m_chunk;	// uncompressed data not yet handed over to the compression
+	QQueue<QFuture<Block>> m_blocks;	// blocks being compressed, in the order of the data
+	quint32 m_crc{0};
+	qint64 m_size{0};
+	bool m_failed{false};
+};
+
+#endif // PARALLELGZIPDEVICE_H
@@ -128,3 +128,29 @@ int XmlStreamReader::readAttributeInt(const QString& name, bool* ok) {
 
 	return str.toInt(ok);
 }
+
+/*!
+ * sets the directory containing the files with the data referenced in the document
+ * (the column data of projects saved with ProjectContainer).
+ */
+void XmlStreamReader::setDataDirectory(const QString& path) {
+	m_dataDirectory = path;
+}
+
+const QString& XmlStreamReader::dataDirectory() const {
+	return m_dataDirectory;
+}
+
+/*!
+ * reports that the data referenced in the document and read in a worker thread is invalid.
+ * Can be called from several threads at the same time, the document is not changed.
+ */
+void XmlStreamReader::raiseDataError(const QString& message) {
+	QMutexLocker locker(&m_dataErrorsMutex);
+	m_dataErrors.append(message);
+}
+
+QStringList XmlStreamReader::dataErrorStrings() const {
+	QMutexLocker locker(&m_dataErrorsMutex);
+	return m_dataErrors;
+}
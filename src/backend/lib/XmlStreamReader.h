@@ -29,9 +29,10 @@
 #ifndef XML_STREAM_READER_H
 #define XML_STREAM_READER_H
 
+#include <QMutex>
+#include <QString>
 #include <QXmlStreamReader>
 
-class QString;
 class QStringList;
 
 class XmlStreamReader : public QXmlStreamReader {
@@ -51,8 +52,16 @@ public:
 	bool skipToEndElement();
 	int readAttributeInt(const QString& name, bool* ok);
 
+	void setDataDirectory(const QString&);
+	const QString& dataDirectory() const;
+	void raiseDataError(const QString&);
+	QStringList dataErrorStrings() const;
+
 private:
 	QStringList m_warnings;
+	QString m_dataDirectory;
+	QStringList m_dataErrors;
+	mutable QMutex m_dataErrorsMutex;	// the data errors are raised in worker threads
 	void init();
 };
 
@@ -454,16 +454,13 @@ else \
 	d->var = str;
 
 //used in Project::load()
+//restores the column pointer from the saved path, to be used in Project where the aspects are looked up via aspectByPath()
 #define RESTORE_COLUMN_POINTER(obj, col, Col) 										\
 do {																				\
 if (!obj->col ##Path().isEmpty()) {													\
-	for (Column* column : columns) {												\
-		if (!column) continue;														\
-		if (column->path() == obj->col ##Path()) {									\
- 			obj->set## Col(column);													\
-			break;				 													\
-		}																			\
-	}																				\
+	auto* column = dynamic_cast<Column*>(aspectByPath(obj->col ##Path()));		\
+	if (column)																		\
+		obj->set## Col(column);														\
 }																					\
 } while(0)
 
@@ -484,17 +481,12 @@ do {																				\
 	d->name ##Path = str;															\
 } while(0)
 
-#define RESTORE_POINTER(obj, name, Name, Type, list) 								\
+#define RESTORE_POINTER(obj, name, Name, Type) 										\
 do {																				\
 if (!obj->name ##Path().isEmpty()) {												\
-	for (AbstractAspect* aspect : list) {											\
-		if (aspect->path() == obj->name ##Path()) {									\
-			auto a = dynamic_cast<Type*>(aspect);									\
-			if (!a) continue;														\
- 			obj->set## Name(a);														\
-			break;				 													\
-		}																			\
-	}																				\
+	auto a = dynamic_cast<Type*>(aspectByPath(obj->name ##Path()));				\
+	if (a)																			\
+		obj->set## Name(a);															\
 }																					\
 } while(0)
 
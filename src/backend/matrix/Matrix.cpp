@@ -155,6 +155,8 @@ bool Matrix::exportView() const {
 		} else if (dlg->format() == ExportSpreadsheetDialog::Format::FITS) {
 			const int exportTo = dlg->exportToFits();
 			m_view->exportToFits(path, exportTo );
+		} else if (dlg->format() == ExportSpreadsheetDialog::Format::HDF5) {
+			m_view->exportToHDF5(path, dlg->appendToFile());
 		} else {
 			const QString separator = dlg->separator();
 			const QLocale::Language format = dlg->numberFormat();
@@ -1355,9 +1357,12 @@ int Matrix::prepareImport(std::vector<void*>& dataContainer, AbstractFileFilter:
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
+		// the filters provide milliseconds since epoch (like for columns), converted in finalizeImport()
+		d->importDateTimes.resize(actualCols);
 		for (int n = 0; n < actualCols; n++) {
-			QVector<QDateTime>* vector = &(static_cast<QVector<QVector<QDateTime>>*>(data())->operator[](n));
-			vector->resize(actualRows);
+			static_cast<QVector<QVector<QDateTime>>*>(data())->operator[](n).resize(actualRows);
+			QVector<qint64>* vector = &d->importDateTimes[n];
+			vector->fill(AbstractColumn::invalidDateTime, actualRows);
 			dataContainer[n] = static_cast<void*>(vector);
 		}
 		d->mode = AbstractColumn::ColumnMode::DateTime;
@@ -1375,6 +1380,17 @@ void Matrix::finalizeImport(int columnOffset, int startColumn, int endColumn, co
 	Q_UNUSED(dateTimeFormat);
 	Q_UNUSED(importMode);
 
+	if (!d->importDateTimes.isEmpty()) {
+		auto* matrixData = static_cast<QVector<QVector<QDateTime>>*>(data());
+		for (int n = 0; n < d->importDateTimes.size(); n++) {
+			const QVector<qint64>& values = d->importDateTimes.at(n);
+			QVector<QDateTime>& column = matrixData->operator[](n);
+			for (int i = 0; i < values.size(); i++)
+				column[i] = AbstractColumn::dateTimeFromMSecs(values.at(i));
+		}
+		d->importDateTimes.clear();
+	}
+
 	setSuppressDataChangedSignal(false);
 	setChanged();
 	setUndoAware(true);
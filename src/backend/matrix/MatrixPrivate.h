@@ -150,6 +150,7 @@ public:
 	double yStart, yEnd;
 	QString formula;			//!<formula used to calculate the cells
 	bool suppressDataChange;
+	QVector<QVector<qint64>> importDateTimes;	//!< date-time values (ms since epoch) filled by the import filters
 };
 
 #endif
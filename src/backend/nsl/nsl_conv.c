@@ -28,16 +28,14 @@
 
 #include "nsl_conv.h"
 #include "nsl_common.h"
+#include "nsl_dft.h"
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
-#include <gsl/gsl_fft_halfcomplex.h>
-#ifdef HAVE_FFTW3
-#include <fftw3.h>
-#endif
 #include "backend/nsl/nsl_stats.h"
 
 const char* nsl_conv_direction_name[] = {i18n("forward (convolution)"), i18n("backward (deconvolution)")};
 const char* nsl_conv_type_name[] = {i18n("linear (zero-padded)"), i18n("circular")};
-const char* nsl_conv_method_name[] = {i18n("auto"), i18n("direct"), i18n("FFT")};
+const char* nsl_conv_method_name[] = {i18n("auto"), i18n("direct"), i18n("FFT"), i18n("FFT (overlap-add)")};
 const char* nsl_conv_norm_name[] = {i18n("none"), i18n("sum"), i18n("Euclidean")};
 const char* nsl_conv_wrap_name[] = {i18n("none"), i18n("maximum"), i18n("center (acausal)")};
 const char* nsl_conv_kernel_name[] = {i18n("sliding average"), i18n("triangular smooth"), i18n("pseudo-Gaussian smooth"), i18n("first derivative"), i18n("smooth first derivative"),
@@ -145,16 +143,67 @@ int nsl_conv_convolution_direction(double s[], size_t n, double r[], size_t m, n
 }
 
 int nsl_conv_convolution(double s[], size_t n, double r[], size_t m, nsl_conv_type_type type, nsl_conv_method_type method, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]) {
-	if (method == nsl_conv_method_direct || (method == nsl_conv_method_auto && GSL_MAX_INT(n, m) <= NSL_CONV_METHOD_BORDER)) {
+	if (method == nsl_conv_method_auto)
+		method = nsl_conv_auto_method(n, m, type);
+
+	switch (method) {
+	case nsl_conv_method_direct:
 		if (type == nsl_conv_type_linear)
 			return nsl_conv_linear_direct(s, n, r, m, normalize, wrap, out);
-		else if (type == nsl_conv_type_circular)
+		else
 			return nsl_conv_circular_direct(s, n, r, m, normalize, wrap, out);
-	} else {
-		return nsl_conv_fft_type(s, n, r, m, nsl_conv_direction_forward, type, normalize, wrap, out);
+	case nsl_conv_method_fft_overlap_add:
+		return nsl_conv_fft_overlap_add(s, n, r, m, type, normalize, wrap, out);
+	case nsl_conv_method_auto:
+	case nsl_conv_method_fft:
+		break;
 	}
 
-	return 0;
+	return nsl_conv_fft_type(s, n, r, m, nsl_conv_direction_forward, type, normalize, wrap, out);
+}
+
+/* relative cost of a real FFT of size N compared to a multiply-add of the direct method */
+#define NSL_CONV_FFT_COST 2.5
+
+/* FFT block size (power of two) for overlap-add with the smallest total cost */
+static size_t nsl_conv_overlap_add_blocksize(size_t n, size_t m, double *cost) {
+	size_t B = 2;
+	while (B < 2*m)
+		B *= 2;
+
+	size_t best = B;
+	double bestcost = DBL_MAX;
+	for (; B <= 4*(n + m); B *= 2) {
+		const size_t blocks = (n + B - m)/(B - m + 1);
+		/* transform of the response, forward and back transform and complex multiplication per block */
+		const double c = NSL_CONV_FFT_COST*B*log2((double)B) * (1. + 2.*blocks) + 2.*B*blocks;
+		if (c < bestcost) {
+			bestcost = c;
+			best = B;
+		}
+	}
+
+	if (cost)
+		*cost = bestcost;
+	return best;
+}
+
+nsl_conv_method_type nsl_conv_auto_method(size_t n, size_t m, nsl_conv_type_type type) {
+	const size_t size = (type == nsl_conv_type_linear) ? n + m - 1 : GSL_MAX(n, m);
+
+	/* direct: every signal point is multiplied with every response point */
+	const double direct = (double)n * (double)m;
+	/* FFT: forward transform of signal and response, back transform and complex multiplication */
+	const double fft = 3.*NSL_CONV_FFT_COST*size*log2((double)GSL_MAX(size, 2)) + 2.*size;
+	/* overlap-add: transforms of blocks of the signal */
+	double ola;
+	nsl_conv_overlap_add_blocksize(n, m, &ola);
+
+	if (direct <= fft && direct <= ola)
+		return nsl_conv_method_direct;
+	if (ola < fft)
+		return nsl_conv_method_fft_overlap_add;
+	return nsl_conv_method_fft;
 }
 
 int nsl_conv_deconvolution(double s[], size_t n, double r[], size_t m, nsl_conv_type_type type, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]) {
@@ -162,8 +211,10 @@ int nsl_conv_deconvolution(double s[], size_t n, double r[], size_t m, nsl_conv_
 	return nsl_conv_fft_type(s, n, r, m, nsl_conv_direction_backward, type, normalize, wrap, out);
 }
 
-int nsl_conv_linear_direct(double s[], size_t n, double r[], size_t m, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]) {
-	size_t i, j, size = n + m - 1, wi = 0;
+/* normalized response in reversed order, so that every output point of the direct methods
+ * is a dot product of contiguous arrays (vectorizable) */
+static double* nsl_conv_reversed_response(double r[], size_t m, nsl_conv_norm_type normalize) {
+	size_t i;
 	double norm = 1;
 	if (normalize == nsl_conv_norm_euclidean) {
 		if ((norm = cblas_dnrm2((int)m, r, 1)) == 0)
@@ -173,30 +224,143 @@ int nsl_conv_linear_direct(double s[], size_t n, double r[], size_t m, nsl_conv_
 			norm = 1.;
 	}
 
+	double* rrev = (double*)malloc(m * sizeof(double));
+	if (rrev == NULL)
+		return NULL;
+	for (i = 0; i < m; i++)
+		rrev[m - 1 - i] = r[i]/norm;
+
+	return rrev;
+}
+
+static double nsl_conv_dot(const double* a, const double* b, size_t n) {
+	size_t i;
+	double res = 0;
+	for (i = 0; i < n; i++)
+		res += a[i] * b[i];
+	return res;
+}
+
+static size_t nsl_conv_wrap_index(double r[], size_t m, nsl_conv_wrap_type wrap) {
+	size_t wi = 0;
 	if (wrap == nsl_conv_wrap_max)
 		nsl_stats_maximum(r, m, &wi);
 	else if (wrap == nsl_conv_wrap_center)
 		wi = m/2;
+	return wi;
+}
+
+int nsl_conv_linear_direct(double s[], size_t n, double r[], size_t m, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]) {
+	size_t j, size = n + m - 1;
+	const size_t wi = nsl_conv_wrap_index(r, m, wrap);
+	double* rrev = nsl_conv_reversed_response(r, m, normalize);
+	if (rrev == NULL) {
+		printf("nsl_conv_linear_direct(): ERROR allocating memory for 'rrev'!\n");
+		return -1;
+	}
 
 	for (j = 0; j < size; j++) {
-		int index;	// can be negative
-		double res = 0;
-		for (i = 0; i < n; i++) {
-			index = (int)(j - i);
-			if (index >= 0 && index < (int)m)
-				res += s[i] * r[index]/norm;
-		}
-		index = (int)(j - wi);
+		/* out[j] = sum_i s[i]*r[j-i] for all i with 0 <= j-i < m */
+		const size_t imin = (j + 1 > m) ? j + 1 - m : 0;
+		const size_t imax = GSL_MIN(j, n - 1);
+		const double res = nsl_conv_dot(s + imin, rrev + (m - 1 - j + imin), imax - imin + 1);
+
+		int index = (int)(j - wi);	// can be negative
 		if (index < 0)
 			index += (int)size;
 		out[index] = res;
 	}
 
+	free(rrev);
 	return 0;
 }
 
 int nsl_conv_circular_direct(double s[], size_t n, double r[], size_t m, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]) {
-	size_t i, j, size = GSL_MAX(n,m), wi = 0;
+	size_t i, j, size = GSL_MAX(n,m);
+	const size_t wi = nsl_conv_wrap_index(r, m, wrap);
+	double* rrev = nsl_conv_reversed_response(r, m, normalize);
+	/* zero-padded signal with the periodic continuation of its last m-1 values in front */
+	double* sp = (double*)malloc((size + m - 1) * sizeof(double));
+	if (rrev == NULL || sp == NULL) {
+		printf("nsl_conv_circular_direct(): ERROR allocating memory!\n");
+		free(rrev);
+		free(sp);
+		return -1;
+	}
+	for (i = 0; i < size + m - 1; i++) {
+		const size_t index = (i + size - (m - 1) % size) % size;
+		sp[i] = index < n ? s[index] : 0.;
+	}
+
+	for (j = 0; j < size; j++) {
+		/* out[j] = sum_k r[k]*s[(j-k) mod size] */
+		const double res = nsl_conv_dot(sp + j, rrev, m);
+
+		int index = (int)(j - wi);	// can be negative
+		if (index < 0)
+			index += (int)size;
+		out[index] = res;
+	}
+
+	free(rrev);
+	free(sp);
+	return 0;
+}
+
+/* forward transform of a block of size B in place (FFTW: re0,im0,re1,im1,... needs B+2 values, GSL: halfcomplex) */
+static int nsl_conv_block_forward(double x[], size_t B) {
+#ifdef HAVE_FFTW3
+	return nsl_dft_fft_r2c_FFTW(x, x, B);
+#else
+	return nsl_dft_fft_real_GSL(x, 1, B);
+#endif
+}
+
+/* normalized back transform of a block of size B in place */
+static int nsl_conv_block_backward(double x[], size_t B) {
+#ifdef HAVE_FFTW3
+	size_t i;
+	int status = nsl_dft_fft_c2r_FFTW(x, x, B);
+	for (i = 0; i < B; i++)
+		x[i] /= B;
+	return status;
+#else
+	return nsl_dft_fft_halfcomplex_inverse_GSL(x, 1, B);
+#endif
+}
+
+/* x *= y for transformed blocks of size B */
+static void nsl_conv_block_multiply(double x[], const double y[], size_t B) {
+	size_t i;
+#ifdef HAVE_FFTW3
+	for (i = 0; i < B + 2; i += 2) {
+		const double re = x[i]*y[i] - x[i+1]*y[i+1];
+		const double im = x[i]*y[i+1] + x[i+1]*y[i];
+		x[i] = re;
+		x[i+1] = im;
+	}
+#else	/* halfcomplex */
+	x[0] *= y[0];
+	for (i = 1; i < B; i += 2) {
+		if (i == B - 1) {	/* B is even: last value is real */
+			x[i] *= y[i];
+			break;
+		}
+		const double re = x[i]*y[i] - x[i+1]*y[i+1];
+		const double im = x[i]*y[i+1] + x[i+1]*y[i];
+		x[i] = re;
+		x[i+1] = im;
+	}
+#endif
+}
+
+int nsl_conv_fft_overlap_add(double s[], size_t n, double r[], size_t m, nsl_conv_type_type type, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]) {
+	size_t i, start;
+	const size_t size = (type == nsl_conv_type_linear) ? n + m - 1 : GSL_MAX(n, m);
+	const size_t wi = nsl_conv_wrap_index(r, m, wrap);
+	const size_t B = nsl_conv_overlap_add_blocksize(n, m, NULL);
+	const size_t L = B - m + 1;	/* signal points per block */
+
 	double norm = 1;
 	if (normalize == nsl_conv_norm_euclidean) {
 		if ((norm = cblas_dnrm2((int)m, r, 1)) == 0)
@@ -206,28 +370,48 @@ int nsl_conv_circular_direct(double s[], size_t n, double r[], size_t m, nsl_con
 			norm = 1.;
 	}
 
-	if (wrap == nsl_conv_wrap_max)
-		nsl_stats_maximum(r, m, &wi);
-	else if (wrap == nsl_conv_wrap_center)
-		wi = m/2;
+	double* rblock = (double*)malloc((B + 2) * sizeof(double));
+	double* block = (double*)malloc((B + 2) * sizeof(double));
+	if (rblock == NULL || block == NULL) {
+		printf("nsl_conv_fft_overlap_add(): ERROR allocating memory!\n");
+		free(rblock);
+		free(block);
+		return -1;
+	}
 
-	for (j = 0; j < size; j++) {
-		int index;	// can be negative
-		double res = 0;
-		for (i = 0; i < n; i++) {
-			index = (int)(j - i);
-			if (index < 0)
-				index += (int)size;
-			if (index < (int)m)
-				res += s[i]*r[index]/norm;
+	/* transformed response */
+	for (i = 0; i < m; i++)
+		rblock[i] = r[i]/norm;
+	for (i = m; i < B + 2; i++)
+		rblock[i] = 0;
+	int status = nsl_conv_block_forward(rblock, B);
+
+	for (i = 0; i < size; i++)
+		out[i] = 0;
+
+	for (start = 0; start < n && status == 0; start += L) {
+		const size_t len = GSL_MIN(L, n - start);
+		for (i = 0; i < len; i++)
+			block[i] = s[start + i];
+		for (i = len; i < B + 2; i++)
+			block[i] = 0;
+
+		status = nsl_conv_block_forward(block, B);
+		nsl_conv_block_multiply(block, rblock, B);
+		status |= nsl_conv_block_backward(block, B);
+
+		/* add the linear convolution of this block (circular: wrapped), shifted by the wrap index */
+		const size_t nblock = len + m - 1;
+		for (i = 0; i < nblock; i++) {
+			const size_t index = ((start + i) % size + size - wi % size) % size;
+			out[index] += block[i];
 		}
-		index = (int)(j - wi);
-		if (index < 0)
-			index += (int)size;
-		out[index] = res;
 	}
 
-	return 0;
+	free(rblock);
+	free(block);
+
+	return status;
 }
 
 int nsl_conv_fft_type(double s[], size_t n, double r[], size_t m, nsl_conv_direction_type dir, nsl_conv_type_type type, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]) {
@@ -303,13 +487,10 @@ int nsl_conv_fft_type(double s[], size_t n, double r[], size_t m, nsl_conv_direc
 int nsl_conv_fft_FFTW(double s[], double r[], size_t n, nsl_conv_direction_type dir, size_t wi, double out[]) {
 	size_t i;
 	const size_t size = 2*(n/2+1);
-	double* in = (double*)malloc(size*sizeof(double));
-	fftw_plan rpf = fftw_plan_dft_r2c_1d(n, in, (fftw_complex*)in, FFTW_ESTIMATE);
 
-	fftw_execute_dft_r2c(rpf, s, (fftw_complex*)s);
-	fftw_execute_dft_r2c(rpf, r, (fftw_complex*)r);
-	fftw_destroy_plan(rpf);
-	free(in);
+	// in place transforms using cached plans
+	if (nsl_dft_fft_r2c_FFTW(s, s, n) != 0 || nsl_dft_fft_r2c_FFTW(r, r, n) != 0)
+		return -1;
 
 	// multiply/divide
 	if (dir == nsl_conv_direction_forward) {
@@ -334,30 +515,22 @@ int nsl_conv_fft_FFTW(double s[], double r[], size_t n, nsl_conv_direction_type
 	}
 
 	// back transform
-	double* o = (double*)malloc(size*sizeof(double));
-	fftw_plan rpb = fftw_plan_dft_c2r_1d(n, (fftw_complex*)o, o, FFTW_ESTIMATE);
-
-	fftw_execute_dft_c2r(rpb, (fftw_complex*)s, s);
-	fftw_destroy_plan(rpb);
+	if (nsl_dft_fft_c2r_FFTW(s, s, n) != 0)
+		return -1;
 
 	for (i = 0; i < n; i++) {
 		size_t index = (i + wi) % n;
 		out[i] = s[index]/n;
 	}
-	free(o);
 
 	return 0;
 }
 #endif
 
 int nsl_conv_fft_GSL(double s[], double r[], size_t n, nsl_conv_direction_type dir, double out[]) {
-	gsl_fft_real_workspace *work = gsl_fft_real_workspace_alloc(n);
-	gsl_fft_real_wavetable *real = gsl_fft_real_wavetable_alloc(n);
-
 	/* FFT s and r */
-	gsl_fft_real_transform(s, 1, n, real, work);
-	gsl_fft_real_transform(r, 1, n, real, work);
-	gsl_fft_real_wavetable_free(real);
+	if (nsl_dft_fft_real_GSL(s, 1, n) != 0 || nsl_dft_fft_real_GSL(r, 1, n) != 0)
+		return -1;
 
 	size_t i;
 	/* calculate halfcomplex product/quotient depending on direction */
@@ -393,11 +566,6 @@ int nsl_conv_fft_GSL(double s[], double r[], size_t n, nsl_conv_direction_type d
 	}
 
 	/* back transform */
-	gsl_fft_halfcomplex_wavetable *hc = gsl_fft_halfcomplex_wavetable_alloc(n);
-	gsl_fft_halfcomplex_inverse(out, 1, n, hc, work);
-	gsl_fft_halfcomplex_wavetable_free(hc);
-	gsl_fft_real_workspace_free(work);
-
-	return 0;
+	return nsl_dft_fft_halfcomplex_inverse_GSL(out, 1, n);
 }
 
@@ -31,10 +31,6 @@
 
 #include <stdlib.h>
 
-/* when to switch from direct to FFT method */
-/* set to zero to use FFT method for any length */
-#define NSL_CONV_METHOD_BORDER 100
-
 #define NSL_CONV_DIRECTION_COUNT 2
 /* forward: convolution, backward: deconvolution */
 typedef enum {nsl_conv_direction_forward, nsl_conv_direction_backward} nsl_conv_direction_type;
@@ -45,9 +41,11 @@ extern const char* nsl_conv_direction_name[];
 typedef enum {nsl_conv_type_linear, nsl_conv_type_circular} nsl_conv_type_type;
 extern const char* nsl_conv_type_name[];
 
-#define NSL_CONV_METHOD_COUNT 3
-/* auto: use direct method for small data size (NSL_CONV_METHOD_BORDER) and FFT method otherwise */
-typedef enum {nsl_conv_method_auto, nsl_conv_method_direct, nsl_conv_method_fft} nsl_conv_method_type;
+#define NSL_CONV_METHOD_COUNT 4
+/* auto: use the method with the smallest estimated cost (see nsl_conv_auto_method())
+ * fft_overlap_add: FFT of blocks of the signal, for long signals and short responses
+ */
+typedef enum {nsl_conv_method_auto, nsl_conv_method_direct, nsl_conv_method_fft, nsl_conv_method_fft_overlap_add} nsl_conv_method_type;
 extern const char* nsl_conv_method_name[];
 
 #define NSL_CONV_NORM_COUNT 3
@@ -79,6 +77,10 @@ int nsl_conv_standard_kernel(double k[], size_t n, nsl_conv_kernel_type);
 int nsl_conv_convolution_direction(double s[], size_t n, double r[], size_t m, nsl_conv_direction_type, nsl_conv_type_type, nsl_conv_method_type, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]);
 
 int nsl_conv_convolution(double s[], size_t n, double r[], size_t m, nsl_conv_type_type, nsl_conv_method_type, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]);
+/* method with the smallest estimated number of operations for convolving a signal of size n with a response of size m
+ * direct: n*m, FFT: ~ N log N of the zero-padded size, overlap-add: ~ (blocks) * B log B for the best block size B
+ */
+nsl_conv_method_type nsl_conv_auto_method(size_t n, size_t m, nsl_conv_type_type);
 /* deconvolution only supported by FFT method */
 int nsl_conv_deconvolution(double s[], size_t n, double r[], size_t m, nsl_conv_type_type, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]);
 
@@ -87,6 +89,11 @@ int nsl_conv_deconvolution(double s[], size_t n, double r[], size_t m, nsl_conv_
  */
 int nsl_conv_linear_direct(double s[], size_t n, double r[], size_t m, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]);
 int nsl_conv_circular_direct(double s[], size_t n, double r[], size_t m, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]);
+/* linear/circular convolution using overlap-add FFT method
+ * the signal is processed in blocks, so the memory needed is independent of n
+ * s and r are untouched
+ */
+int nsl_conv_fft_overlap_add(double s[], size_t n, double r[], size_t m, nsl_conv_type_type, nsl_conv_norm_type normalize, nsl_conv_wrap_type wrap, double out[]);
 /* linear/circular convolution/deconvolution using FFT method
  * s and r are untouched
  */
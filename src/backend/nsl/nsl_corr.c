@@ -28,11 +28,9 @@
 
 #include "nsl_corr.h"
 #include "nsl_common.h"
+#include "nsl_dft.h"
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
-#include <gsl/gsl_fft_halfcomplex.h>
-#ifdef HAVE_FFTW3
-#include <fftw3.h>
-#endif
 
 const char* nsl_corr_type_name[] = {i18n("linear (zero-padded)"), i18n("circular")};
 const char* nsl_corr_norm_name[] = {i18n("none"), i18n("biased"), i18n("unbiased"), i18n("coeff")};
@@ -141,12 +139,10 @@ int nsl_corr_fft_FFTW(double s[], double r[], size_t n, double out[]) {
 		return -1;
 
 	const size_t size = 2*(n/2+1);
-	double* in = (double*)malloc(size*sizeof(double));
-	fftw_plan rpf = fftw_plan_dft_r2c_1d(n, in, (fftw_complex*)in, FFTW_ESTIMATE);
 
-	fftw_execute_dft_r2c(rpf, s, (fftw_complex*)s);
-	fftw_execute_dft_r2c(rpf, r, (fftw_complex*)r);
-	fftw_destroy_plan(rpf);
+	// in place transforms using cached plans
+	if (nsl_dft_fft_r2c_FFTW(s, s, n) != 0 || nsl_dft_fft_r2c_FFTW(r, r, n) != 0)
+		return -1;
 
 	size_t i;
 
@@ -160,28 +156,20 @@ int nsl_corr_fft_FFTW(double s[], double r[], size_t n, double out[]) {
 	}
 
 	// back transform
-	double* o = (double*)malloc(size*sizeof(double));
-	fftw_plan rpb = fftw_plan_dft_c2r_1d(n, (fftw_complex*)o, o, FFTW_ESTIMATE);
-	fftw_execute_dft_c2r(rpb, (fftw_complex*)s, s);
-	fftw_destroy_plan(rpb);
+	if (nsl_dft_fft_c2r_FFTW(s, s, n) != 0)
+		return -1;
 
 	for (i = 0; i < n; i++)
 		out[i] = s[i]/n;
 
-	free(in);
-	free(o);
 	return 0;
 }
 #endif
 
 int nsl_corr_fft_GSL(double s[], double r[], size_t n, double out[]) {
-	gsl_fft_real_workspace *work = gsl_fft_real_workspace_alloc(n);
-	gsl_fft_real_wavetable *real = gsl_fft_real_wavetable_alloc(n);
-
 	/* FFT s and r */
-	gsl_fft_real_transform(s, 1, n, real, work);
-	gsl_fft_real_transform(r, 1, n, real, work);
-	gsl_fft_real_wavetable_free(real);
+	if (nsl_dft_fft_real_GSL(s, 1, n) != 0 || nsl_dft_fft_real_GSL(r, 1, n) != 0)
+		return -1;
 
 	size_t i;
 	/* calculate halfcomplex product */
@@ -196,10 +184,5 @@ int nsl_corr_fft_GSL(double s[], double r[], size_t n, double out[]) {
 	}
 
 	/* back transform */
-	gsl_fft_halfcomplex_wavetable *hc = gsl_fft_halfcomplex_wavetable_alloc(n);
-	gsl_fft_halfcomplex_inverse(out, 1, n, hc, work);
-	gsl_fft_halfcomplex_wavetable_free(hc);
-	gsl_fft_real_workspace_free(work);
-
-	return 0;
+	return nsl_dft_fft_halfcomplex_inverse_GSL(out, 1, n);
 }
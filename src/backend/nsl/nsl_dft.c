@@ -33,11 +33,305 @@
 #ifdef HAVE_FFTW3
 #include <fftw3.h>
 #endif
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
 
 const char* nsl_dft_result_type_name[] = {i18n("Magnitude"), i18n("Amplitude"), i18n("real part"), i18n("imaginary part"), i18n("Power"), i18n("Phase"),
 		i18n("Amplitude in dB"), i18n("normalized amplitude in dB"), i18n("Magnitude squared"), i18n("Amplitude squared"), i18n("raw")};
 const char* nsl_dft_xscale_name[] = {i18n("Frequency"), i18n("Index"), i18n("Period")};
 
+/* plan cache */
+
+/* the FFTW planner is not thread-safe. All planning, plan destruction and cache access is guarded by this lock,
+ * executing a plan with the new-array execute functions is thread-safe */
+#ifdef _WIN32
+static SRWLOCK nsl_dft_plan_lock = SRWLOCK_INIT;
+#define NSL_DFT_LOCK() AcquireSRWLockExclusive(&nsl_dft_plan_lock)
+#define NSL_DFT_UNLOCK() ReleaseSRWLockExclusive(&nsl_dft_plan_lock)
+#else
+static pthread_mutex_t nsl_dft_plan_lock = PTHREAD_MUTEX_INITIALIZER;
+#define NSL_DFT_LOCK() pthread_mutex_lock(&nsl_dft_plan_lock)
+#define NSL_DFT_UNLOCK() pthread_mutex_unlock(&nsl_dft_plan_lock)
+#endif
+
+#define NSL_DFT_PLAN_CACHE_SIZE 16
+#define NSL_DFT_PLAN_INPLACE 1
+#define NSL_DFT_PLAN_UNALIGNED 2
+
+typedef enum {nsl_dft_plan_r2c, nsl_dft_plan_c2r, nsl_dft_plan_gsl_real, nsl_dft_plan_gsl_halfcomplex} nsl_dft_plan_kind;
+
+typedef struct {
+	size_t n;
+	nsl_dft_plan_kind kind;
+	int flags;
+	int users;	/* number of running transforms using this entry */
+	int cached;	/* 0 if the entry was evicted or the cache was full; destroyed by the last user */
+	unsigned long last_use;
+#ifdef HAVE_FFTW3
+	fftw_plan plan;
+#endif
+	void* wavetable;	/* gsl_fft_real_wavetable or gsl_fft_halfcomplex_wavetable */
+} nsl_dft_plan_entry;
+
+static nsl_dft_plan_entry* nsl_dft_plan_cache[NSL_DFT_PLAN_CACHE_SIZE];
+static unsigned long nsl_dft_plan_counter = 0;
+static int nsl_dft_plan_measure = 0;
+static int nsl_dft_plan_nthreads = 1;
+#ifdef HAVE_FFTW3_THREADS
+static int nsl_dft_threads_initialized = 0;
+#endif
+
+/* must be called with the lock held */
+static void nsl_dft_plan_destroy(nsl_dft_plan_entry* entry) {
+	switch (entry->kind) {
+	case nsl_dft_plan_r2c:
+	case nsl_dft_plan_c2r:
+#ifdef HAVE_FFTW3
+		fftw_destroy_plan(entry->plan);
+#endif
+		break;
+	case nsl_dft_plan_gsl_real:
+		gsl_fft_real_wavetable_free((gsl_fft_real_wavetable*)entry->wavetable);
+		break;
+	case nsl_dft_plan_gsl_halfcomplex:
+		gsl_fft_halfcomplex_wavetable_free((gsl_fft_halfcomplex_wavetable*)entry->wavetable);
+		break;
+	}
+	free(entry);
+}
+
+/* must be called with the lock held. returns 0 on success */
+static int nsl_dft_plan_create(nsl_dft_plan_entry* entry) {
+	const size_t n = entry->n;
+	switch (entry->kind) {
+	case nsl_dft_plan_r2c:
+	case nsl_dft_plan_c2r: {
+#ifdef HAVE_FFTW3
+		/* plan on aligned scratch arrays, FFTW_MEASURE overwrites them */
+		double* in = fftw_alloc_real(2*(n/2+1));
+		double* out = (entry->flags & NSL_DFT_PLAN_INPLACE) ? in : fftw_alloc_real(2*(n/2+1));
+		if (in == NULL || out == NULL) {
+			fftw_free(in);
+			if (out != in)
+				fftw_free(out);
+			return -1;
+		}
+
+		unsigned int flags = nsl_dft_plan_measure ? FFTW_MEASURE : FFTW_ESTIMATE;
+		if (entry->flags & NSL_DFT_PLAN_UNALIGNED)
+			flags |= FFTW_UNALIGNED;
+#ifdef HAVE_FFTW3_THREADS
+		if (nsl_dft_threads_initialized)
+			fftw_plan_with_nthreads(n >= NSL_DFT_THREADS_MIN_SIZE ? nsl_dft_plan_nthreads : 1);
+#endif
+		if (entry->kind == nsl_dft_plan_r2c)
+			entry->plan = fftw_plan_dft_r2c_1d((int)n, in, (fftw_complex*)out, flags);
+		else
+			entry->plan = fftw_plan_dft_c2r_1d((int)n, (fftw_complex*)in, out, flags);
+
+		if (out != in)
+			fftw_free(out);
+		fftw_free(in);
+
+		return entry->plan ? 0 : -1;
+#else
+		return -1;
+#endif
+	}
+	case nsl_dft_plan_gsl_real:
+		entry->wavetable = gsl_fft_real_wavetable_alloc(n);
+		return entry->wavetable ? 0 : -1;
+	case nsl_dft_plan_gsl_halfcomplex:
+		entry->wavetable = gsl_fft_halfcomplex_wavetable_alloc(n);
+		return entry->wavetable ? 0 : -1;
+	}
+
+	return -1;
+}
+
+/* returns the cached plan for the given size and kind, creating it if needed. release with nsl_dft_plan_release() */
+static nsl_dft_plan_entry* nsl_dft_plan_acquire(size_t n, nsl_dft_plan_kind kind, int flags) {
+	size_t i;
+	NSL_DFT_LOCK();
+
+	for (i = 0; i < NSL_DFT_PLAN_CACHE_SIZE; i++) {
+		nsl_dft_plan_entry* entry = nsl_dft_plan_cache[i];
+		if (entry && entry->n == n && entry->kind == kind && entry->flags == flags) {
+			entry->users++;
+			entry->last_use = ++nsl_dft_plan_counter;
+			NSL_DFT_UNLOCK();
+			return entry;
+		}
+	}
+
+	nsl_dft_plan_entry* entry = (nsl_dft_plan_entry*)calloc(1, sizeof(nsl_dft_plan_entry));
+	if (entry == NULL) {
+		NSL_DFT_UNLOCK();
+		return NULL;
+	}
+	entry->n = n;
+	entry->kind = kind;
+	entry->flags = flags;
+	if (nsl_dft_plan_create(entry) != 0) {
+		free(entry);
+		NSL_DFT_UNLOCK();
+		return NULL;
+	}
+	entry->users = 1;
+	entry->last_use = ++nsl_dft_plan_counter;
+
+	/* store in a free slot or replace the least recently used entry that is not in use */
+	size_t slot = NSL_DFT_PLAN_CACHE_SIZE;
+	for (i = 0; i < NSL_DFT_PLAN_CACHE_SIZE; i++) {
+		nsl_dft_plan_entry* e = nsl_dft_plan_cache[i];
+		if (e == NULL) {
+			slot = i;
+			break;
+		}
+		if (e->users == 0 && (slot == NSL_DFT_PLAN_CACHE_SIZE || e->last_use < nsl_dft_plan_cache[slot]->last_use))
+			slot = i;
+	}
+	if (slot < NSL_DFT_PLAN_CACHE_SIZE) {
+		if (nsl_dft_plan_cache[slot])
+			nsl_dft_plan_destroy(nsl_dft_plan_cache[slot]);
+		nsl_dft_plan_cache[slot] = entry;
+		entry->cached = 1;
+	}
+
+	NSL_DFT_UNLOCK();
+	return entry;
+}
+
+static void nsl_dft_plan_release(nsl_dft_plan_entry* entry) {
+	NSL_DFT_LOCK();
+	entry->users--;
+	if (entry->users == 0 && !entry->cached)
+		nsl_dft_plan_destroy(entry);
+	NSL_DFT_UNLOCK();
+}
+
+void nsl_dft_plan_cache_clear(void) {
+	size_t i;
+	NSL_DFT_LOCK();
+	for (i = 0; i < NSL_DFT_PLAN_CACHE_SIZE; i++) {
+		nsl_dft_plan_entry* entry = nsl_dft_plan_cache[i];
+		if (entry == NULL)
+			continue;
+		/* entries in use are destroyed by their last user */
+		if (entry->users == 0)
+			nsl_dft_plan_destroy(entry);
+		else
+			entry->cached = 0;
+		nsl_dft_plan_cache[i] = NULL;
+	}
+	NSL_DFT_UNLOCK();
+}
+
+void nsl_dft_set_planner(int measure, double timelimit, int nthreads) {
+	NSL_DFT_LOCK();
+	nsl_dft_plan_measure = measure;
+	nsl_dft_plan_nthreads = nthreads > 0 ? nthreads : 1;
+#ifdef HAVE_FFTW3
+	fftw_set_timelimit(timelimit < 0 ? FFTW_NO_TIMELIMIT : timelimit);
+#ifdef HAVE_FFTW3_THREADS
+	if (!nsl_dft_threads_initialized && nsl_dft_plan_nthreads > 1)
+		nsl_dft_threads_initialized = fftw_init_threads();
+	if (!nsl_dft_threads_initialized)
+		nsl_dft_plan_nthreads = 1;
+#endif
+#else
+	(void)timelimit;
+	nsl_dft_plan_nthreads = 1;
+#endif
+	NSL_DFT_UNLOCK();
+}
+
+int nsl_dft_import_wisdom(const char* filename) {
+#ifdef HAVE_FFTW3
+	NSL_DFT_LOCK();
+	int ok = fftw_import_wisdom_from_filename(filename);
+	NSL_DFT_UNLOCK();
+	return ok ? 0 : -1;
+#else
+	(void)filename;
+	return -1;
+#endif
+}
+
+int nsl_dft_export_wisdom(const char* filename) {
+#ifdef HAVE_FFTW3
+	NSL_DFT_LOCK();
+	int ok = fftw_export_wisdom_to_filename(filename);
+	NSL_DFT_UNLOCK();
+	return ok ? 0 : -1;
+#else
+	(void)filename;
+	return -1;
+#endif
+}
+
+#ifdef HAVE_FFTW3
+static int nsl_dft_plan_flags(const double* in, const double* out) {
+	int flags = 0;
+	if (in == out)
+		flags |= NSL_DFT_PLAN_INPLACE;
+	if (fftw_alignment_of((double*)in) != 0 || fftw_alignment_of((double*)out) != 0)
+		flags |= NSL_DFT_PLAN_UNALIGNED;
+	return flags;
+}
+
+int nsl_dft_fft_r2c_FFTW(double in[], double out[], size_t n) {
+	if (n < 1)
+		return -1;
+	nsl_dft_plan_entry* entry = nsl_dft_plan_acquire(n, nsl_dft_plan_r2c, nsl_dft_plan_flags(in, out));
+	if (entry == NULL)
+		return -1;
+	fftw_execute_dft_r2c(entry->plan, in, (fftw_complex*)out);
+	nsl_dft_plan_release(entry);
+	return 0;
+}
+
+int nsl_dft_fft_c2r_FFTW(double in[], double out[], size_t n) {
+	if (n < 1)
+		return -1;
+	nsl_dft_plan_entry* entry = nsl_dft_plan_acquire(n, nsl_dft_plan_c2r, nsl_dft_plan_flags(in, out));
+	if (entry == NULL)
+		return -1;
+	fftw_execute_dft_c2r(entry->plan, (fftw_complex*)in, out);
+	nsl_dft_plan_release(entry);
+	return 0;
+}
+#endif
+
+int nsl_dft_fft_real_GSL(double data[], size_t stride, size_t n) {
+	if (n < 1)
+		return -1;
+	nsl_dft_plan_entry* entry = nsl_dft_plan_acquire(n, nsl_dft_plan_gsl_real, 0);
+	if (entry == NULL)
+		return -1;
+	gsl_fft_real_workspace* work = gsl_fft_real_workspace_alloc(n);
+	int status = gsl_fft_real_transform(data, stride, n, (gsl_fft_real_wavetable*)entry->wavetable, work);
+	gsl_fft_real_workspace_free(work);
+	nsl_dft_plan_release(entry);
+	return status;
+}
+
+int nsl_dft_fft_halfcomplex_inverse_GSL(double data[], size_t stride, size_t n) {
+	if (n < 1)
+		return -1;
+	nsl_dft_plan_entry* entry = nsl_dft_plan_acquire(n, nsl_dft_plan_gsl_halfcomplex, 0);
+	if (entry == NULL)
+		return -1;
+	gsl_fft_real_workspace* work = gsl_fft_real_workspace_alloc(n);
+	int status = gsl_fft_halfcomplex_inverse(data, stride, n, (gsl_fft_halfcomplex_wavetable*)entry->wavetable, work);
+	gsl_fft_real_workspace_free(work);
+	nsl_dft_plan_release(entry);
+	return status;
+}
+
 int nsl_dft_transform_window(double data[], size_t stride, size_t n, int two_sided, nsl_dft_result_type type, nsl_sf_window_type window_type) {
 	/* apply window function */
 	if (window_type != nsl_sf_window_uniform)
@@ -61,9 +355,10 @@ int nsl_dft_transform(double data[], size_t stride, size_t n, int two_sided, nsl
 	/* stride ignored */
 	(void)stride;
 
-	fftw_plan plan = fftw_plan_dft_r2c_1d(n, data, (fftw_complex *) result, FFTW_ESTIMATE);
-	fftw_execute(plan);
-	fftw_destroy_plan(plan);
+	if (nsl_dft_fft_r2c_FFTW(data, result, n) != 0) {
+		free(result);
+		return -1;
+	}
 
 	/* 2. unpack data */
 	if(two_sided) {
@@ -78,12 +373,10 @@ int nsl_dft_transform(double data[], size_t stride, size_t n, int two_sided, nsl
 	}
 #else
 	/* 1. transform */
-	gsl_fft_real_wavetable *real = gsl_fft_real_wavetable_alloc(n);
-	gsl_fft_real_workspace *work = gsl_fft_real_workspace_alloc(n);
-
-	gsl_fft_real_transform(data, stride, n, real, work);
-	gsl_fft_real_wavetable_free(real);
-	gsl_fft_real_workspace_free(work);
+	if (nsl_dft_fft_real_GSL(data, stride, n) != 0) {
+		free(result);
+		return -1;
+	}
 
 	/* 2. unpack data */
 	gsl_fft_halfcomplex_unpack(data, result, stride, n);
@@ -63,4 +63,32 @@ int nsl_dft_transform(double data[], size_t stride, size_t n, int two_sided, nsl
 /* windowed version */
 int nsl_dft_transform_window(double data[], size_t stride, size_t n, int two_sided, nsl_dft_result_type type, nsl_sf_window_type window);
 
+/* cached FFT plans (FFTW) and wavetables (GSL)
+	plans are created once per size and kept in a small cache shared by all threads
+	all functions are thread-safe
+*/
+#ifdef HAVE_FFTW3
+/* real to complex transform of in[n] to out[2*(n/2+1)] (re0,im0,re1,im1,...). in == out is allowed */
+int nsl_dft_fft_r2c_FFTW(double in[], double out[], size_t n);
+/* unnormalized complex to real back transform of in[2*(n/2+1)] to out[n]. in is destroyed. in == out is allowed */
+int nsl_dft_fft_c2r_FFTW(double in[], double out[], size_t n);
+#endif
+/* in place real transform to halfcomplex format */
+int nsl_dft_fft_real_GSL(double data[], size_t stride, size_t n);
+/* in place inverse of halfcomplex data */
+int nsl_dft_fft_halfcomplex_inverse_GSL(double data[], size_t stride, size_t n);
+
+/* planner settings (FFTW only)
+	measure: use FFTW_MEASURE instead of FFTW_ESTIMATE for new plans
+	timelimit: maximum time in seconds spent for planning a single size (< 0: unlimited)
+	nthreads: number of threads used for transforms of at least NSL_DFT_THREADS_MIN_SIZE points
+*/
+#define NSL_DFT_THREADS_MIN_SIZE 65536
+void nsl_dft_set_planner(int measure, double timelimit, int nthreads);
+/* load/save the accumulated FFTW wisdom. return 0 on success */
+int nsl_dft_import_wisdom(const char* filename);
+int nsl_dft_export_wisdom(const char* filename);
+/* free all cached plans and wavetables */
+void nsl_dft_plan_cache_clear(void);
+
 #endif /* NSL_DFT_H */
@@ -64,6 +64,14 @@ typedef enum {nsl_fit_weight_no,		/* w = 1 */
 } nsl_fit_weight_type;
 extern const char* nsl_fit_weight_type_name[];
 
+#define NSL_FIT_ALGORITHM_COUNT 2
+/* lm: Levenberg-Marquardt with QR decomposition of the full Jacobian (default)
+ * large: Levenberg-Marquardt on the normal equations (Cholesky decomposition of J^T J),
+ *	J^T J is accumulated in blocks of data points, so the full Jacobian is never stored
+ */
+typedef enum {nsl_fit_algorithm_lm, nsl_fit_algorithm_large} nsl_fit_algorithm_type;
+extern const char* nsl_fit_algorithm_name[];
+
 /* convert unbounded variable x to bounded variable where bounds are [min, max] */
 double nsl_fit_map_bound(double x, double min, double max);
 /* convert bounded variable x to unbounded variable where bounds are [min, max] */
@@ -121,31 +121,94 @@ double nsl_geom_linesim_avg_dist_perpoint(const double xdata[], const double yda
 
 /*********** simplification algorithms *********/
 
-void nsl_geom_linesim_douglas_peucker_step(const double xdata[], const double ydata[], const size_t start, const size_t end, size_t *nout, const double tol, size_t index[]) {
-	/*printf("DP: %d - %d\n", start, end);*/
+/* indexed binary min-heap of ids (points or segments) ordered by key[id], ties by smaller id.
+	pos[id] is the position of id in the heap, needed to update the key of an id in the heap */
+typedef struct {
+	size_t *heap;
+	size_t *pos;
+	double *key;
+	size_t size;
+} nsl_geom_linesim_heap;
+
+static int nsl_geom_linesim_heap_init(nsl_geom_linesim_heap *h, const size_t n) {
+	h->heap = (size_t *)malloc(n * sizeof(size_t));
+	h->pos = (size_t *)malloc(n * sizeof(size_t));
+	h->key = (double *)malloc(n * sizeof(double));
+	h->size = 0;
+	return (h->heap && h->pos && h->key) ? 0 : -1;
+}
+
+static void nsl_geom_linesim_heap_free(nsl_geom_linesim_heap *h) {
+	free(h->heap);
+	free(h->pos);
+	free(h->key);
+}
+
+static int nsl_geom_linesim_heap_less(const nsl_geom_linesim_heap *h, const size_t a, const size_t b) {
+	return h->key[a] < h->key[b] || (h->key[a] == h->key[b] && a < b);
+}
+
+static void nsl_geom_linesim_heap_swap(nsl_geom_linesim_heap *h, const size_t i, const size_t j) {
+	size_t tmp = h->heap[i];
+	h->heap[i] = h->heap[j];
+	h->heap[j] = tmp;
+	h->pos[h->heap[i]] = i;
+	h->pos[h->heap[j]] = j;
+}
 
-	size_t i, nkey = start;
-	double maxdist = 0;
-	/* search for key (biggest perp. distance) */
+static void nsl_geom_linesim_heap_up(nsl_geom_linesim_heap *h, size_t i) {
+	while (i > 0 && nsl_geom_linesim_heap_less(h, h->heap[i], h->heap[(i-1)/2])) {
+		nsl_geom_linesim_heap_swap(h, i, (i-1)/2);
+		i = (i-1)/2;
+	}
+}
+
+static void nsl_geom_linesim_heap_down(nsl_geom_linesim_heap *h, size_t i) {
+	for (;;) {
+		size_t min = i, l = 2*i+1, r = 2*i+2;
+		if (l < h->size && nsl_geom_linesim_heap_less(h, h->heap[l], h->heap[min]))
+			min = l;
+		if (r < h->size && nsl_geom_linesim_heap_less(h, h->heap[r], h->heap[min]))
+			min = r;
+		if (min == i)
+			break;
+		nsl_geom_linesim_heap_swap(h, i, min);
+		i = min;
+	}
+}
+
+static void nsl_geom_linesim_heap_push(nsl_geom_linesim_heap *h, const size_t id, const double key) {
+	h->key[id] = key;
+	h->heap[h->size] = id;
+	h->pos[id] = h->size;
+	nsl_geom_linesim_heap_up(h, h->size++);
+}
+
+static size_t nsl_geom_linesim_heap_pop(nsl_geom_linesim_heap *h) {
+	size_t id = h->heap[0];
+	nsl_geom_linesim_heap_swap(h, 0, --h->size);
+	nsl_geom_linesim_heap_down(h, 0);
+	return id;
+}
+
+/* key of id can only be increased (min-heap) */
+static void nsl_geom_linesim_heap_increase(nsl_geom_linesim_heap *h, const size_t id, const double key) {
+	h->key[id] = key;
+	nsl_geom_linesim_heap_down(h, h->pos[id]);
+}
+
+/* point with the largest perpendicular distance (first one) between start and end */
+static size_t nsl_geom_linesim_segment_key(const double xdata[], const double ydata[], const size_t start, const size_t end, double *maxdist) {
+	size_t i, key = start + 1;
+	*maxdist = 0;
 	for (i = start+1; i < end; i++) {
 		double dist = nsl_geom_point_line_dist(xdata[start], ydata[start], xdata[end], ydata[end], xdata[i], ydata[i]);
-		if (dist > maxdist) {
-			maxdist = dist;
-			nkey = i;
+		if (dist > *maxdist) {
+			*maxdist = dist;
+			key = i;
 		}
 	}
-	/*printf("maxdist = %g @ i = %zu\n", maxdist, nkey);*/
-
-	if (maxdist > tol) {
-		/*printf("take %d\n", nkey);*/
-		index[(*nout)++] = nkey;
-		if (nkey-start > 1)
-			nsl_geom_linesim_douglas_peucker_step(xdata, ydata, start, nkey, nout, tol, index);
-		if (end-nkey > 1)
-			nsl_geom_linesim_douglas_peucker_step(xdata, ydata, nkey, end, nout, tol, index);
-	}
-
-	/*printf("nout=%d\n", *nout);*/
+	return key;
 }
 
 size_t nsl_geom_linesim_douglas_peucker(const double xdata[], const double ydata[], const size_t n, const double tol, size_t index[]) {
@@ -154,7 +217,37 @@ size_t nsl_geom_linesim_douglas_peucker(const double xdata[], const double ydata
 	/*first point*/
 	index[nout++] = 0;
 
-	nsl_geom_linesim_douglas_peucker_step(xdata, ydata, 0, n-1, &nout, tol, index);
+	/* segments still to process (start, end). Processed iteratively to avoid deep recursion on large data sets */
+	size_t *stack = (size_t *)malloc(2 * n * sizeof(size_t));
+	if (stack == NULL) {
+		printf("nsl_geom_linesim_douglas_peucker(): ERROR allocating memory!\n");
+		return 0;
+	}
+	size_t nstack = 0;
+	if (n > 2) {
+		stack[nstack++] = 0;
+		stack[nstack++] = n-1;
+	}
+
+	while (nstack > 0) {
+		const size_t end = stack[--nstack];
+		const size_t start = stack[--nstack];
+
+		double maxdist;
+		const size_t nkey = nsl_geom_linesim_segment_key(xdata, ydata, start, end, &maxdist);
+		if (maxdist > tol) {
+			index[nout++] = nkey;
+			if (nkey-start > 1) {
+				stack[nstack++] = start;
+				stack[nstack++] = nkey;
+			}
+			if (end-nkey > 1) {
+				stack[nstack++] = nkey;
+				stack[nstack++] = end;
+			}
+		}
+	}
+	free(stack);
 
 	/* last point */
 	if (index[nout-1] != n-1)
@@ -174,6 +267,7 @@ size_t nsl_geom_linesim_douglas_peucker_auto(const double xdata[], const double
  * Douglas-Peucker variant:
  * The key of all egdes of the current simplified line is calculated and only the
  * largest is added. This is repeated until nout is reached.
+ * The edges are kept in a heap ordered by their largest distance.
  * */
 double nsl_geom_linesim_douglas_peucker_variant(const double xdata[], const double ydata[], const size_t n, const size_t nout, size_t index[]) {
 	size_t i;
@@ -191,95 +285,49 @@ double nsl_geom_linesim_douglas_peucker_variant(const double xdata[], const doub
 	if (nout <= 2)	/* use only first and last point (perp. dist is zero) */
 		return 0.0;
 
-	double *dist = (double *)malloc(n * sizeof(double));
-	if (dist == NULL) {
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): ERROR allocating memory for 'dist'!\n"); */
+	/* edges are identified by their start point */
+	size_t *end = (size_t *)malloc(n * sizeof(size_t));
+	size_t *key = (size_t *)malloc(n * sizeof(size_t));	/* point with largest distance of edge */
+	nsl_geom_linesim_heap heap;
+	if (end == NULL || key == NULL || nsl_geom_linesim_heap_init(&heap, n) != 0) {
+		/* printf("nsl_geom_linesim_douglas_peucker_variant(): ERROR allocating memory!\n"); */
+		free(end);
+		free(key);
+		nsl_geom_linesim_heap_free(&heap);
 		return DBL_MAX;
 	}
 
-	double *maxdist = (double *)malloc(nout * sizeof(double));	/* max dist per edge */
-	if (maxdist == NULL) {
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): ERROR allocating memory for 'maxdist'!\n"); */
-		free(dist);
-		return DBL_MAX;
-	}
-
-	for (i = 0; i < n; i++) {	/* initialize  dist */
-		dist[i] = nsl_geom_point_line_dist(xdata[0], ydata[0], xdata[n-1], ydata[n-1], xdata[i], ydata[i]);
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): %zu dist = %g\n", i, dist[i]); */
-	}
-	for (i = 0; i < nout; i++)
-		maxdist[i] = 0;
+	double maxdist, newmaxdist = 0;
+	end[0] = n-1;
+	key[0] = nsl_geom_linesim_segment_key(xdata, ydata, 0, n-1, &maxdist);
+	nsl_geom_linesim_heap_push(&heap, 0, -maxdist);	/* largest distance first */
 
-	double newmaxdist = 0;
-	do {
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): NEXT ITERATION\n"); */
-		size_t key = 0;
-
-		/* find edge of maximum */
-		size_t maxindex;
-		nsl_stats_maximum(maxdist, ncount, &maxindex);
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): found edge with max dist at index %zu\n", maxindex); */
-		/*newmaxdist = nsl_stats_maximum(dist, n, &key);*/
-		newmaxdist = 0;
-		for (i = index[maxindex]+1; i < index[maxindex+1]; i++) {
-			/* printf("nsl_geom_linesim_douglas_peucker_variant(): iterate i=%zu\n", i); */
-			if (dist[i] > newmaxdist) {
-				newmaxdist = dist[i];
-				key = i;
-			}
-		}
+	while (ncount < nout && heap.size > 0) {
+		const size_t start = nsl_geom_linesim_heap_pop(&heap);
+		const size_t stop = end[start], k = key[start];
+		newmaxdist = -heap.key[start];
+		index[ncount++] = k;
 
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): found key %zu (dist = %g)\n", key, newmaxdist); */
-		ncount++;
-		dist[key] = 0;
-
-		/* find index of previous key */
-		size_t previndex = 0;
-		while (index[previndex+1] < key)
-			previndex++;
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): previndex = %zu (update keys %zu - %zu)\n", previndex, index[previndex], index[previndex+1]); */
-
-		size_t v;
-		/* printf("nsl_geom_linesim_douglas_peucker_variant(): ncount = %zu, previndex = %zu\n", ncount, previndex); */
-		/* update dist[]. no update on last key */
+		/* split edge. no update on last key */
 		if (ncount < nout) {
-			/* shift maxdist */
-			for (v = ncount; v > previndex; v--)
-				maxdist[v] = maxdist[v-1];
-
-			double tmpmax = 0;
-			for (v = index[previndex]+1; v < key; v++) {
-				/* printf("nsl_geom_linesim_douglas_peucker_variant(): %zu in %zu - %zu", v, index[previndex], key); */
-				dist[v] = nsl_geom_point_line_dist(xdata[index[previndex]], ydata[index[previndex]], xdata[key], ydata[key],
-					xdata[v], ydata[v]);
-				if (dist[v] > tmpmax)
-					tmpmax = dist[v];
-
-				/* printf(" dist = %g\n", dist[v]); */
+			if (k - start > 1) {
+				end[start] = k;
+				key[start] = nsl_geom_linesim_segment_key(xdata, ydata, start, k, &maxdist);
+				nsl_geom_linesim_heap_push(&heap, start, -maxdist);
 			}
-			maxdist[previndex] = tmpmax;
-
-			tmpmax = 0;
-			for (v = key+1; v < index[previndex+1]; v++) {
-				/* printf("nsl_geom_linesim_douglas_peucker_variant(): %zu in %zu - %zu", v, key, index[previndex+1]); */
-				dist[v] = nsl_geom_point_line_dist(xdata[key], ydata[key], xdata[index[previndex+1]], ydata[index[previndex+1]],
-					xdata[v], ydata[v]);
-				if (dist[v] > tmpmax)
-					tmpmax = dist[v];
-				/* printf(" dist = %g\n", dist[v]); */
+			if (stop - k > 1) {
+				end[k] = stop;
+				key[k] = nsl_geom_linesim_segment_key(xdata, ydata, k, stop, &maxdist);
+				nsl_geom_linesim_heap_push(&heap, k, -maxdist);
 			}
-			maxdist[previndex+1] = tmpmax;
 		}
+	}
 
-		/* put into index array */
-		for (v = ncount; v > previndex+1; v--)
-			index[v] = index[v-1];
-		index[previndex+1] = key;
-	} while (ncount < nout);
+	free(end);
+	free(key);
+	nsl_geom_linesim_heap_free(&heap);
 
-	free(maxdist);
-	free(dist);
+	nsl_sort_size_t(index, ncount);
 
 	return newmaxdist;
 }
@@ -451,78 +499,56 @@ size_t nsl_geom_linesim_visvalingam_whyatt(const double xdata[], const double yd
 		return 0;
 
 	size_t i, nout = n;
-	double *area = (double *) malloc((n-2)*sizeof(double));	/* area associated with every point */
-	if (area == NULL) {
+	/* remaining points as doubly linked list, inner points in a heap ordered by their associated area */
+	size_t *prev = (size_t *) malloc(n*sizeof(size_t));
+	size_t *next = (size_t *) malloc(n*sizeof(size_t));
+	nsl_geom_linesim_heap heap;
+	if (prev == NULL || next == NULL || nsl_geom_linesim_heap_init(&heap, n) != 0) {
 		printf("nsl_geom_linesim_visvalingam_whyatt(): ERROR allocating memory!\n");
+		free(prev);
+		free(next);
+		nsl_geom_linesim_heap_free(&heap);
 		return 0;
 	}
-	for (i = 0; i < n; i++)
-		index[i] = i;
+	for (i = 0; i < n; i++) {
+		prev[i] = i-1;
+		next[i] = i+1;
+	}
 	for (i = 1; i < n-1; i++)
-		area[i-1] = nsl_geom_three_point_area(xdata[i-1], ydata[i-1], xdata[i], ydata[i], xdata[i+1], ydata[i+1]);
-
-	size_t minindex;
-	while ( nsl_stats_minimum(area, n-2, &minindex) < tol && nout > 2) {
-	/* double minarea;
-	while ( (minarea = nsl_stats_minimum(area, n-2, &minindex)) < tol && nout > 2) { */
-		/*for (i=0; i < n-2; i++)
-			if (area[i]<DBL_MAX)
-				printf("area[%zu] = %g\n", i, area[i]);
-		*/
-		/* remove point minindex */
-		/*printf("removing point %zu (minindex = %zu, minarea = %g) nout=%zu\n", minindex+1, minindex, minarea, nout-1);*/
-		index[minindex+1] = 0;
-		area[minindex] = DBL_MAX;
+		nsl_geom_linesim_heap_push(&heap, i, nsl_geom_three_point_area(xdata[i-1], ydata[i-1], xdata[i], ydata[i], xdata[i+1], ydata[i+1]));
+
+	while (heap.size > 0 && heap.key[heap.heap[0]] < tol && nout > 2) {
+		/* remove point with smallest area */
+		const size_t p = nsl_geom_linesim_heap_pop(&heap);
+		const size_t before = prev[p], after = next[p];
+		next[before] = after;
+		prev[after] = before;
+
+		/* update area of neigbor points (take largest value of new and old area) */
 		double tmparea;
-		/* update area of neigbor points */
-		size_t before = minindex, after = minindex+2;	/* find index before and after */
-		while (index[before] == 0 && before > 0)
-			before--;
-		while (after < n+1 && index[after] == 0)
-			after++;
-		if (minindex > 0) {	/*before */
-			if (before > 0) {
-				size_t beforebefore=before-1;
-				while (index[beforebefore] == 0 && beforebefore > 0)
-					beforebefore--;
-				/*printf("recalculate area[%zu] from %zu %zu %zu\n", before-1, beforebefore, before, after);*/
-				tmparea = nsl_geom_three_point_area(xdata[beforebefore], ydata[beforebefore], xdata[before], ydata[before], xdata[after], ydata[after]);
-				if (tmparea > area[before-1])	/* take largest value of new and old area */
-					area[before-1] = tmparea;
-			}
+		if (before > 0) {
+			tmparea = nsl_geom_three_point_area(xdata[prev[before]], ydata[prev[before]], xdata[before], ydata[before], xdata[after], ydata[after]);
+			if (tmparea > heap.key[before])
+				nsl_geom_linesim_heap_increase(&heap, before, tmparea);
 		}
-		if (minindex < n-3) {	/* after */
-			if (after < n-1) {
-				size_t afterafter = after+1;
-				while (afterafter < n-1 && index[afterafter] == 0)
-					afterafter++;
-				/*printf("recalculate area[%zu] from %zu %zu %zu\n",after-1, before, after, afterafter);*/
-				tmparea = nsl_geom_three_point_area(xdata[before], ydata[before], xdata[after], ydata[after], xdata[afterafter], ydata[afterafter]);
-				if (tmparea > area[after-1])	/* take largest value of new and old area */
-					area[after-1] = tmparea;
-			}
+		if (after < n-1) {
+			tmparea = nsl_geom_three_point_area(xdata[before], ydata[before], xdata[after], ydata[after], xdata[next[after]], ydata[next[after]]);
+			if (tmparea > heap.key[after])
+				nsl_geom_linesim_heap_increase(&heap, after, tmparea);
 		}
 		nout--;
 	};
 
-	/*for(i=0;i<n;i++)
-		printf("INDEX = %d\n", index[i]);
-	*/
-
 	/* condens index */
-	i = 1;
-	size_t newi = 1;
-	while (newi < n-1) {
-		while (index[newi] == 0)
-			newi++;
-		index[i++] = index[newi++];
-	};
-
-	/*for(i=0;i<nout;i++)
-		printf("INDEX2 = %d\n", index[i]);
-	*/
+	size_t p = 0;
+	for (i = 0; i < nout; i++) {
+		index[i] = p;
+		p = next[p];
+	}
 
-	free(area);
+	free(prev);
+	free(next);
+	nsl_geom_linesim_heap_free(&heap);
 	return nout;
 }
 size_t nsl_geom_linesim_visvalingam_whyatt_auto(const double xdata[], const double ydata[], const size_t n, size_t index[]) {
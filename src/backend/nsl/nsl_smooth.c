@@ -31,6 +31,7 @@
 #include "nsl_sf_kernel.h"
 #include "nsl_stats.h"
 #include <gsl/gsl_math.h>
+#include <gsl/gsl_sort.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_sf_gamma.h>   /* gsl_sf_choose */
@@ -300,13 +301,85 @@ int nsl_smooth_moving_average_lagged(double *data, size_t n, size_t points, nsl_
 	return 0;
 }
 
+/* index into data of the padded signal at index (n: left constant, n+1: right constant) */
+static size_t nsl_smooth_pad_index(long index, size_t n, nsl_smooth_pad_mode mode) {
+	const long N = (long)n;
+	if (index >= 0 && index < N)
+		return (size_t)index;
+
+	switch (mode) {
+	case nsl_smooth_pad_mirror:
+		if (N == 1)
+			return 0;
+		index = labs(index) % (2*(N-1));
+		return (size_t)GSL_MIN(index, 2*(N-1)-index);
+	case nsl_smooth_pad_constant:
+		return index < 0 ? n : n+1;
+	case nsl_smooth_pad_periodic:
+		return (size_t)(((index % N) + N) % N);
+	case nsl_smooth_pad_none:	/* window is reduced at the edges */
+	case nsl_smooth_pad_interp:	/* not implemented yet: use nearest */
+	case nsl_smooth_pad_nearest:
+		break;
+	}
+
+	return index < 0 ? 0 : n-1;
+}
+
+/* k-th smallest (0-based) value of the window stored as counts over the value ranks in the Fenwick tree */
+static size_t nsl_smooth_window_kth(const size_t* tree, size_t m, size_t k) {
+	size_t pos = 0, step = 1;
+	while (2*step <= m)
+		step *= 2;
+
+	for (; step > 0; step /= 2) {
+		if (pos + step <= m && tree[pos + step] <= k) {
+			pos += step;
+			k -= tree[pos];
+		}
+	}
+
+	return pos;	/* rank of the value */
+}
+
+static void nsl_smooth_window_update(size_t* tree, size_t m, size_t rank, int add) {
+	size_t i;
+	for (i = rank + 1; i <= m; i += i & (~i + 1))
+		tree[i] = add ? tree[i] + 1 : tree[i] - 1;
+}
+
+/* Sliding window percentile: all values that may enter the window are sorted once and the window is kept as a
+ * Fenwick tree of counts over their ranks. Moving the window and selecting an order statistic is O(log n). */
 int nsl_smooth_percentile(double *data, size_t n, size_t points, double percentile, nsl_smooth_pad_mode mode) {
 	if (n == 0 || points == 0)
 		return -1;
 
-	size_t i, j;
+	size_t i;
+	const size_t m = n + 2;	/* data and the two padding constants */
+	double *values = (double *)malloc(m * sizeof(double));
+	size_t *order = (size_t *)malloc(m * sizeof(size_t));
+	size_t *rank = (size_t *)malloc(m * sizeof(size_t));
+	size_t *tree = (size_t *)calloc(m + 1, sizeof(size_t));
 	double *result = (double *)malloc(n * sizeof(double));
+	if (values == NULL || order == NULL || rank == NULL || tree == NULL || result == NULL) {
+		free(values);
+		free(order);
+		free(rank);
+		free(tree);
+		free(result);
+		return -1;
+	}
 
+	for (i = 0; i < n; i++)
+		values[i] = data[i];
+	values[n] = nsl_smooth_pad_constant_lvalue;
+	values[n+1] = nsl_smooth_pad_constant_rvalue;
+	gsl_sort_index(order, values, 1, m);
+	for (i = 0; i < m; i++)
+		rank[order[i]] = i;
+
+	/* current window [lo, hi] of the padded signal */
+	long lo = 0, hi = -1;
 	for (i = 0; i < n; i++) {
 		size_t np = points;
 		size_t half = (points-1)/2;
@@ -314,54 +387,37 @@ int nsl_smooth_percentile(double *data, size_t n, size_t points, double percenti
 			half = GSL_MIN(GSL_MIN((points-1)/2, i), n-i-1);
 			np = 2*half+1;
 		}
+		const long newlo = (long)i - (long)half, newhi = newlo + (long)np - 1;
 
-		double *values = (double *)malloc(np*sizeof(double));
-		for (j = 0; j < np; j++) {
-			int index = (int)(i-half+j);
-			switch(mode) {
-			case nsl_smooth_pad_none:
-				/*printf(" %d",index);*/
-				values[j] = data[index];
-				break;
-			case nsl_smooth_pad_interp:
-				printf("not implemented yet\n");
-				break;
-			case nsl_smooth_pad_mirror:
-				index=abs(index);
-				/*printf(" %d",GSL_MIN(index,2*(n-1)-index));*/
-				values[j] = data[GSL_MIN(index, 2*((int)n-1)-index)];
-				break;
-			case nsl_smooth_pad_nearest:
-				/*printf(" %d",GSL_MIN(n-1,GSL_MAX(0,index)));*/
-				values[j] = data[GSL_MIN((int)n-1, GSL_MAX(0, index))];
-				break;
-			case nsl_smooth_pad_constant:
-				if (index < 0)
-					values[j] = nsl_smooth_pad_constant_lvalue;
-				else if (index > (int)n-1)
-					values[j] = nsl_smooth_pad_constant_rvalue;
-				else
-					values[j] = data[index];
-				break;
-			case nsl_smooth_pad_periodic:
-				if (index < 0)
-					index = index + (int)n;
-				else if (index > (int)n-1)
-					index = index - (int)n;
-				/*printf(" %d",index);*/
-				values[j] = data[index];
-				break;
-			}
+		if (i == 0) {
+			lo = newlo;
+			hi = newlo - 1;
+		}
+		while (hi < newhi)
+			nsl_smooth_window_update(tree, m, rank[nsl_smooth_pad_index(++hi, n, mode)], 1);
+		while (lo < newlo)
+			nsl_smooth_window_update(tree, m, rank[nsl_smooth_pad_index(lo++, n, mode)], 0);
+
+		/* quantile type 4 (see nsl_stats_quantile_sorted()) */
+		if (percentile < 1./np)
+			result[i] = values[order[nsl_smooth_window_kth(tree, m, 0)]];
+		else if (percentile >= 1.0)
+			result[i] = values[order[nsl_smooth_window_kth(tree, m, np-1)]];
+		else {
+			const size_t j = GSL_MAX((size_t)floor(np*percentile), 1);
+			const double a = values[order[nsl_smooth_window_kth(tree, m, j-1)]];
+			const double b = values[order[nsl_smooth_window_kth(tree, m, j)]];
+			result[i] = a + (np*percentile - j)*(b - a);
 		}
-		/*puts("");*/
-
-		/*using type 4 as default */
-		result[i] = nsl_stats_quantile(values, 1, np, percentile, nsl_stats_quantile_type4);
-		free(values);
 	}
 
 	for (i = 0; i < n; i++)
 		data[i] = result[i];
+
+	free(values);
+	free(order);
+	free(rank);
+	free(tree);
 	free(result);
 
 	return 0;
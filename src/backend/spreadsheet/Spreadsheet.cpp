@@ -43,6 +43,8 @@
 #include <KSharedConfig>
 
 #include <algorithm>
+#include <functional>
+#include <numeric>
 
 /*!
   \class Spreadsheet
@@ -373,6 +375,22 @@ int Spreadsheet::colY(int col) {
 	return -1;
 }
 
+/*!
+ * returns the rank of each string in the dictionary of the dictionary encoded text column \c col,
+ * comparing the ranks of the rows is equivalent to comparing their strings.
+ */
+static QVector<int> textDictionaryRanks(const Column* col) {
+	const auto& dictionary = col->textDictionary();
+	QVector<int> order(dictionary.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&dictionary](int a, int b) { return dictionary.at(a) < dictionary.at(b); });
+
+	QVector<int> ranks(dictionary.size());
+	for (int i = 0; i < order.size(); i++)
+		ranks[order.at(i)] = i;
+	return ranks;
+}
+
 /*! Sorts the given list of column.
   If 'leading' is a null pointer, each column is sorted separately.
 */
@@ -410,12 +428,6 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 		static bool QStringGreater(const QPair<QString, int>& a, const QPair<QString, int>& b) {
 			return a > b;
 		}
-		static bool QDateTimeLess(const QPair<QDateTime, int>& a, const QPair<QDateTime, int>& b) {
-			return a < b;
-		}
-		static bool QDateTimeGreater(const QPair<QDateTime, int>& a, const QPair<QDateTime, int>& b) {
-			return a > b;
-		}
 	};
 
 	WAIT_CURSOR;
@@ -491,21 +503,43 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 					break;
 				}
 			case AbstractColumn::ColumnMode::Text: {
-					QVector<QPair<QString, int>> map;
-
-					for (int i = 0; i < rows; i++)
-						if (!col->textAt(i).isEmpty())
-							map.append(QPair<QString, int>(col->textAt(i), i));
-					const int filledRows = map.size();
+					QVector<int> order;
+					if (col->isTextEncoded()) {
+						// dictionary encoded: sort the ranks of the distinct strings instead of the strings
+						const QVector<int> ranks = textDictionaryRanks(col);
+						const auto& dictionary = col->textDictionary();
+						QVector<QPair<int, int>> map;
+						for (int i = 0; i < rows; i++) {
+							const int code = col->textCodeAt(i);
+							if (code != -1 && !dictionary.at(code).isEmpty())
+								map.append(QPair<int, int>(ranks.at(code), i));
+						}
 
-					if (ascending)
-						std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-					else
-						std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
+						// compare like QStringLess/QStringGreater
+						if (ascending)
+							std::stable_sort(map.begin(), map.end(), std::less<QPair<int, int>>());
+						else
+							std::stable_sort(map.begin(), map.end(), std::greater<QPair<int, int>>());
+						for (const auto& pair : map)
+							order << pair.second;
+					} else {
+						QVector<QPair<QString, int>> map;
+						for (int i = 0; i < rows; i++)
+							if (!col->textAt(i).isEmpty())
+								map.append(QPair<QString, int>(col->textAt(i), i));
+
+						if (ascending)
+							std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
+						else
+							std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
+						for (const auto& pair : map)
+							order << pair.second;
+					}
+					const int filledRows = order.size();
 
 					// put the values in the right order into tempCol
 					for (int i = 0; i < filledRows; i++) {
-						int idx = map.at(i).second;
+						int idx = order.at(i);
 						//too slow: tempCol->copy(col, idx, i, 1);
 						tempCol->setFromColumn(i, col, idx);
 						tempCol->setMasked(col->isMasked(idx));
@@ -515,17 +549,18 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 			case AbstractColumn::ColumnMode::DateTime:
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day: {
-					QVector< QPair<QDateTime, int> > map;
+					// sort the milliseconds since epoch, no QDateTime conversion needed
+					QVector< QPair<qint64, int> > map;
 
 					for (int i = 0; i < rows; i++)
 						if (col->isValid(i))
-							map.append(QPair<QDateTime, int>(col->dateTimeAt(i), i));
+							map.append(QPair<qint64, int>(col->dateTimeMSecsAt(i), i));
 					const int filledRows = map.size();
 
 					if (ascending)
-						std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
+						std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntLess);
 					else
-						std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
+						std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntGreater);
 
 					// put the values in the right order into tempCol
 					for (int i = 0; i < filledRows; i++) {
@@ -642,28 +677,53 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 				break;
 			}
 		case AbstractColumn::ColumnMode::Text: {
-				QVector<QPair<QString, int>> map;
+				QVector<int> order;
 				QVector<int> emptyIndex;
 
-				for (int i = 0; i < rows; i++)
-					if (!leading->textAt(i).isEmpty())
-						map.append(QPair<QString, int>(leading->textAt(i), i));
+				if (leading->isTextEncoded()) {
+					// dictionary encoded: sort the ranks of the distinct strings instead of the strings
+					const QVector<int> ranks = textDictionaryRanks(leading);
+					const auto& dictionary = leading->textDictionary();
+					QVector<QPair<int, int>> map;
+					for (int i = 0; i < rows; i++) {
+						const int code = leading->textCodeAt(i);
+						if (code != -1 && !dictionary.at(code).isEmpty())
+							map.append(QPair<int, int>(ranks.at(code), i));
+						else
+							emptyIndex << i;
+					}
+
+					// compare like QStringLess/QStringGreater
+					if (ascending)
+						std::stable_sort(map.begin(), map.end(), std::less<QPair<int, int>>());
 					else
-						emptyIndex << i;
+						std::stable_sort(map.begin(), map.end(), std::greater<QPair<int, int>>());
+					for (const auto& pair : map)
+						order << pair.second;
+				} else {
+					QVector<QPair<QString, int>> map;
+					for (int i = 0; i < rows; i++)
+						if (!leading->textAt(i).isEmpty())
+							map.append(QPair<QString, int>(leading->textAt(i), i));
+						else
+							emptyIndex << i;
+
+					if (ascending)
+						std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
+					else
+						std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
+					for (const auto& pair : map)
+						order << pair.second;
+				}
 				//QDEBUG("	empty indices: " << emptyIndex)
-				const int filledRows = map.size();
+				const int filledRows = order.size();
 				const int emptyRows = emptyIndex.size();
 
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
-
 				for (auto* col : cols) {
 					std::unique_ptr<Column> tempCol(new Column("temp", col->columnMode()));
 					// put the values in the right order into tempCol
 					for (int i = 0; i < filledRows; i++) {
-						int idx = map.at(i).second;
+						int idx = order.at(i);
 						//too slow: tempCol->copy(col, idx, i, 1);
 						tempCol->setFromColumn(i, col, idx);
 						tempCol->setMasked(col->isMasked(idx));
@@ -689,21 +749,21 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day: {
-				QVector<QPair<QDateTime, int>> map;
+				QVector<QPair<qint64, int>> map;
 				QVector<int> invalidIndex;
 
 				for (int i = 0; i < rows; i++)
 					if (leading->isValid(i))
-						map.append(QPair<QDateTime, int>(leading->dateTimeAt(i), i));
+						map.append(QPair<qint64, int>(leading->dateTimeMSecsAt(i), i));
 					else
 						invalidIndex << i;
 				const int filledRows = map.size();
 				const int invalidRows = invalidIndex.size();
 
 				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
+					std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntLess);
 				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
+					std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntGreater);
 
 				for (auto* col : cols) {
 					std::unique_ptr<Column> tempCol(new Column("temp", col->columnMode()));
@@ -931,8 +991,12 @@ int Spreadsheet::prepareImport(std::vector<void*>& dataContainer, AbstractFileFi
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::DateTime: {
-			auto* vector = static_cast<QVector<QDateTime>* >(column->data());
-			vector->resize(actualRows);
+			// date-time values are stored as milliseconds since epoch
+			auto* vector = static_cast<QVector<qint64>*>(column->data());
+			if (actualRows > vector->size())
+				vector->insert(vector->end(), actualRows - vector->size(), AbstractColumn::invalidDateTime);
+			else
+				vector->resize(actualRows);
 			dataContainer[n] = static_cast<void*>(vector);
 			break;
 		}
@@ -1041,6 +1105,10 @@ void Spreadsheet::finalizeImport(int columnOffset, int startColumn, int endColum
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			comment = i18np("text data, %1 element", "text data, %1 elements", rows);
+			// categorical data with few distinct values is stored dictionary encoded.
+			// not for live data, the column would be re-encoded on every update
+			if (type() != AspectType::LiveDataSource)
+				column->encodeText();
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			comment = i18np("month data, %1 element", "month data, %1 elements", rows);
@@ -31,6 +31,12 @@
   \class XYAnalysisCurve
   \brief Base class for all analysis curves
 
+  The recalculation of the result can be done either synchronously via recalculate()
+  or in the background via recalculateAsync(). In the latter case the calculation part
+  is executed in recalculationPool(), a recalculation that is still running when the
+  source data changes again is cancelled and restarted. The result vectors are swapped
+  into the result columns in the GUI thread once the calculation is done.
+
   \ingroup worksheet
 */
 
@@ -42,6 +48,8 @@
 
 #include <KLocalizedString>
 #include <QDateTime>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 
 XYAnalysisCurve::XYAnalysisCurve(const QString& name, AspectType type)
 	: XYCurve(name, new XYAnalysisCurvePrivate(this), type) {
@@ -57,7 +65,11 @@ XYAnalysisCurve::XYAnalysisCurve(const QString& name, XYAnalysisCurvePrivate* dd
 
 //no need to delete the d-pointer here - it inherits from QGraphicsItem
 //and is deleted during the cleanup in QGraphicsScene
-XYAnalysisCurve::~XYAnalysisCurve() = default;
+XYAnalysisCurve::~XYAnalysisCurve() {
+	//the calculation running in the background accesses the private data, stop it first
+	cancelRecalculation();
+	waitForRecalculation();
+}
 
 void XYAnalysisCurve::init() {
 	Q_D(XYAnalysisCurve);
@@ -65,6 +77,64 @@ void XYAnalysisCurve::init() {
 	d->symbolsStyle = Symbol::Style::NoSymbols;
 }
 
+/*!
+ * thread pool shared by all analysis curves for the recalculations in the background.
+ */
+QThreadPool* XYAnalysisCurve::recalculationPool() {
+	static QThreadPool pool;
+	return &pool;
+}
+
+/*!
+ * recalculates the curve in the background. A recalculation that is already running is cancelled
+ * and restarted when finished. If the data source is another analysis curve that is being recalculated
+ * at the moment, the recalculation is started once the source curve is done.
+ */
+void XYAnalysisCurve::recalculateAsync() {
+	Q_D(XYAnalysisCurve);
+	if (d->recalculating) {
+		d->recalculationCancelFlag.store(1);
+		d->recalculationPending = true;
+		return;
+	}
+
+	const auto* sourceCurve = dynamic_cast<const XYAnalysisCurve*>(d->dataSourceCurve);
+	if (d->dataSourceType == DataSourceType::Curve && sourceCurve && sourceCurve->isRecalculating()) {
+		d->recalculationPending = true;
+		connect(sourceCurve, &XYAnalysisCurve::recalculationFinished, this, &XYAnalysisCurve::recalculatePending, Qt::UniqueConnection);
+		return;
+	}
+
+	d->recalculationPending = false;
+	d->asyncRecalculation = true;
+	recalculate();
+	d->asyncRecalculation = false;
+}
+
+/*!
+ * cancels the recalculation running in the background, the result of the cancelled recalculation is discarded.
+ */
+void XYAnalysisCurve::cancelRecalculation() {
+	Q_D(XYAnalysisCurve);
+	d->recalculationPending = false;
+	if (d->recalculating)
+		d->recalculationCancelFlag.store(1);
+}
+
+/*!
+ * blocks until the calculation running in the background is done.
+ */
+void XYAnalysisCurve::waitForRecalculation() {
+	Q_D(XYAnalysisCurve);
+	if (d->recalculationWatcher)
+		d->recalculationWatcher->waitForFinished();
+}
+
+bool XYAnalysisCurve::isRecalculating() const {
+	Q_D(const XYAnalysisCurve);
+	return d->recalculating;
+}
+
 void XYAnalysisCurve::copyData(QVector<double>& xData, QVector<double>& yData,
 							   const AbstractColumn* xDataColumn, const AbstractColumn* yDataColumn,
 							   double xMin, double xMax) {
@@ -91,7 +161,7 @@ void XYAnalysisCurve::copyData(QVector<double>& xData, QVector<double>& yData,
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::Month:
-			x = xDataColumn->dateTimeAt(row).toMSecsSinceEpoch();
+			x = xDataColumn->dateTimeMSecsAt(row);
 		}
 
 		double y = NAN;
@@ -110,7 +180,7 @@ void XYAnalysisCurve::copyData(QVector<double>& xData, QVector<double>& yData,
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::Month:
-			y = yDataColumn->dateTimeAt(row).toMSecsSinceEpoch();
+			y = yDataColumn->dateTimeMSecsAt(row);
 		}
 
 		// only when inside given range
@@ -136,6 +206,7 @@ BASIC_SHARED_D_READER_IMPL(XYAnalysisCurve, const AbstractColumn*, y2DataColumn,
 CLASS_SHARED_D_READER_IMPL(XYAnalysisCurve, QString, xDataColumnPath, xDataColumnPath)
 CLASS_SHARED_D_READER_IMPL(XYAnalysisCurve, QString, yDataColumnPath, yDataColumnPath)
 CLASS_SHARED_D_READER_IMPL(XYAnalysisCurve, QString, y2DataColumnPath, y2DataColumnPath)
+BASIC_SHARED_D_READER_IMPL(XYAnalysisCurve, bool, autoRecalculate, autoRecalculate)
 
 //##############################################################################
 //#################  setter methods and undo commands ##########################
@@ -224,6 +295,13 @@ void XYAnalysisCurve::setY2DataColumn(const AbstractColumn* column) {
 	}
 }
 
+STD_SETTER_CMD_IMPL_S(XYAnalysisCurve, SetAutoRecalculate, bool, autoRecalculate)
+void XYAnalysisCurve::setAutoRecalculate(bool autoRecalculate) {
+	Q_D(XYAnalysisCurve);
+	if (autoRecalculate != d->autoRecalculate)
+		exec(new XYAnalysisCurveSetAutoRecalculateCmd(d, autoRecalculate, ki18n("%1: change auto recalculation")));
+}
+
 void XYAnalysisCurve::setXDataColumnPath(const QString& path) {
 	Q_D(XYAnalysisCurve);
 	d->xDataColumnPath = path;
@@ -246,11 +324,15 @@ void XYAnalysisCurve::handleSourceDataChanged() {
 	Q_D(XYAnalysisCurve);
 	d->sourceDataChangedSinceLastRecalc = true;
 	emit sourceDataChanged();
+
+	if (d->autoRecalculate)
+		recalculateAsync();
 }
 
 void XYAnalysisCurve::xDataColumnAboutToBeRemoved(const AbstractAspect* aspect) {
 	Q_D(XYAnalysisCurve);
 	if (aspect == d->xDataColumn) {
+		cancelRecalculation();	//the result of the running recalculation is obsolete
 		d->xDataColumn = nullptr;
 		d->retransform();
 	}
@@ -259,6 +341,7 @@ void XYAnalysisCurve::xDataColumnAboutToBeRemoved(const AbstractAspect* aspect)
 void XYAnalysisCurve::yDataColumnAboutToBeRemoved(const AbstractAspect* aspect) {
 	Q_D(XYAnalysisCurve);
 	if (aspect == d->yDataColumn) {
+		cancelRecalculation();
 		d->yDataColumn = nullptr;
 		d->retransform();
 	}
@@ -287,6 +370,44 @@ void XYAnalysisCurve::y2DataColumnNameChanged() {
 	setYDataColumnPath(d->y2DataColumn->path());
 }
 
+/*!
+ * called in the GUI thread when the calculation running in the background is done.
+ */
+void XYAnalysisCurve::recalculationDone() {
+	Q_D(XYAnalysisCurve);
+	if (!d->recalculating) //outdated notification, the recalculation was already replaced by a synchronous one
+		return;
+
+	d->recalculating = false;
+	auto finish = d->recalculationFinish;
+	d->recalculationFinish = nullptr;
+
+	if (d->recalculationCancelFlag.load()) {
+		//result is outdated, start again if requested in the meantime
+		d->xResultVector.clear();
+		d->yResultVector.clear();
+		if (d->recalculationPending)
+			recalculateAsync();
+		return;
+	}
+
+	if (finish)
+		finish();
+	emit recalculationFinished();
+}
+
+/*!
+ * starts the recalculation that was postponed while the source curve was recalculated.
+ */
+void XYAnalysisCurve::recalculatePending() {
+	Q_D(XYAnalysisCurve);
+	const auto* sourceCurve = dynamic_cast<const XYAnalysisCurve*>(d->dataSourceCurve);
+	if (sourceCurve)
+		disconnect(sourceCurve, &XYAnalysisCurve::recalculationFinished, this, &XYAnalysisCurve::recalculatePending);
+	if (d->recalculationPending)
+		recalculateAsync();
+}
+
 //##############################################################################
 //######################### Private implementation #############################
 //##############################################################################
@@ -297,6 +418,79 @@ XYAnalysisCurvePrivate::XYAnalysisCurvePrivate(XYAnalysisCurve* owner) : XYCurve
 //when the parent aspect is removed
 XYAnalysisCurvePrivate::~XYAnalysisCurvePrivate() = default;
 
+/*!
+ * executes the recalculation. \c calculate contains the expensive part of the recalculation that
+ * doesn't access any columns or the GUI and that writes its result into xResultVector and yResultVector
+ * (and into further result members of the derived class). \c finish applies the result in the GUI thread.
+ * The calculation is done in the background if the recalculation was triggered via XYAnalysisCurve::recalculateAsync(),
+ * both parts are executed immediately otherwise.
+ */
+void XYAnalysisCurvePrivate::runRecalculation(const std::function<void()>& calculate, const std::function<void()>& finish) {
+	if (!asyncRecalculation) {
+		//synchronous recalculation requested while another one is running in the background: drop the other one
+		if (recalculating) {
+			q->cancelRecalculation();
+			q->waitForRecalculation();
+			recalculating = false;
+			recalculationFinish = nullptr;
+		}
+		recalculationCancelFlag.store(0);
+		calculate();
+		finish();
+		return;
+	}
+
+	if (!recalculationWatcher) {
+		recalculationWatcher = new QFutureWatcher<void>(q);
+		QObject::connect(recalculationWatcher, &QFutureWatcher<void>::finished, q, &XYAnalysisCurve::recalculationDone);
+	}
+
+	recalculating = true;
+	recalculationCancelFlag.store(0);
+	recalculationFinish = finish;
+	emit q->recalculationStarted();
+	recalculationWatcher->setFuture(QtConcurrent::run(XYAnalysisCurve::recalculationPool(), calculate));
+}
+
+/*!
+ * returns \c true if the running calculation should be stopped since its result is not needed anymore.
+ * To be checked in the calculation part of the recalculation.
+ */
+bool XYAnalysisCurvePrivate::recalculationCancelled() const {
+	return recalculationCancelFlag.load() != 0;
+}
+
+/*!
+ * reports the progress of the calculation running in the background, ignored for synchronous recalculations.
+ * To be called in the calculation part of the recalculation.
+ */
+void XYAnalysisCurvePrivate::setRecalculationProgress(int percentage) {
+	if (recalculating)
+		emit q->recalculationProgress(percentage);
+}
+
+/*!
+ * puts the calculated x- and y-values into the result columns. The previous content is dropped.
+ */
+void XYAnalysisCurvePrivate::swapResultVectors() {
+	xVector->swap(xResultVector);
+	yVector->swap(yResultVector);
+	xResultVector.clear();
+	yResultVector.clear();
+}
+
+/*!
+ * clears the result columns, used if the recalculation can't be carried out.
+ * The result of a recalculation still running in the background is outdated and dropped.
+ */
+void XYAnalysisCurvePrivate::clearResultVectors() {
+	if (recalculating)
+		q->cancelRecalculation();
+
+	xVector->clear();
+	yVector->clear();
+}
+
 //##############################################################################
 //##################  Serialization/Deserialization  ###########################
 //##############################################################################
@@ -305,6 +499,7 @@ void XYAnalysisCurve::save(QXmlStreamWriter* writer) const {
 	Q_D(const XYAnalysisCurve);
 
 	writer->writeStartElement("xyAnalysisCurve");
+	writer->writeAttribute("autoRecalculate", QString::number(d->autoRecalculate));
 
 	//write xy-curve information
 	XYCurve::save(writer);
@@ -329,6 +524,11 @@ bool XYAnalysisCurve::load(XmlStreamReader* reader, bool preview) {
 	QXmlStreamAttributes attribs;
 	QString str;
 
+	attribs = reader->attributes();
+	str = attribs.value("autoRecalculate").toString();
+	if (!str.isEmpty()) //not available in projects created with older versions
+		d->autoRecalculate = str.toInt();
+
 	while (!reader->atEnd()) {
 		reader->readNext();
 		if (reader->isEndElement() && reader->name() == "xyAnalysisCurve")
@@ -33,6 +33,7 @@
 #include "backend/worksheet/plots/cartesian/XYCurve.h"
 
 class XYAnalysisCurvePrivate;
+class QThreadPool;
 
 class XYAnalysisCurve : public XYCurve {
 	Q_OBJECT
@@ -46,6 +47,12 @@ public:
 	static void copyData(QVector<double>& xData, QVector<double>& yData, const AbstractColumn* xDataColumn, const AbstractColumn* yDataColumn, double xMin, double xMax);
 
 	virtual void recalculate() = 0;
+	void recalculateAsync();
+	void cancelRecalculation();
+	void waitForRecalculation();
+	bool isRecalculating() const;
+	static QThreadPool* recalculationPool();
+
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*, bool preview) override;
 
@@ -59,6 +66,7 @@ public:
 	CLASS_D_ACCESSOR_DECL(QString, xDataColumnPath, XDataColumnPath)
 	CLASS_D_ACCESSOR_DECL(QString, yDataColumnPath, YDataColumnPath)
 	CLASS_D_ACCESSOR_DECL(QString, y2DataColumnPath, Y2DataColumnPath)
+	BASIC_D_ACCESSOR_DECL(bool, autoRecalculate, AutoRecalculate)
 
 	typedef XYAnalysisCurvePrivate Private;
 
@@ -78,6 +86,8 @@ private slots:
 	void xDataColumnNameChanged();
 	void yDataColumnNameChanged();
 	void y2DataColumnNameChanged();
+	void recalculationDone();
+	void recalculatePending();
 
 signals:
 	void sourceDataChanged(); //emitted when the source data used in the analysis curves was changed to enable the recalculation in the dock widgets
@@ -86,6 +96,10 @@ signals:
 	void xDataColumnChanged(const AbstractColumn*);
 	void yDataColumnChanged(const AbstractColumn*);
 	void y2DataColumnChanged(const AbstractColumn*);
+	void autoRecalculateChanged(bool);
+	void recalculationStarted();
+	void recalculationProgress(int); //emitted from the worker thread, percentage of the running recalculation
+	void recalculationFinished();
 };
 
 #endif
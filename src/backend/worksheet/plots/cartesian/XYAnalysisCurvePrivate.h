@@ -31,6 +31,12 @@
 
 #include "backend/worksheet/plots/cartesian/XYCurvePrivate.h"
 
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+
+#include <functional>
+
 class XYAnalysisCurve;
 class Column;
 class AbstractColumn;
@@ -40,6 +46,12 @@ public:
 	explicit XYAnalysisCurvePrivate(XYAnalysisCurve*);
 	~XYAnalysisCurvePrivate() override;
 
+	void runRecalculation(const std::function<void()>& calculate, const std::function<void()>& finish);
+	bool recalculationCancelled() const;
+	void setRecalculationProgress(int);
+	void swapResultVectors();
+	void clearResultVectors();
+
 	XYAnalysisCurve::DataSourceType dataSourceType{XYAnalysisCurve::DataSourceType::Spreadsheet};
 	const XYCurve* dataSourceCurve{nullptr};
 
@@ -55,6 +67,17 @@ public:
 	QVector<double>* xVector{nullptr};
 	QVector<double>* yVector{nullptr};
 
+	bool autoRecalculate{false}; //<! recalculate in the background when the source data was changed
+	bool asyncRecalculation{false}; //<! true if the current call of recalculate() was triggered via XYAnalysisCurve::recalculateAsync()
+	bool recalculating{false}; //<! true from the start of a background recalculation until its result was applied
+	bool recalculationPending{false}; //<! recalculate again once the running recalculation or the one of the source curve is done
+	QAtomicInt recalculationCancelFlag;
+	QFutureWatcher<void>* recalculationWatcher{nullptr};
+	std::function<void()> recalculationFinish; //<! part of the recalculation to be executed in the GUI thread after the calculation
+	QElapsedTimer recalculationTimer;
+	QVector<double> xResultVector; //<! x-values calculated in the background, swapped with xVector when finished
+	QVector<double> yResultVector; //<! y-values calculated in the background, swapped with yVector when finished
+
 	XYAnalysisCurve* const q;
 };
 
@@ -102,10 +102,9 @@ XYConvolutionCurvePrivate::XYConvolutionCurvePrivate(XYConvolutionCurve* owner)
 XYConvolutionCurvePrivate::~XYConvolutionCurvePrivate() = default;
 
 void XYConvolutionCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
+	recalculationTimer.start();
 
-	//create convolution result columns if not available yet, clear them otherwise
+	//create convolution result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Numeric);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Numeric);
@@ -121,14 +120,8 @@ void XYConvolutionCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	//clear the previous result
-	convolutionResult = XYConvolutionCurve::ConvolutionResult();
-
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
@@ -146,6 +139,8 @@ void XYConvolutionCurvePrivate::recalculate() {
 	}
 
 	if (tmpYDataColumn == nullptr) {
+		convolutionResult = XYConvolutionCurve::ConvolutionResult();
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -202,19 +197,17 @@ void XYConvolutionCurvePrivate::recalculate() {
 	const size_t n = (size_t)ydataVector.size();	// number of points for signal
 	const size_t m = (size_t)y2dataVector.size();	// number of points for response
 	if (n < 1 || m < 1) {
+		convolutionResult = XYConvolutionCurve::ConvolutionResult();
 		convolutionResult.available = true;
 		convolutionResult.valid = false;
 		convolutionResult.status = i18n("Not enough data points available.");
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-	double* y2data = y2dataVector.data();
-
 	// convolution settings
 	const double samplingInterval = convolutionData.samplingInterval;
 	const nsl_conv_direction_type direction = convolutionData.direction;
@@ -231,49 +224,70 @@ void XYConvolutionCurvePrivate::recalculate() {
 	DEBUG("norm = " << nsl_conv_norm_name[norm]);
 	DEBUG("wrap = " << nsl_conv_wrap_name[wrap]);
 
-///////////////////////////////////////////////////////////
-	size_t np;
-	if (type == nsl_conv_type_linear)
-		np = n + m - 1;
-	else
-		np = GSL_MAX(n, m);
+	const bool hasXData = (tmpXDataColumn != nullptr);
 
-	double* out = (double*)malloc(np * sizeof(double));
-	int status = nsl_conv_convolution_direction(ydata, n, y2data, m, direction, type, method, norm, wrap, out);
+	//the convolution doesn't access any columns and can be done in the background
+	auto calculate = [=]() mutable {
+		double* xdata = xdataVector.data();
+		double* ydata = ydataVector.data();
+		double* y2data = y2dataVector.data();
 
-	if (direction == nsl_conv_direction_backward)
+///////////////////////////////////////////////////////////
+		size_t np;
 		if (type == nsl_conv_type_linear)
-			np = abs((int)(n - m)) + 1;
-
-	xVector->resize((int)np);
-	yVector->resize((int)np);
-	// take given x-axis values or use index
-	if (tmpXDataColumn != nullptr) {
-		int size = GSL_MIN(xdataVector.size(), (int)np);
-		memcpy(xVector->data(), xdata, size * sizeof(double));
-		double sampleInterval = (xVector->data()[size-1] - xVector->data()[0])/(xdataVector.size()-1);
-		DEBUG("xdata size = " << xdataVector.size() << ", np = " << np << ", sample interval = " << sampleInterval);
-		for (int i = size; i < (int)np; i++)	// fill missing values
-			xVector->data()[i] = xVector->data()[size-1] + (i-size+1) * sampleInterval;
-	} else {	// fill with index (starting with 0)
-		for (size_t i = 0; i < np; i++)
-			xVector->data()[i] = i * samplingInterval;
-	}
+			np = n + m - 1;
+		else
+			np = GSL_MAX(n, m);
+
+		double* out = (double*)malloc(np * sizeof(double));
+		convolutionStatus = nsl_conv_convolution_direction(ydata, n, y2data, m, direction, type, method, norm, wrap, out);
+		if (recalculationCancelled()) {
+			free(out);
+			return;
+		}
+		setRecalculationProgress(90);
+
+		if (direction == nsl_conv_direction_backward)
+			if (type == nsl_conv_type_linear)
+				np = abs((int)(n - m)) + 1;
+
+		xResultVector.resize((int)np);
+		yResultVector.resize((int)np);
+		// take given x-axis values or use index
+		if (hasXData) {
+			int size = GSL_MIN(xdataVector.size(), (int)np);
+			memcpy(xResultVector.data(), xdata, size * sizeof(double));
+			double sampleInterval = (xResultVector.data()[size-1] - xResultVector.data()[0])/(xdataVector.size()-1);
+			DEBUG("xdata size = " << xdataVector.size() << ", np = " << np << ", sample interval = " << sampleInterval);
+			for (int i = size; i < (int)np; i++)	// fill missing values
+				xResultVector.data()[i] = xResultVector.data()[size-1] + (i-size+1) * sampleInterval;
+		} else {	// fill with index (starting with 0)
+			for (size_t i = 0; i < np; i++)
+				xResultVector.data()[i] = i * samplingInterval;
+		}
 
-	memcpy(yVector->data(), out, np * sizeof(double));
-	free(out);
+		memcpy(yResultVector.data(), out, np * sizeof(double));
+		free(out);
 ///////////////////////////////////////////////////////////
+	};
+
+	auto finish = [=]() {
+		swapResultVectors();
+
+		//write the result
+		convolutionResult = XYConvolutionCurve::ConvolutionResult();
+		convolutionResult.available = true;
+		convolutionResult.valid = true;
+		convolutionResult.status = QString::number(convolutionStatus);
+		convolutionResult.elapsedTime = recalculationTimer.elapsed();
 
-	//write the result
-	convolutionResult.available = true;
-	convolutionResult.valid = true;
-	convolutionResult.status = QString::number(status);
-	convolutionResult.elapsedTime = timer.elapsed();
+		//redraw the curve
+		recalcLogicalPoints();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	emit q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runRecalculation(calculate, finish);
 }
 
 //##############################################################################
@@ -49,7 +49,7 @@ public:
 		size_t kernelSize{2};					// size of kernel
 		nsl_conv_direction_type direction{nsl_conv_direction_forward};	// forward (convolution) or backward (deconvolution)
 		nsl_conv_type_type type{nsl_conv_type_linear};		// linear or circular
-		nsl_conv_method_type method{nsl_conv_method_auto};	// how to calculate convolution (auto, direct or FFT method)
+		nsl_conv_method_type method{nsl_conv_method_auto};	// how to calculate convolution (auto, direct, FFT or overlap-add method)
 		nsl_conv_norm_type normalize{nsl_conv_norm_none};	// normalization of response
 		nsl_conv_wrap_type wrap{nsl_conv_wrap_none};		// wrap response
 		bool autoRange{true};					// use all data?
@@ -44,6 +44,7 @@ public:
 
 	XYConvolutionCurve::ConvolutionData convolutionData;
 	XYConvolutionCurve::ConvolutionResult convolutionResult;
+	int convolutionStatus{0};
 
 	XYConvolutionCurve* const q;
 };
@@ -103,10 +103,9 @@ XYCorrelationCurvePrivate::~XYCorrelationCurvePrivate() = default;
 
 void XYCorrelationCurvePrivate::recalculate() {
 	DEBUG("XYCorrelationCurvePrivate::recalculate()");
-	QElapsedTimer timer;
-	timer.start();
+	recalculationTimer.start();
 
-	//create correlation result columns if not available yet, clear them otherwise
+	//create correlation result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Numeric);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Numeric);
@@ -122,14 +121,8 @@ void XYCorrelationCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	//clear the previous result
-	correlationResult = XYCorrelationCurve::CorrelationResult();
-
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
@@ -147,6 +140,8 @@ void XYCorrelationCurvePrivate::recalculate() {
 	}
 
 	if (tmpYDataColumn == nullptr || tmpY2DataColumn == nullptr) {
+		correlationResult = XYCorrelationCurve::CorrelationResult();
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -193,19 +188,17 @@ void XYCorrelationCurvePrivate::recalculate() {
 	const size_t n = (size_t)ydataVector.size();	// number of points for signal
 	const size_t m = (size_t)y2dataVector.size();	// number of points for response
 	if (n < 1 || m < 1) {
+		correlationResult = XYCorrelationCurve::CorrelationResult();
 		correlationResult.available = true;
 		correlationResult.valid = false;
 		correlationResult.status = i18n("Not enough data points available.");
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-	double* y2data = y2dataVector.data();
-
 	// correlation settings
 	const double samplingInterval = correlationData.samplingInterval;
 	const nsl_corr_type_type type = correlationData.type;
@@ -216,47 +209,68 @@ void XYCorrelationCurvePrivate::recalculate() {
 	DEBUG("type = " << nsl_corr_type_name[type]);
 	DEBUG("norm = " << nsl_corr_norm_name[norm]);
 
+	const bool hasXData = (tmpXDataColumn != nullptr);
+
+	//the correlation doesn't access any columns and can be done in the background
+	auto calculate = [=]() mutable {
+		double* xdata = xdataVector.data();
+		double* ydata = ydataVector.data();
+		double* y2data = y2dataVector.data();
+
 ///////////////////////////////////////////////////////////
-	size_t np = GSL_MAX(n, m);
-	if (type == nsl_corr_type_linear)
-		np = 2 * np - 1;
-
-	double* out = (double*)malloc(np * sizeof(double));
-	int status = nsl_corr_correlation(ydata, n, y2data, m, type, norm, out);
-
-	xVector->resize((int)np);
-	yVector->resize((int)np);
-	// take given x-axis values or use index
-	if (tmpXDataColumn != nullptr) {
-		int size = GSL_MIN(xdataVector.size(), (int)np);
-		memcpy(xVector->data(), xdata, size * sizeof(double));
-		double sampleInterval = (xVector->data()[size-1] - xVector->data()[0])/(xdataVector.size()-1);
-		DEBUG("xdata size = " << xdataVector.size() << ", np = " << np << ", sample interval = " << sampleInterval);
-		for (int i = size; i < (int)np; i++)	// fill missing values
-			xVector->data()[i] = xVector->data()[size-1] + (i-size+1) * sampleInterval;
-	} else {	// fill with index (starting with 0)
+		size_t np = GSL_MAX(n, m);
 		if (type == nsl_corr_type_linear)
-			for (size_t i = 0; i < np; i++)
-				xVector->data()[i] = (int)(i-np/2) * samplingInterval;
-		else
-			for (size_t i = 0; i < np; i++)
-				xVector->data()[i] = (int)i * samplingInterval;
-	}
+			np = 2 * np - 1;
 
-	memcpy(yVector->data(), out, np * sizeof(double));
-	free(out);
+		double* out = (double*)malloc(np * sizeof(double));
+		correlationStatus = nsl_corr_correlation(ydata, n, y2data, m, type, norm, out);
+		if (recalculationCancelled()) {
+			free(out);
+			return;
+		}
+		setRecalculationProgress(90);
+
+		xResultVector.resize((int)np);
+		yResultVector.resize((int)np);
+		// take given x-axis values or use index
+		if (hasXData) {
+			int size = GSL_MIN(xdataVector.size(), (int)np);
+			memcpy(xResultVector.data(), xdata, size * sizeof(double));
+			double sampleInterval = (xResultVector.data()[size-1] - xResultVector.data()[0])/(xdataVector.size()-1);
+			DEBUG("xdata size = " << xdataVector.size() << ", np = " << np << ", sample interval = " << sampleInterval);
+			for (int i = size; i < (int)np; i++)	// fill missing values
+				xResultVector.data()[i] = xResultVector.data()[size-1] + (i-size+1) * sampleInterval;
+		} else {	// fill with index (starting with 0)
+			if (type == nsl_corr_type_linear)
+				for (size_t i = 0; i < np; i++)
+					xResultVector.data()[i] = (int)(i-np/2) * samplingInterval;
+			else
+				for (size_t i = 0; i < np; i++)
+					xResultVector.data()[i] = (int)i * samplingInterval;
+		}
+
+		memcpy(yResultVector.data(), out, np * sizeof(double));
+		free(out);
 ///////////////////////////////////////////////////////////
+	};
+
+	auto finish = [=]() {
+		swapResultVectors();
+
+		//write the result
+		correlationResult = XYCorrelationCurve::CorrelationResult();
+		correlationResult.available = true;
+		correlationResult.valid = true;
+		correlationResult.status = QString::number(correlationStatus);
+		correlationResult.elapsedTime = recalculationTimer.elapsed();
 
-	//write the result
-	correlationResult.available = true;
-	correlationResult.valid = true;
-	correlationResult.status = QString::number(status);
-	correlationResult.elapsedTime = timer.elapsed();
+		//redraw the curve
+		recalcLogicalPoints();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	emit q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runRecalculation(calculate, finish);
 }
 
 //##############################################################################
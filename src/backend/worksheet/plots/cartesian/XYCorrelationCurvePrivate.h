@@ -44,6 +44,7 @@ public:
 
 	XYCorrelationCurve::CorrelationData correlationData;
 	XYCorrelationCurve::CorrelationResult correlationResult;
+	int correlationStatus{0};
 
 	XYCorrelationCurve* const q;
 };
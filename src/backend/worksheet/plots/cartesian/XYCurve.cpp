@@ -59,6 +59,8 @@
 #include <KLocalizedString>
 #include <KSharedConfig>
 
+#include <cmath>
+
 extern "C" {
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_spline.h>
@@ -998,6 +1000,7 @@ void XYCurvePrivate::retransform() {
 #endif
 
 	m_scenePoints.clear();
+	m_hitTestGridDirty = true;
 
 	if (!xColumn || !yColumn) {
 		DEBUG("	xColumn or yColumn not available");
@@ -1141,7 +1144,7 @@ void XYCurvePrivate::recalcLogicalPoints() {
 				tempPoint.setX(xColumn->valueAt(row));
 				break;
 			case AbstractColumn::ColumnMode::DateTime:
-				tempPoint.setX(xColumn->dateTimeAt(row).toMSecsSinceEpoch());
+				tempPoint.setX(xColumn->dateTimeMSecsAt(row));
 				break;
 			case AbstractColumn::ColumnMode::Text:
 			case AbstractColumn::ColumnMode::Month:
@@ -1156,7 +1159,7 @@ void XYCurvePrivate::recalcLogicalPoints() {
 				tempPoint.setY(yColumn->valueAt(row));
 				break;
 			case AbstractColumn::ColumnMode::DateTime:
-				tempPoint.setY(yColumn->dateTimeAt(row).toMSecsSinceEpoch());
+				tempPoint.setY(yColumn->dateTimeMSecsAt(row));
 				break;
 			case AbstractColumn::ColumnMode::Text:
 			case AbstractColumn::ColumnMode::Month:
@@ -1281,6 +1284,7 @@ void XYCurvePrivate::updateLines() {
 #endif
 	linePath = QPainterPath();
 	m_lines.clear();
+	m_hitTestGridDirty = true;
 	if (lineType == XYCurve::LineType::NoLine) {
 		DEBUG("	nothing to do, since line type is XYCurve::LineType::NoLine");
 		updateFilling();
@@ -2268,7 +2272,7 @@ bool XYCurve::minMax(const AbstractColumn* column1, const AbstractColumn* column
 			else if (errorPlusColumn->columnMode() == AbstractColumn::ColumnMode::DateTime ||
 					 errorPlusColumn->columnMode() == AbstractColumn::ColumnMode::Month ||
 					 errorPlusColumn->columnMode() == AbstractColumn::ColumnMode::Day)
-				errorPlus = errorPlusColumn->dateTimeAt(i).toMSecsSinceEpoch();
+				errorPlus = errorPlusColumn->dateTimeMSecsAt(i);
 			else
 				return false;
 		else
@@ -2285,7 +2289,7 @@ bool XYCurve::minMax(const AbstractColumn* column1, const AbstractColumn* column
 				else if (errorMinusColumn->columnMode() == AbstractColumn::ColumnMode::DateTime ||
 						 errorMinusColumn->columnMode() == AbstractColumn::ColumnMode::Month ||
 						 errorMinusColumn->columnMode() == AbstractColumn::ColumnMode::Day)
-					errorMinus = errorMinusColumn->dateTimeAt(i).toMSecsSinceEpoch();
+					errorMinus = errorMinusColumn->dateTimeMSecsAt(i);
 				else
 					return false;
 			else
@@ -2299,7 +2303,7 @@ bool XYCurve::minMax(const AbstractColumn* column1, const AbstractColumn* column
 		else if (column1->columnMode() == AbstractColumn::ColumnMode::DateTime ||
 				 column1->columnMode() == AbstractColumn::ColumnMode::Month ||
 				 column1->columnMode() == AbstractColumn::ColumnMode::Day) {
-			value = column1->dateTimeAt(i).toMSecsSinceEpoch();
+			value = column1->dateTimeMSecsAt(i);
 		} else
 			return false;
 
@@ -2330,24 +2334,38 @@ bool XYCurvePrivate::activateCurve(QPointF mouseScenePos, double maxDist) {
 	if (maxDist < 0)
 		maxDist = (linePen.width() < 10) ? 10. : linePen.width();
 
+	//the plot checks all its curves on every mouse move, skip the curves far away from the mouse position
+	if (!boundingRectangle.adjusted(-maxDist, -maxDist, maxDist, maxDist).contains(mouseScenePos))
+		return false;
+
 	auto properties{q->xColumn()->properties()};
 	if (properties == AbstractColumn::Properties::No) {
 		// assumption: points exist if no line. otherwise previously returned false
-		if (lineType == XYCurve::LineType::NoLine) {
-			QPointF curvePosPrevScene = m_scenePoints.at(0);
-			QPointF curvePosScene = curvePosPrevScene;
-			for (int row = 0; row < rowCount; row ++) {
-				if (gsl_hypot(mouseScenePos.x() - curvePosScene.x(), mouseScenePos.y() - curvePosScene.y()) <= maxDist)
-					return true;
+		if (m_hitTestGridDirty)
+			updateHitTestGrid();
 
-				curvePosPrevScene = curvePosScene;
-				curvePosScene = m_scenePoints.at(row);
+		auto itemNear = [&](int i) {
+			if (lineType == XYCurve::LineType::NoLine) {
+				const QPointF& point = m_scenePoints.at(i);
+				return gsl_hypot(mouseScenePos.x() - point.x(), mouseScenePos.y() - point.y()) <= maxDist;
 			}
-		} else {
-			for (int row = 0; row < rowCount; row++) {
-				QLineF line = m_lines.at(row);
-				if (pointLiesNearLine(line.p1(), line.p2(), mouseScenePos, maxDist))
-					return true;
+			const QLineF& line = m_lines.at(i);
+			return pointLiesNearLine(line.p1(), line.p2(), mouseScenePos, maxDist);
+		};
+
+		// only the items in the cells around the mouse position need to be checked
+		int colMin, rowMin, colMax, rowMax;
+		if (!hitTestGridCells(mouseScenePos.x() - maxDist, mouseScenePos.y() - maxDist,
+				mouseScenePos.x() + maxDist, mouseScenePos.y() + maxDist, colMin, rowMin, colMax, rowMax))
+			return false;
+
+		for (int row = rowMin; row <= rowMax; ++row) {
+			for (int col = colMin; col <= colMax; ++col) {
+				const int cell = row * m_hitTestGridColumns + col;
+				for (int k = m_hitTestGridCellStart.at(cell); k < m_hitTestGridCellStart.at(cell + 1); ++k) {
+					if (itemNear(m_hitTestGridItems.at(k)))
+						return true;
+				}
 			}
 		}
 
@@ -2412,6 +2430,146 @@ bool XYCurvePrivate::activateCurve(QPointF mouseScenePos, double maxDist) {
 	return false;
 }
 
+/*!
+ * (re)builds the grid used in activateCurve() to find the lines (or the points, if no line is drawn)
+ * close to the mouse position without checking all of them for non-monotonic x-data.
+ * Each line is registered in the cells it crosses, items with non-finite coordinates can't be hit and are skipped.
+ * The grid is invalidated in retransform() and updateLines() and built on the first hit-test afterwards.
+ */
+void XYCurvePrivate::updateHitTestGrid() {
+	m_hitTestGridDirty = false;
+	m_hitTestGridCellStart.clear();
+	m_hitTestGridItems.clear();
+	m_hitTestGridColumns = 0;
+	m_hitTestGridRows = 0;
+
+	const bool lines = (lineType != XYCurve::LineType::NoLine);
+	const int count = lines ? m_lines.size() : m_scenePoints.size();
+	if (count == 0)
+		return;
+
+	auto itemLine = [&](int i) {
+		return lines ? m_lines.at(i) : QLineF(m_scenePoints.at(i), m_scenePoints.at(i));
+	};
+	auto isFinite = [](const QLineF& line) {
+		return std::isfinite(line.x1()) && std::isfinite(line.y1()) && std::isfinite(line.x2()) && std::isfinite(line.y2());
+	};
+
+	//bounding box of all items
+	double left{INFINITY}, top{INFINITY}, right{-INFINITY}, bottom{-INFINITY};
+	for (int i = 0; i < count; ++i) {
+		const QLineF& line = itemLine(i);
+		if (!isFinite(line))
+			continue;
+		left = qMin(left, qMin(line.x1(), line.x2()));
+		right = qMax(right, qMax(line.x1(), line.x2()));
+		top = qMin(top, qMin(line.y1(), line.y2()));
+		bottom = qMax(bottom, qMax(line.y1(), line.y2()));
+	}
+	if (left > right)
+		return;
+
+	//about four items per cell on average
+	const int cellsPerAxis = qBound(1, static_cast<int>(std::sqrt(count/4.)), 256);
+	m_hitTestGridColumns = (right > left) ? cellsPerAxis : 1;
+	m_hitTestGridRows = (bottom > top) ? cellsPerAxis : 1;
+	m_hitTestGridOrigin = QPointF(left, top);
+	m_hitTestGridCellWidth = (right > left) ? (right - left)/m_hitTestGridColumns : 1.;
+	m_hitTestGridCellHeight = (bottom > top) ? (bottom - top)/m_hitTestGridRows : 1.;
+
+	//count the items per cell and store them afterwards, cell by cell
+	const int cellCount = m_hitTestGridColumns * m_hitTestGridRows;
+	m_hitTestGridCellStart.fill(0, cellCount + 1);
+	QVector<int> cells;
+	for (int i = 0; i < count; ++i) {
+		const QLineF& line = itemLine(i);
+		if (!isFinite(line))
+			continue;
+		hitTestGridLineCells(line, cells);
+		for (int cell : qAsConst(cells))
+			++m_hitTestGridCellStart[cell + 1];
+	}
+
+	for (int cell = 0; cell < cellCount; ++cell)
+		m_hitTestGridCellStart[cell + 1] += m_hitTestGridCellStart.at(cell);
+
+	m_hitTestGridItems.resize(m_hitTestGridCellStart.at(cellCount));
+	QVector<int> fill = m_hitTestGridCellStart;
+	for (int i = 0; i < count; ++i) {
+		const QLineF& line = itemLine(i);
+		if (!isFinite(line))
+			continue;
+		hitTestGridLineCells(line, cells);
+		for (int cell : qAsConst(cells))
+			m_hitTestGridItems[fill[cell]++] = i;
+	}
+}
+
+/*!
+ * determines the grid cells crossed by the line \p line (traversal of the grid from the cell of the start point
+ * to the cell of the end point, crossing one cell border per step) and stores their indices in \p cells.
+ * The line has to lie within the grid.
+ */
+void XYCurvePrivate::hitTestGridLineCells(const QLineF& line, QVector<int>& cells) const {
+	cells.clear();
+
+	//coordinates in units of cells
+	const double x0{(line.x1() - m_hitTestGridOrigin.x())/m_hitTestGridCellWidth};
+	const double y0{(line.y1() - m_hitTestGridOrigin.y())/m_hitTestGridCellHeight};
+	const double x1{(line.x2() - m_hitTestGridOrigin.x())/m_hitTestGridCellWidth};
+	const double y1{(line.y2() - m_hitTestGridOrigin.y())/m_hitTestGridCellHeight};
+
+	int col = qBound(0, static_cast<int>(x0), m_hitTestGridColumns - 1);
+	int row = qBound(0, static_cast<int>(y0), m_hitTestGridRows - 1);
+	const int colEnd = qBound(0, static_cast<int>(x1), m_hitTestGridColumns - 1);
+	const int rowEnd = qBound(0, static_cast<int>(y1), m_hitTestGridRows - 1);
+	const int colStep = (colEnd > col) ? 1 : -1;
+	const int rowStep = (rowEnd > row) ? 1 : -1;
+
+	//line parameter t in [0, 1] at which the next vertical and horizontal cell border is crossed
+	const double dx{x1 - x0};
+	const double dy{y1 - y0};
+	const double tDeltaX = (dx != 0.) ? qAbs(1./dx) : INFINITY;
+	const double tDeltaY = (dy != 0.) ? qAbs(1./dy) : INFINITY;
+	double tMaxX = (dx > 0.) ? (col + 1 - x0)/dx : ((dx < 0.) ? (col - x0)/dx : INFINITY);
+	double tMaxY = (dy > 0.) ? (row + 1 - y0)/dy : ((dy < 0.) ? (row - y0)/dy : INFINITY);
+
+	cells << row * m_hitTestGridColumns + col;
+	int steps = qAbs(colEnd - col) + qAbs(rowEnd - row);
+	while (steps-- > 0) {
+		if (col != colEnd && (row == rowEnd || tMaxX < tMaxY)) {
+			col += colStep;
+			tMaxX += tDeltaX;
+		} else {
+			row += rowStep;
+			tMaxY += tDeltaY;
+		}
+		cells << row * m_hitTestGridColumns + col;
+	}
+}
+
+/*!
+ * determines the range of grid cells overlapping the rectangle [\p xMin, \p xMax] x [\p yMin, \p yMax] in scene coordinates.
+ * \return \c false if the rectangle lies completely outside of the grid
+ */
+bool XYCurvePrivate::hitTestGridCells(double xMin, double yMin, double xMax, double yMax, int& colMin, int& rowMin, int& colMax, int& rowMax) const {
+	if (m_hitTestGridColumns == 0 || m_hitTestGridRows == 0)
+		return false;
+
+	const double x0{(xMin - m_hitTestGridOrigin.x())/m_hitTestGridCellWidth};
+	const double x1{(xMax - m_hitTestGridOrigin.x())/m_hitTestGridCellWidth};
+	const double y0{(yMin - m_hitTestGridOrigin.y())/m_hitTestGridCellHeight};
+	const double y1{(yMax - m_hitTestGridOrigin.y())/m_hitTestGridCellHeight};
+	if (x1 < 0 || y1 < 0 || x0 > m_hitTestGridColumns || y0 > m_hitTestGridRows)
+		return false;
+
+	colMin = qBound(0, static_cast<int>(x0), m_hitTestGridColumns - 1);
+	colMax = qBound(0, static_cast<int>(x1), m_hitTestGridColumns - 1);
+	rowMin = qBound(0, static_cast<int>(y0), m_hitTestGridRows - 1);
+	rowMax = qBound(0, static_cast<int>(y1), m_hitTestGridRows - 1);
+	return true;
+}
+
 /*!
  * \brief XYCurve::pointLiesNearLine
  * Calculates if a point \p pos lies near than maxDist to the line created by the points \p p1 and \p p2
@@ -65,6 +65,7 @@ public:
 	bool activateCurve(QPointF mouseScenePos, double maxDist);
 	bool pointLiesNearLine(const QPointF p1, const QPointF p2, const QPointF pos, const double maxDist) const;
 	bool pointLiesNearCurve(const QPointF mouseScenePos, const QPointF curvePosPrevScene, const QPointF curvePosScene, const int index, const double maxDist) const;
+	void updateHitTestGrid();
 
 	//data source
 	const AbstractColumn* xColumn{nullptr};
@@ -155,6 +156,8 @@ private:
 	void drawValues(QPainter*);
 	void drawFilling(QPainter*);
 	void draw(QPainter*);
+	bool hitTestGridCells(double xMin, double yMin, double xMax, double yMax, int& colMin, int& rowMin, int& colMax, int& rowMax) const;
+	void hitTestGridLineCells(const QLineF&, QVector<int>& cells) const;
 
 	//TODO: add m_
 	QPainterPath linePath;
@@ -175,6 +178,16 @@ private:
 	std::vector<int> validPointsIndicesLogical;	//original indices in the source columns for valid and non-masked values (size of m_logicalPoints)
 	std::vector<bool> connectedPointsLogical;  	//true for points connected with the consecutive point (size of m_logicalPoints)
 
+	//uniform grid over m_lines (or m_scenePoints if no line is drawn) used in activateCurve() for non-monotonic x-data
+	QPointF m_hitTestGridOrigin;
+	double m_hitTestGridCellWidth{1.};
+	double m_hitTestGridCellHeight{1.};
+	int m_hitTestGridColumns{0};
+	int m_hitTestGridRows{0};
+	QVector<int> m_hitTestGridCellStart;	//offsets into m_hitTestGridItems (size m_hitTestGridColumns*m_hitTestGridRows + 1)
+	QVector<int> m_hitTestGridItems;	//indices in m_lines or m_scenePoints, sorted by cell
+	bool m_hitTestGridDirty{true};
+
 	QPixmap m_pixmap;
 	QImage m_hoverEffectImage;
 	QImage m_selectionEffectImage;
@@ -99,9 +99,49 @@ XYDataReductionCurvePrivate::XYDataReductionCurvePrivate(XYDataReductionCurve* o
 //when the parent aspect is removed
 XYDataReductionCurvePrivate::~XYDataReductionCurvePrivate() = default;
 
+//! simplifies the data with the given algorithm, returns the number of points stored in \c index
+size_t XYDataReductionCurvePrivate::simplify(nsl_geom_linesim_type type, const double* xdata, const double* ydata, size_t n, double tol, double tol2,
+		size_t* index, double& calcTolerance) {
+	size_t npoints = 0;
+	switch (type) {
+	case nsl_geom_linesim_type_douglas_peucker_variant:	// tol used as number of points
+		npoints = tol;
+		calcTolerance = nsl_geom_linesim_douglas_peucker_variant(xdata, ydata, n, npoints, index);
+		break;
+	case nsl_geom_linesim_type_douglas_peucker:
+		npoints = nsl_geom_linesim_douglas_peucker(xdata, ydata, n, tol, index);
+		break;
+	case nsl_geom_linesim_type_nthpoint:	// tol used as step
+		npoints = nsl_geom_linesim_nthpoint(n, (int)tol, index);
+		break;
+	case nsl_geom_linesim_type_raddist:
+		npoints = nsl_geom_linesim_raddist(xdata, ydata, n, tol, index);
+		break;
+	case nsl_geom_linesim_type_perpdist:	// tol2 used as repeat
+		npoints = nsl_geom_linesim_perpdist_repeat(xdata, ydata, n, tol, tol2, index);
+		break;
+	case nsl_geom_linesim_type_interp:
+		npoints = nsl_geom_linesim_interp(xdata, ydata, n, tol, index);
+		break;
+	case nsl_geom_linesim_type_visvalingam_whyatt:
+		npoints = nsl_geom_linesim_visvalingam_whyatt(xdata, ydata, n, tol, index);
+		break;
+	case nsl_geom_linesim_type_reumann_witkam:
+		npoints = nsl_geom_linesim_reumann_witkam(xdata, ydata, n, tol, index);
+		break;
+	case nsl_geom_linesim_type_opheim:
+		npoints = nsl_geom_linesim_opheim(xdata, ydata, n, tol, tol2, index);
+		break;
+	case nsl_geom_linesim_type_lang:	// tol2 used as region
+		npoints = nsl_geom_linesim_lang(xdata, ydata, n, tol, tol2, index);
+		break;
+	}
+
+	return npoints;
+}
+
 void XYDataReductionCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
+	recalculationTimer.start();
 
 	//create dataReduction result columns if not available yet, clear them otherwise
 	if (!xColumn) {
@@ -119,14 +159,8 @@ void XYDataReductionCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	dataReductionResult = XYDataReductionCurve::DataReductionResult();
-
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
@@ -141,6 +175,8 @@ void XYDataReductionCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		dataReductionResult = XYDataReductionCurve::DataReductionResult();
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -161,23 +197,47 @@ void XYDataReductionCurvePrivate::recalculate() {
 		xmax = dataReductionData.xRange.last();
 	}
 
-	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
+	//the values of numeric columns without masked rows are used in place if all of them are valid and in the range,
+	//the data of large (mapped) columns is not copied then
+	Column::NumericValues xValues;
+	Column::NumericValues yValues;
+	const auto* xNumericColumn = dynamic_cast<const Column*>(tmpXDataColumn);
+	const auto* yNumericColumn = dynamic_cast<const Column*>(tmpYDataColumn);
+	if (xNumericColumn && yNumericColumn
+		&& xNumericColumn->columnMode() == AbstractColumn::ColumnMode::Numeric
+		&& yNumericColumn->columnMode() == AbstractColumn::ColumnMode::Numeric
+		&& xNumericColumn->maskedIntervals().isEmpty() && yNumericColumn->maskedIntervals().isEmpty()) {
+		xValues = xNumericColumn->numericValues();
+		yValues = yNumericColumn->numericValues();
+		const int rows = qMin(xValues.size(), yValues.size());
+		const double* x = xValues.data();
+		const double* y = yValues.data();
+		for (int i = 0; i < rows; ++i) {
+			if (!std::isfinite(x[i]) || !std::isfinite(y[i]) || x[i] < xmin || x[i] > xmax) {
+				xValues = Column::NumericValues();
+				yValues = Column::NumericValues();
+				break;
+			}
+		}
+	}
+
+	if (!xValues.data())
+		XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
 
 	//number of data points to use
-	const size_t n = (size_t)xdataVector.size();
+	const size_t n = xValues.data() ? (size_t)qMin(xValues.size(), yValues.size()) : (size_t)xdataVector.size();
 	if (n < 2) {
+		dataReductionResult = XYDataReductionCurve::DataReductionResult();
 		dataReductionResult.available = true;
 		dataReductionResult.valid = false;
 		dataReductionResult.status = i18n("Not enough data points available.");
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// dataReduction settings
 	const nsl_geom_linesim_type type = dataReductionData.type;
 	const double tol = dataReductionData.tolerance;
@@ -188,88 +248,75 @@ void XYDataReductionCurvePrivate::recalculate() {
 	DEBUG("tolerance/step:" << tol);
 	DEBUG("tolerance2/repeat/maxtol/region:" << tol2);
 
-///////////////////////////////////////////////////////////
-	emit q->completed(10);
+	//the data reduction doesn't access any columns and can be done in the background
+	auto calculate = [=]() mutable {
+		const double* xdata = xValues.data() ? xValues.data() : xdataVector.constData();
+		const double* ydata = yValues.data() ? yValues.data() : ydataVector.constData();
 
-	size_t npoints = 0;
-	double calcTolerance = 0;	// calculated tolerance from Douglas-Peucker variant
-	size_t *index = (size_t *) malloc(n*sizeof(size_t));
-	switch (type) {
-	case nsl_geom_linesim_type_douglas_peucker_variant:	// tol used as number of points
-		npoints = tol;
-		calcTolerance = nsl_geom_linesim_douglas_peucker_variant(xdata, ydata, n, npoints, index);
-		break;
-	case nsl_geom_linesim_type_douglas_peucker:
-		npoints = nsl_geom_linesim_douglas_peucker(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_nthpoint:	// tol used as step
-		npoints = nsl_geom_linesim_nthpoint(n, (int)tol, index);
-		break;
-	case nsl_geom_linesim_type_raddist:
-		npoints = nsl_geom_linesim_raddist(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_perpdist:	// tol2 used as repeat
-		npoints = nsl_geom_linesim_perpdist_repeat(xdata, ydata, n, tol, tol2, index);
-		break;
-	case nsl_geom_linesim_type_interp:
-		npoints = nsl_geom_linesim_interp(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_visvalingam_whyatt:
-		npoints = nsl_geom_linesim_visvalingam_whyatt(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_reumann_witkam:
-		npoints = nsl_geom_linesim_reumann_witkam(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_opheim:
-		npoints = nsl_geom_linesim_opheim(xdata, ydata, n, tol, tol2, index);
-		break;
-	case nsl_geom_linesim_type_lang:	// tol2 used as region
-		npoints = nsl_geom_linesim_opheim(xdata, ydata, n, tol, tol2, index);
-		break;
-	}
+///////////////////////////////////////////////////////////
+		emit q->completed(10);
+		setRecalculationProgress(10);
+
+		double calcTolerance = 0;	// calculated tolerance from Douglas-Peucker variant
+		size_t *index = (size_t *) malloc(n*sizeof(size_t));
+		npoints = simplify(type, xdata, ydata, n, tol, tol2, index, calcTolerance);
+
+		DEBUG("npoints =" << npoints);
+		if (type == nsl_geom_linesim_type_douglas_peucker_variant)
+			DEBUG("calculated tolerance =" << calcTolerance)
+		else
+			Q_UNUSED(calcTolerance);
+
+		if (recalculationCancelled()) {
+			free(index);
+			return;
+		}
+		emit q->completed(80);
+		setRecalculationProgress(80);
+
+		xResultVector.resize((int)npoints);
+		yResultVector.resize((int)npoints);
+		for (int i = 0; i < (int)npoints; i++) {
+			xResultVector[i] = xdata[index[i]];
+			yResultVector[i] = ydata[index[i]];
+		}
 
-	DEBUG("npoints =" << npoints);
-	if (type == nsl_geom_linesim_type_douglas_peucker_variant)
-		DEBUG("calculated tolerance =" << calcTolerance)
-	else
-		Q_UNUSED(calcTolerance);
+		emit q->completed(90);
+		setRecalculationProgress(90);
 
-	emit q->completed(80);
+		posError = nsl_geom_linesim_positional_squared_error(xdata, ydata, n, index);
+		areaError = nsl_geom_linesim_area_error(xdata, ydata, n, index);
 
-	xVector->resize((int)npoints);
-	yVector->resize((int)npoints);
-	for (int i = 0; i < (int)npoints; i++) {
-		(*xVector)[i] = xdata[index[i]];
-		(*yVector)[i] = ydata[index[i]];
-	}
+		free(index);
 
-	emit q->completed(90);
+///////////////////////////////////////////////////////////
+	};
 
-	const double posError = nsl_geom_linesim_positional_squared_error(xdata, ydata, n, index);
-	const double areaError = nsl_geom_linesim_area_error(xdata, ydata, n, index);
+	auto finish = [=]() {
+		swapResultVectors();
 
-	free(index);
+		//write the result
+		dataReductionResult = XYDataReductionCurve::DataReductionResult();
+		dataReductionResult.available = true;
+		dataReductionResult.valid = true;
+		if (npoints > 0)
+			dataReductionResult.status = QString("OK");
+		else
+			dataReductionResult.status = QString("FAILURE");
+		dataReductionResult.elapsedTime = recalculationTimer.elapsed();
+		dataReductionResult.npoints = npoints;
+		dataReductionResult.posError = posError;
+		dataReductionResult.areaError = areaError;
+
+		//redraw the curve
+		recalcLogicalPoints();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
 
-///////////////////////////////////////////////////////////
+		emit q->completed(100);
+	};
 
-	//write the result
-	dataReductionResult.available = true;
-	dataReductionResult.valid = true;
-	if (npoints > 0)
-		dataReductionResult.status = QString("OK");
-	else
-		dataReductionResult.status = QString("FAILURE");
-	dataReductionResult.elapsedTime = timer.elapsed();
-	dataReductionResult.npoints = npoints;
-	dataReductionResult.posError = posError;
-	dataReductionResult.areaError = areaError;
-
-	//redraw the curve
-	recalcLogicalPoints();
-	emit q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
-
-	emit q->completed(100);
+	runRecalculation(calculate, finish);
 }
 
 //##############################################################################
@@ -42,9 +42,13 @@ public:
 	~XYDataReductionCurvePrivate() override;
 
 	void recalculate();
+	static size_t simplify(nsl_geom_linesim_type, const double* xdata, const double* ydata, size_t n, double tol, double tol2, size_t* index, double& calcTolerance);
 
 	XYDataReductionCurve::DataReductionData dataReductionData;
 	XYDataReductionCurve::DataReductionResult dataReductionResult;
+	size_t npoints{0};
+	double posError{0.};
+	double areaError{0.};
 
 	XYDataReductionCurve* const q;
 };
@@ -105,10 +105,9 @@ XYDifferentiationCurvePrivate::~XYDifferentiationCurvePrivate() = default;
 // ...
 // see XYFitCurvePrivate
 void XYDifferentiationCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
+	recalculationTimer.start();
 
-	//create differentiation result columns if not available yet, clear them otherwise
+	//create differentiation result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Numeric);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Numeric);
@@ -124,14 +123,8 @@ void XYDifferentiationCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	differentiationResult = XYDifferentiationCurve::DifferentiationResult();
-
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
@@ -146,6 +139,8 @@ void XYDifferentiationCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		differentiationResult = XYDifferentiationCurve::DifferentiationResult();
+		clearResultVectors();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
@@ -170,18 +165,17 @@ void XYDifferentiationCurvePrivate::recalculate() {
 	//number of data points to differentiate
 	const size_t n = (size_t)xdataVector.size();
 	if (n < 3) {
+		differentiationResult = XYDifferentiationCurve::DifferentiationResult();
 		differentiationResult.available = true;
 		differentiationResult.valid = false;
 		differentiationResult.status = i18n("Not enough data points available.");
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// differentiation settings
 	const nsl_diff_deriv_order_type derivOrder = differentiationData.derivOrder;
 	const int accOrder = differentiationData.accOrder;
@@ -189,46 +183,62 @@ void XYDifferentiationCurvePrivate::recalculate() {
 	DEBUG(nsl_diff_deriv_order_name[derivOrder] << "derivative");
 	DEBUG("accuracy order:" << accOrder);
 
+	//the differentiation doesn't access any columns and can be done in the background
+	auto calculate = [=]() mutable {
+		double* xdata = xdataVector.data();
+		double* ydata = ydataVector.data();
+
 ///////////////////////////////////////////////////////////
-	int status = 0;
-
-	switch (derivOrder) {
-	case nsl_diff_deriv_order_first:
-		status = nsl_diff_first_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_second:
-		status = nsl_diff_second_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_third:
-		status = nsl_diff_third_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_fourth:
-		status = nsl_diff_fourth_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_fifth:
-		status = nsl_diff_fifth_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_sixth:
-		status = nsl_diff_sixth_deriv(xdata, ydata, n, accOrder);
-		break;
-	}
+		differentiationStatus = 0;
 
-	xVector->resize((int)n);
-	yVector->resize((int)n);
-	memcpy(xVector->data(), xdata, n * sizeof(double));
-	memcpy(yVector->data(), ydata, n * sizeof(double));
+		switch (derivOrder) {
+		case nsl_diff_deriv_order_first:
+			differentiationStatus = nsl_diff_first_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_second:
+			differentiationStatus = nsl_diff_second_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_third:
+			differentiationStatus = nsl_diff_third_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_fourth:
+			differentiationStatus = nsl_diff_fourth_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_fifth:
+			differentiationStatus = nsl_diff_fifth_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_sixth:
+			differentiationStatus = nsl_diff_sixth_deriv(xdata, ydata, n, accOrder);
+			break;
+		}
+		if (recalculationCancelled())
+			return;
+		setRecalculationProgress(90);
+
+		xResultVector.resize((int)n);
+		yResultVector.resize((int)n);
+		memcpy(xResultVector.data(), xdata, n * sizeof(double));
+		memcpy(yResultVector.data(), ydata, n * sizeof(double));
 ///////////////////////////////////////////////////////////
+	};
 
-	//write the result
-	differentiationResult.available = true;
-	differentiationResult.valid = true;
-	differentiationResult.status = QString::number(status);
-	differentiationResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		swapResultVectors();
+
+		//write the result
+		differentiationResult = XYDifferentiationCurve::DifferentiationResult();
+		differentiationResult.available = true;
+		differentiationResult.valid = true;
+		differentiationResult.status = QString::number(differentiationStatus);
+		differentiationResult.elapsedTime = recalculationTimer.elapsed();
+
+		//redraw the curve
+		recalcLogicalPoints();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	emit q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runRecalculation(calculate, finish);
 }
 
 //##############################################################################
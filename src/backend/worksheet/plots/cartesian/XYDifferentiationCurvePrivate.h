@@ -45,6 +45,7 @@ public:
 
 	XYDifferentiationCurve::DifferentiationData differentiationData;
 	XYDifferentiationCurve::DifferentiationResult differentiationResult;
+	int differentiationStatus{0};
 
 	XYDifferentiationCurve* const q;
 };
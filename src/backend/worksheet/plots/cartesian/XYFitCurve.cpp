@@ -40,6 +40,7 @@
 #include "backend/core/AbstractColumn.h"
 #include "backend/core/column/Column.h"
 #include "backend/lib/commandtemplates.h"
+#include "backend/spreadsheet/Spreadsheet.h"
 #include "backend/lib/macros.h"
 #include "backend/gsl/errors.h"
 #include "backend/gsl/ExpressionParser.h"
@@ -51,6 +52,9 @@ extern "C" {
 #include <gsl/gsl_version.h>
 #include <gsl/gsl_cdf.h>
 #include <gsl/gsl_statistics_double.h>
+#if (GSL_MAJOR_VERSION > 2) || (GSL_MAJOR_VERSION == 2) && (GSL_MINOR_VERSION >= 2)
+#include <gsl/gsl_multilarge_nlinear.h>
+#endif
 #include "backend/gsl/parser.h"
 #include "backend/nsl/nsl_sf_stats.h"
 #include "backend/nsl/nsl_stats.h"
@@ -59,7 +63,10 @@ extern "C" {
 #include <QDateTime>
 #include <QElapsedTimer>
 #include <QIcon>
+#include <QThread>
 #include <QThreadPool>
+#include <QVarLengthArray>
+#include <QtConcurrentRun>
 
 XYFitCurve::XYFitCurve(const QString& name)
 	: XYAnalysisCurve(name, new XYFitCurvePrivate(this), AspectType::XYFitCurve) {
@@ -660,6 +667,229 @@ void XYFitCurve::initFitData(XYFitCurve::FitData& fitData) {
 	}
 }
 
+// value of the data point in \c row used in the fit (NAN for text columns)
+static double fitValue(const AbstractColumn* column, int row) {
+	switch (column->columnMode()) {
+	case AbstractColumn::ColumnMode::Numeric:
+		return column->valueAt(row);
+	case AbstractColumn::ColumnMode::Integer:
+		return column->integerAt(row);
+	case AbstractColumn::ColumnMode::BigInt:
+		return column->bigIntAt(row);
+	case AbstractColumn::ColumnMode::Text:	// not valid
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Month:
+		return column->dateTimeMSecsAt(row);
+	}
+
+	return NAN;
+}
+
+/*!
+ * copies the valid data points of the rows \c startRow .. \c endRow (-1 = last row) inside of the fit range [\c xmin, \c xmax]
+ * to \c xdata and \c ydata. The values of the error columns are copied to \c xerror and \c yerror if they are used in the fit,
+ * points without error values are skipped in this case.
+ * Logic from XYAnalysisCurve::copyData(), extended by the handling of error columns.
+ */
+//TODO: decide how to deal with non-numerical error columns
+static void copyFitData(const XYFitCurve::FitData& fitData, const AbstractColumn* xColumn, const AbstractColumn* yColumn,
+		const AbstractColumn* xErrorColumn, const AbstractColumn* yErrorColumn, int startRow, int endRow, double xmin, double xmax,
+		QVector<double>& xdata, QVector<double>& ydata, QVector<double>& xerror, QVector<double>& yerror) {
+	int lastRow = qMin(xColumn->rowCount(), yColumn->rowCount()) - 1;
+	if (endRow >= 0)
+		lastRow = qMin(lastRow, endRow);
+	for (int row = qMax(startRow, 0); row <= lastRow; ++row) {
+		// omit invalid data
+		if (!xColumn->isValid(row) || xColumn->isMasked(row) ||
+				!yColumn->isValid(row) || yColumn->isMasked(row))
+			continue;
+
+		const double x = fitValue(xColumn, row);
+		const double y = fitValue(yColumn, row);
+
+		// only when inside given range
+		if (x >= xmin && x <= xmax) {
+			if ((!xErrorColumn && !yErrorColumn) || !fitData.useDataErrors) {	// x-y
+				xdata.append(x);
+				ydata.append(y);
+			} else if (!xErrorColumn && yErrorColumn) {	// x-y-dy
+				if (!std::isnan(yErrorColumn->valueAt(row))) {
+					xdata.append(x);
+					ydata.append(y);
+					yerror.append(yErrorColumn->valueAt(row));
+				}
+			} else if (xErrorColumn && yErrorColumn) {	// x-y-dx-dy
+				if (!std::isnan(xErrorColumn->valueAt(row)) && !std::isnan(yErrorColumn->valueAt(row))) {
+					xdata.append(x);
+					ydata.append(y);
+					xerror.append(xErrorColumn->valueAt(row));
+					yerror.append(yErrorColumn->valueAt(row));
+				}
+			}
+		}
+	}
+}
+
+/*!
+ * fits the model of \c fitData to each data set of \c dataSets (e.g. many curves or segments of one long measurement)
+ * and returns the results in the same order. The data points and errors are selected in the same way
+ * as for the fit of a curve, so each result is the same as the one of a fit curve with the same data.
+ * The data is copied in the calling thread. The fits run concurrently, each with its own solver workspace,
+ * if the model can be compiled, otherwise one after another since parsing the model is not thread-safe.
+ */
+QVector<XYFitCurve::FitResult> XYFitCurve::batchFit(const XYFitCurve::FitData& fitData, const QVector<XYFitCurve::BatchFitData>& dataSets) {
+	DEBUG("XYFitCurve::batchFit(), number of data sets = " << dataSets.size());
+	const int count = dataSets.size();
+	QVector<FitResult> results(count);
+	QVector<QVector<double>> xdataVectors(count);
+	QVector<QVector<double>> ydataVectors(count);
+	QVector<QVector<double>> xerrorVectors(count);
+	QVector<QVector<double>> yerrorVectors(count);
+
+	for (int i = 0; i < count; ++i) {
+		const auto& dataSet = dataSets.at(i);
+		if (!dataSet.xColumn || !dataSet.yColumn)
+			continue;
+
+		// same checks as in XYFitCurvePrivate::recalculate()
+		if (dataSet.yErrorColumn && dataSet.yErrorColumn->rowCount() < dataSet.xColumn->rowCount()) {
+			results[i].available = true;
+			results[i].status = i18n("Not sufficient weight data points provided.");
+			continue;
+		}
+
+		double xmin, xmax;
+		if (fitData.autoRange) {
+			xmin = dataSet.xColumn->minimum();
+			xmax = dataSet.xColumn->maximum();
+		} else {
+			xmin = fitData.fitRange.first();
+			xmax = fitData.fitRange.last();
+		}
+		copyFitData(fitData, dataSet.xColumn, dataSet.yColumn, dataSet.xErrorColumn, dataSet.yErrorColumn, dataSet.startRow, dataSet.endRow,
+				xmin, xmax, xdataVectors[i], ydataVectors[i], xerrorVectors[i], yerrorVectors[i]);
+	}
+
+	// the model is compiled once and shared by all fits, the compiled program is only read during the evaluation
+	parser_program* program = XYFitCurvePrivate::compileModel(fitData);
+	FitResult* result = results.data();
+	QVector<double>* xdata = xdataVectors.data();
+	QVector<double>* ydata = ydataVectors.data();
+	QVector<double>* xerror = xerrorVectors.data();
+	QVector<double>* yerror = yerrorVectors.data();
+	auto fitDataSet = [=](int i) {
+		if (result[i].available)	// checks failed
+			return;
+		QElapsedTimer timer;
+		timer.start();
+		FitData data = fitData;	// the fit changes the start values
+		XYFitCurvePrivate::fit(data, result[i], xdata[i], ydata[i], xerror[i], yerror[i], nullptr, nullptr, program);
+		result[i].elapsedTime = timer.elapsed();
+	};
+
+	if (program) {
+		QVector<QFuture<void>> futures;
+		for (int i = 0; i < count; ++i)
+			futures << QtConcurrent::run([=]() { fitDataSet(i); });
+		for (auto& future : futures)
+			future.waitForFinished();
+		parser_program_free(program);
+	} else {
+		DEBUG("	model can't be compiled, fitting the data sets sequentially")
+		for (int i = 0; i < count; ++i)
+			fitDataSet(i);
+	}
+
+	return results;
+}
+
+/*!
+ * writes the results of batchFit() to \c spreadsheet, one row per data set:
+ * the name of the data set, the parameter values and their errors and the most important goodness of fit values.
+ */
+void XYFitCurve::batchFitResults(const XYFitCurve::FitData& fitData, const QVector<XYFitCurve::BatchFitData>& dataSets,
+				const QVector<XYFitCurve::FitResult>& results, Spreadsheet* spreadsheet) {
+	const int count = results.size();
+	const int np = fitData.paramNames.size();
+
+	QVector<QString> names(count);
+	QVector<QString> status(count);
+	QVector<int> iterations(count);
+	QVector<QVector<double>> paramValues(np, QVector<double>(count, NAN));
+	QVector<QVector<double>> errorValues(np, QVector<double>(count, NAN));
+	QVector<QVector<double>> statistics(5, QVector<double>(count, NAN));	// SSE, RMS, RSD, R^2, R^2 adj.
+	for (int i = 0; i < count; ++i) {
+		const auto& result = results.at(i);
+		if (i < dataSets.size() && dataSets.at(i).yColumn) {
+			const auto& dataSet = dataSets.at(i);
+			names[i] = dataSet.yColumn->name();
+			if (dataSet.startRow > 0 || dataSet.endRow >= 0)
+				names[i] += QStringLiteral(" [%1..%2]").arg(dataSet.startRow + 1).arg(dataSet.endRow >= 0 ? QString::number(dataSet.endRow + 1) : QString());
+		}
+		status[i] = result.status;
+		iterations[i] = result.iterations;
+		if (!result.valid)
+			continue;
+
+		for (int j = 0; j < np && j < result.paramValues.size(); ++j) {
+			paramValues[j][i] = result.paramValues.at(j);
+			errorValues[j][i] = result.errorValues.at(j);
+		}
+		statistics[0][i] = result.sse;
+		statistics[1][i] = result.rms;
+		statistics[2][i] = result.rsd;
+		statistics[3][i] = result.rsquare;
+		statistics[4][i] = result.rsquareAdj;
+	}
+
+	const QStringList statisticsNames{i18n("SSE"), i18n("RMS"), i18n("RSD"), i18n("R²"), i18n("R² adj.")};
+	spreadsheet->setRowCount(count);
+	spreadsheet->setColumnCount(1 + 2 * np + statisticsNames.size() + 2);
+
+	int col = 0;
+	Column* column = spreadsheet->column(col++);
+	column->setName(i18n("Data set"));
+	column->setColumnMode(AbstractColumn::ColumnMode::Text);
+	column->setPlotDesignation(AbstractColumn::PlotDesignation::X);
+	column->replaceTexts(0, names);
+
+	for (int j = 0; j < np; ++j) {
+		column = spreadsheet->column(col++);
+		column->setName(fitData.paramNames.at(j));
+		column->setColumnMode(AbstractColumn::ColumnMode::Numeric);
+		column->setPlotDesignation(AbstractColumn::PlotDesignation::Y);
+		column->replaceValues(0, paramValues.at(j));
+
+		column = spreadsheet->column(col++);
+		column->setName(i18n("%1 error", fitData.paramNames.at(j)));
+		column->setColumnMode(AbstractColumn::ColumnMode::Numeric);
+		column->setPlotDesignation(AbstractColumn::PlotDesignation::YError);
+		column->replaceValues(0, errorValues.at(j));
+	}
+
+	for (int k = 0; k < statisticsNames.size(); ++k) {
+		column = spreadsheet->column(col++);
+		column->setName(statisticsNames.at(k));
+		column->setColumnMode(AbstractColumn::ColumnMode::Numeric);
+		column->setPlotDesignation(AbstractColumn::PlotDesignation::Y);
+		column->replaceValues(0, statistics.at(k));
+	}
+
+	column = spreadsheet->column(col++);
+	column->setName(i18n("Iterations"));
+	column->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	column->setPlotDesignation(AbstractColumn::PlotDesignation::Y);
+	column->replaceInteger(0, iterations);
+
+	column = spreadsheet->column(col++);
+	column->setName(i18n("Status"));
+	column->setColumnMode(AbstractColumn::ColumnMode::Text);
+	column->setPlotDesignation(AbstractColumn::PlotDesignation::NoDesignation);
+	column->replaceTexts(0, status);
+}
+
 /*!
 	Returns an icon to be used in the project explorer.
 */
@@ -742,8 +972,62 @@ struct data {
 	double* paramMin;	// lower parameter limits
 	double* paramMax;	// upper parameter limits
 	bool* paramFixed;	// parameter fixed?
+	const parser_program* program;	// compiled model (nullptr if the model has to be parsed for every point)
+	double* buffer;	// workspace of 3*n values for the compiled model
+	gsl_matrix* jacobianBlock;	// workspace for a block of rows of the Jacobian (large data set solver)
 };
 
+/*!
+ * calls \c evaluate(start, end) for blocks of the \c n data points in parallel
+ * and returns \c false if one of the calls failed
+ */
+template <typename Function>
+static bool evaluateBlocks(size_t n, Function evaluate) {
+	const size_t minBlockSize = 10000;
+	const size_t blockCount = qMax((size_t)1, qMin((size_t)QThread::idealThreadCount(), n/minBlockSize));
+
+	QAtomicInt failed(0);
+	QVector<QFuture<void>> futures;
+	for (size_t b = 1; b < blockCount; ++b) {
+		const size_t start = b*n/blockCount;
+		const size_t end = (b + 1)*n/blockCount;
+		futures << QtConcurrent::run([=, &failed]() {
+			if (!evaluate(start, end))
+				failed.storeRelease(1);
+		});
+	}
+	if (!evaluate(0, n/blockCount))
+		failed.storeRelease(1);
+	for (auto& future : futures)
+		future.waitForFinished();
+
+	return failed.loadAcquire() == 0;
+}
+
+/*!
+ * evaluates the compiled model for the points [start, end) with the parameter values \c paramValues
+ * (bound values). If \c varParam is not negative, the values of this parameter are taken from
+ * \c varValues (one value per point).
+ */
+static bool evaluateProgram(const struct data* d, const QVector<double>& paramValues, int varParam, const double* varValues,
+		size_t start, size_t end, double* out) {
+	const int np = paramValues.size();
+	QVarLengthArray<const double*, 16> values(np + 1);
+	QVarLengthArray<size_t, 16> strides(np + 1);
+	values[0] = d->x + start;
+	strides[0] = 1;
+	for (int j = 0; j < np; ++j) {
+		values[j + 1] = &paramValues[j];
+		strides[j + 1] = 0;
+	}
+	if (varParam >= 0) {
+		values[varParam + 1] = varValues + start;
+		strides[varParam + 1] = 1;
+	}
+
+	return parser_program_eval(d->program, values.constData(), strides.constData(), end - start, out + start) == 0;
+}
+
 /*!
  * \param paramValues vector containing current values of the fit parameters
  * \param params
@@ -763,6 +1047,34 @@ int func_f(const gsl_vector* paramValues, void* params, gsl_vector* f) {
 	double *min = ((struct data*)params)->paramMin;
 	double *max = ((struct data*)params)->paramMax;
 
+	// checks for allowed values of x for different models
+	// TODO: more to check
+	if (modelCategory == nsl_fit_model_distribution && modelType == nsl_sf_stats_lognormal) {
+		for (size_t i = 0; i < n; i++)
+			if (x[i] < 0)
+				x[i] = 0;
+	}
+
+	// compiled model: evaluate all points at once
+	const struct data* d = (struct data*)params;
+	if (d->program) {
+		QVector<double> values(paramNames->size());
+		for (int i = 0; i < paramNames->size(); i++)
+			values[i] = nsl_fit_map_bound(gsl_vector_get(paramValues, (size_t)i), min[i], max[i]);
+
+		double* Y = d->buffer;
+		if (!evaluateBlocks(n, [=](size_t start, size_t end) { return evaluateProgram(d, values, -1, nullptr, start, end, Y); }))
+			return GSL_ENOMEM;
+
+		for (size_t i = 0; i < n; i++) {
+			if (std::isnan(x[i]) || std::isnan(y[i]))
+				continue;
+			gsl_vector_set(f, i, sqrt(weight[i]) * (Y[i] - y[i]));
+		}
+
+		return GSL_SUCCESS;
+	}
+
 	// set current values of the parameters
 	for (int i = 0; i < paramNames->size(); i++) {
 		double v = gsl_vector_get(paramValues, (size_t)i);
@@ -777,13 +1089,6 @@ int func_f(const gsl_vector* paramValues, void* params, gsl_vector* f) {
 		if (std::isnan(x[i]) || std::isnan(y[i]))
 			continue;
 
-		// checks for allowed values of x for different models
-		// TODO: more to check
-		if (modelCategory == nsl_fit_model_distribution && modelType == nsl_sf_stats_lognormal) {
-			if (x[i] < 0)
-				x[i] = 0;
-		}
-
 		assign_variable("x", x[i]);
 		//DEBUG("evaluate function \"" << func << "\" @ x = " << x[i] << ":");
 		double Yi = parse(func);
@@ -1465,6 +1770,47 @@ int func_df(const gsl_vector* paramValues, void* params, gsl_matrix* J) {
 		}
 		break;
 	case nsl_fit_model_custom:
+		// compiled model: numerical derivatives of all points at once, parallel in blocks of points
+		const struct data* d = (struct data*)params;
+		if (d->program) {
+			const int np = paramNames->size();
+			QVector<double> values(np);
+			for (int j = 0; j < np; j++)
+				values[j] = nsl_fit_map_bound(gsl_vector_get(paramValues, j), min[j], max[j]);
+
+			double* f_p = d->buffer;
+			double* p_dp = d->buffer + n;
+			double* f_pdp = d->buffer + 2*n;
+			auto derivatives = [=](size_t start, size_t end) {
+				if (!evaluateProgram(d, values, -1, nullptr, start, end, f_p))
+					return false;
+
+				for (int j = 0; j < np; j++) {
+					if (fixed[j]) {
+						for (size_t i = start; i < end; i++)
+							gsl_matrix_set(J, i, (size_t)j, 0.);
+						continue;
+					}
+
+					// step size scaled with function value
+					for (size_t i = start; i < end; i++)
+						p_dp[i] = values[j] + (std::abs(f_p[i]) > 0 ? 1.e-9 * std::abs(f_p[i]) : 1.e-9);
+					if (!evaluateProgram(d, values, j, p_dp, start, end, f_pdp))
+						return false;
+
+					// calculate finite difference
+					for (size_t i = start; i < end; i++) {
+						const double eps = std::abs(f_p[i]) > 0 ? 1.e-9 * std::abs(f_p[i]) : 1.e-9;
+						gsl_matrix_set(J, i, (size_t)j, sqrt(weight[i])*(f_pdp[i] - f_p[i])/eps);
+					}
+				}
+				return true;
+			};
+			if (!evaluateBlocks(n, derivatives))
+				return GSL_ENOMEM;
+			break;
+		}
+
 		QByteArray funcba = ((struct data*)params)->func->toLatin1();
 		const char* func = funcba.data();
 		QByteArray nameba;
@@ -1519,6 +1865,61 @@ int func_fdf(const gsl_vector* x, void* params, gsl_vector* f, gsl_matrix* J) {
 	return GSL_SUCCESS;
 }
 
+#if (GSL_MAJOR_VERSION > 2) || (GSL_MAJOR_VERSION == 2) && (GSL_MINOR_VERSION >= 2)
+/*!
+ * Jacobian for the large data set solver: calculates v = op(J) u and/or J^T J
+ * from blocks of rows of the Jacobian, so the full n x p matrix is never stored
+ * \param TransJ CblasTrans: v = J^T u, CblasNoTrans: v = J u
+ * \param JTJ lower triangle of J^T J
+ */
+int func_df_large(CBLAS_TRANSPOSE_t TransJ, const gsl_vector* paramValues, const gsl_vector* u, void* params, gsl_vector* v, gsl_matrix* JTJ) {
+	const struct data* d = (struct data*)params;
+	gsl_matrix* Jblock = d->jacobianBlock;
+	const size_t blockSize = Jblock->size1;
+	const size_t np = paramValues->size;
+
+	if (JTJ)
+		gsl_matrix_set_zero(JTJ);
+	if (v && TransJ == CblasTrans)
+		gsl_vector_set_zero(v);
+
+	for (size_t start = 0; start < d->n; start += blockSize) {
+		const size_t rows = qMin(blockSize, d->n - start);
+		struct data block = *d;
+		block.n = rows;
+		block.x = d->x + start;
+		block.y = d->y + start;
+		block.weight = d->weight + start;
+
+		gsl_matrix_view J = gsl_matrix_submatrix(Jblock, 0, 0, rows, np);
+		const int status = func_df(paramValues, &block, &J.matrix);
+		if (status != GSL_SUCCESS)
+			return status;
+
+		if (JTJ)
+			gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, &J.matrix, 1.0, JTJ);
+		if (v) {
+			if (TransJ == CblasTrans) {
+				gsl_vector_const_view ublock = gsl_vector_const_subvector(u, start, rows);
+				gsl_blas_dgemv(CblasTrans, 1.0, &J.matrix, &ublock.vector, 1.0, v);
+			} else {
+				gsl_vector_view vblock = gsl_vector_subvector(v, start, rows);
+				gsl_blas_dgemv(CblasNoTrans, 1.0, &J.matrix, u, 0.0, &vblock.vector);
+			}
+		}
+	}
+
+	// the columns of fixed parameters are zero, keep J^T J positive definite (the step of these parameters stays zero)
+	if (JTJ) {
+		for (size_t j = 0; j < np; j++)
+			if (d->paramFixed[j])
+				gsl_matrix_set(JTJ, j, j, 1.);
+	}
+
+	return GSL_SUCCESS;
+}
+#endif
+
 /* prepare the fit result columns */
 void XYFitCurvePrivate::prepareResultColumns() {
 	DEBUG("XYFitCurvePrivate::prepareResultColumns()")
@@ -1553,37 +1954,31 @@ void XYFitCurvePrivate::prepareResultColumns() {
 	DEBUG("XYFitCurvePrivate::prepareResultColumns() DONE")
 }
 
-void XYFitCurvePrivate::recalculate() {
-	DEBUG("XYFitCurvePrivate::recalculate()");
-
-	QElapsedTimer timer;
-	timer.start();
-
-	// prepare source data columns
-	const AbstractColumn* tmpXDataColumn = nullptr;
-	const AbstractColumn* tmpYDataColumn = nullptr;
-	if (dataSourceType == XYAnalysisCurve::DataSourceType::Spreadsheet) {
-		DEBUG("	spreadsheet columns as data source");
-		tmpXDataColumn = xDataColumn;
-		tmpYDataColumn = yDataColumn;
-	} else {
-		DEBUG("	curve columns as data source");
-		tmpXDataColumn = dataSourceCurve->xColumn();
-		tmpYDataColumn = dataSourceCurve->yColumn();
-	}
-
-	// clear the previous result
-	fitResult = XYFitCurve::FitResult();
-
-	if (!tmpXDataColumn || !tmpYDataColumn) {
-		DEBUG("	ERROR: Preparing source data columns failed!");
-		emit q->dataChanged();
-		sourceDataChangedSinceLastRecalc = false;
-		return;
-	}
-
-	prepareResultColumns();
+/*!
+ * compiles the model of \c fitData with the variable "x" and the fit parameters.
+ * Returns \c nullptr if the model can't be compiled and has to be parsed for every point.
+ */
+parser_program* XYFitCurvePrivate::compileModel(const XYFitCurve::FitData& fitData) {
+	QVector<QByteArray> varNamesBA{"x"};
+	for (const auto& name : fitData.paramNames)
+		varNamesBA << name.toLatin1();
+	QVector<const char*> varNames;
+	for (const auto& name : varNamesBA)
+		varNames << name.constData();
+	return parser_compile(fitData.model.toLatin1().constData(), varNames.constData(), varNames.size());
+}
 
+/*!
+ * fits the model of \c fitData to the data points and fills \c fitResult (except of the elapsed time).
+ * \c residuals gets the (weighted) residuals of the data points.
+ * \c progress is called after every iteration with the number of iterations relative to the maximal number in percent,
+ * the fit is stopped if it returns \c false.
+ * \c program is the model compiled with compileModel(), the model is compiled in the fit if \c nullptr.
+ * The fit doesn't depend on a curve, it is thread-safe if the model can be compiled (see parser_compile()).
+ */
+void XYFitCurvePrivate::fit(XYFitCurve::FitData& fitData, XYFitCurve::FitResult& fitResult, QVector<double>& xdataVector, QVector<double>& ydataVector,
+		QVector<double>& xerrorVector, QVector<double>& yerrorVector, QVector<double>* residuals, const std::function<bool(int)>& progress,
+		const parser_program* program) {
 	//fit settings
 	const unsigned int maxIters = fitData.maxIterations;	//maximal number of iterations
 	const double delta = fitData.eps;		//fit tolerance
@@ -1592,106 +1987,9 @@ void XYFitCurvePrivate::recalculate() {
 		fitResult.available = true;
 		fitResult.valid = false;
 		fitResult.status = i18n("Model has no parameters.");
-		emit q->dataChanged();
-		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	if (yErrorColumn) {
-		if (yErrorColumn->rowCount() < tmpXDataColumn->rowCount()) {
-			fitResult.available = true;
-			fitResult.valid = false;
-			fitResult.status = i18n("Not sufficient weight data points provided.");
-			emit q->dataChanged();
-			sourceDataChangedSinceLastRecalc = false;
-			return;
-		}
-	}
-
-	//copy all valid data point for the fit to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
-	QVector<double> xerrorVector;
-	QVector<double> yerrorVector;
-	double xmin, xmax;
-	if (fitData.autoRange) {
-		xmin = tmpXDataColumn->minimum();
-		xmax = tmpXDataColumn->maximum();
-	} else {
-		xmin = fitData.fitRange.first();
-		xmax = fitData.fitRange.last();
-	}
-	DEBUG("	fit range = " << xmin << " .. " << xmax);
-
-	//logic from XYAnalysisCurve::copyData(), extended by the handling of error columns.
-	//TODO: decide how to deal with non-numerical error columns
-	int rowCount = qMin(tmpXDataColumn->rowCount(), tmpYDataColumn->rowCount());
-	for (int row = 0; row < rowCount; ++row) {
-		// omit invalid data
-		if (!tmpXDataColumn->isValid(row) || tmpXDataColumn->isMasked(row) ||
-				!tmpYDataColumn->isValid(row) || tmpYDataColumn->isMasked(row))
-			continue;
-
-		double x = NAN;
-		switch (tmpXDataColumn->columnMode()) {
-		case AbstractColumn::ColumnMode::Numeric:
-			x = tmpXDataColumn->valueAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Integer:
-			x = tmpXDataColumn->integerAt(row);
-			break;
-		case AbstractColumn::ColumnMode::BigInt:
-			x = tmpXDataColumn->bigIntAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Text:	// not valid
-			break;
-		case AbstractColumn::ColumnMode::DateTime:
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::Month:
-			x = tmpXDataColumn->dateTimeAt(row).toMSecsSinceEpoch();
-		}
-
-		double y = NAN;
-		switch (tmpYDataColumn->columnMode()) {
-		case AbstractColumn::ColumnMode::Numeric:
-			y = tmpYDataColumn->valueAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Integer:
-			y = tmpYDataColumn->integerAt(row);
-			break;
-		case AbstractColumn::ColumnMode::BigInt:
-			y = tmpYDataColumn->bigIntAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Text:	// not valid
-			break;
-		case AbstractColumn::ColumnMode::DateTime:
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::Month:
-			y = tmpYDataColumn->dateTimeAt(row).toMSecsSinceEpoch();
-		}
-
-		// only when inside given range
-		if (x >= xmin && x <= xmax) {
-			if ((!xErrorColumn && !yErrorColumn) || !fitData.useDataErrors) {	// x-y
-				xdataVector.append(x);
-				ydataVector.append(y);
-			} else if (!xErrorColumn && yErrorColumn) {	// x-y-dy
-				if (!std::isnan(yErrorColumn->valueAt(row))) {
-					xdataVector.append(x);
-					ydataVector.append(y);
-					yerrorVector.append(yErrorColumn->valueAt(row));
-				}
-			} else if (xErrorColumn && yErrorColumn) {	// x-y-dx-dy
-				if (!std::isnan(xErrorColumn->valueAt(row)) && !std::isnan(yErrorColumn->valueAt(row))) {
-					xdataVector.append(x);
-					ydataVector.append(y);
-					xerrorVector.append(xErrorColumn->valueAt(row));
-					yerrorVector.append(yErrorColumn->valueAt(row));
-				}
-			}
-		}
-	}
-
 	//number of data points to fit
 	const size_t n = xdataVector.size();
 	DEBUG("	number of data points: " << n);
@@ -1699,8 +1997,6 @@ void XYFitCurvePrivate::recalculate() {
 		fitResult.available = true;
 		fitResult.valid = false;
 		fitResult.status = i18n("No data points available.");
-		emit q->dataChanged();
-		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
@@ -1708,8 +2004,6 @@ void XYFitCurvePrivate::recalculate() {
 		fitResult.available = true;
 		fitResult.valid = false;
 		fitResult.status = i18n("The number of data points (%1) must be greater than or equal to the number of parameters (%2).", n, np);
-		emit q->dataChanged();
-		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
@@ -1717,8 +2011,6 @@ void XYFitCurvePrivate::recalculate() {
 		fitResult.available = true;
 		fitResult.valid = false;
 		fitResult.status = i18n("Fit model not specified.");
-		emit q->dataChanged();
-		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
@@ -1778,7 +2070,15 @@ void XYFitCurvePrivate::recalculate() {
 	//function to fit
 	gsl_multifit_function_fdf f;
 	DEBUG("	model = " << STDSTRING(fitData.model));
-	struct data params = {n, xdata, ydata, weight, fitData.modelCategory, fitData.modelType, fitData.degree, &fitData.model, &fitData.paramNames, fitData.paramLowerLimits.data(), fitData.paramUpperLimits.data(), fitData.paramFixed.data()};
+	// compile the model once, the fit evaluates it many times for all data points
+	parser_program* ownProgram = program ? nullptr : compileModel(fitData);
+	if (!program)
+		program = ownProgram;
+	DEBUG("	model compiled: " << (program != nullptr));
+	QVector<double> buffer(program ? 3*n : 0);
+
+	struct data params = {n, xdata, ydata, weight, fitData.modelCategory, fitData.modelType, fitData.degree, &fitData.model, &fitData.paramNames, fitData.paramLowerLimits.data(), fitData.paramUpperLimits.data(), fitData.paramFixed.data(),
+		program, buffer.data(), nullptr};
 	f.f = &func_f;
 	f.df = &func_df;
 	f.fdf = &func_fdf;
@@ -1786,9 +2086,40 @@ void XYFitCurvePrivate::recalculate() {
 	f.p = np;
 	f.params = &params;
 
-	DEBUG("	initialize the derivative solver (using Levenberg-Marquardt robust solver)");
-	const gsl_multifit_fdfsolver_type* T = gsl_multifit_fdfsolver_lmsder;
-	gsl_multifit_fdfsolver* s = gsl_multifit_fdfsolver_alloc(T, n, np);
+	gsl_multifit_fdfsolver* s = nullptr;
+	const gsl_vector* solverX;	// current parameters, residuals and step of the solver
+	const gsl_vector* solverF;
+	const gsl_vector* solverDx;
+#if (GSL_MAJOR_VERSION > 2) || (GSL_MAJOR_VERSION == 2) && (GSL_MINOR_VERSION >= 2)
+	gsl_multilarge_nlinear_fdf fLarge;
+	gsl_multilarge_nlinear_workspace* w = nullptr;
+	if (fitData.algorithm == nsl_fit_algorithm_large) {
+		DEBUG("	initialize the large data set solver (using Levenberg-Marquardt on the normal equations)");
+		const size_t jacobianBlockSize = 65536;
+		params.jacobianBlock = gsl_matrix_alloc(qMin(n, jacobianBlockSize), np);
+		fLarge.f = &func_f;
+		fLarge.df = &func_df_large;
+		fLarge.fvv = nullptr;
+		fLarge.n = n;
+		fLarge.p = np;
+		fLarge.params = &params;
+
+		gsl_multilarge_nlinear_parameters largeParams = gsl_multilarge_nlinear_default_parameters();
+		largeParams.trs = gsl_multilarge_nlinear_trs_lm;
+		w = gsl_multilarge_nlinear_alloc(gsl_multilarge_nlinear_trust, &largeParams, n, np);
+		solverX = w->x;
+		solverF = w->f;
+		solverDx = w->dx;
+	} else
+#endif
+	{
+		DEBUG("	initialize the derivative solver (using Levenberg-Marquardt robust solver)");
+		const gsl_multifit_fdfsolver_type* T = gsl_multifit_fdfsolver_lmsder;
+		s = gsl_multifit_fdfsolver_alloc(T, n, np);
+		solverX = s->x;
+		solverF = s->f;
+		solverDx = s->dx;
+	}
 
 	DEBUG("	set start values");
 	double* x_init = fitData.paramStartValues.data();
@@ -1801,14 +2132,38 @@ void XYFitCurvePrivate::recalculate() {
 	gsl_vector_view x = gsl_vector_view_array(x_init, np);
 	DEBUG("	Turning off GSL error handler to avoid overflow/underflow");
 	gsl_set_error_handler_off();
+	// (re)start and iterate the selected solver
+	auto setSolver = [&]() {
+#if (GSL_MAJOR_VERSION > 2) || (GSL_MAJOR_VERSION == 2) && (GSL_MINOR_VERSION >= 2)
+		if (w) {
+			gsl_multilarge_nlinear_init(&x.vector, &fLarge, w);
+			return;
+		}
+#endif
+		gsl_multifit_fdfsolver_set(s, &f, &x.vector);
+	};
+	auto iterateSolver = [&]() {
+#if (GSL_MAJOR_VERSION > 2) || (GSL_MAJOR_VERSION == 2) && (GSL_MINOR_VERSION >= 2)
+		if (w)
+			return gsl_multilarge_nlinear_iterate(w);
+#endif
+		return gsl_multifit_fdfsolver_iterate(s);
+	};
+
 	DEBUG("	Initialize solver with function f and initial guess x");
-	gsl_multifit_fdfsolver_set(s, &f, &x.vector);
+	setSolver();
 
 	DEBUG("	Iterate ...");
 	int status;
 	unsigned int iter = 0;
+	bool cancelled = false;
+	auto continueFit = [&]() {
+		if (progress && !progress(qMin(100, (int)(100. * iter / maxIters))))
+			cancelled = true;
+		return !cancelled;
+	};
 	fitResult.solverOutput.clear();
-	writeSolverState(s);
+	writeSolverState(fitData, fitResult, solverX, solverF);
 	do {
 		iter++;
 		DEBUG("		iter " << iter);
@@ -1816,26 +2171,26 @@ void XYFitCurvePrivate::recalculate() {
 		// update weights for Y-depending weights (using function values from residuals)
 		if (fitData.yWeightsType == nsl_fit_weight_statistical_fit) {
 			for (size_t i = 0; i < n; i++)
-				weight[i] = 1./(gsl_vector_get(s->f, i)/sqrt(weight[i]) + ydata[i]);	// 1/Y_i
+				weight[i] = 1./(gsl_vector_get(solverF, i)/sqrt(weight[i]) + ydata[i]);	// 1/Y_i
 		} else if (fitData.yWeightsType == nsl_fit_weight_relative_fit) {
 			for (size_t i = 0; i < n; i++)
-				weight[i] = 1./gsl_pow_2(gsl_vector_get(s->f, i)/sqrt(weight[i]) + ydata[i]);	// 1/Y_i^2
+				weight[i] = 1./gsl_pow_2(gsl_vector_get(solverF, i)/sqrt(weight[i]) + ydata[i]);	// 1/Y_i^2
 		}
 
 		DEBUG("		run fdfsolver_iterate");
-		status = gsl_multifit_fdfsolver_iterate(s);
+		status = iterateSolver();
 		DEBUG("		fdfsolver_iterate DONE");
-		writeSolverState(s);
+		writeSolverState(fitData, fitResult, solverX, solverF);
 		if (status) {
 			DEBUG("		iter " << iter << ", status = " << gsl_strerror(status));
 			break;
 		}
-		status = gsl_multifit_test_delta(s->dx, s->x, delta, delta);
+		status = gsl_multifit_test_delta(solverDx, solverX, delta, delta);
 		DEBUG("		iter " << iter << ", test status = " << status);
-	} while (status == GSL_CONTINUE && iter < maxIters);
+	} while (status == GSL_CONTINUE && iter < maxIters && continueFit());
 
 	// second run for x-error fitting
-	if (xerrorVector.size() > 0) {
+	if (xerrorVector.size() > 0 && !cancelled) {
 		DEBUG("	Rerun fit with x errors");
 
 		unsigned int iter2 = 0;
@@ -1848,7 +2203,7 @@ void XYFitCurvePrivate::recalculate() {
 
 			// calculate function from residuals
 			for (size_t i = 0; i < n; i++)
-				fun[i] = gsl_vector_get(s->f, i) * 1./sqrt(weight[i]) + ydata[i];
+				fun[i] = gsl_vector_get(solverF, i) * 1./sqrt(weight[i]) + ydata[i];
 
 			// calculate weight[i]
 			for (size_t i = 0; i < n; i++) {
@@ -1915,27 +2270,28 @@ void XYFitCurvePrivate::recalculate() {
 			}
 
 			// update weights
-			gsl_multifit_fdfsolver_set(s, &f, &x.vector);
+			setSolver();
 
 			do {	// fit
 				iter++;
-				writeSolverState(s);
-				status = gsl_multifit_fdfsolver_iterate(s);
+				writeSolverState(fitData, fitResult, solverX, solverF);
+				status = iterateSolver();
 				//printf ("status = %s\n", gsl_strerror (status));
 				if (status) {
 					DEBUG("		iter " << iter << ", status = " << gsl_strerror(status));
 					break;
 				}
-				status = gsl_multifit_test_delta(s->dx, s->x, delta, delta);
-			} while (status == GSL_CONTINUE && iter < maxIters);
+				status = gsl_multifit_test_delta(solverDx, solverX, delta, delta);
+			} while (status == GSL_CONTINUE && iter < maxIters && continueFit());
 
-			chisq = gsl_blas_dnrm2(s->f);
-		} while (iter2 < maxIters && fabs(chisq-chisqOld) > fitData.eps);
+			chisq = gsl_blas_dnrm2(solverF);
+		} while (iter2 < maxIters && fabs(chisq-chisqOld) > fitData.eps && !cancelled);
 
 		delete[] fun;
 	}
 
 	delete[] weight;
+	parser_program_free(ownProgram);
 
 	// unscale start parameter
 	for (unsigned int i = 0; i < np; i++)
@@ -1944,25 +2300,33 @@ void XYFitCurvePrivate::recalculate() {
 	//get the covariance matrix
 	//TODO: scale the Jacobian when limits are used before constructing the covar matrix?
 	gsl_matrix* covar = gsl_matrix_alloc(np, np);
+#if (GSL_MAJOR_VERSION > 2) || (GSL_MAJOR_VERSION == 2) && (GSL_MINOR_VERSION >= 2)
+	if (w)	// from J^T J of the last iteration
+		gsl_multilarge_nlinear_covar(covar, w);
+	else
+#endif
+	{
 #if GSL_MAJOR_VERSION >= 2
 	// the Jacobian is not part of the solver anymore
 	gsl_matrix *J = gsl_matrix_alloc(s->fdf->n, s->fdf->p);
 	gsl_multifit_fdfsolver_jac(s, J);
 	gsl_multifit_covar(J, 0.0, covar);
+	gsl_matrix_free(J);
 #else
 	gsl_multifit_covar(s->J, 0.0, covar);
 #endif
+	}
 
 	//write the result
 	fitResult.available = true;
-	fitResult.valid = true;
-	fitResult.status = gslErrorToString(status);
+	fitResult.valid = !cancelled;
+	fitResult.status = cancelled ? i18n("Fit cancelled.") : gslErrorToString(status);
 	fitResult.iterations = iter;
 	fitResult.dof = n - (np - nf);	// samples - (parameter - fixed parameter)
 
 	//gsl_blas_dnrm2() - computes the Euclidian norm (||r||_2 = \sqrt {\sum r_i^2}) of the vector with the elements weight[i]*(Yi - y[i])
 	//gsl_blas_dasum() - computes the absolute sum \sum |r_i| of the elements of the vector with the elements weight[i]*(Yi - y[i])
-	fitResult.sse = gsl_pow_2(gsl_blas_dnrm2(s->f));
+	fitResult.sse = gsl_pow_2(gsl_blas_dnrm2(solverF));
 
 	if (fitResult.dof != 0) {
 		fitResult.rms = fitResult.sse/fitResult.dof;
@@ -1970,7 +2334,7 @@ void XYFitCurvePrivate::recalculate() {
 	}
 	fitResult.mse = fitResult.sse/n;
 	fitResult.rmse = sqrt(fitResult.mse);
-	fitResult.mae = gsl_blas_dasum(s->f)/n;
+	fitResult.mae = gsl_blas_dasum(solverF)/n;
 	// SST needed for coefficient of determination, R-squared and F test
 	fitResult.sst = gsl_stats_tss(ydata, 1, n);
 	// for a linear model without intercept R-squared is calculated differently
@@ -2006,7 +2370,7 @@ void XYFitCurvePrivate::recalculate() {
 	const double alpha = 1.0 - fitData.confidenceInterval/100.;
 	for (unsigned int i = 0; i < np; i++) {
 		// scale resulting values if they are bounded
-		fitResult.paramValues[i] = nsl_fit_map_bound(gsl_vector_get(s->x, i), x_min[i], x_max[i]);
+		fitResult.paramValues[i] = nsl_fit_map_bound(gsl_vector_get(solverX, i), x_min[i], x_max[i]);
 		// use results as start values if desired
 		if (fitData.useResults) {
 			fitData.paramStartValues.data()[i] = fitResult.paramValues[i];
@@ -2018,53 +2382,158 @@ void XYFitCurvePrivate::recalculate() {
 		fitResult.tdist_marginValues[i] = nsl_stats_tdist_margin(alpha, fitResult.dof, fitResult.errorValues.at(i));
 	}
 
-	// fill residuals vector. To get residuals on the correct x values, fill the rest with zeros.
-	residualsVector->resize(tmpXDataColumn->rowCount());
-	DEBUG("	Residual vector size: " << residualsVector->size())
-	if (fitData.autoRange) {	// evaluate full range of residuals
-		xVector->resize(tmpXDataColumn->rowCount());
-		auto mode = tmpXDataColumn->columnMode();
-		for (int i = 0; i < tmpXDataColumn->rowCount(); i++)
-			if (mode == AbstractColumn::ColumnMode::Numeric)
-				(*xVector)[i] = tmpXDataColumn->valueAt(i);
-			else if (mode == AbstractColumn::ColumnMode::Integer)
-				(*xVector)[i] = tmpXDataColumn->integerAt(i);
-			else if (mode == AbstractColumn::ColumnMode::BigInt)
-				(*xVector)[i] = tmpXDataColumn->bigIntAt(i);
-			else if (mode == AbstractColumn::ColumnMode::DateTime)
-				(*xVector)[i] = tmpXDataColumn->dateTimeAt(i).toMSecsSinceEpoch();
-
-		ExpressionParser* parser = ExpressionParser::getInstance();
-		bool rc = parser->evaluateCartesian(fitData.model, xVector, residualsVector,
-							fitData.paramNames, fitResult.paramValues);
-		if (rc) {
-			for (int i = 0; i < tmpXDataColumn->rowCount(); i++)
-				(*residualsVector)[i] = tmpYDataColumn->valueAt(i) - (*residualsVector)[i];
-		} else {
-			DEBUG("	ERROR: Failed parsing residuals")
-			residualsVector->clear();
-		}
-	} else {	// only selected range
-		size_t j = 0;
-		for (int i = 0; i < tmpXDataColumn->rowCount(); i++) {
-			if (tmpXDataColumn->valueAt(i) >= xmin && tmpXDataColumn->valueAt(i) <= xmax)
-				residualsVector->data()[i] = - gsl_vector_get(s->f, j++);
-			else	// outside range
-				residualsVector->data()[i] = 0;
-		}
+	if (residuals) {
+		residuals->resize(n);
+		for (size_t i = 0; i < n; i++)
+			(*residuals)[i] = - gsl_vector_get(solverF, i);
 	}
-	residualsColumn->setChanged();
 
 	//free resources
-	gsl_multifit_fdfsolver_free(s);
+	if (s)
+		gsl_multifit_fdfsolver_free(s);
+#if (GSL_MAJOR_VERSION > 2) || (GSL_MAJOR_VERSION == 2) && (GSL_MINOR_VERSION >= 2)
+	if (w)
+		gsl_multilarge_nlinear_free(w);
+#endif
+	if (params.jacobianBlock)
+		gsl_matrix_free(params.jacobianBlock);
 	gsl_matrix_free(covar);
+}
+
+void XYFitCurvePrivate::recalculate() {
+	DEBUG("XYFitCurvePrivate::recalculate()");
+
+	QElapsedTimer timer;
+	timer.start();
+
+	// prepare source data columns
+	const AbstractColumn* tmpXDataColumn = nullptr;
+	const AbstractColumn* tmpYDataColumn = nullptr;
+	if (dataSourceType == XYAnalysisCurve::DataSourceType::Spreadsheet) {
+		DEBUG("	spreadsheet columns as data source");
+		tmpXDataColumn = xDataColumn;
+		tmpYDataColumn = yDataColumn;
+	} else {
+		DEBUG("	curve columns as data source");
+		tmpXDataColumn = dataSourceCurve->xColumn();
+		tmpYDataColumn = dataSourceCurve->yColumn();
+	}
+
+	if (!tmpXDataColumn || !tmpYDataColumn) {
+		DEBUG("	ERROR: Preparing source data columns failed!");
+		fitResult = XYFitCurve::FitResult();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+		return;
+	}
+
+	if (yErrorColumn) {
+		if (yErrorColumn->rowCount() < tmpXDataColumn->rowCount()) {
+			prepareResultColumns();
+			fitResult = XYFitCurve::FitResult();
+			fitResult.available = true;
+			fitResult.valid = false;
+			fitResult.status = i18n("Not sufficient weight data points provided.");
+			emit q->dataChanged();
+			sourceDataChangedSinceLastRecalc = false;
+			return;
+		}
+	}
 
-	//calculate the fit function (vectors)
-	evaluate();
-	fitResult.elapsedTime = timer.elapsed();
+	//copy all valid data point for the fit to temporary vectors
+	QVector<double> xdataVector;
+	QVector<double> ydataVector;
+	QVector<double> xerrorVector;
+	QVector<double> yerrorVector;
+	double xmin, xmax;
+	if (fitData.autoRange) {
+		xmin = tmpXDataColumn->minimum();
+		xmax = tmpXDataColumn->maximum();
+	} else {
+		xmin = fitData.fitRange.first();
+		xmax = fitData.fitRange.last();
+	}
+	DEBUG("	fit range = " << xmin << " .. " << xmax);
+
+	copyFitData(fitData, tmpXDataColumn, tmpYDataColumn, xErrorColumn, yErrorColumn, 0, -1, xmin, xmax,
+			xdataVector, ydataVector, xerrorVector, yerrorVector);
+
+	// the fit can only run in the background if the model can be compiled,
+	// parsing the model for every data point uses the shared symbol table of the parser
+	parser_program* program = compileModel(fitData);
+	if (!program)
+		asyncRecalculation = false;
+	parser_program_free(program);
+
+	const XYFitCurve::FitData data = fitData;
+	auto calculate = [=]() mutable {
+		calculatedFitData = data;	// the fit changes the start values
+		calculatedFitResult = XYFitCurve::FitResult();
+		calculatedResidualsVector.clear();
+		auto progress = [this](int percentage) {
+			setRecalculationProgress(percentage);
+			return !recalculationCancelled();
+		};
+		fit(calculatedFitData, calculatedFitResult, xdataVector, ydataVector, xerrorVector, yerrorVector, &calculatedResidualsVector, progress);
+	};
+
+	auto finish = [=]() {
+		fitResult = calculatedFitResult;
+		if (fitData.useResults)
+			fitData.paramStartValues = calculatedFitData.paramStartValues;
+		prepareResultColumns();
+		if (!fitResult.valid) {
+			emit q->dataChanged();
+			sourceDataChangedSinceLastRecalc = false;
+			return;
+		}
+
+		// fill residuals vector. To get residuals on the correct x values, fill the rest with zeros.
+		residualsVector->resize(tmpXDataColumn->rowCount());
+		DEBUG("	Residual vector size: " << residualsVector->size())
+		if (fitData.autoRange) {	// evaluate full range of residuals
+			xVector->resize(tmpXDataColumn->rowCount());
+			auto mode = tmpXDataColumn->columnMode();
+			for (int i = 0; i < tmpXDataColumn->rowCount(); i++)
+				if (mode == AbstractColumn::ColumnMode::Numeric)
+					(*xVector)[i] = tmpXDataColumn->valueAt(i);
+				else if (mode == AbstractColumn::ColumnMode::Integer)
+					(*xVector)[i] = tmpXDataColumn->integerAt(i);
+				else if (mode == AbstractColumn::ColumnMode::BigInt)
+					(*xVector)[i] = tmpXDataColumn->bigIntAt(i);
+				else if (mode == AbstractColumn::ColumnMode::DateTime)
+					(*xVector)[i] = tmpXDataColumn->dateTimeMSecsAt(i);
+
+			ExpressionParser* parser = ExpressionParser::getInstance();
+			bool rc = parser->evaluateCartesian(fitData.model, xVector, residualsVector,
+								fitData.paramNames, fitResult.paramValues);
+			if (rc) {
+				for (int i = 0; i < tmpXDataColumn->rowCount(); i++)
+					(*residualsVector)[i] = tmpYDataColumn->valueAt(i) - (*residualsVector)[i];
+			} else {
+				DEBUG("	ERROR: Failed parsing residuals")
+				residualsVector->clear();
+			}
+		} else {	// only selected range
+			size_t j = 0;
+			for (int i = 0; i < tmpXDataColumn->rowCount(); i++) {
+				if (tmpXDataColumn->valueAt(i) >= xmin && tmpXDataColumn->valueAt(i) <= xmax)
+					residualsVector->data()[i] = calculatedResidualsVector.at(j++);
+				else	// outside range
+					residualsVector->data()[i] = 0;
+			}
+		}
+		residualsColumn->setChanged();
+
+		//calculate the fit function (vectors)
+		evaluate();
+		fitResult.elapsedTime = timer.elapsed();
+
+		sourceDataChangedSinceLastRecalc = false;
+		DEBUG("XYFitCurvePrivate::recalculate() DONE");
+	};
 
-	sourceDataChangedSinceLastRecalc = false;
-	DEBUG("XYFitCurvePrivate::recalculate() DONE");
+	runRecalculation(calculate, finish);
 }
 
 /* evaluate fit function (preview == true: use start values, default: false) */
@@ -2143,22 +2612,22 @@ void XYFitCurvePrivate::evaluate(bool preview) {
 /*!
  * writes out the current state of the solver \c s
  */
-void XYFitCurvePrivate::writeSolverState(gsl_multifit_fdfsolver* s) {
+void XYFitCurvePrivate::writeSolverState(const XYFitCurve::FitData& fitData, XYFitCurve::FitResult& fitResult, const gsl_vector* x, const gsl_vector* f) {
 	QString state;
 
 	//current parameter values, semicolon separated
 	double* min = fitData.paramLowerLimits.data();
 	double* max = fitData.paramUpperLimits.data();
 	for (int i = 0; i < fitData.paramNames.size(); ++i) {
-		const double x = gsl_vector_get(s->x, i);
+		const double value = gsl_vector_get(x, i);
 		// map parameter if bounded
-		state += QString::number(nsl_fit_map_bound(x, min[i], max[i])) + '\t';
+		state += QString::number(nsl_fit_map_bound(value, min[i], max[i])) + '\t';
 	}
 
 	//current value of the chi2-function
-	state += QString::number(gsl_pow_2(gsl_blas_dnrm2(s->f)));
+	state += QString::number(gsl_pow_2(gsl_blas_dnrm2(f)));
 	state += ';';
-	DEBUG("	chi = " << gsl_pow_2(gsl_blas_dnrm2(s->f)));
+	DEBUG("	chi = " << gsl_pow_2(gsl_blas_dnrm2(f)));
 
 	fitResult.solverOutput += state;
 }
@@ -2192,6 +2661,7 @@ void XYFitCurve::save(QXmlStreamWriter* writer) const {
 	writer->writeAttribute("degree", QString::number(d->fitData.degree));
 	if (d->fitData.modelCategory == nsl_fit_model_custom)
 		writer->writeAttribute("model", d->fitData.model);
+	writer->writeAttribute("algorithm", QString::number(d->fitData.algorithm));
 	writer->writeAttribute("maxIterations", QString::number(d->fitData.maxIterations));
 	writer->writeAttribute("eps", QString::number(d->fitData.eps, 'g', 15));
 	writer->writeAttribute("evaluatedPoints", QString::number(d->fitData.evaluatedPoints));
@@ -2332,6 +2802,9 @@ bool XYFitCurve::load(XmlStreamReader* reader, bool preview) {
 				READ_STRING_VALUE("model", fitData.model);
 				DEBUG("read model = " << STDSTRING(d->fitData.model));
 			}
+			str = attribs.value("algorithm").toString();
+			if (!str.isEmpty())
+				d->fitData.algorithm = (nsl_fit_algorithm_type)str.toInt();
 			READ_INT_VALUE("maxIterations", fitData.maxIterations, int);
 			READ_DOUBLE_VALUE("eps", fitData.eps);
 			READ_INT_VALUE("fittedPoints", fitData.evaluatedPoints, size_t);	// old name
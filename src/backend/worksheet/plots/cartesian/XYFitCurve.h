@@ -38,6 +38,7 @@ extern "C" {
 }
 
 class XYFitCurvePrivate;
+class Spreadsheet;
 
 class XYFitCurve : public XYAnalysisCurve {
 	Q_OBJECT
@@ -59,6 +60,7 @@ public:
 		QVector<double> paramUpperLimits;
 		QVector<bool> paramFixed;
 
+		nsl_fit_algorithm_type algorithm{nsl_fit_algorithm_lm};
 		int maxIterations{500};
 		double eps{1.e-4};
 		size_t evaluatedPoints{1000};
@@ -107,6 +109,16 @@ public:
 		QString solverOutput;
 	};
 
+	// data set of a batch fit: rows startRow .. endRow (-1 = last row) of the columns
+	struct BatchFitData {
+		const AbstractColumn* xColumn{nullptr};
+		const AbstractColumn* yColumn{nullptr};
+		const AbstractColumn* xErrorColumn{nullptr};	// optional, used if FitData::useDataErrors is set
+		const AbstractColumn* yErrorColumn{nullptr};	// optional, used if FitData::useDataErrors is set
+		int startRow{0};
+		int endRow{-1};
+	};
+
 	explicit XYFitCurve(const QString& name);
 	~XYFitCurve() override;
 
@@ -116,6 +128,9 @@ public:
 	static void initFitData(XYFitCurve::FitData&);
 	void initStartValues(const XYCurve*);
 	static void initStartValues(XYFitCurve::FitData&, const XYCurve*);
+	static QVector<XYFitCurve::FitResult> batchFit(const XYFitCurve::FitData&, const QVector<XYFitCurve::BatchFitData>&);
+	static void batchFitResults(const XYFitCurve::FitData&, const QVector<XYFitCurve::BatchFitData>&,
+				const QVector<XYFitCurve::FitResult>&, Spreadsheet*);
 
 	QIcon icon() const override;
 	void save(QXmlStreamWriter*) const override;
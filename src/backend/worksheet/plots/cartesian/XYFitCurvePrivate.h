@@ -34,6 +34,7 @@
 
 class XYFitCurve;
 class Column;
+struct parser_program;
 
 extern "C" {
 #include <gsl/gsl_multifit_nlin.h>
@@ -46,6 +47,10 @@ public:
 
 	void recalculate();
 	void evaluate(bool preview = false);
+	static void fit(XYFitCurve::FitData&, XYFitCurve::FitResult&, QVector<double>& xdata, QVector<double>& ydata,
+			QVector<double>& xerror, QVector<double>& yerror, QVector<double>* residuals = nullptr,
+			const std::function<bool(int)>& progress = nullptr, const parser_program* program = nullptr);
+	static parser_program* compileModel(const XYFitCurve::FitData&);
 
 	const AbstractColumn* xErrorColumn{nullptr}; //<! column storing the values for the x-error to be used in the fit
 	const AbstractColumn* yErrorColumn{nullptr}; //<! column storing the values for the y-error to be used in the fit
@@ -59,11 +64,15 @@ public:
 	Column* residualsColumn{nullptr};
 	QVector<double>* residualsVector{nullptr};
 
+	XYFitCurve::FitData calculatedFitData; //<! fit data used in the running fit, contains the resulting start values
+	XYFitCurve::FitResult calculatedFitResult; //<! result of the running fit, applied when finished
+	QVector<double> calculatedResidualsVector; //<! residuals of the fitted data points calculated in the running fit
+
 	XYFitCurve* const q;
 
 private:
 	void prepareResultColumns();
-	void writeSolverState(gsl_multifit_fdfsolver*);
+	static void writeSolverState(const XYFitCurve::FitData&, XYFitCurve::FitResult&, const gsl_vector* x, const gsl_vector* f);
 };
 
 #endif
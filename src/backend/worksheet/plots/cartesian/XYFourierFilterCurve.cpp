@@ -110,10 +110,9 @@ XYFourierFilterCurvePrivate::XYFourierFilterCurvePrivate(XYFourierFilterCurve* o
 XYFourierFilterCurvePrivate::~XYFourierFilterCurvePrivate() = default;
 
 void XYFourierFilterCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
+	recalculationTimer.start();
 
-	//create filter result columns if not available yet, clear them otherwise
+	//create filter result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Numeric);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Numeric);
@@ -129,14 +128,8 @@ void XYFourierFilterCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	filterResult = XYFourierFilterCurve::FilterResult();
-
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
@@ -151,6 +144,8 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		filterResult = XYFourierFilterCurve::FilterResult();
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -190,19 +185,17 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	//number of data points to filter
 	const size_t n = (size_t)xdataVector.size();
 	if (n == 0) {
+		filterResult = XYFourierFilterCurve::FilterResult();
 		filterResult.available = true;
 		filterResult.valid = false;
 		filterResult.status = i18n("No data points available.");
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	//double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
-
 	// filter settings
 	const nsl_filter_type type = filterData.type;
 	const nsl_filter_form form = filterData.form;
@@ -216,7 +209,6 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	DEBUG("cutoffs ="<<cutoff<<cutoff2);
 	DEBUG("unit :"<<nsl_filter_cutoff_unit_name[unit]<<nsl_filter_cutoff_unit_name[unit2]);
 
-///////////////////////////////////////////////////////////
 	// calculate index
 	double cutindex = 0, cutindex2 = 0;
 	switch (unit) {
@@ -248,25 +240,39 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	DEBUG("cut off @" << cutindex << cutindex2);
 	DEBUG("bandwidth =" << bandwidth);
 
-	// run filter
-	int status = nsl_filter_fourier(ydata, n, type, form, order, cutindex, bandwidth);
+	//the filter doesn't access any columns and can be done in the background
+	auto calculate = [=]() mutable {
+		double* ydata = ydataVector.data();
 
-	xVector->resize((int)n);
-	yVector->resize((int)n);
-	memcpy(xVector->data(), xdataVector.data(), n*sizeof(double));
-	memcpy(yVector->data(), ydata, n*sizeof(double));
 ///////////////////////////////////////////////////////////
+		// run filter
+		filterStatus = nsl_filter_fourier(ydata, n, type, form, order, cutindex, bandwidth);
+		if (filterStatus != GSL_SUCCESS || recalculationCancelled())
+			return;	// no result on failure, the data is not filtered
+		setRecalculationProgress(90);
+
+		xResultVector = xdataVector;
+		yResultVector = ydataVector;
+///////////////////////////////////////////////////////////
+	};
 
-	//write the result
-	filterResult.available = true;
-	filterResult.valid = true;
-	filterResult.status = gslErrorToString(status);
-	filterResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		swapResultVectors();
+
+		//write the result
+		filterResult = XYFourierFilterCurve::FilterResult();
+		filterResult.available = true;
+		filterResult.valid = (filterStatus == GSL_SUCCESS);
+		filterResult.status = gslErrorToString(filterStatus);
+		filterResult.elapsedTime = recalculationTimer.elapsed();
+
+		//redraw the curve
+		recalcLogicalPoints();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	emit q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runRecalculation(calculate, finish);
 }
 
 //##############################################################################
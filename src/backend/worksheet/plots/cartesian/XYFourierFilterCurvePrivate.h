@@ -44,6 +44,7 @@ public:
 
 	XYFourierFilterCurve::FilterData filterData;
 	XYFourierFilterCurve::FilterResult filterResult;
+	int filterStatus{0};
 
 	XYFourierFilterCurve* const q;
 };
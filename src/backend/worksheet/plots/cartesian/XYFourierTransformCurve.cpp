@@ -106,10 +106,9 @@ XYFourierTransformCurvePrivate::XYFourierTransformCurvePrivate(XYFourierTransfor
 XYFourierTransformCurvePrivate::~XYFourierTransformCurvePrivate() = default;
 
 void XYFourierTransformCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
+	recalculationTimer.start();
 
-	//create transform result columns if not available yet, clear them otherwise
+	//create transform result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Numeric);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Numeric);
@@ -125,15 +124,11 @@ void XYFourierTransformCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	transformResult = XYFourierTransformCurve::TransformResult();
-
 	if (!xDataColumn || !yDataColumn) {
+		transformResult = XYFourierTransformCurve::TransformResult();
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -163,18 +158,17 @@ void XYFourierTransformCurvePrivate::recalculate() {
 	//number of data points to transform
 	unsigned int n = (unsigned int)ydataVector.size();
 	if (n == 0) {
+		transformResult = XYFourierTransformCurve::TransformResult();
 		transformResult.available = true;
 		transformResult.valid = false;
 		transformResult.status = i18n("No data points available.");
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// transform settings
 	const nsl_sf_window_type windowType = transformData.windowType;
 	const nsl_dft_result_type type = transformData.type;
@@ -188,75 +182,81 @@ void XYFourierTransformCurvePrivate::recalculate() {
 	DEBUG("scale:" << nsl_dft_xscale_name[xScale]);
 	DEBUG("two sided:" << twoSided);
 	DEBUG("shifted:" << shifted);
-#ifndef NDEBUG
-	QDebug out = qDebug();
-	for (unsigned int i = 0; i < n; i++)
-		out<<ydata[i];
-#endif
+
+	//the transform doesn't access any columns and can be done in the background
+	auto calculate = [=]() mutable {
+		double* xdata = xdataVector.data();
+		double* ydata = ydataVector.data();
 
 ///////////////////////////////////////////////////////////
-	// transform with window
-	int status = nsl_dft_transform_window(ydata, 1, n, twoSided, type, windowType);
-
-	unsigned int N = n;
-	if (twoSided == false)
-		N = n/2;
-
-	switch (xScale) {
-	case nsl_dft_xscale_frequency:
-		for (unsigned int i = 0; i < N; i++) {
-			if (i >= n/2 && shifted)
-				xdata[i] = (n-1)/(xmax-xmin)*(i/(double)n-1.);
-			else
-				xdata[i] = (n-1)*i/(xmax-xmin)/n;
-		}
-		break;
-	case nsl_dft_xscale_index:
-		for (unsigned int i = 0; i < N; i++) {
-			if (i >= n/2 && shifted)
-				xdata[i] = (int)i-(int) N;
-			else
-				xdata[i] = i;
-		}
-		break;
-	case nsl_dft_xscale_period: {
-			double f0 = (n-1)/(xmax-xmin)/n;
+		// transform with window
+		transformStatus = nsl_dft_transform_window(ydata, 1, n, twoSided, type, windowType);
+		if (recalculationCancelled())
+			return;
+		setRecalculationProgress(80);
+
+		unsigned int N = n;
+		if (twoSided == false)
+			N = n/2;
+
+		switch (xScale) {
+		case nsl_dft_xscale_frequency:
 			for (unsigned int i = 0; i < N; i++) {
-				double f = (n-1)*i/(xmax-xmin)/n;
-				xdata[i] = 1/(f+f0);
+				if (i >= n/2 && shifted)
+					xdata[i] = (n-1)/(xmax-xmin)*(i/(double)n-1.);
+				else
+					xdata[i] = (n-1)*i/(xmax-xmin)/n;
 			}
 			break;
+		case nsl_dft_xscale_index:
+			for (unsigned int i = 0; i < N; i++) {
+				if (i >= n/2 && shifted)
+					xdata[i] = (int)i-(int) N;
+				else
+					xdata[i] = i;
+			}
+			break;
+		case nsl_dft_xscale_period: {
+				double f0 = (n-1)/(xmax-xmin)/n;
+				for (unsigned int i = 0; i < N; i++) {
+					double f = (n-1)*i/(xmax-xmin)/n;
+					xdata[i] = 1/(f+f0);
+				}
+				break;
+			}
+		}
+
+		xResultVector.resize((int)N);
+		yResultVector.resize((int)N);
+		if (shifted) {
+			memcpy(xResultVector.data(), &xdata[n/2], n/2*sizeof(double));
+			memcpy(&xResultVector.data()[n/2], xdata, n/2*sizeof(double));
+			memcpy(yResultVector.data(), &ydata[n/2], n/2*sizeof(double));
+			memcpy(&yResultVector.data()[n/2], ydata, n/2*sizeof(double));
+		} else {
+			memcpy(xResultVector.data(), xdata, N*sizeof(double));
+			memcpy(yResultVector.data(), ydata, N*sizeof(double));
 		}
-	}
-#ifndef NDEBUG
-	out = qDebug();
-	for (unsigned int i = 0; i < N; i++)
-		out << ydata[i] << '(' << xdata[i] << ')';
-#endif
-
-	xVector->resize((int)N);
-	yVector->resize((int)N);
-	if (shifted) {
-		memcpy(xVector->data(), &xdata[n/2], n/2*sizeof(double));
-		memcpy(&xVector->data()[n/2], xdata, n/2*sizeof(double));
-		memcpy(yVector->data(), &ydata[n/2], n/2*sizeof(double));
-		memcpy(&yVector->data()[n/2], ydata, n/2*sizeof(double));
-	} else {
-		memcpy(xVector->data(), xdata, N*sizeof(double));
-		memcpy(yVector->data(), ydata, N*sizeof(double));
-	}
 ///////////////////////////////////////////////////////////
+	};
 
-	//write the result
-	transformResult.available = true;
-	transformResult.valid = true;
-	transformResult.status = gslErrorToString(status);
-	transformResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		swapResultVectors();
+
+		//write the result
+		transformResult = XYFourierTransformCurve::TransformResult();
+		transformResult.available = true;
+		transformResult.valid = true;
+		transformResult.status = gslErrorToString(transformStatus);
+		transformResult.elapsedTime = recalculationTimer.elapsed();
+
+		//redraw the curve
+		recalcLogicalPoints();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	emit q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runRecalculation(calculate, finish);
 }
 
 //##############################################################################
@@ -44,6 +44,7 @@ public:
 
 	XYFourierTransformCurve::TransformData transformData;
 	XYFourierTransformCurve::TransformResult transformResult;
+	int transformStatus{0};
 
 	XYFourierTransformCurve* const q;
 };
@@ -104,10 +104,9 @@ XYIntegrationCurvePrivate::XYIntegrationCurvePrivate(XYIntegrationCurve* owner)
 XYIntegrationCurvePrivate::~XYIntegrationCurvePrivate() = default;
 
 void XYIntegrationCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
+	recalculationTimer.start();
 
-	//create integration result columns if not available yet, clear them otherwise
+	//create integration result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Numeric);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Numeric);
@@ -123,14 +122,8 @@ void XYIntegrationCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	integrationResult = XYIntegrationCurve::IntegrationResult();
-
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
@@ -145,6 +138,8 @@ void XYIntegrationCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		integrationResult = XYIntegrationCurve::IntegrationResult();
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -169,18 +164,17 @@ void XYIntegrationCurvePrivate::recalculate() {
 
 	const size_t n = (size_t)xdataVector.size();	// number of data points to integrate
 	if (n < 2) {
+		integrationResult = XYIntegrationCurve::IntegrationResult();
 		integrationResult.available = true;
 		integrationResult.valid = false;
 		integrationResult.status = i18n("Not enough data points available.");
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// integration settings
 	const nsl_int_method_type method = integrationData.method;
 	const bool absolute = integrationData.absolute;
@@ -188,42 +182,58 @@ void XYIntegrationCurvePrivate::recalculate() {
 	DEBUG("method:"<<nsl_int_method_name[method]);
 	DEBUG("absolute area:"<<absolute);
 
+	//the integration doesn't access any columns and can be done in the background
+	auto calculate = [=]() mutable {
+		double* xdata = xdataVector.data();
+		double* ydata = ydataVector.data();
+
 ///////////////////////////////////////////////////////////
-	int status = 0;
-	size_t np = n;
-
-	switch (method) {
-	case nsl_int_method_rectangle:
-		status = nsl_int_rectangle(xdata, ydata, n, absolute);
-		break;
-	case nsl_int_method_trapezoid:
-		status = nsl_int_trapezoid(xdata, ydata, n, absolute);
-		break;
-	case nsl_int_method_simpson:
-		np = nsl_int_simpson(xdata, ydata, n, absolute);
-		break;
-	case nsl_int_method_simpson_3_8:
-		np = nsl_int_simpson_3_8(xdata, ydata, n, absolute);
-		break;
-	}
+		integrationStatus = 0;
+		size_t np = n;
 
-	xVector->resize((int)np);
-	yVector->resize((int)np);
-	memcpy(xVector->data(), xdata, np * sizeof(double));
-	memcpy(yVector->data(), ydata, np * sizeof(double));
+		switch (method) {
+		case nsl_int_method_rectangle:
+			integrationStatus = nsl_int_rectangle(xdata, ydata, n, absolute);
+			break;
+		case nsl_int_method_trapezoid:
+			integrationStatus = nsl_int_trapezoid(xdata, ydata, n, absolute);
+			break;
+		case nsl_int_method_simpson:
+			np = nsl_int_simpson(xdata, ydata, n, absolute);
+			break;
+		case nsl_int_method_simpson_3_8:
+			np = nsl_int_simpson_3_8(xdata, ydata, n, absolute);
+			break;
+		}
+		if (recalculationCancelled())
+			return;
+		setRecalculationProgress(90);
+
+		xResultVector.resize((int)np);
+		yResultVector.resize((int)np);
+		memcpy(xResultVector.data(), xdata, np * sizeof(double));
+		memcpy(yResultVector.data(), ydata, np * sizeof(double));
 ///////////////////////////////////////////////////////////
+	};
+
+	auto finish = [=]() {
+		swapResultVectors();
+
+		//write the result
+		integrationResult = XYIntegrationCurve::IntegrationResult();
+		integrationResult.available = true;
+		integrationResult.valid = true;
+		integrationResult.status = QString::number(integrationStatus);
+		integrationResult.value = yVector->last();
+		integrationResult.elapsedTime = recalculationTimer.elapsed();
+
+		//redraw the curve
+		recalcLogicalPoints();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//write the result
-	integrationResult.available = true;
-	integrationResult.valid = true;
-	integrationResult.status = QString::number(status);
-	integrationResult.elapsedTime = timer.elapsed();
-	integrationResult.value = ydata[np-1];
-
-	//redraw the curve
-	recalcLogicalPoints();
-	emit q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runRecalculation(calculate, finish);
 }
 
 //##############################################################################
@@ -44,6 +44,7 @@ public:
 
 	XYIntegrationCurve::IntegrationData integrationData;
 	XYIntegrationCurve::IntegrationResult integrationResult;
+	int integrationStatus{0};
 
 	XYIntegrationCurve* const q;
 };
@@ -107,10 +107,9 @@ XYInterpolationCurvePrivate::XYInterpolationCurvePrivate(XYInterpolationCurve* o
 XYInterpolationCurvePrivate::~XYInterpolationCurvePrivate() = default;
 
 void XYInterpolationCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
+	recalculationTimer.start();
 
-	//create interpolation result columns if not available yet, clear them otherwise
+	//create interpolation result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Numeric);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Numeric);
@@ -126,14 +125,8 @@ void XYInterpolationCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	interpolationResult = XYInterpolationCurve::InterpolationResult();
-
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
@@ -148,6 +141,8 @@ void XYInterpolationCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		interpolationResult = XYInterpolationCurve::InterpolationResult();
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -156,9 +151,11 @@ void XYInterpolationCurvePrivate::recalculate() {
 
 	//check column sizes
 	if (tmpXDataColumn->rowCount() != tmpYDataColumn->rowCount()) {
+		interpolationResult = XYInterpolationCurve::InterpolationResult();
 		interpolationResult.available = true;
 		interpolationResult.valid = false;
 		interpolationResult.status = i18n("Number of x and y data points must be equal.");
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -184,18 +181,17 @@ void XYInterpolationCurvePrivate::recalculate() {
 	//number of data points to interpolate
 	const size_t n = (size_t)xdataVector.size();
 	if (n < 2) {
+		interpolationResult = XYInterpolationCurve::InterpolationResult();
 		interpolationResult.available = true;
 		interpolationResult.valid = false;
 		interpolationResult.status = i18n("Not enough data points available.");
+		clearResultVectors();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// interpolation settings
 	const nsl_interp_type type = interpolationData.type;
 	const nsl_interp_pch_variant variant = interpolationData.variant;
@@ -210,214 +206,238 @@ void XYInterpolationCurvePrivate::recalculate() {
 	DEBUG("evaluate:"<<nsl_interp_evaluate_name[evaluate]);
 	DEBUG("npoints ="<<npoints);
 
-///////////////////////////////////////////////////////////
-	int status = 0;
-
-	gsl_interp_accel *acc = gsl_interp_accel_alloc();
-	gsl_spline *spline = nullptr;
-	switch (type) {
-	case nsl_interp_type_linear:
-		spline = gsl_spline_alloc(gsl_interp_linear, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_polynomial:
-		spline = gsl_spline_alloc(gsl_interp_polynomial, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_cspline:
-		spline = gsl_spline_alloc(gsl_interp_cspline, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_cspline_periodic:
-		spline = gsl_spline_alloc(gsl_interp_cspline_periodic, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_akima:
-		spline = gsl_spline_alloc(gsl_interp_akima, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_akima_periodic:
-		spline = gsl_spline_alloc(gsl_interp_akima_periodic, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_steffen:
-#if GSL_MAJOR_VERSION >= 2
-		spline = gsl_spline_alloc(gsl_interp_steffen, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-#endif
-		break;
-	case nsl_interp_type_cosine:
-	case nsl_interp_type_pch:
-	case nsl_interp_type_rational:
-	case nsl_interp_type_exponential:
-		break;
-	}
+	//the interpolation doesn't access any columns and can be done in the background
+	auto calculate = [=]() mutable {
+		double* xdata = xdataVector.data();
+		double* ydata = ydataVector.data();
 
-	xVector->resize((int)npoints);
-	yVector->resize((int)npoints);
-	for (unsigned int i = 0; i < npoints; i++) {
-		size_t a = 0, b = n-1;
-
-		double x = xmin + i*(xmax-xmin)/(npoints-1);
-		(*xVector)[(int)i] = x;
-
-		// find index a,b for interval [x[a],x[b]] around x[i] using bisection
-		if (type == nsl_interp_type_cosine || type == nsl_interp_type_exponential || type == nsl_interp_type_pch) {
-			while (b-a > 1) {
-				unsigned int j = floor((a+b)/2.);
-				if (xdata[j] > x)
-					b = j;
-				else
-					a = j;
-			}
-		}
+///////////////////////////////////////////////////////////
+		interpolationStatus = 0;
 
-		// evaluate interpolation
-		double t;
+		gsl_interp_accel *acc = gsl_interp_accel_alloc();
+		gsl_spline *spline = nullptr;
 		switch (type) {
 		case nsl_interp_type_linear:
+			spline = gsl_spline_alloc(gsl_interp_linear, n);
+			interpolationStatus = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_polynomial:
+			spline = gsl_spline_alloc(gsl_interp_polynomial, n);
+			interpolationStatus = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_cspline:
+			spline = gsl_spline_alloc(gsl_interp_cspline, n);
+			interpolationStatus = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_cspline_periodic:
+			spline = gsl_spline_alloc(gsl_interp_cspline_periodic, n);
+			interpolationStatus = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_akima:
+			spline = gsl_spline_alloc(gsl_interp_akima, n);
+			interpolationStatus = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_akima_periodic:
+			spline = gsl_spline_alloc(gsl_interp_akima_periodic, n);
+			interpolationStatus = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_steffen:
-			switch (evaluate) {
-			case nsl_interp_evaluate_function:
-				(*yVector)[(int)i] = gsl_spline_eval(spline, x, acc);
-				break;
-			case nsl_interp_evaluate_derivative:
-				(*yVector)[(int)i] = gsl_spline_eval_deriv(spline, x, acc);
-				break;
-			case nsl_interp_evaluate_second_derivative:
-				(*yVector)[(int)i] = gsl_spline_eval_deriv2(spline, x, acc);
-				break;
-			case nsl_interp_evaluate_integral:
-				(*yVector)[(int)i] = gsl_spline_eval_integ(spline, xmin, x, acc);
-				break;
-			}
+	#if GSL_MAJOR_VERSION >= 2
+			spline = gsl_spline_alloc(gsl_interp_steffen, n);
+			interpolationStatus = gsl_spline_init(spline, xdata, ydata, n);
+	#endif
 			break;
 		case nsl_interp_type_cosine:
-			t = (x-xdata[a])/(xdata[b]-xdata[a]);
-			t = (1.-cos(M_PI*t))/2.;
-			(*yVector)[(int)i] =  ydata[a] + t*(ydata[b]-ydata[a]);
-			break;
+		case nsl_interp_type_pch:
+		case nsl_interp_type_rational:
 		case nsl_interp_type_exponential:
-			t = (x-xdata[a])/(xdata[b]-xdata[a]);
-			(*yVector)[(int)i] = ydata[a]*pow(ydata[b]/ydata[a],t);
 			break;
-		case nsl_interp_type_pch: {
-				t = (x-xdata[a])/(xdata[b]-xdata[a]);
-				double t2 = t*t, t3 = t2*t;
-				double h1 = 2.*t3-3.*t2+1, h2 = -2.*t3+3.*t2, h3 = t3-2*t2+t, h4 = t3-t2;
-				double m1 = 0.,m2 = 0.;
-				switch (variant) {
-				case nsl_interp_pch_variant_finite_difference:
-					if (a == 0)
-						m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m1 = ( (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) + (ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1]) )/2.;
-					if (b == n-1)
-						m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m2 = ( (ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) + (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
+		}
 
-					break;
-				case nsl_interp_pch_variant_catmull_rom:
-					if (a == 0)
-						m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m1 = (ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
-					if (b == n-1)
-						m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m2 = (ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
+		xResultVector.resize((int)npoints);
+		yResultVector.resize((int)npoints);
+		for (unsigned int i = 0; i < npoints; i++) {
+			if (recalculationCancelled())
+				break;
+			if (i % 10000 == 0)
+				setRecalculationProgress((int)(90. * i / npoints));
 
-					break;
-				case nsl_interp_pch_variant_cardinal:
-					if (a == 0)
-						m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m1 = (ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
-					m1 *= (1.-tension);
-					if (b == n-1)
-						m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m2 = (ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
-					m2 *= (1.-tension);
+			size_t a = 0, b = n-1;
 
-					break;
-				case nsl_interp_pch_variant_kochanek_bartels:
-					if (a == 0)
-						m1 = (1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m1 = ( (1.-continuity)*(1.+bias)*(ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1])
-						     + (1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
-					m1 *= (1.-tension);
-					if (b == n-1)
-						m2 = (1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+			double x = xmin + i*(xmax-xmin)/(npoints-1);
+			xResultVector[(int)i] = x;
+
+			// find index a,b for interval [x[a],x[b]] around x[i] using bisection
+			if (type == nsl_interp_type_cosine || type == nsl_interp_type_exponential || type == nsl_interp_type_pch) {
+				while (b-a > 1) {
+					unsigned int j = floor((a+b)/2.);
+					if (xdata[j] > x)
+						b = j;
 					else
-						m2 = ( (1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a])
-						     + (1.-continuity)*(1.-bias)*(ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) )/2.;
-					m2 *= (1.-tension);
+						a = j;
+				}
+			}
 
+			// evaluate interpolation
+			double t;
+			switch (type) {
+			case nsl_interp_type_linear:
+			case nsl_interp_type_polynomial:
+			case nsl_interp_type_cspline:
+			case nsl_interp_type_cspline_periodic:
+			case nsl_interp_type_akima:
+			case nsl_interp_type_akima_periodic:
+			case nsl_interp_type_steffen:
+				switch (evaluate) {
+				case nsl_interp_evaluate_function:
+					yResultVector[(int)i] = gsl_spline_eval(spline, x, acc);
+					break;
+				case nsl_interp_evaluate_derivative:
+					yResultVector[(int)i] = gsl_spline_eval_deriv(spline, x, acc);
+					break;
+				case nsl_interp_evaluate_second_derivative:
+					yResultVector[(int)i] = gsl_spline_eval_deriv2(spline, x, acc);
+					break;
+				case nsl_interp_evaluate_integral:
+					yResultVector[(int)i] = gsl_spline_eval_integ(spline, xmin, x, acc);
 					break;
 				}
-
-				// Hermite polynomial
-				(*yVector)[(int)i] = ydata[a]*h1+ydata[b]*h2+(xdata[b]-xdata[a])*(m1*h3+m2*h4);
-			}
-			break;
-		case nsl_interp_type_rational: {
-				double v,dv;
-				nsl_interp_ratint(xdata, ydata, (int)n, x, &v, &dv);
-				(*yVector)[(int)i] = v;
-				//TODO: use error dv
 				break;
+			case nsl_interp_type_cosine:
+				t = (x-xdata[a])/(xdata[b]-xdata[a]);
+				t = (1.-cos(M_PI*t))/2.;
+				yResultVector[(int)i] =  ydata[a] + t*(ydata[b]-ydata[a]);
+				break;
+			case nsl_interp_type_exponential:
+				t = (x-xdata[a])/(xdata[b]-xdata[a]);
+				yResultVector[(int)i] = ydata[a]*pow(ydata[b]/ydata[a],t);
+				break;
+			case nsl_interp_type_pch: {
+					t = (x-xdata[a])/(xdata[b]-xdata[a]);
+					double t2 = t*t, t3 = t2*t;
+					double h1 = 2.*t3-3.*t2+1, h2 = -2.*t3+3.*t2, h3 = t3-2*t2+t, h4 = t3-t2;
+					double m1 = 0.,m2 = 0.;
+					switch (variant) {
+					case nsl_interp_pch_variant_finite_difference:
+						if (a == 0)
+							m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m1 = ( (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) + (ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1]) )/2.;
+						if (b == n-1)
+							m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m2 = ( (ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) + (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
+
+						break;
+					case nsl_interp_pch_variant_catmull_rom:
+						if (a == 0)
+							m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m1 = (ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
+						if (b == n-1)
+							m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m2 = (ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
+
+						break;
+					case nsl_interp_pch_variant_cardinal:
+						if (a == 0)
+							m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m1 = (ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
+						m1 *= (1.-tension);
+						if (b == n-1)
+							m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m2 = (ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
+						m2 *= (1.-tension);
+
+						break;
+					case nsl_interp_pch_variant_kochanek_bartels:
+						if (a == 0)
+							m1 = (1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m1 = ( (1.-continuity)*(1.+bias)*(ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1])
+							     + (1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
+						m1 *= (1.-tension);
+						if (b == n-1)
+							m2 = (1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m2 = ( (1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a])
+							     + (1.-continuity)*(1.-bias)*(ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) )/2.;
+						m2 *= (1.-tension);
+
+						break;
+					}
+
+					// Hermite polynomial
+					yResultVector[(int)i] = ydata[a]*h1+ydata[b]*h2+(xdata[b]-xdata[a])*(m1*h3+m2*h4);
+				}
+				break;
+			case nsl_interp_type_rational: {
+					double v,dv;
+					nsl_interp_ratint(xdata, ydata, (int)n, x, &v, &dv);
+					yResultVector[(int)i] = v;
+					//TODO: use error dv
+					break;
+				}
 			}
 		}
-	}
 
-	// calculate "evaluate" option for own types
-	if (type == nsl_interp_type_cosine || type == nsl_interp_type_exponential || type == nsl_interp_type_pch || type == nsl_interp_type_rational) {
-		switch (evaluate) {
-		case nsl_interp_evaluate_function:
-			break;
-		case nsl_interp_evaluate_derivative:
-			nsl_diff_first_deriv_second_order(xVector->data(), yVector->data(), npoints);
-			break;
-		case nsl_interp_evaluate_second_derivative:
-			nsl_diff_second_deriv_second_order(xVector->data(), yVector->data(), npoints);
-			break;
-		case nsl_interp_evaluate_integral:
-			nsl_int_trapezoid(xVector->data(), yVector->data(), npoints, 0);
-			break;
+		if (recalculationCancelled()) {
+			gsl_spline_free(spline);
+			gsl_interp_accel_free(acc);
+			return;
 		}
-	}
 
-	// check values
-	for (int i = 0; i < (int)npoints; i++) {
-		if ((*yVector)[i] > std::numeric_limits<double>::max())
-			(*yVector)[i] = std::numeric_limits<double>::max();
-		else if ((*yVector)[i] < std::numeric_limits<double>::lowest())
-			(*yVector)[i] = std::numeric_limits<double>::lowest();
-	}
+		// calculate "evaluate" option for own types
+		if (type == nsl_interp_type_cosine || type == nsl_interp_type_exponential || type == nsl_interp_type_pch || type == nsl_interp_type_rational) {
+			switch (evaluate) {
+			case nsl_interp_evaluate_function:
+				break;
+			case nsl_interp_evaluate_derivative:
+				nsl_diff_first_deriv_second_order(xResultVector.data(), yResultVector.data(), npoints);
+				break;
+			case nsl_interp_evaluate_second_derivative:
+				nsl_diff_second_deriv_second_order(xResultVector.data(), yResultVector.data(), npoints);
+				break;
+			case nsl_interp_evaluate_integral:
+				nsl_int_trapezoid(xResultVector.data(), yResultVector.data(), npoints, 0);
+				break;
+			}
+		}
 
-	gsl_spline_free(spline);
-	gsl_interp_accel_free(acc);
+		// check values
+		for (int i = 0; i < (int)npoints; i++) {
+			if (yResultVector[i] > std::numeric_limits<double>::max())
+				yResultVector[i] = std::numeric_limits<double>::max();
+			else if (yResultVector[i] < std::numeric_limits<double>::lowest())
+				yResultVector[i] = std::numeric_limits<double>::lowest();
+		}
+
+		gsl_spline_free(spline);
+		gsl_interp_accel_free(acc);
 
 ///////////////////////////////////////////////////////////
+	};
+
+	auto finish = [=]() {
+		swapResultVectors();
 
-	//write the result
-	interpolationResult.available = true;
-	interpolationResult.valid = true;
-	interpolationResult.status = gslErrorToString(status);
-	interpolationResult.elapsedTime = timer.elapsed();
+		//write the result
+		interpolationResult = XYInterpolationCurve::InterpolationResult();
+		interpolationResult.available = true;
+		interpolationResult.valid = true;
+		interpolationResult.status = gslErrorToString(interpolationStatus);
+		interpolationResult.elapsedTime = recalculationTimer.elapsed();
+
+		//redraw the curve
+		recalcLogicalPoints();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	emit q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runRecalculation(calculate, finish);
 }
 
 //##############################################################################
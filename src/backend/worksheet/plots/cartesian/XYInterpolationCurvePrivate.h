@@ -45,6 +45,7 @@ public:
 
 	XYInterpolationCurve::InterpolationData interpolationData;
 	XYInterpolationCurve::InterpolationResult interpolationResult;
+	int interpolationStatus{0};
 
 	XYInterpolationCurve* const q;
 };
@@ -44,6 +44,7 @@
 
 #include <QIcon>
 #include <QElapsedTimer>
+#include <QMutex>
 #include <QThreadPool>
 
 extern "C" {
@@ -52,6 +53,10 @@ extern "C" {
 #include "backend/nsl/nsl_sf_kernel.h"
 }
 
+//the constants of the constant padding are global variables in nsl_smooth,
+//the smoothings using them must not run at the same time in different curves
+static QMutex padConstantMutex;
+
 XYSmoothCurve::XYSmoothCurve(const QString& name)
 	: XYAnalysisCurve(name, new XYSmoothCurvePrivate(this), AspectType::XYSmoothCurve) {
 }
@@ -106,10 +111,9 @@ XYSmoothCurvePrivate::XYSmoothCurvePrivate(XYSmoothCurve* owner) : XYAnalysisCur
 XYSmoothCurvePrivate::~XYSmoothCurvePrivate() = default;
 
 void XYSmoothCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
+	recalculationTimer.start();
 
-	//create smooth result columns if not available yet, clear them otherwise
+	//create smooth result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Numeric);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Numeric);
@@ -127,11 +131,6 @@ void XYSmoothCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
-		if (roughVector)
-			roughVector->clear();
 	}
 
 	if (!roughColumn) {
@@ -140,9 +139,6 @@ void XYSmoothCurvePrivate::recalculate() {
 		q->addChild(roughColumn);
 	}
 
-	// clear the previous result
-	smoothResult = XYSmoothCurve::SmoothResult();
-
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
@@ -157,6 +153,9 @@ void XYSmoothCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		smoothResult = XYSmoothCurve::SmoothResult();
+		clearResultVectors();
+		roughVector->clear();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
@@ -164,9 +163,12 @@ void XYSmoothCurvePrivate::recalculate() {
 
 	//check column sizes
 	if (tmpXDataColumn->rowCount() != tmpYDataColumn->rowCount()) {
+		smoothResult = XYSmoothCurve::SmoothResult();
 		smoothResult.available = true;
 		smoothResult.valid = false;
 		smoothResult.status = i18n("Number of x and y data points must be equal.");
+		clearResultVectors();
+		roughVector->clear();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -192,21 +194,18 @@ void XYSmoothCurvePrivate::recalculate() {
 	//number of data points to smooth
 	const size_t n = (size_t)xdataVector.size();
 	if (n < 2) {
+		smoothResult = XYSmoothCurve::SmoothResult();
 		smoothResult.available = true;
 		smoothResult.valid = false;
 		smoothResult.status = i18n("Not enough data points available.");
+		clearResultVectors();
+		roughVector->clear();
 		recalcLogicalPoints();
 		emit q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
-	double* ydataOriginal = new double[n];
-	memcpy(ydataOriginal, ydata, n*sizeof(double));
-
 	// smooth settings
 	const nsl_smooth_type type = smoothData.type;
 	const size_t points = smoothData.points;
@@ -225,48 +224,68 @@ void XYSmoothCurvePrivate::recalculate() {
 	DEBUG("mode ="<<nsl_smooth_pad_mode_name[mode]);
 	DEBUG("const. values ="<<lvalue<<rvalue);
 
+	//the smoothing itself doesn't access any columns and can be done in the background
+	auto calculate = [=]() mutable {
+		const QVector<double> ydataOriginal(ydataVector);
+		double* ydata = ydataVector.data();	// detaches from the original data
+
 ///////////////////////////////////////////////////////////
-	int status = 0;
-
-	switch (type) {
-	case nsl_smooth_type_moving_average:
-		status = nsl_smooth_moving_average(ydata, n, points, weight, mode);
-		break;
-	case nsl_smooth_type_moving_average_lagged:
-		status = nsl_smooth_moving_average_lagged(ydata, n, points, weight, mode);
-		break;
-	case nsl_smooth_type_percentile:
-		status = nsl_smooth_percentile(ydata, n, points, percentile, mode);
-		break;
-	case nsl_smooth_type_savitzky_golay:
-		if (mode == nsl_smooth_pad_constant)
-			nsl_smooth_pad_constant_set(lvalue, rvalue);
-		status = nsl_smooth_savgol(ydata, n, points, order, mode);
-		break;
-	}
+		int status = 0;
 
-	xVector->resize((int)n);
-	yVector->resize((int)n);
-	memcpy(xVector->data(), xdata, n*sizeof(double));
-	memcpy(yVector->data(), ydata, n*sizeof(double));
+		QMutexLocker locker(mode == nsl_smooth_pad_constant ? &padConstantMutex : nullptr);
+		switch (type) {
+		case nsl_smooth_type_moving_average:
+			status = nsl_smooth_moving_average(ydata, n, points, weight, mode);
+			break;
+		case nsl_smooth_type_moving_average_lagged:
+			status = nsl_smooth_moving_average_lagged(ydata, n, points, weight, mode);
+			break;
+		case nsl_smooth_type_percentile:
+			status = nsl_smooth_percentile(ydata, n, points, percentile, mode);
+			break;
+		case nsl_smooth_type_savitzky_golay:
+			if (mode == nsl_smooth_pad_constant)
+				nsl_smooth_pad_constant_set(lvalue, rvalue);
+			status = nsl_smooth_savgol(ydata, n, points, order, mode);
+			break;
+		}
+		locker.unlock();
+		smoothStatus = status;
+		if (recalculationCancelled())
+			return;
+		setRecalculationProgress(90);
+
+		xResultVector = xdataVector;
+		yResultVector = ydataVector;
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	smoothResult.available = true;
-	smoothResult.valid = true;
-	smoothResult.status = QString::number(status);
-	smoothResult.elapsedTime = timer.elapsed();
-
-	//fill rough vector
-	roughVector->resize((int)n);
-	for (int i = 0; i < (int)n; ++i)
-		roughVector->data()[i] = ydataOriginal[i] - ydata[i];
-	roughColumn->setChanged();
-
-	//redraw the curve
-	recalcLogicalPoints();
-	emit q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+		//fill rough vector
+		roughResultVector.resize((int)n);
+		for (int i = 0; i < (int)n; ++i)
+			roughResultVector[i] = ydataOriginal.at(i) - ydata[i];
+	};
+
+	auto finish = [=]() {
+		swapResultVectors();
+		roughVector->swap(roughResultVector);
+		roughResultVector.clear();
+
+		//write the result
+		smoothResult = XYSmoothCurve::SmoothResult();
+		smoothResult.available = true;
+		smoothResult.valid = true;
+		smoothResult.status = QString::number(smoothStatus);
+		smoothResult.elapsedTime = recalculationTimer.elapsed();
+
+		roughColumn->setChanged();
+
+		//redraw the curve
+		recalcLogicalPoints();
+		emit q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
+
+	runRecalculation(calculate, finish);
 }
 
 //##############################################################################
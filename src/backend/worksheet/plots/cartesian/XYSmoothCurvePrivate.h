@@ -48,6 +48,8 @@ public:
 
 	Column* roughColumn{nullptr};
 	QVector<double>* roughVector{nullptr};
+	QVector<double> roughResultVector;
+	int smoothStatus{0};
 
 	XYSmoothCurve* const q;
 };
@@ -36,6 +36,7 @@
 #include "backend/lib/macros.h"
 #include "backend/core/column/Column.h"
 #include "backend/core/column/ColumnPrivate.h"
+#include "backend/datasources/filters/HDF5Filter.h"
 
 #include "kdefrontend/spreadsheet/AddSubtractValueDialog.h"
 #include "kdefrontend/matrix/MatrixFunctionDialog.h"
@@ -59,6 +60,7 @@
 #include <QHeaderView>
 
 #include <KLocalizedString>
+#include <KMessageBox>
 #include <QIcon>
 
 #include <cfloat>
@@ -1520,3 +1522,13 @@ void MatrixView::exportToFits(const QString &fileName, const int exportTo) const
 
 	delete filter;
 }
+
+void MatrixView::exportToHDF5(const QString& fileName, bool append) const {
+	HDF5Filter filter;
+	filter.setAppendMode(append);
+	filter.write(fileName, m_matrix);
+	if (!filter.lastError().isEmpty()) {
+		RESET_CURSOR;
+		KMessageBox::error(nullptr, filter.lastError());
+	}
+}
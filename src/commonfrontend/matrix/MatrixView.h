@@ -75,6 +75,7 @@ public:
                            const bool latexHeaders, const bool gridLines,
                            const bool entire, const bool captions) const;
 	void exportToFits(const QString& fileName, const int exportTo) const;
+	void exportToHDF5(const QString& fileName, bool append = false) const;
 
 public slots:
 	void createContextMenu(QMenu*) const;
@@ -34,11 +34,15 @@
 #include "backend/spreadsheet/Spreadsheet.h"
 #include "commonfrontend/spreadsheet/SpreadsheetItemDelegate.h"
 #include "commonfrontend/spreadsheet/SpreadsheetHeaderView.h"
+#include "backend/datasources/filters/AsciiFilter.h"
 #include "backend/datasources/filters/FITSFilter.h"
+#include "backend/datasources/filters/HDF5Filter.h"
+#include "backend/datasources/filters/SQLDatabaseFilter.h"
 #include "backend/lib/macros.h"
 #include "backend/lib/trace.h"
 #include "backend/core/column/Column.h"
 #include "backend/core/column/ColumnPrivate.h"
+#include "backend/core/column/ColumnFormatter.h"
 #include "backend/core/datatypes/SimpleCopyThroughFilter.h"
 #include "backend/core/datatypes/Double2StringFilter.h"
 #include "backend/core/datatypes/String2DoubleFilter.h"
@@ -57,14 +61,13 @@
 #include <QPrinter>
 #include <QPrintDialog>
 #include <QPrintPreviewDialog>
-#include <QSqlDatabase>
-#include <QSqlError>
-#include <QSqlQuery>
 #include <QTableView>
 #include <QToolBar>
 #include <QTextStream>
 #include <QProcess>
-#include <QRegularExpression>
+#include <QDataStream>
+#include <QThread>
+#include <QtConcurrentRun>
 #if QT_VERSION >= 0x051000
 #include <QRandomGenerator>
 #endif
@@ -1398,6 +1401,9 @@ void SpreadsheetView::cutSelection() {
 	RESET_CURSOR;
 }
 
+//MIME type used for copying selections between spreadsheets without converting the values to text
+static const QString columnDataMimeType = QStringLiteral("application/x-labplot-column-data");
+
 void SpreadsheetView::copySelection() {
 	PERFTRACE("copy selected cells");
 	const int first_col = firstSelectedColumn();
@@ -1412,42 +1418,267 @@ void SpreadsheetView::copySelection() {
 	const int rows = last_row - first_row + 1;
 
 	WAIT_CURSOR;
-	QString output_str;
+	QVector<const Column*> columns;
+	for (int c = 0; c < cols; c++)
+		columns << m_spreadsheet->column(first_col + c);
+
+	//a single selection range covers the whole rectangle, otherwise determine the selected cells
+	//once here and not for every cell, the selection model cannot be used in the threads below
+	ColumnFormatter formatter(columns, QLocale(), QByteArrayLiteral("\t"));
+	const QItemSelection& selection = m_tableView->selectionModel()->selection();
+	const bool rectangular = (selection.size() == 1);
+	if (!rectangular) {
+		QVector<bool> selected(rows * cols);
+		for (const auto& range : selection) {
+			for (int r = qMax(range.top(), first_row); r <= qMin(range.bottom(), last_row); ++r)
+				for (int c = qMax(range.left(), first_col); c <= qMin(range.right(), last_col); ++c)
+					selected[(r - first_row) * cols + c - first_col] = true;
+		}
+		formatter.setSelection(selected, first_row);
+	}
+
+	auto formatRows = [&formatter](int start, int end) {
+		return formatter.formatRows(start, end);
+	};
+
+	//format large selections in blocks of rows in parallel
+	QByteArray output;
+	const int threads = QThread::idealThreadCount();
+	if (threads > 1 && rows * cols > 100000) {
+		const int blockSize = rows/threads + 1;
+		QVector<QFuture<QByteArray>> blocks;
+		for (int start = first_row; start <= last_row; start += blockSize)
+			blocks << QtConcurrent::run(formatRows, start, qMin(start + blockSize, last_row + 1));
+
+		int size = 0;
+		for (auto& block : blocks)
+			size += block.result().size();
+		output.reserve(size);
+		for (const auto& block : qAsConst(blocks))
+			output += block.result();
+	} else
+		output = formatRows(first_row, last_row + 1);
+	output.chop(1);	//no newline after the last row
+
+	auto* mimeData = new QMimeData;
+	mimeData->setData(QStringLiteral("text/plain"), output);
+
+	//for rectangular selections also provide the values of the columns for pasting into LabPlot
+	if (rectangular) {
+		QByteArray data;
+		QDataStream out(&data, QIODevice::WriteOnly);
+		out << cols << rows;
+		for (const auto* col : columns) {
+			const auto mode = col->columnMode();
+			out << static_cast<int>(mode);
+			switch (mode) {
+			case AbstractColumn::ColumnMode::Numeric: {
+				QVector<double> values(rows);
+				for (int r = 0; r < rows; ++r)
+					values[r] = col->valueAt(first_row + r);
+				out << values;
+				break;
+			}
+			case AbstractColumn::ColumnMode::Integer: {
+				QVector<int> values(rows);
+				for (int r = 0; r < rows; ++r)
+					values[r] = col->integerAt(first_row + r);
+				out << values;
+				break;
+			}
+			case AbstractColumn::ColumnMode::BigInt: {
+				QVector<qint64> values(rows);
+				for (int r = 0; r < rows; ++r)
+					values[r] = col->bigIntAt(first_row + r);
+				out << values;
+				break;
+			}
+			case AbstractColumn::ColumnMode::DateTime:
+			case AbstractColumn::ColumnMode::Month:
+			case AbstractColumn::ColumnMode::Day: {
+				QVector<qint64> msecs(rows);
+				for (int r = 0; r < rows; ++r)
+					msecs[r] = col->dateTimeMSecsAt(first_row + r);
+				out << static_cast<int>(col->timeSpec()) << msecs;
+				break;
+			}
+			case AbstractColumn::ColumnMode::Text: {
+				QVector<QString> texts(rows);
+				for (int r = 0; r < rows; ++r)
+					texts[r] = col->textAt(first_row + r);
+				out << texts;
+			}
+			}
+		}
+		mimeData->setData(columnDataMimeType, data);
+	}
 
-	QVector<Column*> columns;
-	QVector<char> formats;
-	for (int c = 0; c < cols; c++) {
-		Column* col = m_spreadsheet->column(first_col + c);
-		columns << col;
-		const Double2StringFilter* out_fltr = static_cast<Double2StringFilter*>(col->outputFilter());
-		formats << out_fltr->numericFormat();
+	QApplication::clipboard()->setMimeData(mimeData);
+	RESET_CURSOR;
+}
+
+/*!
+ * pastes the column data copied in copySelection() into the current selection.
+ * The data is pasted as it is, without converting it to text and back, if the selection
+ * has the size of the copied data or if the data is pasted at the current cell
+ * and if the target columns either have the mode of the copied columns or are empty.
+ * \return \c false if the data cannot be pasted this way and has to be pasted as text
+ */
+bool SpreadsheetView::pasteColumnData(const QByteArray& data) {
+	QDataStream in(data);
+	int cols, rows;
+	in >> cols >> rows;
+	if (in.status() != QDataStream::Ok || cols < 1 || rows < 1)
+		return false;
+
+	struct ColumnData {
+		AbstractColumn::ColumnMode mode;
+		QVector<double> values;
+		QVector<int> integers;
+		QVector<qint64> bigInts;	//also milliseconds since epoch for date-time columns
+		Qt::TimeSpec timeSpec{Qt::LocalTime};
+		QVector<QString> texts;
+	};
+
+	QVector<ColumnData> columnData(cols);
+	for (auto& column : columnData) {
+		int mode;
+		in >> mode;
+		column.mode = static_cast<AbstractColumn::ColumnMode>(mode);
+		switch (column.mode) {
+		case AbstractColumn::ColumnMode::Numeric:
+			in >> column.values;
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			in >> column.integers;
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			in >> column.bigInts;
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day: {
+			int timeSpec;
+			in >> timeSpec >> column.bigInts;
+			column.timeSpec = static_cast<Qt::TimeSpec>(timeSpec);
+			break;
+		}
+		case AbstractColumn::ColumnMode::Text:
+			in >> column.texts;
+		}
 	}
+	if (in.status() != QDataStream::Ok)
+		return false;
 
-	QLocale locale;
-	for (int r = 0; r < rows; r++) {
-		for (int c = 0; c < cols; c++) {
-			const Column* col_ptr = columns.at(c);
-			if (isCellSelected(first_row + r, first_col + c)) {
-// 				if (formulaModeActive())
-// 					output_str += col_ptr->formula(first_row + r);
-// 				else
-				if (col_ptr->columnMode() == AbstractColumn::ColumnMode::Numeric)
-					output_str += locale.toString(col_ptr->valueAt(first_row + r), formats.at(c), 16); // copy with max. precision
-				else if (col_ptr->columnMode() == AbstractColumn::ColumnMode::Integer || col_ptr->columnMode() == AbstractColumn::ColumnMode::BigInt)
-					output_str += QString::number(col_ptr->valueAt(first_row + r));
-				else
-					output_str += col_ptr->asStringColumn()->textAt(first_row + r);
-			}
-			if (c < cols-1)
-				output_str += '\t';
+	int first_col = firstSelectedColumn();
+	int last_col = lastSelectedColumn();
+	int first_row = firstSelectedRow();
+	int last_row = lastSelectedRow();
+	if ( (first_col == -1 || first_row == -1) || (last_row == first_row && last_col == first_col) ) {
+		getCurrentCell(&first_row, &first_col);
+		if (first_row == -1) first_row = 0;
+		if (first_col == -1) first_col = 0;
+	} else if (last_row - first_row + 1 != rows || last_col - first_col + 1 != cols
+			|| m_tableView->selectionModel()->selection().size() != 1)
+		return false;
+	last_row = first_row + rows - 1;
+	last_col = first_col + cols - 1;
+
+	//columns with values need to have the mode of the copied data
+	const int columnCount = m_spreadsheet->columnCount();
+	for (int c = first_col; c <= last_col && c < columnCount; ++c) {
+		const Column* col = m_spreadsheet->column(c);
+		if (col->hasValues() && col->columnMode() != columnData.at(c - first_col).mode)
+			return false;
+	}
+
+	PERFTRACE("paste column data");
+	WAIT_CURSOR;
+	m_spreadsheet->beginMacro(i18n("%1: paste from clipboard", m_spreadsheet->name()));
+
+	for (int c = first_col; c <= last_col && c < columnCount; ++c) {
+		Column* col = m_spreadsheet->column(c);
+		if (!col->hasValues())
+			col->setColumnMode(columnData.at(c - first_col).mode);
+	}
+
+	//add columns and rows if necessary
+	for (int c = columnCount; c <= last_col; ++c) {
+		Column* new_col = new Column(QString::number(c - first_col), columnData.at(c - first_col).mode);
+		new_col->setPlotDesignation(AbstractColumn::PlotDesignation::Y);
+		new_col->insertRows(0, m_spreadsheet->rowCount());
+		m_spreadsheet->addChild(new_col);
+	}
+
+	if (last_row >= m_spreadsheet->rowCount())
+		m_spreadsheet->appendRows(last_row + 1 - m_spreadsheet->rowCount());
+
+	setCellsSelected(first_row, first_col, last_row, last_col);
+
+	for (int c = 0; c < cols; ++c) {
+		Column* col = m_spreadsheet->column(first_col + c);
+		const auto& column = columnData.at(c);
+		col->setSuppressDataChangedSignal(true);
+		switch (column.mode) {
+		case AbstractColumn::ColumnMode::Numeric:
+			col->replaceValues(first_row, column.values);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			col->replaceInteger(first_row, column.integers);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			col->replaceBigInt(first_row, column.bigInts);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day: {
+			QVector<QDateTime> dateTimes(column.bigInts.size());
+			for (int r = 0; r < column.bigInts.size(); ++r)
+				dateTimes[r] = AbstractColumn::dateTimeFromMSecs(column.bigInts.at(r), column.timeSpec);
+			col->replaceDateTimes(first_row, dateTimes);
+			break;
+		}
+		case AbstractColumn::ColumnMode::Text:
+			col->replaceTexts(first_row, column.texts);
 		}
-		if (r < rows-1)
-			output_str += '\n';
+		col->setSuppressDataChangedSignal(false);
+		col->setChanged();
 	}
 
-	QApplication::clipboard()->setText(output_str);
+	m_spreadsheet->endMacro();
 	RESET_CURSOR;
+	return true;
 }
+
+/*!
+ * splits \p row at sequences of whitespace characters like QString::split() with the regular expression "\\s+".
+ */
+static QVector<QStringRef> splitAtWhitespace(const QStringRef& row) {
+	QVector<QStringRef> cells;
+	const int size = row.size();
+	int start = 0;
+	int i = 0;
+	while (i < size) {
+		if (!row.at(i).isSpace()) {
+			++i;
+			continue;
+		}
+		cells << row.mid(start, i - start);
+		while (i < size && row.at(i).isSpace())
+			++i;
+		start = i;
+	}
+	cells << row.mid(start);
+	return cells;
+}
+
+/*!
+ * QString sharing the characters of \p ref to pass it to the QLocale conversion functions without copying.
+ */
+static inline QString cellString(const QStringRef& ref) {
+	return QString::fromRawData(ref.unicode(), ref.size());
+}
+
 /*
 bool determineLocale(const QString& value, QLocale& locale) {
 	int pointIndex = value.indexOf(QLatin1Char('.'));
@@ -1463,6 +1694,9 @@ void SpreadsheetView::pasteIntoSelection() {
 		return;
 
 	const QMimeData* mime_data = QApplication::clipboard()->mimeData();
+	if (mime_data->hasFormat(columnDataMimeType) && pasteColumnData(mime_data->data(columnDataMimeType)))
+		return;
+
 	if (!mime_data->hasFormat("text/plain"))
 		return;
 
@@ -1477,28 +1711,30 @@ void SpreadsheetView::pasteIntoSelection() {
 	int input_row_count = 0;
 	int input_col_count = 0;
 
-	QString input_str = QString(mime_data->data("text/plain")).trimmed();
-	QVector<QStringList> cellTexts;
+	//the cells reference the pasted text instead of being copied into separate strings
+	const QString input_str = QString::fromUtf8(mime_data->data("text/plain")).trimmed();
+	QVector<QVector<QStringRef>> cellTexts;
 	QString separator;
 	if (input_str.indexOf(QLatin1String("\r\n")) != -1)
 		separator = QLatin1String("\r\n");
 	else
 		separator = QLatin1Char('\n');
 
-	QStringList input_rows(input_str.split(separator));
+	const QVector<QStringRef> input_rows(input_str.splitRef(separator));
 	input_row_count = input_rows.count();
 	input_col_count = 0;
 	bool hasTabs = false;
 	if (input_row_count > 0 && input_rows.constFirst().indexOf(QLatin1Char('\t')) != -1)
 		hasTabs = true;
 
-	for (int i = 0; i < input_row_count; i++) {
+	cellTexts.reserve(input_row_count);
+	for (const auto& input_row : input_rows) {
 		if (hasTabs)
-			cellTexts.append(input_rows.at(i).split(QLatin1Char('\t')));
+			cellTexts.append(input_row.split(QLatin1Char('\t')));
 		else
-			cellTexts.append(input_rows.at(i).split(QRegularExpression(QStringLiteral("\\s+"))));
-		if (cellTexts.at(i).count() > input_col_count)
-			input_col_count = cellTexts.at(i).count();
+			cellTexts.append(splitAtWhitespace(input_row));
+		if (cellTexts.constLast().count() > input_col_count)
+			input_col_count = cellTexts.constLast().count();
 	}
 
 	QLocale locale;
@@ -1527,9 +1763,9 @@ void SpreadsheetView::pasteIntoSelection() {
 			//first non-empty value in the column to paste determines the column mode/type of the new column to be added
 			const int curCol = c - first_col;
 			QString nonEmptyValue;
-			for (auto r : cellTexts) {
+			for (const auto& r : cellTexts) {
 				if (curCol < r.count() && !r.at(curCol).isEmpty()) {
-					nonEmptyValue = r.at(curCol);
+					nonEmptyValue = r.at(curCol).toString();
 					break;
 				}
 			}
@@ -1547,9 +1783,9 @@ void SpreadsheetView::pasteIntoSelection() {
 				const int curCol = columnCount - first_col + c;
 				//first non-empty value in the column to paste determines the column mode/type of the new column to be added
 				QString nonEmptyValue;
-				for (auto r : cellTexts) {
+				for (const auto& r : cellTexts) {
 					if (curCol < r.count() && !r.at(curCol).isEmpty()) {
-						nonEmptyValue = r.at(curCol);
+						nonEmptyValue = r.at(curCol).toString();
 						break;
 					}
 				}
@@ -1583,14 +1819,14 @@ void SpreadsheetView::pasteIntoSelection() {
 				QVector<double> new_data(rows);
 				for (int r = 0; r < rows; ++r) {
 					if (c < cellTexts.at(r).count())
-						new_data[r] = locale.toDouble(cellTexts.at(r).at(c));
+						new_data[r] = locale.toDouble(cellString(cellTexts.at(r).at(c)));
 				}
 				col->replaceValues(0, new_data);
 			} else {
 				for (int r = 0; r < rows && r < input_row_count; r++) {
 					if ( isCellSelected(first_row + r, first_col + c) && (c < cellTexts.at(r).count()) ) {
 						if (!cellTexts.at(r).at(c).isEmpty())
-							col->setValueAt(first_row + r, locale.toDouble(cellTexts.at(r).at(c)));
+							col->setValueAt(first_row + r, locale.toDouble(cellString(cellTexts.at(r).at(c))));
 						else
 							col->setValueAt(first_row + r, std::numeric_limits<double>::quiet_NaN());
 					}
@@ -1601,14 +1837,14 @@ void SpreadsheetView::pasteIntoSelection() {
 				QVector<int> new_data(rows);
 				for (int r = 0; r < rows; ++r) {
 					if (c < cellTexts.at(r).count())
-						new_data[r] = locale.toInt(cellTexts.at(r).at(c));
+						new_data[r] = locale.toInt(cellString(cellTexts.at(r).at(c)));
 				}
 				col->replaceInteger(0, new_data);
 			} else {
 				for (int r = 0; r < rows && r < input_row_count; r++) {
 					if ( isCellSelected(first_row + r, first_col + c) && (c < cellTexts.at(r).count()) ) {
 						if (!cellTexts.at(r).at(c).isEmpty())
-							col->setIntegerAt(first_row + r, locale.toInt(cellTexts.at(r).at(c)));
+							col->setIntegerAt(first_row + r, locale.toInt(cellString(cellTexts.at(r).at(c))));
 						else
 							col->setIntegerAt(first_row + r, 0);
 					}
@@ -1617,14 +1853,16 @@ void SpreadsheetView::pasteIntoSelection() {
 		} else if (col->columnMode() == AbstractColumn::ColumnMode::BigInt) {
 			if (rows == m_spreadsheet->rowCount() && rows <= cellTexts.size()) {
 				QVector<qint64> new_data(rows);
-				for (int r = 0; r < rows; ++r)
-					new_data[r] = locale.toLongLong(cellTexts.at(r).at(c));
+				for (int r = 0; r < rows; ++r) {
+					if (c < cellTexts.at(r).count())
+						new_data[r] = locale.toLongLong(cellString(cellTexts.at(r).at(c)));
+				}
 				col->replaceBigInt(0, new_data);
 			} else {
 				for (int r = 0; r < rows && r < input_row_count; r++) {
 					if ( isCellSelected(first_row + r, first_col + c) && (c < cellTexts.at(r).count()) ) {
 						if (!cellTexts.at(r).at(c).isEmpty())
-							col->setBigIntAt(first_row + r, locale.toLongLong(cellTexts.at(r).at(c)));
+							col->setBigIntAt(first_row + r, locale.toLongLong(cellString(cellTexts.at(r).at(c))));
 						else
 							col->setBigIntAt(first_row + r, 0);
 					}
@@ -1636,7 +1874,7 @@ void SpreadsheetView::pasteIntoSelection() {
 // 					if (formulaModeActive())
 // 						col->setFormula(first_row + r, cellTexts.at(r).at(c));
 // 					else
-					col->asStringColumn()->setTextAt(first_row + r, cellTexts.at(r).at(c));
+					col->asStringColumn()->setTextAt(first_row + r, cellTexts.at(r).at(c).toString());
 				}
 			}
 		}
@@ -3088,6 +3326,9 @@ bool SpreadsheetView::exportView() {
 		case ExportSpreadsheetDialog::Format::SQLite:
 			exportToSQLite(path);
 			break;
+		case ExportSpreadsheetDialog::Format::HDF5:
+			exportToHDF5(path, dlg->appendToFile());
+			break;
 		}
 		RESET_CURSOR;
 	}
@@ -3289,44 +3530,21 @@ void SpreadsheetView::exportToFile(const QString& path, const bool exportHeader,
 		QMessageBox::critical(nullptr, i18n("Failed to export"), i18n("Failed to write to '%1'. Please check the path.", path));
 		return;
 	}
-
-	PERFTRACE("export spreadsheet to file");
-	QTextStream out(&file);
+	file.close();
 
 	int maxRow = maxRowToExport();
 	if (maxRow < 0)
 		return;
 
-	const int cols = m_spreadsheet->columnCount();
-	QString sep = separator;
-	sep = sep.replace(QLatin1String("TAB"), QLatin1String("\t"), Qt::CaseInsensitive);
-	sep = sep.replace(QLatin1String("SPACE"), QLatin1String(" "), Qt::CaseInsensitive);
-
-	//export header (column names)
-	if (exportHeader) {
-		for (int j = 0; j < cols; ++j) {
-			out << '"' << m_spreadsheet->column(j)->name() <<'"';
-			if (j != cols - 1)
-				out << sep;
-		}
-		out << '\n';
-	}
-
-	//export values
-	QLocale locale(language);
-	for (int i = 0; i <= maxRow; ++i) {
-		for (int j = 0; j < cols; ++j) {
-			Column* col = m_spreadsheet->column(j);
-			if (col->columnMode() == AbstractColumn::ColumnMode::Numeric) {
-				const Double2StringFilter* out_fltr = static_cast<Double2StringFilter*>(col->outputFilter());
-				out << locale.toString(col->valueAt(i), out_fltr->numericFormat(), 16); // export with max. precision
-			} else
-				out << col->asStringColumn()->textAt(i);
-
-			if (j != cols - 1)
-				out << sep;
-		}
-		out << '\n';
+	AsciiFilter filter;
+	filter.setSeparatingCharacter(separator);
+	filter.setHeaderEnabled(exportHeader);
+	filter.setNumberFormat(language);
+	filter.setEndRow(maxRow + 1);
+	filter.write(path, m_spreadsheet);
+	if (!filter.lastError().isEmpty()) {
+		RESET_CURSOR;
+		QMessageBox::critical(nullptr, i18n("Failed to export"), filter.lastError());
 	}
 }
 
@@ -3668,107 +3886,36 @@ void SpreadsheetView::exportToFits(const QString &fileName, const int exportTo,
 	delete filter;
 }
 
-void SpreadsheetView::exportToSQLite(const QString& path) const {
-	QFile file(path);
-	if (!file.open(QFile::WriteOnly | QFile::Truncate))
+void SpreadsheetView::exportToHDF5(const QString& path, bool append) const {
+	const int maxRow = maxRowToExport();
+	if (maxRow < 0)
 		return;
 
-	PERFTRACE("export spreadsheet to SQLite database");
-	QApplication::processEvents(QEventLoop::AllEvents, 0);
-
-	//create database
-	const QStringList& drivers = QSqlDatabase::drivers();
-	QString driver;
-	if (drivers.contains(QLatin1String("QSQLITE3")))
-		driver = QLatin1String("QSQLITE3");
-	else
-		driver = QLatin1String("QSQLITE");
-
-	QSqlDatabase db = QSqlDatabase::addDatabase(driver);
-	db.setDatabaseName(path);
-	if (!db.open()) {
+	HDF5Filter filter;
+	filter.setEndRow(maxRow + 1);
+	filter.setAppendMode(append);
+	filter.write(path, m_spreadsheet);
+	if (!filter.lastError().isEmpty()) {
 		RESET_CURSOR;
-		KMessageBox::error(nullptr, i18n("Couldn't create the SQLite database %1.", path));
+		KMessageBox::error(nullptr, filter.lastError());
 	}
+}
 
-	//create table
-	const int cols = m_spreadsheet->columnCount();
-	QString query = QLatin1String("create table ") + m_spreadsheet->name() + QLatin1String(" (");
-	for (int i = 0; i < cols; ++i) {
-		Column* col = m_spreadsheet->column(i);
-		if (i != 0)
-			query += QLatin1String(", ");
-
-		query += QLatin1String("\"") + col->name() + QLatin1String("\" ");
-		switch (col->columnMode()) {
-		case AbstractColumn::ColumnMode::Numeric:
-			query += QLatin1String("REAL");
-			break;
-		case AbstractColumn::ColumnMode::Integer:
-		case AbstractColumn::ColumnMode::BigInt:
-			query += QLatin1String("INTEGER");
-			break;
-		case AbstractColumn::ColumnMode::Text:
-		case AbstractColumn::ColumnMode::Month:
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::DateTime:
-			query += QLatin1String("TEXT");
-			break;
-		}
-	}
-	query += QLatin1Char(')');
-	QSqlQuery q;
-	if (!q.exec(query)) {
-		RESET_CURSOR;
-		KMessageBox::error(nullptr, i18n("Failed to create table in the SQLite database %1.", path) + '\n' + q.lastError().databaseText());
-		db.close();
+void SpreadsheetView::exportToSQLite(const QString& path) const {
+	const int maxRow = maxRowToExport();
+	if (maxRow < 0)
 		return;
-	}
 
+	QApplication::processEvents(QEventLoop::AllEvents, 0);
 
-	int maxRow = maxRowToExport();
-	if (maxRow < 0) {
-		db.close();
+	SQLDatabaseFilter filter;
+	filter.setEndRow(maxRow);
+	if (!filter.write(path, m_spreadsheet)) {
+		RESET_CURSOR;
+		KMessageBox::error(nullptr, filter.lastError());
 		return;
 	}
 
-	//create bulk insert statement
-	{
-	PERFTRACE("Create the bulk insert statement");
-	q.exec(QLatin1String("BEGIN TRANSACTION;"));
-	query = "INSERT INTO '" + m_spreadsheet->name() + "' (";
-	for (int i = 0; i < cols; ++i) {
-		if (i != 0)
-			query += QLatin1String(", ");
-		query += QLatin1Char('\'') + m_spreadsheet->column(i)->name() + QLatin1Char('\'');
-	}
-	query += QLatin1String(") VALUES ");
-
-	for (int i = 0; i <= maxRow; ++i) {
-		if (i != 0)
-			query += QLatin1String(",");
-
-		query += QLatin1Char('(');
-		for (int j = 0; j < cols; ++j) {
-			Column* col = m_spreadsheet->column(j);
-			if (j != 0)
-				query += QLatin1String(", ");
-
-			query += QLatin1Char('\'') + col->asStringColumn()->textAt(i) + QLatin1Char('\'');
-		}
-		query += QLatin1String(")");
-	}
-	query += QLatin1Char(';');
-	}
-
-	//insert values
-	if (!q.exec(query)) {
-		RESET_CURSOR;
-		KMessageBox::error(nullptr, i18n("Failed to insert values into the table."));
-		QDEBUG("bulk insert error " << q.lastError().databaseText());
-	} else
-		q.exec(QLatin1String("COMMIT TRANSACTION;"));
-
-	//close the database
-	db.close();
+	emit m_spreadsheet->statusInfo(i18n("%1 exported to the SQLite database (%2 rows per second).",
+			m_spreadsheet->name(), QString::number(filter.rowsPerSecond(), 'f', 0)));
 }
@@ -100,7 +100,9 @@ private:
 	                   const bool skipEmptyRows,const bool exportEntire) const;
 	void exportToFits(const QString& path, const int exportTo, const bool commentsAsUnits) const;
 	void exportToSQLite(const QString& path) const;
+	void exportToHDF5(const QString& path, bool append = false) const;
 	int maxRowToExport() const;
+	bool pasteColumnData(const QByteArray&);
 
 	void insertColumnsLeft(int);
 	void insertColumnsRight(int);
@@ -34,6 +34,7 @@
 #include <QStandardPaths>
 #include <QModelIndex>
 #include <QSysInfo>
+#include <QThread>
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -50,6 +51,9 @@
 #include "MainWin.h"
 #include "backend/core/AbstractColumn.h"
 #include "backend/lib/macros.h"
+extern "C" {
+#include "backend/nsl/nsl_dft.h"
+}
 
 /*
  * collect all system info to show in About dialog
@@ -180,6 +184,11 @@ int main (int argc, char *argv[]) {
 	KColorSchemeManager manager;
 	manager.activateScheme(manager.indexForScheme(schemeName));
 
+	// FFT planning: measured plans are reused via the wisdom stored in the application data folder
+	const QString wisdomFile = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QLatin1String("/fftw_wisdom");
+	nsl_dft_set_planner(group.readEntry(QLatin1String("FFTMeasurePlans"), true), 1., QThread::idealThreadCount());
+	nsl_dft_import_wisdom(qPrintable(wisdomFile));
+
 	MainWin* window = new MainWin(nullptr, filename);
 	window->show();
 
@@ -191,5 +200,11 @@ int main (int argc, char *argv[]) {
 	if (parser.isSet(presenterOption))
 		window->showPresenter();
 
-	return app.exec();
+	const int rc = app.exec();
+
+	if (QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)))
+		nsl_dft_export_wisdom(qPrintable(wisdomFile));
+	nsl_dft_plan_cache_clear();
+
+	return rc;
 }
@@ -30,6 +30,7 @@
 #include "MainWin.h"
 
 #include "backend/core/Project.h"
+#include "backend/core/ProjectContainer.h"
 #include "backend/core/Folder.h"
 #include "backend/core/AspectTreeModel.h"
 #include "backend/core/Workbook.h"
@@ -47,6 +48,9 @@
 #include "backend/datapicker/Datapicker.h"
 #include "backend/note/Note.h"
 #include "backend/lib/macros.h"
+#ifdef HAVE_ZLIB
+#include "backend/lib/ParallelGzipDevice.h"
+#endif
 #include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 
 #ifdef HAVE_MQTT
@@ -106,6 +110,7 @@
 #include <QHash>
 #include <QStatusBar>
 #include <QTemporaryFile>
+#include <QtConcurrentRun>
 #include <QTimeLine>
 // #include <QtWidgets>
 // #include <QtQuickWidgets/QQuickWidget>
@@ -122,12 +127,16 @@
 #include <KToolBar>
 #include <KLocalizedString>
 #include <KFilterDev>
+#include <karchive_version.h>
 #include <KRecentFilesAction>
 #include <KActionMenu>
 #include <KColorScheme>
 #include <KColorSchemeManager>
 #include <kconfigwidgets_version.h>
 
+#include <functional>
+#include <memory>
+
 #ifdef HAVE_CANTOR_LIBS
 #include <cantor/backend.h>
 #include <KConfigDialog>
@@ -182,6 +191,9 @@ MainWin::MainWin(QWidget *parent, const QString& filename)
 }
 
 MainWin::~MainWin() {
+	//the project file must be written completely if the project is still being saved in the background
+	m_saveWatcher.waitForFinished();
+
 	//save the recent opened files
 	m_recentProjectsAction->saveEntries( KSharedConfig::openConfig()->group("Recent Files") );
 	KConfigGroup group = KSharedConfig::openConfig()->group("MainWin");
@@ -321,6 +333,9 @@ void MainWin::initGUI(const QString& fileName) {
 	m_autoSaveTimer.setInterval(interval);
 	connect(&m_autoSaveTimer, &QTimer::timeout, this, &MainWin::autoSaveProject);
 
+	m_saveInBackground = group.readEntry<bool>("SaveInBackground", false);
+	connect(&m_saveWatcher, &QFutureWatcher<QString>::finished, this, &MainWin::saveFinished);
+
 	if (!fileName.isEmpty()) {
 		createMdiArea();
 		setCentralWidget(m_mdiArea);
@@ -1170,6 +1185,7 @@ bool MainWin::newProject() {
 	connect(m_project, &Project::aspectAboutToBeRemoved, this, &MainWin::handleAspectAboutToBeRemoved);
 	connect(m_project, SIGNAL(statusInfo(QString)), statusBar(), SLOT(showMessage(QString)));
 	connect(m_project, &Project::changed, this, &MainWin::projectChanged);
+	m_autoSaveNeeded = false;
 	connect(m_project, &Project::requestProjectContextMenu, this, &MainWin::createContextMenu);
 	connect(m_project, &Project::requestFolderContextMenu, this, &MainWin::createFolderContextMenu);
 	connect(m_project, &Project::mdiWindowVisibilityChanged, this, &MainWin::updateMdiWindowVisibility);
@@ -1240,9 +1256,23 @@ void MainWin::openProject(const QString& filename) {
 	QElapsedTimer timer;
 	timer.start();
 	bool rc = false;
+	bool autoSaveRestored = false;
 	if (Project::isLabPlotProject(filename)) {
 		m_project->setFileName(filename);
-		rc = m_project->load(filename);
+
+		//offer to restore the changes that were auto-saved after the project file was saved the last time
+		const QString& autoSavePath = ProjectContainer::autoSavePath(filename);
+		if (ProjectContainer::isContainer(autoSavePath)
+			&& QFileInfo(ProjectContainer::manifestFileName(autoSavePath)).lastModified() > QFileInfo(filename).lastModified()) {
+			RESET_CURSOR;
+			const int status = KMessageBox::questionYesNo(this,
+				i18n("The project '%1' contains auto-saved changes that were not saved in the project file. Do you want to restore them?", filename),
+				i18n("Restore Auto-Saved Changes"));
+			autoSaveRestored = (status == KMessageBox::Yes);
+			WAIT_CURSOR;
+		}
+
+		rc = m_project->load(autoSaveRestored ? autoSavePath : filename);
 	}
 #ifdef HAVE_LIBORIGIN
 	else if (OriginProjectParser::isOriginProject(filename)) {
@@ -1372,6 +1402,8 @@ void MainWin::openProject(const QString& filename) {
 	m_project->setChanged(false);
 
 	if (!rc) {
+		//keep the auto-saved changes of the project that couldn't be opened
+		m_project->setFileName(QString());
 		closeProject();
 		RESET_CURSOR;
 		return;
@@ -1386,6 +1418,11 @@ void MainWin::openProject(const QString& filename) {
 	updateGUI(); //there are most probably worksheets or spreadsheets in the open project -> update the GUI
 	m_saveAction->setEnabled(false);
 
+	//the restored changes are not saved in the project file yet but they are auto-saved already
+	if (autoSaveRestored)
+		m_project->setChanged(true);
+	m_autoSaveNeeded = false;
+
 	statusBar()->showMessage( i18n("Project successfully opened (in %1 seconds).", (float)timer.elapsed()/1000) );
 
 	KConfigGroup group = KSharedConfig::openConfig()->group(QLatin1String("MainWin"));
@@ -1426,6 +1463,10 @@ bool MainWin::closeProject() {
 // 		}
 	}
 
+	//the project was saved or the changes were discarded, the auto-saved changes are not needed anymore
+	if (!m_project->fileName().isEmpty())
+		ProjectContainer::remove(ProjectContainer::autoSavePath(m_project->fileName()));
+
 	m_projectClosing = true;
 	statusBar()->clearMessage();
 	delete m_aspectTreeModel;
@@ -1487,16 +1528,16 @@ bool MainWin::saveProjectAs() {
 }
 
 /*!
- * auxiliary function that does the actual saving of the project
+ * writes the project file \c fileName via a temporary file, \c write writes the content into the device
+ * doing the compression and returns \c false on failure. The file \c fileName is only replaced if the
+ * temporary file was written completely. Returns an empty string on success and the error message otherwise.
+ * Doesn't access the project and can be called in a worker thread.
  */
-bool MainWin::save(const QString& fileName) {
+static QString writeProjectFile(const QString& fileName, const std::function<bool(QIODevice*)>& write) {
 	QTemporaryFile tempFile(QDir::tempPath() + QLatin1Char('/') + QLatin1String("labplot_save_XXXXXX"));
-	if (!tempFile.open()) {
-		KMessageBox::error(this, i18n("Couldn't open the temporary file for writing."));
-		return false;
-	}
+	if (!tempFile.open())
+		return i18n("Couldn't open the temporary file for writing.");
 
-	WAIT_CURSOR;
 	const QString& tempFileName = tempFile.fileName();
 	DEBUG("Using temporary file " << STDSTRING(tempFileName))
 	tempFile.close();
@@ -1505,75 +1546,179 @@ bool MainWin::save(const QString& fileName) {
 	QIODevice* file;
 	// if ending is .lml, do gzip compression anyway
 	if (fileName.endsWith(QLatin1String(".lml")))
+#ifdef HAVE_ZLIB
+		file = new ParallelGzipDevice(tempFileName);
+#else
 		file = new KCompressionDevice(tempFileName, KCompressionDevice::GZip);
+#endif
 	else
 		file = new KFilterDev(tempFileName);
 
 	if (file == nullptr)
 		file = new QFile(tempFileName);
 
-	bool ok;
+	QString error;
 	if (file->open(QIODevice::WriteOnly)) {
-		m_project->setFileName(fileName);
+		bool ok = write(file);
+		//the remaining compressed data is written on close()
+		file->close();
+		if (ok) {
+#ifdef HAVE_ZLIB
+			if (auto* gzipFile = dynamic_cast<ParallelGzipDevice*>(file))
+				ok = !gzipFile->failed();
+#endif
+#if KARCHIVE_VERSION >= QT_VERSION_CHECK(5, 80, 0)
+			if (auto* compressionFile = dynamic_cast<KCompressionDevice*>(file))
+				ok = (compressionFile->error() == QFileDevice::NoError);
+#endif
+		}
 
-		QPixmap thumbnail = centralWidget()->grab();
+		if (!ok)
+			error = i18n("Couldn't write the file '%1': %2", fileName, file->errorString());
+		else {
+			// target file must not exist
+			if (QFile::exists(fileName))
+				QFile::remove(fileName);
 
-		QXmlStreamWriter writer(file);
-		m_project->setFileName(fileName);
-		m_project->save(thumbnail, &writer);
-		m_project->undoStack()->clear();
-		m_project->setChanged(false);
-		file->close();
+			// do not rename temp file. Qt still holds a handle (which fails renaming on Windows) and deletes it
+			if (!QFile::copy(tempFileName, fileName))
+				error = i18n("Couldn't save the file '%1'.", fileName);
+		}
+	} else
+		error = i18n("Couldn't open the file '%1' for writing.", fileName);
 
-		// target file must not exist
-		if (QFile::exists(fileName))
-			QFile::remove(fileName);
+	delete file;
+	return error;
+}
 
-		// do not rename temp file. Qt still holds a handle (which fails renaming on Windows) and deletes it
-		bool rc = QFile::copy(tempFileName, fileName);
-		if (rc) {
-			updateTitleBar();
-			statusBar()->showMessage(i18n("Project saved"));
-			m_saveAction->setEnabled(false);
-			m_recentProjectsAction->addUrl( QUrl(fileName) );
-			ok = true;
-
-			//if the project dock is visible, refresh the shown content
-			//(version and modification time might have been changed)
-			if (stackedWidget->currentWidget() == projectDock)
-				projectDock->setProject(m_project);
-
-			//we have a file name now
-			// -> auto save can be activated now if not happened yet
-			if (m_autoSaveActive && !m_autoSaveTimer.isActive())
-				m_autoSaveTimer.start();
-		} else {
+/*!
+ * auxiliary function that does the actual saving of the project
+ */
+bool MainWin::save(const QString& fileName) {
+	//finish a still running save in the background first
+	if (m_saveWatcher.isRunning())
+		m_saveWatcher.waitForFinished();
+
+	WAIT_CURSOR;
+	m_project->setFileName(fileName);
+	QPixmap thumbnail = centralWidget()->grab();
+
+	if (m_saveInBackground) {
+		//the project can only be serialized in the GUI thread. It's streamed into an uncompressed temporary file
+		//which is compressed and written to the project file in a worker thread while the user continues working.
+		std::shared_ptr<QTemporaryFile> xmlFile(new QTemporaryFile(QDir::tempPath() + QLatin1Char('/') + QLatin1String("labplot_save_XXXXXX.xml")));
+		bool ok = xmlFile->open();
+		if (ok) {
+			QXmlStreamWriter writer(xmlFile.get());
+			m_project->save(thumbnail, &writer);
+			ok = !writer.hasError() && xmlFile->flush();
+		}
+		if (!ok) {
 			RESET_CURSOR;
-			KMessageBox::error(this, i18n("Couldn't save the file '%1'.", fileName));
-			ok = false;
+			KMessageBox::error(this, i18n("Couldn't write the temporary file '%1': %2", xmlFile->fileName(), xmlFile->errorString()));
+			return false;
 		}
-	} else {
+
+		m_project->undoStack()->clear();
+		m_project->setChanged(false);
+		m_autoSaveNeeded = false;
+		m_saveAction->setEnabled(false);
+
+		m_saveFileName = fileName;
+		m_saveWatcher.setFuture(QtConcurrent::run([fileName, xmlFile]() {
+			return writeProjectFile(fileName, [&xmlFile](QIODevice* file) {
+				//copy block-wise, the compression of ParallelGzipDevice works on chunks of 1 MiB
+				xmlFile->seek(0);
+				QByteArray block;
+				while (!(block = xmlFile->read(1024*1024)).isEmpty()) {
+					if (file->write(block) != block.size())
+						return false;
+				}
+				return xmlFile->error() == QFileDevice::NoError;
+			});
+		}));
+		statusBar()->showMessage(i18n("Saving the project..."));
 		RESET_CURSOR;
-		KMessageBox::error(this, i18n("Couldn't open the file '%1' for writing.", fileName));
-		ok = false;
+		return true;
 	}
 
-	delete file;
+	const QString& error = writeProjectFile(fileName, [=](QIODevice* file) {
+		QXmlStreamWriter writer(file);
+		m_project->save(thumbnail, &writer);
+		return !writer.hasError();
+	});
 
 	RESET_CURSOR;
-	return ok;
+	if (!error.isEmpty()) {
+		KMessageBox::error(this, error);
+		return false;
+	}
+
+	m_project->undoStack()->clear();
+	m_project->setChanged(false);
+	m_autoSaveNeeded = false;
+
+	projectSaved(fileName);
+	return true;
+}
+
+/*!
+ * called when the project was saved in the background.
+ */
+void MainWin::saveFinished() {
+	const QString& error = m_saveWatcher.result();
+	if (!error.isEmpty()) {
+		//the project is not saved, allow to save it again
+		if (m_project && m_project->fileName() == m_saveFileName)
+			m_project->setChanged(true);
+		statusBar()->clearMessage();
+		KMessageBox::error(this, error);
+		return;
+	}
+
+	if (m_project && m_project->fileName() == m_saveFileName)
+		projectSaved(m_saveFileName);
+	else
+		m_recentProjectsAction->addUrl(QUrl(m_saveFileName));
+}
+
+/*!
+ * updates the UI after the project was saved to the file \c fileName.
+ */
+void MainWin::projectSaved(const QString& fileName) {
+	updateTitleBar();
+	statusBar()->showMessage(i18n("Project saved"));
+	m_saveAction->setEnabled(false);
+	m_recentProjectsAction->addUrl( QUrl(fileName) );
+
+	//if the project dock is visible, refresh the shown content
+	//(version and modification time might have been changed)
+	if (stackedWidget->currentWidget() == projectDock)
+		projectDock->setProject(m_project);
+
+	//we have a file name now
+	// -> auto save can be activated now if not happened yet
+	if (m_autoSaveActive && !m_autoSaveTimer.isActive())
+		m_autoSaveTimer.start();
 }
 
 /*!
  * automatically saves the project in the specified time interval.
  */
 void MainWin::autoSaveProject() {
-	//don't auto save when there are no changes or the file name
+	//don't auto save when there are no changes since the last (auto) save or the file name
 	//was not provided yet (the project was never explicitly saved yet).
-	if ( !m_project->hasChanged() || m_project->fileName().isEmpty())
+	if (!m_autoSaveNeeded || !m_project->hasChanged() || m_project->fileName().isEmpty())
 		return;
 
-	this->saveProject();
+	//save incrementally into the container next to the project file,
+	//only the data of the columns modified since the last auto save is written
+	ProjectContainer container(ProjectContainer::autoSavePath(m_project->fileName()));
+	if (container.save(m_project)) {
+		m_autoSaveNeeded = false;
+		statusBar()->showMessage(i18n("Project auto-saved"));
+	} else
+		statusBar()->showMessage(i18n("Failed to auto-save the project"));
 }
 
 void MainWin::updateTitleBar() {
@@ -1760,6 +1905,7 @@ void MainWin::newCantorWorksheet(QAction* action) {
 	Adds "changed" to the window caption and activates the save-Action.
 */
 void MainWin::projectChanged() {
+	m_autoSaveNeeded = true;
 	updateTitleBar();
 	m_saveAction->setEnabled(true);
 	m_undoAction->setEnabled(true);
@@ -2240,6 +2386,8 @@ void MainWin::handleSettingsChanges() {
 	if (interval != m_autoSaveTimer.interval())
 		m_autoSaveTimer.setInterval(interval);
 
+	m_saveInBackground = group.readEntry<bool>("SaveInBackground", false);
+
 	//show memory info
 	bool showMemoryInfo = group.readEntry(QLatin1String("ShowMemoryInfo"), true);
 	if (m_showMemoryInfo != showMemoryInfo) {
@@ -2415,8 +2563,10 @@ void MainWin::exportDialog() {
 	if (!win)
 		return;
 
+	//the part may report more details about the export in the status bar
 	AbstractPart* part = static_cast<PartMdiView*>(win)->part();
-	if (part->exportView())
+	statusBar()->clearMessage();
+	if (part->exportView() && statusBar()->currentMessage().isEmpty())
 		statusBar()->showMessage(i18n("%1 exported", part->name()));
 }
 
@@ -31,6 +31,7 @@
 #include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 
 #include <KXmlGuiWindow>
+#include <QFutureWatcher>
 #include <QTimer>
 
 class AbstractAspect;
@@ -145,6 +146,10 @@ private:
 	bool m_projectClosing{false};
 	bool m_autoSaveActive{false};
 	QTimer m_autoSaveTimer;
+	bool m_autoSaveNeeded{false};	//the project was changed since the last auto save
+	bool m_saveInBackground{false};
+	QFutureWatcher<QString> m_saveWatcher;	//watches the saving of the project in the background
+	QString m_saveFileName;
 	bool m_showMemoryInfo{true};
 	bool m_showWelcomeScreen{false};
 	bool m_saveWelcomeScreen{true};
@@ -256,6 +261,7 @@ private:
 	bool warnModified();
 	void activateSubWindowForAspect(const AbstractAspect*) const;
 	bool save(const QString&);
+	void projectSaved(const QString&);
 // 	void toggleShowWidget(QWidget* widget, bool showToRight);
 // 	void toggleHideWidget(QWidget* widget, bool hideToLeft);
 
@@ -293,6 +299,7 @@ private slots:
 	bool saveProject();
 	bool saveProjectAs();
 	void autoSaveProject();
+	void saveFinished();
 	void updateTitleBar();
 
 	void print();
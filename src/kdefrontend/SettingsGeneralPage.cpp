@@ -48,6 +48,7 @@ SettingsGeneralPage::SettingsGeneralPage(QWidget* parent) : SettingsPage(parent)
 	connect(ui.cbUnits, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SettingsGeneralPage::changed);
 	connect(ui.chkAutoSave, &QCheckBox::stateChanged, this, &SettingsGeneralPage::autoSaveChanged);
 	connect(ui.chkMemoryInfo, &QCheckBox::stateChanged, this, &SettingsGeneralPage::changed);
+	connect(ui.chkSaveInBackground, &QCheckBox::stateChanged, this, &SettingsGeneralPage::changed);
 
 	loadSettings();
 	interfaceChanged(ui.cbInterface->currentIndex());
@@ -65,6 +66,7 @@ void SettingsGeneralPage::applySettings() {
 	group.writeEntry(QLatin1String("AutoSave"), ui.chkAutoSave->isChecked());
 	group.writeEntry(QLatin1String("AutoSaveInterval"), ui.sbAutoSaveInterval->value());
 	group.writeEntry(QLatin1String("ShowMemoryInfo"), ui.chkMemoryInfo->isChecked());
+	group.writeEntry(QLatin1String("SaveInBackground"), ui.chkSaveInBackground->isChecked());
 }
 
 void SettingsGeneralPage::restoreDefaults() {
@@ -78,6 +80,7 @@ void SettingsGeneralPage::restoreDefaults() {
 	ui.sbAutoSaveInterval->setValue(0);
 	ui.sbAutoSaveInterval->setValue(5);
 	ui.chkMemoryInfo->setChecked(true);
+	ui.chkSaveInBackground->setChecked(false);
 }
 
 void SettingsGeneralPage::loadSettings() {
@@ -91,6 +94,7 @@ void SettingsGeneralPage::loadSettings() {
 	ui.chkAutoSave->setChecked(group.readEntry<bool>(QLatin1String("AutoSave"), false));
 	ui.sbAutoSaveInterval->setValue(group.readEntry(QLatin1String("AutoSaveInterval"), 0));
 	ui.chkMemoryInfo->setChecked(group.readEntry<bool>(QLatin1String("ShowMemoryInfo"), true));
+	ui.chkSaveInBackground->setChecked(group.readEntry<bool>(QLatin1String("SaveInBackground"), false));
 }
 
 void SettingsGeneralPage::retranslateUi() {
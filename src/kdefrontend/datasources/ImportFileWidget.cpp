@@ -802,6 +802,8 @@ AbstractFileFilter* ImportFileWidget::currentFileFilter() const {
 		auto filter = static_cast<NgspiceRawBinaryFilter*>(m_currentFilter.get());
 		filter->setStartRow(ui.sbStartRow->value());
 		filter->setEndRow(ui.sbEndRow->value());
+		filter->setStartColumn(ui.sbStartColumn->value());
+		filter->setEndColumn(ui.sbEndColumn->value());
 
 		break;
 	}
@@ -1083,13 +1085,14 @@ void ImportFileWidget::fileTypeChanged(int index) {
 		ui.sbPreviewLines->hide();
 		break;
 	case AbstractFileFilter::FileType::NgspiceRawAscii:
-	case AbstractFileFilter::FileType::NgspiceRawBinary:
-		ui.lFilter->hide();
-		ui.cbFilter->hide();
 		ui.lStartColumn->hide();
 		ui.sbStartColumn->hide();
 		ui.lEndColumn->hide();
 		ui.sbEndColumn->hide();
+	// falls through
+	case AbstractFileFilter::FileType::NgspiceRawBinary:
+		ui.lFilter->hide();
+		ui.cbFilter->hide();
 		ui.tabWidget->removeTab(0);
 		ui.tabWidget->setCurrentIndex(0);
 		break;
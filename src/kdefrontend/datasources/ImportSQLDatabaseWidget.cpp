@@ -30,6 +30,7 @@
 #include "DatabaseManagerDialog.h"
 #include "DatabaseManagerWidget.h"
 #include "backend/datasources/AbstractDataSource.h"
+#include "backend/datasources/filters/SQLDatabaseFilter.h"
 #include "backend/datasources/filters/AbstractFileFilter.h"
 #include "backend/lib/macros.h"
 
@@ -344,80 +345,20 @@ void ImportSQLDatabaseWidget::read(AbstractDataSource* dataSource, AbstractFileF
 		return;
 
 	WAIT_CURSOR;
-	//execute the current query (select on a table or a custom query)
-	QSqlQuery q;
-// 	q.setForwardOnly(true); //TODO: crashes most probably because of q.last() and q.first() below
-	q.prepare(currentQuery());
-	if (!q.exec() || !q.isActive()) {
-		RESET_CURSOR;
-		if (!q.lastError().databaseText().isEmpty())
-			KMessageBox::error(this, q.lastError().databaseText(), i18n("Unable to Execute Query"));
+	//execute the current query (select on a table or a custom query) and read the result set forward-only
+	SQLDatabaseFilter filter;
+	filter.setColumnModes(m_columnModes);
+	filter.setDateTimeFormat(ui.cbDateTimeFormat->currentText());
+	filter.setNumberFormat((QLocale::Language)ui.cbNumberFormat->currentIndex());
+	connect(&filter, &SQLDatabaseFilter::completed, this, &ImportSQLDatabaseWidget::completed);
+	const int rows = filter.read(m_db, currentQuery(), dataSource, importMode);
+	RESET_CURSOR;
+	if (rows == -1) {
+		if (!filter.lastError().isEmpty())
+			KMessageBox::error(this, filter.lastError(), i18n("Unable to Execute Query"));
 
 		setInvalid();
-		return;
 	}
-
-	//determine the number of rows/records to read
-	q.last();
-	const int rows = q.at()+1;
-	q.first();
-
-	// pointers to the actual data containers
-	//columnOffset indexes the "start column" in the datasource. Data will be imported starting from this column.
-	std::vector<void*> dataContainer;
-	int columnOffset = dataSource->prepareImport(dataContainer, importMode, rows, m_cols, m_columnNames, m_columnModes);
-
-	//number and DateTime formatting
-	const QString& dateTimeFormat = ui.cbDateTimeFormat->currentText();
-	const QLocale numberFormat = QLocale((QLocale::Language)ui.cbNumberFormat->currentIndex());
-
-	//read the data
-	int row = 0;
-	do {
-		for (int col = 0; col < m_cols; ++col) {
-			const QString valueString = q.record().value(col).toString();
-
-			// set value depending on data type
-			switch (m_columnModes[col]) {
-			case AbstractColumn::ColumnMode::Numeric: {
-				bool isNumber;
-				const double value = numberFormat.toDouble(valueString, &isNumber);
-				static_cast<QVector<double>*>(dataContainer[col])->operator[](row) = (isNumber ? value : NAN);
-				break;
-			}
-			case AbstractColumn::ColumnMode::Integer: {
-				bool isNumber;
-				const int value = numberFormat.toInt(valueString, &isNumber);
-				static_cast<QVector<int>*>(dataContainer[col])->operator[](row) = (isNumber ? value : NAN);
-				break;
-			}
-			case AbstractColumn::ColumnMode::BigInt: {
-				bool isNumber;
-				const qint64 value = numberFormat.toLongLong(valueString, &isNumber);
-				static_cast<QVector<qint64>*>(dataContainer[col])->operator[](row) = (isNumber ? value : NAN);
-				break;
-			}
-			case AbstractColumn::ColumnMode::DateTime: {
-				const QDateTime valueDateTime = QDateTime::fromString(valueString, dateTimeFormat);
-				static_cast<QVector<QDateTime>*>(dataContainer[col])->operator[](row) = valueDateTime.isValid() ? valueDateTime : QDateTime();
-				break;
-			}
-			case AbstractColumn::ColumnMode::Text:
-				static_cast<QVector<QString>*>(dataContainer[col])->operator[](row) = valueString;
-				break;
-			case AbstractColumn::ColumnMode::Month:	// never happens
-			case AbstractColumn::ColumnMode::Day:
-				break;
-			}
-		}
-
-		row++;
-		emit completed(100 * row/rows);
-	} while (q.next());
-	DEBUG("	Read " << row << " rows");
-
-	dataSource->finalizeImport(columnOffset, 1, m_cols, dateTimeFormat, importMode);
-	RESET_CURSOR;
 }
 
 QString ImportSQLDatabaseWidget::currentQuery(bool preview) {
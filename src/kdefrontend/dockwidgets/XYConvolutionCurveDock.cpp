@@ -124,6 +124,7 @@ void XYConvolutionCurveDock::setupGeneral() {
 	connect( uiGeneralTab.cbNorm, SIGNAL(currentIndexChanged(int)), this, SLOT(normChanged()) );
 	connect( uiGeneralTab.cbWrap, SIGNAL(currentIndexChanged(int)), this, SLOT(wrapChanged()) );
 	connect( uiGeneralTab.pbRecalculate, SIGNAL(clicked()), this, SLOT(recalculateClicked()) );
+	connect( uiGeneralTab.chkAutoRecalculate, SIGNAL(clicked(bool)), this, SLOT(autoRecalculateChanged(bool)) );
 
 	connect( cbDataSourceCurve, SIGNAL(currentModelIndexChanged(QModelIndex)), this, SLOT(dataSourceCurveChanged(QModelIndex)) );
 	connect( cbXDataColumn, SIGNAL(currentModelIndexChanged(QModelIndex)), this, SLOT(xDataColumnChanged(QModelIndex)) );
@@ -191,6 +192,7 @@ void XYConvolutionCurveDock::initGeneralTab() {
 	this->showConvolutionResult();
 
 	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_convolutionCurve->autoRecalculate());
 
 	//Slots
 	connect(m_convolutionCurve, SIGNAL(aspectDescriptionChanged(const AbstractAspect*)), this, SLOT(curveDescriptionChanged(const AbstractAspect*)));
@@ -201,6 +203,9 @@ void XYConvolutionCurveDock::initGeneralTab() {
 	connect(m_convolutionCurve, SIGNAL(y2DataColumnChanged(const AbstractColumn*)), this, SLOT(curveY2DataColumnChanged(const AbstractColumn*)));
 	connect(m_convolutionCurve, SIGNAL(convolutionDataChanged(XYConvolutionCurve::ConvolutionData)), this, SLOT(curveConvolutionDataChanged(XYConvolutionCurve::ConvolutionData)));
 	connect(m_convolutionCurve, SIGNAL(sourceDataChanged()), this, SLOT(enableRecalculate()));
+	connect(m_convolutionCurve, SIGNAL(autoRecalculateChanged(bool)), this, SLOT(curveAutoRecalculateChanged(bool)));
+	connect(m_convolutionCurve, SIGNAL(recalculationProgress(int)), this, SLOT(curveRecalculationProgress(int)));
+	connect(m_convolutionCurve, &XYAnalysisCurve::recalculationFinished, this, &XYConvolutionCurveDock::showConvolutionResult);
 }
 
 void XYConvolutionCurveDock::setModel() {
@@ -523,6 +528,14 @@ void XYConvolutionCurveDock::recalculateClicked() {
 	QApplication::restoreOverrideCursor();
 }
 
+void XYConvolutionCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYConvolutionCurveDock::enableRecalculate() const {
 	DEBUG("XYConvolutionCurveDock::enableRecalculate()");
 	if (m_initializing)
@@ -658,6 +671,16 @@ void XYConvolutionCurveDock::curveConvolutionDataChanged(const XYConvolutionCurv
 	m_initializing = false;
 }
 
+void XYConvolutionCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYConvolutionCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYConvolutionCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
@@ -80,6 +80,7 @@ private slots:
 
 	void recalculateClicked();
 	void enableRecalculate() const;
+	void autoRecalculateChanged(bool);
 
 	//SLOTs for changes triggered in XYCurve
 	//General-Tab
@@ -90,6 +91,8 @@ private slots:
 	void curveYDataColumnChanged(const AbstractColumn*);
 	void curveY2DataColumnChanged(const AbstractColumn*);
 	void curveConvolutionDataChanged(const XYConvolutionCurve::ConvolutionData&);
+	void curveAutoRecalculateChanged(bool);
+	void curveRecalculationProgress(int);
 	void dataChanged();
 };
 
@@ -113,6 +113,7 @@ void XYCorrelationCurveDock::setupGeneral() {
 	connect( uiGeneralTab.cbType, SIGNAL(currentIndexChanged(int)), this, SLOT(typeChanged()) );
 	connect( uiGeneralTab.cbNorm, SIGNAL(currentIndexChanged(int)), this, SLOT(normChanged()) );
 	connect( uiGeneralTab.pbRecalculate, SIGNAL(clicked()), this, SLOT(recalculateClicked()) );
+	connect( uiGeneralTab.chkAutoRecalculate, SIGNAL(clicked(bool)), this, SLOT(autoRecalculateChanged(bool)) );
 
 	connect( cbDataSourceCurve, SIGNAL(currentModelIndexChanged(QModelIndex)), this, SLOT(dataSourceCurveChanged(QModelIndex)) );
 	connect( cbXDataColumn, SIGNAL(currentModelIndexChanged(QModelIndex)), this, SLOT(xDataColumnChanged(QModelIndex)) );
@@ -174,6 +175,7 @@ void XYCorrelationCurveDock::initGeneralTab() {
 	this->showCorrelationResult();
 
 	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_correlationCurve->autoRecalculate());
 
 	//Slots
 	connect(m_correlationCurve, SIGNAL(aspectDescriptionChanged(const AbstractAspect*)), this, SLOT(curveDescriptionChanged(const AbstractAspect*)));
@@ -184,6 +186,9 @@ void XYCorrelationCurveDock::initGeneralTab() {
 	connect(m_correlationCurve, SIGNAL(y2DataColumnChanged(const AbstractColumn*)), this, SLOT(curveY2DataColumnChanged(const AbstractColumn*)));
 	connect(m_correlationCurve, SIGNAL(correlationDataChanged(XYCorrelationCurve::CorrelationData)), this, SLOT(curveCorrelationDataChanged(XYCorrelationCurve::CorrelationData)));
 	connect(m_correlationCurve, SIGNAL(sourceDataChanged()), this, SLOT(enableRecalculate()));
+	connect(m_correlationCurve, SIGNAL(autoRecalculateChanged(bool)), this, SLOT(curveAutoRecalculateChanged(bool)));
+	connect(m_correlationCurve, SIGNAL(recalculationProgress(int)), this, SLOT(curveRecalculationProgress(int)));
+	connect(m_correlationCurve, &XYAnalysisCurve::recalculationFinished, this, &XYCorrelationCurveDock::showCorrelationResult);
 }
 
 void XYCorrelationCurveDock::setModel() {
@@ -411,6 +416,14 @@ void XYCorrelationCurveDock::recalculateClicked() {
 	QApplication::restoreOverrideCursor();
 }
 
+void XYCorrelationCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYCorrelationCurveDock::enableRecalculate() const {
 	DEBUG("XYCorrelationCurveDock::enableRecalculate()");
 	if (m_initializing)
@@ -539,6 +552,16 @@ void XYCorrelationCurveDock::curveCorrelationDataChanged(const XYCorrelationCurv
 	m_initializing = false;
 }
 
+void XYCorrelationCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYCorrelationCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYCorrelationCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
@@ -76,6 +76,7 @@ private slots:
 
 	void recalculateClicked();
 	void enableRecalculate() const;
+	void autoRecalculateChanged(bool);
 
 	//SLOTs for changes triggered in XYCurve
 	//General-Tab
@@ -86,6 +87,8 @@ private slots:
 	void curveYDataColumnChanged(const AbstractColumn*);
 	void curveY2DataColumnChanged(const AbstractColumn*);
 	void curveCorrelationDataChanged(const XYCorrelationCurve::CorrelationData&);
+	void curveAutoRecalculateChanged(bool);
+	void curveRecalculationProgress(int);
 	void dataChanged();
 };
 
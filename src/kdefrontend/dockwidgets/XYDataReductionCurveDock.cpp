@@ -108,6 +108,7 @@ void XYDataReductionCurveDock::setupGeneral() {
 	connect(uiGeneralTab.chkAuto2, &QCheckBox::clicked, this, &XYDataReductionCurveDock::autoTolerance2Changed);
 	connect(uiGeneralTab.sbTolerance2, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &XYDataReductionCurveDock::tolerance2Changed);
 	connect(uiGeneralTab.pbRecalculate, &QPushButton::clicked, this, &XYDataReductionCurveDock::recalculateClicked);
+	connect(uiGeneralTab.chkAutoRecalculate, &QCheckBox::clicked, this, &XYDataReductionCurveDock::autoRecalculateChanged);
 
 	connect(cbDataSourceCurve, &TreeViewComboBox::currentModelIndexChanged, this, &XYDataReductionCurveDock::dataSourceCurveChanged);
 	connect(cbXDataColumn, &TreeViewComboBox::currentModelIndexChanged, this, &XYDataReductionCurveDock::xDataColumnChanged);
@@ -190,6 +191,7 @@ void XYDataReductionCurveDock::initGeneralTab() {
 	uiGeneralTab.pbRecalculate->setEnabled(m_dataReductionCurve->isSourceDataChangedSinceLastRecalc());
 
 	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_dataReductionCurve->autoRecalculate());
 
 	//Slots
 	connect(m_dataReductionCurve, &XYDataReductionCurve::aspectDescriptionChanged, this, &XYDataReductionCurveDock::curveDescriptionChanged);
@@ -199,6 +201,9 @@ void XYDataReductionCurveDock::initGeneralTab() {
 	connect(m_dataReductionCurve, &XYDataReductionCurve::yDataColumnChanged, this, &XYDataReductionCurveDock::curveYDataColumnChanged);
 	connect(m_dataReductionCurve, &XYDataReductionCurve::dataReductionDataChanged, this, &XYDataReductionCurveDock::curveDataReductionDataChanged);
 	connect(m_dataReductionCurve, &XYDataReductionCurve::sourceDataChanged, this, &XYDataReductionCurveDock::enableRecalculate);
+	connect(m_dataReductionCurve, &XYAnalysisCurve::autoRecalculateChanged, this, &XYDataReductionCurveDock::curveAutoRecalculateChanged);
+	connect(m_dataReductionCurve, &XYAnalysisCurve::recalculationProgress, this, &XYDataReductionCurveDock::curveRecalculationProgress);
+	connect(m_dataReductionCurve, &XYAnalysisCurve::recalculationFinished, this, &XYDataReductionCurveDock::showDataReductionResult);
 }
 
 void XYDataReductionCurveDock::setModel() {
@@ -606,6 +611,14 @@ void XYDataReductionCurveDock::recalculateClicked() {
 	emit info(i18n("Data reduction status: %1", m_dataReductionCurve->dataReductionResult().status));
 }
 
+void XYDataReductionCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYDataReductionCurveDock::enableRecalculate() const {
 	if (m_initializing)
 		return;
@@ -712,6 +725,16 @@ void XYDataReductionCurveDock::curveDataReductionDataChanged(const XYDataReducti
 	m_initializing = false;
 }
 
+void XYDataReductionCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYDataReductionCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYDataReductionCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
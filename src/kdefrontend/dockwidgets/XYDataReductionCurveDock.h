@@ -85,6 +85,7 @@ private slots:
 
 	void recalculateClicked();
 	void enableRecalculate() const;
+	void autoRecalculateChanged(bool);
 
 	//SLOTs for changes triggered in XYCurve
 	//General-Tab
@@ -94,6 +95,8 @@ private slots:
 	void curveXDataColumnChanged(const AbstractColumn*);
 	void curveYDataColumnChanged(const AbstractColumn*);
 	void curveDataReductionDataChanged(const XYDataReductionCurve::DataReductionData&);
+	void curveAutoRecalculateChanged(bool);
+	void curveRecalculationProgress(int);
 	void dataChanged();
 };
 
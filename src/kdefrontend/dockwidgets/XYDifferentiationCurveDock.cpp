@@ -106,6 +106,7 @@ void XYDifferentiationCurveDock::setupGeneral() {
 	connect(uiGeneralTab.cbDerivOrder, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &XYDifferentiationCurveDock::derivOrderChanged);
 	connect(uiGeneralTab.sbAccOrder, QOverload<int>::of(&QSpinBox::valueChanged), this, &XYDifferentiationCurveDock::accOrderChanged);
 	connect(uiGeneralTab.pbRecalculate, &QPushButton::clicked, this, &XYDifferentiationCurveDock::recalculateClicked);
+	connect(uiGeneralTab.chkAutoRecalculate, &QCheckBox::clicked, this, &XYDifferentiationCurveDock::autoRecalculateChanged);
 
 	connect(cbDataSourceCurve, &TreeViewComboBox::currentModelIndexChanged, this, &XYDifferentiationCurveDock::dataSourceCurveChanged);
 	connect(cbXDataColumn, &TreeViewComboBox::currentModelIndexChanged, this, &XYDifferentiationCurveDock::xDataColumnChanged);
@@ -180,6 +181,7 @@ void XYDifferentiationCurveDock::initGeneralTab() {
 	this->showDifferentiationResult();
 
 	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_differentiationCurve->autoRecalculate());
 
 	//Slots
 	connect(m_differentiationCurve, &XYDifferentiationCurve::aspectDescriptionChanged, this, &XYDifferentiationCurveDock::curveDescriptionChanged);
@@ -189,6 +191,9 @@ void XYDifferentiationCurveDock::initGeneralTab() {
 	connect(m_differentiationCurve, &XYDifferentiationCurve::yDataColumnChanged, this, &XYDifferentiationCurveDock::curveYDataColumnChanged);
 	connect(m_differentiationCurve, &XYDifferentiationCurve::differentiationDataChanged, this, &XYDifferentiationCurveDock::curveDifferentiationDataChanged);
 	connect(m_differentiationCurve, &XYDifferentiationCurve::sourceDataChanged, this, &XYDifferentiationCurveDock::enableRecalculate);
+	connect(m_differentiationCurve, &XYAnalysisCurve::autoRecalculateChanged, this, &XYDifferentiationCurveDock::curveAutoRecalculateChanged);
+	connect(m_differentiationCurve, &XYAnalysisCurve::recalculationProgress, this, &XYDifferentiationCurveDock::curveRecalculationProgress);
+	connect(m_differentiationCurve, &XYAnalysisCurve::recalculationFinished, this, &XYDifferentiationCurveDock::showDifferentiationResult);
 }
 
 void XYDifferentiationCurveDock::setModel() {
@@ -511,6 +516,14 @@ void XYDifferentiationCurveDock::recalculateClicked() {
 	QApplication::restoreOverrideCursor();
 }
 
+void XYDifferentiationCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYDifferentiationCurveDock::enableRecalculate() const {
 	if (m_initializing)
 		return;
@@ -618,6 +631,16 @@ void XYDifferentiationCurveDock::curveDifferentiationDataChanged(const XYDiffere
 	m_initializing = false;
 }
 
+void XYDifferentiationCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYDifferentiationCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYDifferentiationCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
@@ -78,6 +78,7 @@ private slots:
 
 	void recalculateClicked();
 	void enableRecalculate() const;
+	void autoRecalculateChanged(bool);
 
 	//SLOTs for changes triggered in XYDifferentiationCurve
 	//General-Tab
@@ -87,6 +88,8 @@ private slots:
 	void curveXDataColumnChanged(const AbstractColumn*);
 	void curveYDataColumnChanged(const AbstractColumn*);
 	void curveDifferentiationDataChanged(const XYDifferentiationCurve::DifferentiationData&);
+	void curveAutoRecalculateChanged(bool);
+	void curveRecalculationProgress(int);
 	void dataChanged();
 };
 
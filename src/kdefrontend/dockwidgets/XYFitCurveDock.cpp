@@ -209,6 +209,7 @@ void XYFitCurveDock::setupGeneral() {
 	connect(uiGeneralTab.tbFunctions, &QToolButton::clicked, this, &XYFitCurveDock::showFunctions);
 	connect(uiGeneralTab.pbOptions, &QPushButton::clicked, this, &XYFitCurveDock::showOptions);
 	connect(uiGeneralTab.pbRecalculate, &QPushButton::clicked, this, &XYFitCurveDock::recalculateClicked);
+	connect(uiGeneralTab.chkAutoRecalculate, &QCheckBox::clicked, this, &XYFitCurveDock::autoRecalculateChanged);
 	connect(uiGeneralTab.lData, &QPushButton::clicked, this, &XYFitCurveDock::showDataOptions);
 	connect(uiGeneralTab.lFit, &QPushButton::clicked, this, &XYFitCurveDock::showFitOptions);
 	connect(uiGeneralTab.lParameters, &QPushButton::clicked, this, &XYFitCurveDock::showParameters);
@@ -280,6 +281,7 @@ void XYFitCurveDock::initGeneralTab() {
 	DEBUG("	model degree = " << m_fitData.degree);
 
 	uiGeneralTab.chkVisible->setChecked(m_curve->isVisible());
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_fitCurve->autoRecalculate());
 
 	//Slots
 	connect(m_fitCurve, &XYFitCurve::aspectDescriptionChanged, this, &XYFitCurveDock::curveDescriptionChanged);
@@ -291,6 +293,9 @@ void XYFitCurveDock::initGeneralTab() {
 	connect(m_fitCurve, &XYFitCurve::yErrorColumnChanged, this, &XYFitCurveDock::curveYErrorColumnChanged);
 	connect(m_fitCurve, &XYFitCurve::fitDataChanged, this, &XYFitCurveDock::curveFitDataChanged);
 	connect(m_fitCurve, &XYFitCurve::sourceDataChanged, this, &XYFitCurveDock::enableRecalculate);
+	connect(m_fitCurve, &XYAnalysisCurve::autoRecalculateChanged, this, &XYFitCurveDock::curveAutoRecalculateChanged);
+	connect(m_fitCurve, &XYAnalysisCurve::recalculationProgress, this, &XYFitCurveDock::curveRecalculationProgress);
+	connect(m_fitCurve, &XYAnalysisCurve::recalculationFinished, this, &XYFitCurveDock::showFitResult);
 
 	connect(fitParametersWidget, &FitParametersWidget::parametersChanged, this, &XYFitCurveDock::parametersChanged);
 	connect(fitParametersWidget, &FitParametersWidget::parametersValid, this, &XYFitCurveDock::parametersValid);
@@ -1086,6 +1091,14 @@ void XYFitCurveDock::expressionChanged() {
 	enableRecalculate();
 }
 
+void XYFitCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYFitCurveDock::enableRecalculate() {
 	DEBUG("XYFitCurveDock::enableRecalculate()");
 	if (m_initializing || m_fitCurve == nullptr)
@@ -1416,6 +1429,16 @@ void XYFitCurveDock::curveFitDataChanged(const XYFitCurve::FitData& fitData) {
 	m_initializing = false;
 }
 
+void XYFitCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYFitCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYFitCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
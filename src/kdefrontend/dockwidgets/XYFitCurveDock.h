@@ -103,6 +103,7 @@ private slots:
 	void updateModelEquation();
 	void expressionChanged();
 	void enableRecalculate();
+	void autoRecalculateChanged(bool);
 	void resultParametersContextMenuRequest(QPoint);
 	void resultGoodnessContextMenuRequest(QPoint);
 	void resultLogContextMenuRequest(QPoint);
@@ -119,6 +120,8 @@ private slots:
 	void curveXErrorColumnChanged(const AbstractColumn*);
 	void curveYErrorColumnChanged(const AbstractColumn*);
 	void curveFitDataChanged(const XYFitCurve::FitData&);
+	void curveAutoRecalculateChanged(bool);
+	void curveRecalculationProgress(int);
 	void dataChanged();
 };
 
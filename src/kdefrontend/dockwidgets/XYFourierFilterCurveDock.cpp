@@ -114,6 +114,7 @@ void XYFourierFilterCurveDock::setupGeneral() {
 	connect( uiGeneralTab.cbUnit, SIGNAL(currentIndexChanged(int)), this, SLOT(unitChanged()) );
 	connect( uiGeneralTab.cbUnit2, SIGNAL(currentIndexChanged(int)), this, SLOT(unit2Changed()) );
 	connect( uiGeneralTab.pbRecalculate, SIGNAL(clicked()), this, SLOT(recalculateClicked()) );
+	connect( uiGeneralTab.chkAutoRecalculate, SIGNAL(clicked(bool)), this, SLOT(autoRecalculateChanged(bool)) );
 
 	connect(cbDataSourceCurve, &TreeViewComboBox::currentModelIndexChanged, this, &XYFourierFilterCurveDock::dataSourceCurveChanged);
 	connect(cbXDataColumn, &TreeViewComboBox::currentModelIndexChanged, this, &XYFourierFilterCurveDock::xDataColumnChanged);
@@ -173,6 +174,7 @@ void XYFourierFilterCurveDock::initGeneralTab() {
 	this->showFilterResult();
 
 	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_filterCurve->autoRecalculate());
 
 	//Slots
 	connect(m_filterCurve, SIGNAL(aspectDescriptionChanged(const AbstractAspect*)), this, SLOT(curveDescriptionChanged(const AbstractAspect*)));
@@ -182,6 +184,9 @@ void XYFourierFilterCurveDock::initGeneralTab() {
 	connect(m_filterCurve, SIGNAL(yDataColumnChanged(const AbstractColumn*)), this, SLOT(curveYDataColumnChanged(const AbstractColumn*)));
 	connect(m_filterCurve, SIGNAL(filterDataChanged(XYFourierFilterCurve::FilterData)), this, SLOT(curveFilterDataChanged(XYFourierFilterCurve::FilterData)));
 	connect(m_filterCurve, SIGNAL(sourceDataChanged()), this, SLOT(enableRecalculate()));
+	connect(m_filterCurve, SIGNAL(autoRecalculateChanged(bool)), this, SLOT(curveAutoRecalculateChanged(bool)));
+	connect(m_filterCurve, SIGNAL(recalculationProgress(int)), this, SLOT(curveRecalculationProgress(int)));
+	connect(m_filterCurve, &XYAnalysisCurve::recalculationFinished, this, &XYFourierFilterCurveDock::showFilterResult);
 }
 
 void XYFourierFilterCurveDock::setModel() {
@@ -587,6 +592,14 @@ void XYFourierFilterCurveDock::recalculateClicked() {
 	QApplication::restoreOverrideCursor();
 }
 
+void XYFourierFilterCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYFourierFilterCurveDock::enableRecalculate() const {
 	if (m_initializing)
 		return;
@@ -692,6 +705,16 @@ void XYFourierFilterCurveDock::curveFilterDataChanged(const XYFourierFilterCurve
 	m_initializing = false;
 }
 
+void XYFourierFilterCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYFourierFilterCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYFourierFilterCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
@@ -76,6 +76,7 @@ private slots:
 
 	void recalculateClicked();
 	void enableRecalculate() const;
+	void autoRecalculateChanged(bool);
 
 	//SLOTs for changes triggered in XYCurve
 	//General-Tab
@@ -85,6 +86,8 @@ private slots:
 	void curveXDataColumnChanged(const AbstractColumn*);
 	void curveYDataColumnChanged(const AbstractColumn*);
 	void curveFilterDataChanged(const XYFourierFilterCurve::FilterData&);
+	void curveAutoRecalculateChanged(bool);
+	void curveRecalculationProgress(int);
 	void dataChanged();
 };
 
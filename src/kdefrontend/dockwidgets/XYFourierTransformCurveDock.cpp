@@ -102,6 +102,7 @@ void XYFourierTransformCurveDock::setupGeneral() {
 
 //	connect( uiGeneralTab.pbOptions, SIGNAL(clicked()), this, SLOT(showOptions()) );
 	connect( uiGeneralTab.pbRecalculate, SIGNAL(clicked()), this, SLOT(recalculateClicked()) );
+	connect( uiGeneralTab.chkAutoRecalculate, SIGNAL(clicked(bool)), this, SLOT(autoRecalculateChanged(bool)) );
 }
 
 void XYFourierTransformCurveDock::initGeneralTab() {
@@ -154,6 +155,7 @@ void XYFourierTransformCurveDock::initGeneralTab() {
 	uiGeneralTab.pbRecalculate->setEnabled(m_transformCurve->isSourceDataChangedSinceLastRecalc());
 
 	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_transformCurve->autoRecalculate());
 
 	//Slots
 	connect(m_transformCurve, SIGNAL(aspectDescriptionChanged(const AbstractAspect*)), this, SLOT(curveDescriptionChanged(const AbstractAspect*)));
@@ -161,6 +163,9 @@ void XYFourierTransformCurveDock::initGeneralTab() {
 	connect(m_transformCurve, SIGNAL(yDataColumnChanged(const AbstractColumn*)), this, SLOT(curveYDataColumnChanged(const AbstractColumn*)));
 	connect(m_transformCurve, SIGNAL(transformDataChanged(XYFourierTransformCurve::TransformData)), this, SLOT(curveTransformDataChanged(XYFourierTransformCurve::TransformData)));
 	connect(m_transformCurve, SIGNAL(sourceDataChangedSinceLastTransform()), this, SLOT(enableRecalculate()));
+	connect(m_transformCurve, SIGNAL(autoRecalculateChanged(bool)), this, SLOT(curveAutoRecalculateChanged(bool)));
+	connect(m_transformCurve, SIGNAL(recalculationProgress(int)), this, SLOT(curveRecalculationProgress(int)));
+	connect(m_transformCurve, &XYAnalysisCurve::recalculationFinished, this, &XYFourierTransformCurveDock::showTransformResult);
 }
 
 void XYFourierTransformCurveDock::setModel() {
@@ -323,6 +328,14 @@ void XYFourierTransformCurveDock::recalculateClicked() {
 	QApplication::restoreOverrideCursor();
 }
 
+void XYFourierTransformCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYFourierTransformCurveDock::enableRecalculate() const {
 	if (m_initializing)
 		return;
@@ -408,6 +421,16 @@ void XYFourierTransformCurveDock::curveTransformDataChanged(const XYFourierTrans
 	m_initializing = false;
 }
 
+void XYFourierTransformCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYFourierTransformCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYFourierTransformCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
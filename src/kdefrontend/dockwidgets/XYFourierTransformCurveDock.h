@@ -75,6 +75,7 @@ private slots:
 	void recalculateClicked();
 
 	void enableRecalculate() const;
+	void autoRecalculateChanged(bool);
 
 	//SLOTs for changes triggered in XYCurve
 	//General-Tab
@@ -82,6 +83,8 @@ private slots:
 	void curveXDataColumnChanged(const AbstractColumn*);
 	void curveYDataColumnChanged(const AbstractColumn*);
 	void curveTransformDataChanged(const XYFourierTransformCurve::TransformData&);
+	void curveAutoRecalculateChanged(bool);
+	void curveRecalculationProgress(int);
 	void dataChanged();
 };
 
@@ -106,6 +106,7 @@ void XYIntegrationCurveDock::setupGeneral() {
 	connect(uiGeneralTab.cbMethod, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &XYIntegrationCurveDock::methodChanged);
 	connect(uiGeneralTab.cbAbsolute, &QCheckBox::clicked, this, &XYIntegrationCurveDock::absoluteChanged);
 	connect(uiGeneralTab.pbRecalculate, &QPushButton::clicked, this, &XYIntegrationCurveDock::recalculateClicked);
+	connect(uiGeneralTab.chkAutoRecalculate, &QCheckBox::clicked, this, &XYIntegrationCurveDock::autoRecalculateChanged);
 
 	connect(cbDataSourceCurve, &TreeViewComboBox::currentModelIndexChanged, this, &XYIntegrationCurveDock::dataSourceCurveChanged);
 	connect(cbXDataColumn, &TreeViewComboBox::currentModelIndexChanged, this, &XYIntegrationCurveDock::xDataColumnChanged);
@@ -179,6 +180,7 @@ void XYIntegrationCurveDock::initGeneralTab() {
 	this->showIntegrationResult();
 
 	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_integrationCurve->autoRecalculate());
 
 	//Slots
 	connect(m_integrationCurve, &XYIntegrationCurve::aspectDescriptionChanged, this, &XYIntegrationCurveDock::curveDescriptionChanged);
@@ -188,6 +190,9 @@ void XYIntegrationCurveDock::initGeneralTab() {
 	connect(m_integrationCurve, &XYIntegrationCurve::yDataColumnChanged, this, &XYIntegrationCurveDock::curveYDataColumnChanged);
 	connect(m_integrationCurve, &XYIntegrationCurve::integrationDataChanged, this, &XYIntegrationCurveDock::curveIntegrationDataChanged);
 	connect(m_integrationCurve, &XYIntegrationCurve::sourceDataChanged, this, &XYIntegrationCurveDock::enableRecalculate);
+	connect(m_integrationCurve, &XYAnalysisCurve::autoRecalculateChanged, this, &XYIntegrationCurveDock::curveAutoRecalculateChanged);
+	connect(m_integrationCurve, &XYAnalysisCurve::recalculationProgress, this, &XYIntegrationCurveDock::curveRecalculationProgress);
+	connect(m_integrationCurve, &XYAnalysisCurve::recalculationFinished, this, &XYIntegrationCurveDock::showIntegrationResult);
 }
 
 void XYIntegrationCurveDock::setModel() {
@@ -428,6 +433,14 @@ void XYIntegrationCurveDock::recalculateClicked() {
 	QApplication::restoreOverrideCursor();
 }
 
+void XYIntegrationCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYIntegrationCurveDock::enableRecalculate() const {
 	if (m_initializing)
 		return;
@@ -536,6 +549,16 @@ void XYIntegrationCurveDock::curveIntegrationDataChanged(const XYIntegrationCurv
 	m_initializing = false;
 }
 
+void XYIntegrationCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYIntegrationCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYIntegrationCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
@@ -128,6 +128,7 @@ void XYInterpolationCurveDock::setupGeneral() {
 	connect(uiGeneralTab.sbPoints, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &XYInterpolationCurveDock::numberOfPointsChanged);
 	connect(uiGeneralTab.cbPointsMode, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &XYInterpolationCurveDock::pointsModeChanged);
 	connect(uiGeneralTab.pbRecalculate, &QPushButton::clicked, this, &XYInterpolationCurveDock::recalculateClicked);
+	connect(uiGeneralTab.chkAutoRecalculate, &QCheckBox::clicked, this, &XYInterpolationCurveDock::autoRecalculateChanged);
 
 	connect(cbDataSourceCurve, &TreeViewComboBox::currentModelIndexChanged, this, &XYInterpolationCurveDock::dataSourceCurveChanged);
 	connect(cbXDataColumn, &TreeViewComboBox::currentModelIndexChanged, this, &XYInterpolationCurveDock::xDataColumnChanged);
@@ -211,6 +212,7 @@ void XYInterpolationCurveDock::initGeneralTab() {
 	this->showInterpolationResult();
 
 	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_interpolationCurve->autoRecalculate());
 
 	//Slots
 	connect(m_interpolationCurve, &XYInterpolationCurve::aspectDescriptionChanged, this, &XYInterpolationCurveDock::curveDescriptionChanged);
@@ -220,6 +222,9 @@ void XYInterpolationCurveDock::initGeneralTab() {
 	connect(m_interpolationCurve, &XYInterpolationCurve::yDataColumnChanged, this, &XYInterpolationCurveDock::curveYDataColumnChanged);
 	connect(m_interpolationCurve, &XYInterpolationCurve::interpolationDataChanged, this, &XYInterpolationCurveDock::curveInterpolationDataChanged);
 	connect(m_interpolationCurve, &XYInterpolationCurve::sourceDataChanged, this, &XYInterpolationCurveDock::enableRecalculate);
+	connect(m_interpolationCurve, &XYAnalysisCurve::autoRecalculateChanged, this, &XYInterpolationCurveDock::curveAutoRecalculateChanged);
+	connect(m_interpolationCurve, &XYAnalysisCurve::recalculationProgress, this, &XYInterpolationCurveDock::curveRecalculationProgress);
+	connect(m_interpolationCurve, &XYAnalysisCurve::recalculationFinished, this, &XYInterpolationCurveDock::showInterpolationResult);
 }
 
 void XYInterpolationCurveDock::setModel() {
@@ -649,6 +654,14 @@ void XYInterpolationCurveDock::recalculateClicked() {
 	QApplication::restoreOverrideCursor();
 }
 
+void XYInterpolationCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYInterpolationCurveDock::enableRecalculate() const {
 	if (m_initializing)
 		return;
@@ -754,6 +767,16 @@ void XYInterpolationCurveDock::curveInterpolationDataChanged(const XYInterpolati
 	m_initializing = false;
 }
 
+void XYInterpolationCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYInterpolationCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYInterpolationCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
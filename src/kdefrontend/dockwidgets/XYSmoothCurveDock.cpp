@@ -115,6 +115,7 @@ void XYSmoothCurveDock::setupGeneral() {
 	connect(uiGeneralTab.sbLeftValue, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &XYSmoothCurveDock::valueChanged);
 	connect(uiGeneralTab.sbRightValue, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &XYSmoothCurveDock::valueChanged);
 	connect(uiGeneralTab.pbRecalculate, &QPushButton::clicked, this, &XYSmoothCurveDock::recalculateClicked);
+	connect(uiGeneralTab.chkAutoRecalculate, &QCheckBox::clicked, this, &XYSmoothCurveDock::autoRecalculateChanged);
 
 	connect(cbDataSourceCurve, &TreeViewComboBox::currentModelIndexChanged, this, &XYSmoothCurveDock::dataSourceCurveChanged);
 	connect(cbXDataColumn, &TreeViewComboBox::currentModelIndexChanged, this, &XYSmoothCurveDock::xDataColumnChanged);
@@ -196,6 +197,7 @@ void XYSmoothCurveDock::initGeneralTab() {
 	this->showSmoothResult();
 
 	uiGeneralTab.chkVisible->setChecked( m_curve->isVisible() );
+	uiGeneralTab.chkAutoRecalculate->setChecked(m_smoothCurve->autoRecalculate());
 
 	//Slots
 	connect(m_smoothCurve, &XYSmoothCurve::aspectDescriptionChanged, this, &XYSmoothCurveDock::curveDescriptionChanged);
@@ -205,6 +207,9 @@ void XYSmoothCurveDock::initGeneralTab() {
 	connect(m_smoothCurve, &XYSmoothCurve::yDataColumnChanged, this, &XYSmoothCurveDock::curveYDataColumnChanged);
 	connect(m_smoothCurve, &XYSmoothCurve::smoothDataChanged, this, &XYSmoothCurveDock::curveSmoothDataChanged);
 	connect(m_smoothCurve, &XYSmoothCurve::sourceDataChanged, this, &XYSmoothCurveDock::enableRecalculate);
+	connect(m_smoothCurve, &XYAnalysisCurve::autoRecalculateChanged, this, &XYSmoothCurveDock::curveAutoRecalculateChanged);
+	connect(m_smoothCurve, &XYAnalysisCurve::recalculationProgress, this, &XYSmoothCurveDock::curveRecalculationProgress);
+	connect(m_smoothCurve, &XYAnalysisCurve::recalculationFinished, this, &XYSmoothCurveDock::showSmoothResult);
 }
 
 void XYSmoothCurveDock::setModel() {
@@ -527,6 +532,14 @@ void XYSmoothCurveDock::recalculateClicked() {
 	QApplication::restoreOverrideCursor();
 }
 
+void XYSmoothCurveDock::autoRecalculateChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* curve : m_curvesList)
+		dynamic_cast<XYAnalysisCurve*>(curve)->setAutoRecalculate(state);
+}
+
 void XYSmoothCurveDock::enableRecalculate() const {
 	if (m_initializing)
 		return;
@@ -632,6 +645,16 @@ void XYSmoothCurveDock::curveSmoothDataChanged(const XYSmoothCurve::SmoothData&
 	m_initializing = false;
 }
 
+void XYSmoothCurveDock::curveAutoRecalculateChanged(bool state) {
+	m_initializing = true;
+	uiGeneralTab.chkAutoRecalculate->setChecked(state);
+	m_initializing = false;
+}
+
+void XYSmoothCurveDock::curveRecalculationProgress(int percentage) {
+	emit info(i18n("Recalculating: %1%", percentage));
+}
+
 void XYSmoothCurveDock::dataChanged() {
 	this->enableRecalculate();
 }
@@ -385,9 +385,14 @@ void AddSubtractValueDialog::generateForColumns() {
 			//fall through
 		case Add:
 			for (auto* col : m_columns) {
-				auto* data = static_cast<QVector<QDateTime>* >(col->data());
-				for (int i = 0; i<rows; ++i)
-					new_data[i] = QDateTime::fromMSecsSinceEpoch(data->operator[](i).toMSecsSinceEpoch() + value);
+				auto* data = static_cast<QVector<qint64>* >(col->data());
+				for (int i = 0; i<rows; ++i) {
+					const qint64 msecs = data->operator[](i);
+					if (msecs != AbstractColumn::invalidDateTime)
+						new_data[i] = AbstractColumn::dateTimeFromMSecs(msecs + value, col->timeSpec());
+					else
+						new_data[i] = QDateTime();
+				}
 
 				col->replaceDateTimes(0, new_data);
 			}
@@ -77,6 +77,9 @@ ExportSpreadsheetDialog::ExportSpreadsheetDialog(QWidget* parent) : QDialog(pare
 	const QStringList& drivers = QSqlDatabase::drivers();
 	if (drivers.contains(QLatin1String("QSQLITE")) || drivers.contains(QLatin1String("QSQLITE3")))
 		ui->cbFormat->addItem("SQLite", static_cast<int>(Format::SQLite));
+#ifdef HAVE_HDF5
+	ui->cbFormat->addItem("HDF5", static_cast<int>(Format::HDF5));
+#endif
 
 	QStringList separators = AsciiFilter::separatorCharacters();
 	separators.takeAt(0); //remove the first entry "auto"
@@ -119,6 +122,7 @@ ExportSpreadsheetDialog::ExportSpreadsheetDialog(QWidget* parent) : QDialog(pare
 	ui->chkMatrixVHeader->setChecked(conf.readEntry("MatrixVerticalHeader", true));
 	ui->chkMatrixVHeader->setChecked(conf.readEntry("FITSSpreadsheetColumnsUnits", true));
 	ui->cbExportToFITS->setCurrentIndex(conf.readEntry("FITSTo", 0));
+	ui->chkAppend->setChecked(conf.readEntry("HDF5Append", false));
 	m_showOptions = conf.readEntry("ShowOptions", false);
 	ui->gbOptions->setVisible(m_showOptions);
 	m_showOptions ? m_showOptionsButton->setText(i18n("Hide Options")) :
@@ -149,6 +153,7 @@ ExportSpreadsheetDialog::~ExportSpreadsheetDialog() {
 	conf.writeEntry("MatrixHorizontalHeader", ui->chkMatrixHHeader->isChecked());
 	conf.writeEntry("FITSTo", ui->cbExportToFITS->currentIndex());
 	conf.writeEntry("FITSSpreadsheetColumnsUnits", ui->chkColumnsAsUnits->isChecked());
+	conf.writeEntry("HDF5Append", ui->chkAppend->isChecked());
 
 	KWindowConfig::saveWindowSize(windowHandle(), conf);
 }
@@ -252,6 +257,13 @@ bool ExportSpreadsheetDialog::commentsAsUnitsFits() const {
 	return ui->chkColumnsAsUnits->isChecked();
 }
 
+/*!
+  returns \c true if the data should be appended to an existing file (HDF5 only).
+*/
+bool ExportSpreadsheetDialog::appendToFile() const {
+	return (format() == Format::HDF5) && ui->chkAppend->isChecked();
+}
+
 QString ExportSpreadsheetDialog::separator() const {
 	return ui->cbSeparator->currentText();
 }
@@ -277,7 +289,7 @@ void ExportSpreadsheetDialog::setExportToImage(bool possible) {
 
 //SLOTS
 void ExportSpreadsheetDialog::okClicked() {
-	if (format() != Format::FITS)
+	if (format() != Format::FITS && !appendToFile())
 		if ( QFile::exists(ui->leFileName->text()) ) {
 			int r = KMessageBox::questionYesNo(this, i18n("The file already exists. Do you really want to overwrite it?"), i18n("Export"));
 			if (r == KMessageBox::No)
@@ -340,6 +352,9 @@ void ExportSpreadsheetDialog::selectFile() {
 	case Format::SQLite:
 		extensions = i18n("SQLite databases files (*.db *.sqlite *.sdb *.db2 *.sqlite2 *.sdb2 *.db3 *.sqlite3 *.sdb3)");
 		break;
+	case Format::HDF5:
+		extensions = i18n("HDF5 files (*.h5 *.hdf *.hdf5)");
+		break;
 	}
 
 	const QString path = QFileDialog::getSaveFileName(this, i18n("Export to file"), dir, extensions);
@@ -359,18 +374,18 @@ void ExportSpreadsheetDialog::selectFile() {
 	called when the output format was changed. Adjusts the extension for the specified file.
  */
 void ExportSpreadsheetDialog::formatChanged(int index) {
+	const Format format = Format(ui->cbFormat->itemData(index).toInt());
 	QStringList extensions;
-	extensions << ".txt" << ".bin" << ".tex" << ".fits" << ".db";
+	extensions << ".txt" << ".bin" << ".tex" << ".fits" << ".db" << ".h5";
 	QString path = ui->leFileName->text();
 	int i = path.indexOf(".");
-	if (index != 1) {
+	if (format != Format::Binary) {
 		if (i == -1)
-			path = path + extensions.at(index);
+			path = path + extensions.at(static_cast<int>(format));
 		else
-			path = path.left(i) + extensions.at(index);
+			path = path.left(i) + extensions.at(static_cast<int>(format));
 	}
 
-	const Format format = Format(ui->cbFormat->itemData(ui->cbFormat->currentIndex()).toInt());
 	if (format == Format::LaTeX) {
 		ui->cbSeparator->hide();
 		ui->lSeparator->hide();
@@ -433,7 +448,7 @@ void ExportSpreadsheetDialog::formatChanged(int index) {
 				ui->chkColumnsAsUnits->show();
 			}
 		}
-	} else if (format == Format::SQLite) {
+	} else if (format == Format::SQLite || format == Format::HDF5) {
 		ui->cbSeparator->hide();
 		ui->lSeparator->hide();
 		ui->lNumberFormat->hide();
@@ -490,12 +505,15 @@ void ExportSpreadsheetDialog::formatChanged(int index) {
 		ui->chkColumnsAsUnits->hide();
 	}
 
-	if (!m_matrixMode && !(format == Format::FITS || format == Format::SQLite)) {
+	if (!m_matrixMode && !(format == Format::FITS || format == Format::SQLite || format == Format::HDF5)) {
 		ui->chkExportHeader->show();
 		ui->lExportHeader->show();
 	}
 
-	setFormat(static_cast<Format>(index));
+	ui->lAppend->setVisible(format == Format::HDF5);
+	ui->chkAppend->setVisible(format == Format::HDF5);
+
+	setFormat(format);
 	ui->leFileName->setText(path);
 }
 
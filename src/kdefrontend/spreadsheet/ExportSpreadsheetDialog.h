@@ -63,6 +63,7 @@ public:
 	QLocale::Language numberFormat() const;
 	int exportToFits() const;
 	bool commentsAsUnitsFits() const;
+	bool appendToFile() const;
 	void setExportTo(const QStringList& to);
 	void setExportToImage(bool possible);
 
@@ -71,7 +72,8 @@ public:
 		Binary,
 		LaTeX,
 		FITS,
-		SQLite
+		SQLite,
+		HDF5
 	};
 
 	Format format() const;
@@ -29,6 +29,10 @@
 #include "FitOptionsWidget.h"
 #include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 
+extern "C" {
+#include <gsl/gsl_version.h>
+}
+
 /*!
 	\class FitOptionsWidget
 	\brief Widget for editing advanced fit options.
@@ -47,10 +51,19 @@ FitOptionsWidget::FitOptionsWidget(QWidget* parent, XYFitCurve::FitData* fitData
 	ui.lRobust->setVisible(false);
 	ui.cbRobust->setVisible(false);
 
+	for (int i = 0; i < NSL_FIT_ALGORITHM_COUNT; i++)
+		ui.cbAlgorithm->addItem(i18n(nsl_fit_algorithm_name[i]));
+#if !((GSL_MAJOR_VERSION > 2) || (GSL_MAJOR_VERSION == 2) && (GSL_MINOR_VERSION >= 2))
+	// the solver for large data sets needs GSL >= 2.2
+	ui.lAlgorithm->setVisible(false);
+	ui.cbAlgorithm->setVisible(false);
+#endif
+
 	ui.leEps->setValidator( new QDoubleValidator(ui.leEps) );
 	ui.leMaxIterations->setValidator( new QIntValidator(ui.leMaxIterations) );
 	ui.leEvaluatedPoints->setValidator( new QIntValidator(ui.leEvaluatedPoints) );
 
+	ui.cbAlgorithm->setCurrentIndex(m_fitData->algorithm);
 	ui.leEps->setText(QString::number(m_fitData->eps));
 	ui.leMaxIterations->setText(QString::number(m_fitData->maxIterations));
 	ui.leEvaluatedPoints->setText(QString::number(m_fitData->evaluatedPoints));
@@ -95,6 +108,7 @@ FitOptionsWidget::FitOptionsWidget(QWidget* parent, XYFitCurve::FitData* fitData
 	ui.sbConfidenceInterval->setValue(m_fitData->confidenceInterval);
 
 	//SLOTS
+	connect(ui.cbAlgorithm, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FitOptionsWidget::changed);
 	connect(ui.leEps, &QLineEdit::textChanged, this, &FitOptionsWidget::changed);
 	connect(ui.leMaxIterations, &QLineEdit::textChanged, this, &FitOptionsWidget::changed);
 	connect(ui.leEvaluatedPoints, &QLineEdit::textChanged, this, &FitOptionsWidget::changed);
@@ -237,6 +251,7 @@ void FitOptionsWidget::evalRangeMaxDateTimeChanged(const QDateTime& dateTime) {
 }
 
 void FitOptionsWidget::applyClicked() {
+	m_fitData->algorithm = (nsl_fit_algorithm_type)ui.cbAlgorithm->currentIndex();
 	m_fitData->maxIterations = ui.leMaxIterations->text().toFloat();
 	m_fitData->eps = ui.leEps->text().toFloat();
 	m_fitData->evaluatedPoints = ui.leEvaluatedPoints->text().toInt();
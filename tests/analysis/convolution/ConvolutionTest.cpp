@@ -1499,6 +1499,211 @@ void ConvolutionTest::testCircularDeconv_norm() {
 	QCOMPARE(resultYDataColumn->valueAt(3), 4.);
 }
 
+//##############################################################################
+//#################  overlap-add method  #######################################
+//##############################################################################
+
+void ConvolutionTest::testLinearOverlapAdd() {
+	// data
+	QVector<double> yData;
+	for (int i = 0;  i < 10000; i++)
+		yData.append(sin(i/10.) + (i % 7));
+	QVector<double> y2Data;
+	for (int i = 0;  i < 300; i++)
+		y2Data.append(exp(-(i - 150.)*(i - 150.)/1000.));
+
+	//data source columns
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Numeric);
+	yDataColumn.replaceValues(0, yData);
+
+	Column y2DataColumn("y2", AbstractColumn::ColumnMode::Numeric);
+	y2DataColumn.replaceValues(0, y2Data);
+
+	XYConvolutionCurve directCurve("direct");
+	directCurve.setYDataColumn(&yDataColumn);
+	directCurve.setY2DataColumn(&y2DataColumn);
+	XYConvolutionCurve overlapAddCurve("overlap-add");
+	overlapAddCurve.setYDataColumn(&yDataColumn);
+	overlapAddCurve.setY2DataColumn(&y2DataColumn);
+
+	//perform the convolution with both methods
+	XYConvolutionCurve::ConvolutionData convolutionData = directCurve.convolutionData();
+	convolutionData.method = nsl_conv_method_direct;
+	convolutionData.normalize = nsl_conv_norm_sum;
+	convolutionData.wrap = nsl_conv_wrap_center;
+	directCurve.setConvolutionData(convolutionData);
+	convolutionData.method = nsl_conv_method_fft_overlap_add;
+	overlapAddCurve.setConvolutionData(convolutionData);
+
+	//check the results
+	QCOMPARE(overlapAddCurve.convolutionResult().available, true);
+	QCOMPARE(overlapAddCurve.convolutionResult().valid, true);
+
+	const AbstractColumn* directYDataColumn = directCurve.yColumn();
+	const AbstractColumn* resultYDataColumn = overlapAddCurve.yColumn();
+
+	const int np = resultYDataColumn->rowCount();
+	QCOMPARE(np, 10299);
+	QCOMPARE(directYDataColumn->rowCount(), np);
+
+	for (int i = 0; i < np; i++)
+		QVERIFY(fabs(resultYDataColumn->valueAt(i) - directYDataColumn->valueAt(i)) < 1.e-9);
+}
+
+void ConvolutionTest::testCircularOverlapAdd() {
+	// data
+	QVector<double> yData;
+	for (int i = 0;  i < 10000; i++)
+		yData.append(sin(i/10.) + (i % 7));
+	QVector<double> y2Data;
+	for (int i = 0;  i < 300; i++)
+		y2Data.append(exp(-(i - 150.)*(i - 150.)/1000.));
+
+	//data source columns
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Numeric);
+	yDataColumn.replaceValues(0, yData);
+
+	Column y2DataColumn("y2", AbstractColumn::ColumnMode::Numeric);
+	y2DataColumn.replaceValues(0, y2Data);
+
+	XYConvolutionCurve directCurve("direct");
+	directCurve.setYDataColumn(&yDataColumn);
+	directCurve.setY2DataColumn(&y2DataColumn);
+	XYConvolutionCurve overlapAddCurve("overlap-add");
+	overlapAddCurve.setYDataColumn(&yDataColumn);
+	overlapAddCurve.setY2DataColumn(&y2DataColumn);
+
+	//perform the convolution with both methods
+	XYConvolutionCurve::ConvolutionData convolutionData = directCurve.convolutionData();
+	convolutionData.type = nsl_conv_type_circular;
+	convolutionData.method = nsl_conv_method_direct;
+	convolutionData.wrap = nsl_conv_wrap_max;
+	directCurve.setConvolutionData(convolutionData);
+	convolutionData.method = nsl_conv_method_fft_overlap_add;
+	overlapAddCurve.setConvolutionData(convolutionData);
+
+	//check the results
+	QCOMPARE(overlapAddCurve.convolutionResult().available, true);
+	QCOMPARE(overlapAddCurve.convolutionResult().valid, true);
+
+	const AbstractColumn* directYDataColumn = directCurve.yColumn();
+	const AbstractColumn* resultYDataColumn = overlapAddCurve.yColumn();
+
+	const int np = resultYDataColumn->rowCount();
+	QCOMPARE(np, 10000);
+	QCOMPARE(directYDataColumn->rowCount(), np);
+
+	for (int i = 0; i < np; i++)
+		QVERIFY(fabs(resultYDataColumn->valueAt(i) - directYDataColumn->valueAt(i)) < 1.e-9);
+}
+
+//##############################################################################
+//#################  asynchronous recalculation  ###############################
+//##############################################################################
+
+void ConvolutionTest::testLinearAsync() {
+	// data
+	QVector<int> xData = {1,2,3,4};
+	QVector<double> yData = {1.,2.,3.,4.};
+	QVector<double> y2Data = {0,1.,.5};
+
+	//data source columns
+	Column xDataColumn("x", AbstractColumn::ColumnMode::Integer);
+	xDataColumn.replaceInteger(0, xData);
+
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Numeric);
+	yDataColumn.replaceValues(0, yData);
+
+	Column y2DataColumn("y2", AbstractColumn::ColumnMode::Numeric);
+	y2DataColumn.replaceValues(0, y2Data);
+
+	XYConvolutionCurve convolutionCurve("convolution");
+	convolutionCurve.setXDataColumn(&xDataColumn);
+	convolutionCurve.setYDataColumn(&yDataColumn);
+	convolutionCurve.setY2DataColumn(&y2DataColumn);
+
+	//perform the convolution in the background, a second request cancels and restarts the first one
+	QSignalSpy spy(&convolutionCurve, &XYAnalysisCurve::recalculationFinished);
+	convolutionCurve.recalculateAsync();
+	convolutionCurve.recalculateAsync();
+	QVERIFY(convolutionCurve.isRecalculating());
+	QVERIFY(spy.wait(10000));
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(convolutionCurve.isRecalculating(), false);
+
+	//check the results
+	const XYConvolutionCurve::ConvolutionResult& convolutionResult = convolutionCurve.convolutionResult();
+	QCOMPARE(convolutionResult.available, true);
+	QCOMPARE(convolutionResult.valid, true);
+
+	const AbstractColumn* resultXDataColumn = convolutionCurve.xColumn();
+	const AbstractColumn* resultYDataColumn = convolutionCurve.yColumn();
+
+	const int np = resultXDataColumn->rowCount();
+	QCOMPARE(np, 6);
+
+	for (int i = 0; i < np; i++)
+		QCOMPARE(resultXDataColumn->valueAt(i), (double)i + 1);
+
+	FuzzyCompare(resultYDataColumn->valueAt(0), 0., 1.e-15);
+	QCOMPARE(resultYDataColumn->valueAt(1), 1.);
+	QCOMPARE(resultYDataColumn->valueAt(2), 2.5);
+	QCOMPARE(resultYDataColumn->valueAt(3), 4.);
+	QCOMPARE(resultYDataColumn->valueAt(4), 5.5);
+	QCOMPARE(resultYDataColumn->valueAt(5), 2.);
+}
+
+void ConvolutionTest::testLinearAsyncCancel() {
+	// data
+	QVector<int> xData = {1,2,3,4};
+	QVector<double> yData = {1.,2.,3.,4.};
+	QVector<double> y2Data = {0,1.,.5};
+
+	//data source columns
+	Column xDataColumn("x", AbstractColumn::ColumnMode::Integer);
+	xDataColumn.replaceInteger(0, xData);
+
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Numeric);
+	yDataColumn.replaceValues(0, yData);
+
+	Column y2DataColumn("y2", AbstractColumn::ColumnMode::Numeric);
+	y2DataColumn.replaceValues(0, y2Data);
+
+	XYConvolutionCurve convolutionCurve("convolution");
+	convolutionCurve.setXDataColumn(&xDataColumn);
+	convolutionCurve.setYDataColumn(&yDataColumn);
+	convolutionCurve.setY2DataColumn(&y2DataColumn);
+	convolutionCurve.recalculate();
+
+	const AbstractColumn* resultXDataColumn = convolutionCurve.xColumn();
+	const AbstractColumn* resultYDataColumn = convolutionCurve.yColumn();
+	QCOMPARE(resultXDataColumn->rowCount(), 6);
+
+	//change the source data and cancel the recalculation in the background, the result of the previous convolution is kept
+	yDataColumn.replaceValues(0, QVector<double>{2.,4.,6.,8.});
+	QSignalSpy finishedSpy(&convolutionCurve, &XYAnalysisCurve::recalculationFinished);
+	convolutionCurve.recalculateAsync();
+	QVERIFY(convolutionCurve.isRecalculating());
+	convolutionCurve.cancelRecalculation();
+	convolutionCurve.waitForRecalculation();
+	QTRY_COMPARE(convolutionCurve.isRecalculating(), false);
+	QCOMPARE(finishedSpy.count(), 0);
+
+	//check the results
+	const int np = resultXDataColumn->rowCount();
+	QCOMPARE(np, 6);
+
+	for (int i = 0; i < np; i++)
+		QCOMPARE(resultXDataColumn->valueAt(i), (double)i + 1);
+
+	FuzzyCompare(resultYDataColumn->valueAt(0), 0., 1.e-15);
+	QCOMPARE(resultYDataColumn->valueAt(1), 1.);
+	QCOMPARE(resultYDataColumn->valueAt(2), 2.5);
+	QCOMPARE(resultYDataColumn->valueAt(3), 4.);
+	QCOMPARE(resultYDataColumn->valueAt(4), 5.5);
+	QCOMPARE(resultYDataColumn->valueAt(5), 2.);
+}
+
 void ConvolutionTest::testPerformance() {
 	// data
 	QVector<double> yData;
@@ -1541,4 +1746,49 @@ void ConvolutionTest::testPerformance() {
 	QCOMPARE(np, N + 2);
 }
 
+void ConvolutionTest::testPerformance_overlapAdd() {
+	// data
+#ifdef HAVE_FFTW3
+	const int N = 3e6;
+#else	// GSL is much slower
+	const int N = 5e5;
+#endif
+	QVector<double> yData;
+	for (int i = 0;  i < N; i++)
+		yData.append(i % 100);
+	QVector<double> y2Data;
+	for (int i = 0;  i < 500; i++)
+		y2Data.append(exp(-(i - 250.)*(i - 250.)/5000.));
+
+	//data source columns
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Numeric);
+	yDataColumn.replaceValues(0, yData);
+
+	Column y2DataColumn("y2", AbstractColumn::ColumnMode::Numeric);
+	y2DataColumn.replaceValues(0, y2Data);
+
+	XYConvolutionCurve convolutionCurve("convolution");
+	convolutionCurve.setYDataColumn(&yDataColumn);
+	convolutionCurve.setY2DataColumn(&y2DataColumn);
+
+	//prepare and perform the convolution (auto selects overlap-add for this size)
+	XYConvolutionCurve::ConvolutionData convolutionData = convolutionCurve.convolutionData();
+	QCOMPARE(nsl_conv_auto_method(N, 500, convolutionData.type), nsl_conv_method_fft_overlap_add);
+	QBENCHMARK {
+		// triggers recalculate()
+		convolutionCurve.setConvolutionData(convolutionData);
+	}
+
+	//check the results
+	const XYConvolutionCurve::ConvolutionResult& convolutionResult = convolutionCurve.convolutionResult();
+
+	QCOMPARE(convolutionResult.available, true);
+	QCOMPARE(convolutionResult.valid, true);
+
+	const AbstractColumn* resultXDataColumn = convolutionCurve.xColumn();
+
+	const int np = resultXDataColumn->rowCount();
+	QCOMPARE(np, N + 499);
+}
+
 QTEST_MAIN(ConvolutionTest)
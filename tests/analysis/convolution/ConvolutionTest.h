@@ -69,6 +69,13 @@ private slots:
 	void testCircularDeconv2();
 	void testCircularDeconv_norm();
 
+	void testLinearOverlapAdd();
+	void testCircularOverlapAdd();
+
+	void testLinearAsync();
+	void testLinearAsyncCancel();
+
 	void testPerformance();
+	void testPerformance_overlapAdd();
 };
 #endif
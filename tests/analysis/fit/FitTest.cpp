@@ -28,6 +28,7 @@
 
 #include "FitTest.h"
 #include "backend/core/column/Column.h"
+#include "backend/spreadsheet/Spreadsheet.h"
 #include "backend/worksheet/plots/cartesian/XYFitCurve.h"
 
 extern "C" {
@@ -35,6 +36,22 @@ extern "C" {
 #include "backend/nsl/nsl_stats.h"
 }
 
+/*!
+ * all fits are carried out with both solvers, the QR based one and the one for large data sets
+ * solving the normal equations, and have to reproduce the certified values with the same precision.
+ */
+void FitTest::initTestCase_data() {
+	QTest::addColumn<int>("algorithm");
+	QTest::newRow("QR") << (int)nsl_fit_algorithm_lm;
+	QTest::newRow("normal equations") << (int)nsl_fit_algorithm_large;
+}
+
+// solver of the current row of the global test data
+static nsl_fit_algorithm_type fitAlgorithm() {
+	QFETCH_GLOBAL(int, algorithm);
+	return (nsl_fit_algorithm_type)algorithm;
+}
+
 //##############################################################################
 //#################  linear regression with NIST datasets ######################
 //##############################################################################
@@ -62,6 +79,7 @@ void FitTest::testLinearNorris() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 1;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitCurve.setFitData(fitData);
 
 	//perform the fit
@@ -114,6 +132,7 @@ void FitTest::testLinearPontius() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 2;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitCurve.setFitData(fitData);
 
 	//perform the fit
@@ -162,6 +181,7 @@ void FitTest::testLinearNoInt1() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*x";
 	fitData.paramNames << "b1";
 	const int np = fitData.paramNames.size();
@@ -216,6 +236,7 @@ void FitTest::testLinearNoInt1_2() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 1;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.paramStartValues[0] = 0;
 	fitData.paramFixed[0] = true;
 	fitCurve.setFitData(fitData);
@@ -263,6 +284,7 @@ void FitTest::testLinearNoInt2() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "c * x";
 	fitData.paramNames << "c";
 	const int np = fitData.paramNames.size();
@@ -319,6 +341,7 @@ void FitTest::testLinearNoInt2_2() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 1;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.paramStartValues[0] = 0;
 	fitData.paramFixed[0] = true;
 	fitCurve.setFitData(fitData);
@@ -347,6 +370,11 @@ void FitTest::testLinearNoInt2_2() {
 }
 
 void FitTest::testLinearFilip() {
+	// the condition number of the (scaled) normal equations is about 4e19 > 1/DBL_EPSILON,
+	// J^T J is not positive definite in double precision and can't be solved with Cholesky
+	if (fitAlgorithm() == nsl_fit_algorithm_large)
+		QSKIP("Filip is too ill-conditioned for the normal equations");
+
 	//NIST data for Filip dataset
 	QVector<double> xData = {-6.860120914,-4.324130045,-4.358625055,-4.358426747,-6.955852379,-6.661145254,-6.355462942,-6.118102026,
 		-7.115148017,-6.815308569,-6.519993057,-6.204119983,-5.853871964,-6.109523091,-5.79832982,-5.482672118,-5.171791386,-4.851705903,
@@ -381,6 +409,7 @@ void FitTest::testLinearFilip() {
 	fitData.degree = 10;
 	fitData.eps = 1.e-8;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	const int np = fitData.paramNames.size();
 	fitCurve.setFitData(fitData);
 
@@ -475,6 +504,7 @@ void FitTest::testLinearWampler1() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 5;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitCurve.setFitData(fitData);
 
 	//perform the fit
@@ -525,6 +555,7 @@ void FitTest::testLinearWampler2() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 5;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitCurve.setFitData(fitData);
 
 	//perform the fit
@@ -585,6 +616,7 @@ void FitTest::testLinearWampler3() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 5;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitCurve.setFitData(fitData);
 
 	//perform the fit
@@ -640,6 +672,7 @@ void FitTest::testLinearWampler4() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 5;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitCurve.setFitData(fitData);
 
 	//perform the fit
@@ -698,6 +731,7 @@ void FitTest::testLinearWampler5() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 5;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitCurve.setFitData(fitData);
 
 	//perform the fit
@@ -753,6 +787,7 @@ void FitTest::testLinearWP_OLS() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 2;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitCurve.setFitData(fitData);
 
 	//perform the fit
@@ -840,6 +875,7 @@ void FitTest::testLinearR_lm2() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 2;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitCurve.setFitData(fitData);
 
 	//perform the fit
@@ -930,6 +966,7 @@ void FitTest::testNonLinearMisra1a() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(1.-exp(-b2*x))";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -984,6 +1021,7 @@ void FitTest::testNonLinearMisra1a_2() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(1.-exp(-b2*x))";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1038,6 +1076,7 @@ void FitTest::testNonLinearMisra1a_3() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(1.-exp(-b2*x))";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1093,6 +1132,7 @@ void FitTest::testNonLinearMisra1b() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(1.-1./(1.+b2*x/2)^2)";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1147,6 +1187,7 @@ void FitTest::testNonLinearMisra1b_2() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(1.-1./(1.+b2*x/2)^2)";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1201,6 +1242,7 @@ void FitTest::testNonLinearMisra1b_3() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(1.-1./(1.+b2*x/2)^2)";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1255,6 +1297,7 @@ void FitTest::testNonLinearMisra1c() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(1.-1./sqrt(1.+2.*b2*x))";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1309,6 +1352,7 @@ void FitTest::testNonLinearMisra1c_2() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(1.-1./sqrt(1.+2.*b2*x))";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1363,6 +1407,7 @@ void FitTest::testNonLinearMisra1c_3() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(1.-1./sqrt(1.+2.*b2*x))";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1417,6 +1462,7 @@ void FitTest::testNonLinearMisra1d() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*b2*x/(1.+b2*x)";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1471,6 +1517,7 @@ void FitTest::testNonLinearMisra1d_2() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*b2*x/(1.+b2*x)";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1525,6 +1572,7 @@ void FitTest::testNonLinearMisra1d_3() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*b2*x/(1.+b2*x)";
 	fitData.paramNames << "b1" << "b2";
 	fitData.eps = 1.e-12;
@@ -1581,6 +1629,7 @@ void FitTest::testNonLinearMGH09() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(x^2 + b2*x)/(x^2 + x*b3 + b4)";
 	fitData.paramNames << "b1" << "b2" << "b3" << "b4";
 	//fitData.eps = 1.e-12;
@@ -1647,6 +1696,7 @@ void FitTest::testNonLinearMGH09_2() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(x^2 + b2*x)/(x^2 + x*b3 + b4)";
 	fitData.paramNames << "b1" << "b2" << "b3" << "b4";
 	//fitData.eps = 1.e-12;
@@ -1711,6 +1761,7 @@ void FitTest::testNonLinearMGH09_3() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*(x^2 + b2*x)/(x^2 + x*b3 + b4)";
 	fitData.paramNames << "b1" << "b2" << "b3" << "b4";
 	//fitData.eps = 1.e-12;
@@ -1775,6 +1826,7 @@ void FitTest::testNonLinearMGH10() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*exp(b2/(x+b3))";
 	fitData.paramNames << "b1" << "b2" << "b3";
 	//fitData.eps = 1.e-12;
@@ -1835,6 +1887,7 @@ void FitTest::testNonLinearMGH10_2() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*exp(b2/(x+b3))";
 	fitData.paramNames << "b1" << "b2" << "b3";
 	//fitData.eps = 1.e-12;
@@ -1895,6 +1948,7 @@ void FitTest::testNonLinearMGH10_3() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1*exp(b2/(x+b3))";
 	fitData.paramNames << "b1" << "b2" << "b3";
 	//fitData.eps = 1.e-12;
@@ -1953,6 +2007,7 @@ void FitTest::testNonLinearRat43() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1/pow(1. + exp(b2-b3*x), 1/b4)";
 	fitData.paramNames << "b1" << "b2" << "b3" << "b4";
 	fitData.eps = 1.e-9;
@@ -2015,6 +2070,7 @@ void FitTest::testNonLinearRat43_2() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1/pow(1. + exp(b2-b3*x), 1/b4)";
 	fitData.paramNames << "b1" << "b2" << "b3" << "b4";
 	fitData.eps = 1.e-10;
@@ -2077,6 +2133,7 @@ void FitTest::testNonLinearRat43_3() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "b1/pow(1. + exp(b2-b3*x), 1/b4)";
 	fitData.paramNames << "b1" << "b2" << "b3" << "b4";
 	//fitData.eps = 1.e-12;
@@ -2140,6 +2197,7 @@ void FitTest::testNonLinearMichaelis_Menten() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "Vm * x/(Km + x)";
 	fitData.paramNames << "Vm" << "Km";
 	fitData.eps = 1.e-12;
@@ -2211,6 +2269,7 @@ void FitTest::testNonLinearGP_lcdemo() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	// x > Tc : d + mh(x-Tc)
 	// x < Tc : d + ml(x-Tc) + b tanh(g(Tc-x))
 	fitData.model = "d + theta(x-Tc)*mh*(x-Tc) + theta(Tc-x)*(ml*(x-Tc)+b*tanh(g*(Tc-x)))";
@@ -2295,6 +2354,7 @@ void FitTest::testLinearGP_PY_noerror() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "a1 + a2 * x";
 	fitData.paramNames << "a1" << "a2";
 	fitData.eps = 1.e-9;
@@ -2363,6 +2423,7 @@ void FitTest::testLinearGP_PY_yerror_polynomial() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 1;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 //	fitData.eps = 1.e-12;
 	const int np = fitData.paramNames.size();
 	fitData.paramStartValues << 5. << -0.5;
@@ -2422,6 +2483,7 @@ void FitTest::testLinearGP_PY_yerror_custom() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "a1 + a2 * x";
 	fitData.paramNames << "a1" << "a2";
 	fitData.eps = 1.e-9;
@@ -2494,6 +2556,7 @@ void FitTest::testLinearGP_PY_xyerror_polynomial() {
 	fitData.modelType = nsl_fit_model_polynomial;
 	fitData.degree = 1;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.eps = 1.e-12;
 	const int np = fitData.paramNames.size();
 	fitData.paramStartValues << 5. << -0.5;
@@ -2561,6 +2624,7 @@ void FitTest::testLinearGP_PY_xyerror_custom() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "a1 + a2 * x";
 	fitData.paramNames << "a1" << "a2";
 	fitData.eps = 1.e-12;
@@ -2641,6 +2705,7 @@ void FitTest::testLinearGP_PY_xyerror_custom_instrumental_weight() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "a1 + a2 * x";
 	fitData.paramNames << "a1" << "a2";
 //	fitData.eps = 1.e-12;
@@ -2721,6 +2786,7 @@ void FitTest::testLinearGP_PY_xyerror_custom_inverse_weight() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "a1 + a2 * x";
 	fitData.paramNames << "a1" << "a2";
 //	fitData.eps = 1.e-12;
@@ -2789,6 +2855,7 @@ void FitTest::testNonLinear_yerror_zero_bug408535() {
 	XYFitCurve::FitData fitData = fitCurve.fitData();
 	fitData.modelCategory = nsl_fit_model_custom;
 	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
 	fitData.model = "A*exp(-B/x)";
 	fitData.paramNames << "A" << "B";
 //	fitData.eps = 1.e-12;
@@ -2833,4 +2900,290 @@ void FitTest::testNonLinear_yerror_zero_bug408535() {
 	FuzzyCompare(fitResult.rsquareAdj, 0.999724193304893, 1.e-9);
 }
 
+//##############################################################################
+//#########################  fit in the background  ############################
+//##############################################################################
+
+// same as testNonLinearMichaelis_Menten() with the fit running in the background
+void FitTest::testNonLinearMichaelis_Menten_async() {
+	// generic data
+	QVector<double> xData = {0.0,0.2,0.4,0.6,0.8,1.0,1.2,1.4,1.6,1.8,2.0};
+	QVector<double> yData = {0.0,0.6,0.65,0.7,0.75,0.75,0.8,0.9,0.85,0.95,0.9};
+
+	//data source columns
+	Column xDataColumn("x", AbstractColumn::ColumnMode::Numeric);
+	xDataColumn.replaceValues(0, xData);
+
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Numeric);
+	yDataColumn.replaceValues(0, yData);
+
+	XYFitCurve fitCurve("fit");
+	fitCurve.setXDataColumn(&xDataColumn);
+	fitCurve.setYDataColumn(&yDataColumn);
+
+	//prepare the fit
+	XYFitCurve::FitData fitData = fitCurve.fitData();
+	fitData.modelCategory = nsl_fit_model_custom;
+	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
+	fitData.model = "Vm * x/(Km + x)";
+	fitData.paramNames << "Vm" << "Km";
+	fitData.eps = 1.e-12;
+	const int np = fitData.paramNames.size();
+	fitData.paramStartValues << 1.0 << 1.0 ;
+	for (int i = 0; i < np; i++) {
+		fitData.paramLowerLimits << -std::numeric_limits<double>::max();
+		fitData.paramUpperLimits << std::numeric_limits<double>::max();
+	}
+	fitCurve.setFitData(fitData);
+
+	//perform the fit in the background
+	QSignalSpy spy(&fitCurve, &XYAnalysisCurve::recalculationFinished);
+	fitCurve.recalculateAsync();
+	QVERIFY(fitCurve.isRecalculating());
+	QVERIFY(spy.wait(10000));
+	QCOMPARE(fitCurve.isRecalculating(), false);
+	const XYFitCurve::FitResult& fitResult = fitCurve.fitResult();
+
+	//check the results
+	QCOMPARE(fitResult.available, true);
+	QCOMPARE(fitResult.valid, true);
+
+	QCOMPARE(np, 2);
+
+	FuzzyCompare(fitResult.paramValues.at(0), 0.94556434933256, 1.e-5);
+	FuzzyCompare(fitResult.errorValues.at(0), 0.0388803714011844, 3.e-4);
+	FuzzyCompare(fitResult.paramValues.at(1), 0.159400761666661, 3.e-5);
+	FuzzyCompare(fitResult.errorValues.at(1), 0.0388429738447119, 5.e-4);
+
+	FuzzyCompare(fitResult.rms, 0.00280486748877263, 1.e-9);
+	FuzzyCompare(fitResult.rsd, 0.0529609996957444, 1.e-9);
+	FuzzyCompare(fitResult.sse, 0.0252438073989537, 1.e-9);
+
+	//the fit curve was evaluated
+	QCOMPARE(fitCurve.xColumn()->rowCount(), (int)fitData.evaluatedPoints);
+}
+
+//##############################################################################
+//#############################  batch fit  ####################################
+//##############################################################################
+
+void FitTest::testBatchFit() {
+	// three segments of one measurement with different exponential decays
+	const QVector<double> amplitudes{10., 5., 2.};
+	const QVector<double> rates{0.5, 1.5, 3.};
+	const int N = 50;
+	QVector<double> xData, yData;
+	for (int j = 0; j < amplitudes.size(); j++)
+		for (int i = 0; i < N; i++) {
+			const double x = 0.1*i;
+			xData.append(x);
+			yData.append(amplitudes.at(j)*exp(-rates.at(j)*x));
+		}
+
+	//data source columns
+	Column xDataColumn("x", AbstractColumn::ColumnMode::Numeric);
+	xDataColumn.replaceValues(0, xData);
+
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Numeric);
+	yDataColumn.replaceValues(0, yData);
+
+	QVector<XYFitCurve::BatchFitData> dataSets;
+	for (int j = 0; j < amplitudes.size(); j++) {
+		XYFitCurve::BatchFitData dataSet;
+		dataSet.xColumn = &xDataColumn;
+		dataSet.yColumn = &yDataColumn;
+		dataSet.startRow = j*N;
+		dataSet.endRow = (j + 1)*N - 1;
+		dataSets << dataSet;
+	}
+	// data set without data
+	dataSets << XYFitCurve::BatchFitData();
+
+	//prepare the fit
+	XYFitCurve::FitData fitData;
+	fitData.modelCategory = nsl_fit_model_custom;
+	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
+	fitData.model = "a*exp(-b*x)";
+	fitData.paramNames << "a" << "b";
+	const int np = fitData.paramNames.size();
+	fitData.paramStartValues << 1. << 1.;
+	for (int i = 0; i < np; i++) {
+		fitData.paramLowerLimits << -std::numeric_limits<double>::max();
+		fitData.paramUpperLimits << std::numeric_limits<double>::max();
+	}
+
+	//perform the fits
+	const QVector<XYFitCurve::FitResult> fitResults = XYFitCurve::batchFit(fitData, dataSets);
+
+	//check the results
+	QCOMPARE(fitResults.size(), 4);
+	for (int j = 0; j < amplitudes.size(); j++) {
+		const auto& fitResult = fitResults.at(j);
+		QCOMPARE(fitResult.available, true);
+		QCOMPARE(fitResult.valid, true);
+		FuzzyCompare(fitResult.paramValues.at(0), amplitudes.at(j), 1.e-6);
+		FuzzyCompare(fitResult.paramValues.at(1), rates.at(j), 1.e-6);
+	}
+	QCOMPARE(fitResults.at(3).available, true);
+	QCOMPARE(fitResults.at(3).valid, false);
+
+	//write the results
+	Spreadsheet spreadsheet("results", true);
+	XYFitCurve::batchFitResults(fitData, dataSets, fitResults, &spreadsheet);
+	QCOMPARE(spreadsheet.rowCount(), 4);
+	QCOMPARE(spreadsheet.columnCount(), 1 + 2*np + 5 + 2);
+	QCOMPARE(spreadsheet.column(1)->name(), QLatin1String("a"));
+	QCOMPARE(spreadsheet.column(3)->name(), QLatin1String("b"));
+	for (int j = 0; j < amplitudes.size(); j++) {
+		FuzzyCompare(spreadsheet.column(1)->valueAt(j), amplitudes.at(j), 1.e-6);
+		FuzzyCompare(spreadsheet.column(3)->valueAt(j), rates.at(j), 1.e-6);
+	}
+	QVERIFY(std::isnan(spreadsheet.column(1)->valueAt(3)));
+}
+
+// batch fits with and without data errors give the same results as fitting each data set with a fit curve
+void FitTest::testBatchFit_weighted() {
+	// Pearson's data and York's weights, see testLinearGP_PY_xyerror_custom()
+	QVector<double> xData = {0.0,0.9,1.8,2.6,3.3,4.4,5.2,6.1,6.5,7.4};
+	QVector<double> yData = {5.9,5.4,4.4,4.6,3.5,3.7,2.8,2.8,2.4,1.5};
+	QVector<double> xError = {1000.,1000.,500.,800.,200.,80.,60.,20.,1.8,1.0};
+	QVector<double> yError = {1.0,1.8,4.,8.,20.,20.,70.,70.,100.,500.};
+
+	//data source columns
+	Column xDataColumn("x", AbstractColumn::ColumnMode::Numeric);
+	xDataColumn.replaceValues(0, xData);
+
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Numeric);
+	yDataColumn.replaceValues(0, yData);
+
+	Column xErrorColumn("xerr", AbstractColumn::ColumnMode::Numeric);
+	xErrorColumn.replaceValues(0, xError);
+
+	Column yErrorColumn("yerr", AbstractColumn::ColumnMode::Numeric);
+	yErrorColumn.replaceValues(0, yError);
+
+	// x-y, x-y-dy and x-y-dx-dy
+	QVector<XYFitCurve::BatchFitData> dataSets(3);
+	for (auto& dataSet : dataSets) {
+		dataSet.xColumn = &xDataColumn;
+		dataSet.yColumn = &yDataColumn;
+	}
+	dataSets[1].yErrorColumn = &yErrorColumn;
+	dataSets[2].xErrorColumn = &xErrorColumn;
+	dataSets[2].yErrorColumn = &yErrorColumn;
+
+	//prepare the fit
+	XYFitCurve::FitData fitData;
+	fitData.modelCategory = nsl_fit_model_custom;
+	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
+	fitData.model = "a + b*x";
+	fitData.paramNames << "a" << "b";
+	fitData.eps = 1.e-12;
+	const int np = fitData.paramNames.size();
+	fitData.paramStartValues << 5. << -0.5;
+	for (int i = 0; i < np; i++) {
+		fitData.paramLowerLimits << -std::numeric_limits<double>::max();
+		fitData.paramUpperLimits << std::numeric_limits<double>::max();
+	}
+	fitData.xWeightsType = nsl_fit_weight_direct;
+	fitData.yWeightsType = nsl_fit_weight_direct;
+	fitData.useResults = false;	// every fit of the fit curves below starts with the same values
+
+	//perform the fits
+	const QVector<XYFitCurve::FitResult> fitResults = XYFitCurve::batchFit(fitData, dataSets);
+	QCOMPARE(fitResults.size(), dataSets.size());
+
+	//compare with the fits of the single data sets
+	for (int j = 0; j < dataSets.size(); j++) {
+		XYFitCurve fitCurve("fit");
+		fitCurve.setXDataColumn(dataSets.at(j).xColumn);
+		fitCurve.setYDataColumn(dataSets.at(j).yColumn);
+		fitCurve.setXErrorColumn(dataSets.at(j).xErrorColumn);
+		fitCurve.setYErrorColumn(dataSets.at(j).yErrorColumn);
+		fitCurve.setFitData(fitData);
+		fitCurve.recalculate();
+		const XYFitCurve::FitResult& fitResult = fitCurve.fitResult();
+
+		const auto& batchResult = fitResults.at(j);
+		QCOMPARE(batchResult.valid, true);
+		QCOMPARE(batchResult.valid, fitResult.valid);
+		QCOMPARE(batchResult.iterations, fitResult.iterations);
+		for (int i = 0; i < np; i++) {
+			QCOMPARE(batchResult.paramValues.at(i), fitResult.paramValues.at(i));
+			QCOMPARE(batchResult.errorValues.at(i), fitResult.errorValues.at(i));
+		}
+		QCOMPARE(batchResult.sse, fitResult.sse);
+		QCOMPARE(batchResult.rms, fitResult.rms);
+	}
+
+	//the data errors were used
+	QVERIFY(fitResults.at(0).paramValues.at(0) != fitResults.at(1).paramValues.at(0));
+	QVERIFY(fitResults.at(1).paramValues.at(0) != fitResults.at(2).paramValues.at(0));
+
+	//the data errors are ignored if not wanted
+	fitData.useDataErrors = false;
+	const QVector<XYFitCurve::FitResult> unweightedResults = XYFitCurve::batchFit(fitData, dataSets);
+	for (const auto& result : unweightedResults)
+		QCOMPARE(result.paramValues.at(0), fitResults.at(0).paramValues.at(0));
+}
+
+//##############################################################################
+//#########################  performance  ######################################
+//##############################################################################
+
+void FitTest::testPerformance_customModel() {
+	// data: Gaussian peak on a constant background
+	const int N = 100000;
+	QVector<double> xData, yData;
+	for (int i = 0; i < N; i++) {
+		const double x = -5. + 10.*i/N;
+		xData.append(x);
+		yData.append(2.5*exp(-(x - 0.5)*(x - 0.5)/(2*1.2*1.2)) + 0.3 + 0.01*sin(50.*x));
+	}
+
+	//data source columns
+	Column xDataColumn("x", AbstractColumn::ColumnMode::Numeric);
+	xDataColumn.replaceValues(0, xData);
+
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Numeric);
+	yDataColumn.replaceValues(0, yData);
+
+	XYFitCurve fitCurve("fit");
+	fitCurve.setXDataColumn(&xDataColumn);
+	fitCurve.setYDataColumn(&yDataColumn);
+
+	//prepare the fit
+	XYFitCurve::FitData fitData = fitCurve.fitData();
+	fitData.modelCategory = nsl_fit_model_custom;
+	XYFitCurve::initFitData(fitData);
+	fitData.algorithm = fitAlgorithm();
+	fitData.model = "a*exp(-(x-mu)^2/(2*s^2)) + c";
+	fitData.paramNames << "a" << "mu" << "s" << "c";
+	const int np = fitData.paramNames.size();
+	fitData.paramStartValues << 2. << 0. << 1. << 0.;
+	for (int i = 0; i < np; i++) {
+		fitData.paramLowerLimits << -std::numeric_limits<double>::max();
+		fitData.paramUpperLimits << std::numeric_limits<double>::max();
+	}
+
+	//perform the fit
+	QBENCHMARK {
+		// triggers recalculate()
+		fitCurve.setFitData(fitData);
+	}
+	const XYFitCurve::FitResult& fitResult = fitCurve.fitResult();
+
+	//check the results
+	QCOMPARE(fitResult.available, true);
+	QCOMPARE(fitResult.valid, true);
+
+	FuzzyCompare(fitResult.paramValues.at(0), 2.5, 1.e-3);
+	FuzzyCompare(fitResult.paramValues.at(1), 0.5, 1.e-3);
+	FuzzyCompare(fitResult.paramValues.at(2), 1.2, 1.e-3);
+	FuzzyCompare(fitResult.paramValues.at(3), 0.3, 1.e-2);
+}
+
 QTEST_MAIN(FitTest)
@@ -34,6 +34,8 @@ class FitTest : public AnalysisTest {
 	Q_OBJECT
 
 private slots:
+	void initTestCase_data();
+
 	//linear regression (see NIST/linear data)
 	void testLinearNorris();
 	void testLinearPontius();
@@ -88,5 +90,12 @@ private slots:
 	void testLinearGP_PY_xyerror_custom_inverse_weight();
 
 	void testNonLinear_yerror_zero_bug408535();
+
+	void testNonLinearMichaelis_Menten_async();
+
+	void testBatchFit();
+	void testBatchFit_weighted();
+
+	void testPerformance_customModel();
 };
 #endif
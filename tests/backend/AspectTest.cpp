@@ -0,0 +1,257 @@
+/***************************************************************************
+File                 : AspectTest.cpp
+Project              : LabPlot
+Description          : Tests for the aspect tree of the project
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "AspectTest.h"
+#include "backend/core/Folder.h"
+#include "backend/core/Project.h"
+#include "backend/core/column/Column.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+#include <QUndoStack>
+
+void AspectTest::initTestCase() {
+	qRegisterMetaType<const AbstractAspect*>("const AbstractAspect*");
+	qRegisterMetaType<const AbstractColumn*>("const AbstractColumn*");
+}
+
+/*!
+ * compares Project::aspectByPath() for the paths of all aspects in the project with a scan of the project tree
+ * and checks that the paths in \p stalePaths are not found anymore
+ */
+static void checkAspectByPath(const Project& project, const QStringList& stalePaths = QStringList()) {
+	const auto& all = project.children<AbstractAspect>(AbstractAspect::ChildIndexFlag::Recursive | AbstractAspect::ChildIndexFlag::IncludeHidden);
+	for (auto* aspect : all) {
+		const QString& path = aspect->path();
+
+		//the first visible aspect with this path, the hidden aspects and their children are not found
+		AbstractAspect* expected = nullptr;
+		for (auto* candidate : project.children<AbstractAspect>(AbstractAspect::ChildIndexFlag::Recursive)) {
+			if (candidate->path() == path) {
+				expected = candidate;
+				break;
+			}
+		}
+
+		QCOMPARE(project.aspectByPath(path), expected);
+	}
+
+	for (const auto& path : stalePaths)
+		QCOMPARE(project.aspectByPath(path), static_cast<AbstractAspect*>(nullptr));
+}
+
+void AspectTest::testAspectByPath() {
+	Project project;
+	auto* f1 = new Folder("f1");
+	auto* f2 = new Folder("f2");
+	project.addChild(f1);
+	project.addChild(f2);
+
+	auto* spreadsheet = new Spreadsheet("s", true);
+	f1->addChild(spreadsheet);
+	auto* x = new Column("x");
+	auto* y = new Column("y");
+	spreadsheet->addChild(x);
+	spreadsheet->addChild(y);
+
+	const QString root = project.path();
+	QCOMPARE(project.aspectByPath(root + "/f1/s/y"), y);
+	checkAspectByPath(project, {root + "/f2/s", root + "/f1/x"});
+
+	//rename the spreadsheet and the folder containing it
+	spreadsheet->setName("t");
+	QCOMPARE(project.aspectByPath(root + "/f1/t/x"), x);
+	checkAspectByPath(project, {root + "/f1/s", root + "/f1/s/x"});
+
+	f1->setName("g1");
+	QCOMPARE(project.aspectByPath(root + "/g1/t/x"), x);
+	checkAspectByPath(project, {root + "/f1", root + "/f1/t", root + "/f1/t/x"});
+
+	project.undoStack()->undo();
+	QCOMPARE(project.aspectByPath(root + "/f1/t/x"), x);
+	checkAspectByPath(project, {root + "/g1", root + "/g1/t/x"});
+
+	//move the spreadsheet to the other folder
+	spreadsheet->reparent(f2);
+	QCOMPARE(project.aspectByPath(root + "/f2/t/y"), y);
+	checkAspectByPath(project, {root + "/f1/t", root + "/f1/t/y"});
+
+	project.undoStack()->undo();
+	QCOMPARE(project.aspectByPath(root + "/f1/t/y"), y);
+	checkAspectByPath(project, {root + "/f2/t", root + "/f2/t/y"});
+
+	project.undoStack()->redo();
+	QCOMPARE(project.aspectByPath(root + "/f2/t/y"), y);
+	checkAspectByPath(project, {root + "/f1/t", root + "/f1/t/y"});
+
+	//hide and show a column
+	x->setHidden(true);
+	QCOMPARE(project.aspectByPath(root + "/f2/t/x"), static_cast<AbstractAspect*>(nullptr));
+	checkAspectByPath(project, {root + "/f2/t/x"});
+
+	x->setHidden(false);
+	QCOMPARE(project.aspectByPath(root + "/f2/t/x"), x);
+	checkAspectByPath(project);
+
+	//delete a column, restore it and delete it again
+	y->remove();
+	checkAspectByPath(project, {root + "/f2/t/y"});
+
+	project.undoStack()->undo();
+	QCOMPARE(project.aspectByPath(root + "/f2/t/y"), y);
+	checkAspectByPath(project);
+
+	project.undoStack()->redo();
+	checkAspectByPath(project, {root + "/f2/t/y"});
+
+	//delete the folder with the spreadsheet
+	f2->remove();
+	checkAspectByPath(project, {root + "/f2", root + "/f2/t", root + "/f2/t/x"});
+	QCOMPARE(project.aspectByPath(root + "/f1"), f1);
+}
+
+/*!
+ * compares children<T>(), child<T>(), childCount<T>() and indexOfChild<T>() of \p parent,
+ * that use the children cached per type, with a scan of all children
+ */
+template <class T> static void checkChildren(const AbstractAspect* parent) {
+	using Flag = AbstractAspect::ChildIndexFlag;
+	const QVector<AbstractAspect::ChildIndexFlags> flagsList{{}, Flag::IncludeHidden, Flag::Recursive, Flag::Recursive | Flag::IncludeHidden};
+	for (const auto flags : flagsList) {
+		QVector<T*> expected;
+		for (auto* child : parent->children(AspectType::AbstractAspect, flags)) {
+			T* typed = dynamic_cast<T*>(child);
+			if (typed)
+				expected << typed;
+		}
+
+		QCOMPARE(parent->children<T>(flags), expected);
+		if (flags & Flag::Recursive)
+			continue;
+
+		QCOMPARE(parent->childCount<T>(flags), expected.size());
+		for (int i = 0; i < expected.size(); ++i) {
+			QCOMPARE(parent->child<T>(i, flags), expected.at(i));
+			QCOMPARE(parent->indexOfChild<T>(expected.at(i), flags), i);
+		}
+		QCOMPARE(parent->child<T>(expected.size(), flags), static_cast<T*>(nullptr));
+	}
+}
+
+static void checkChildren(const Project& project) {
+	checkChildren<AbstractAspect>(&project);
+	checkChildren<Folder>(&project);
+	checkChildren<Spreadsheet>(&project);
+	checkChildren<AbstractColumn>(&project);
+	checkChildren<Column>(&project);
+	for (auto* spreadsheet : project.children<Spreadsheet>(AbstractAspect::ChildIndexFlag::Recursive | AbstractAspect::ChildIndexFlag::IncludeHidden)) {
+		checkChildren<AbstractAspect>(spreadsheet);
+		checkChildren<Column>(spreadsheet);
+	}
+}
+
+void AspectTest::testChildren() {
+	Project project;
+	auto* f = new Folder("f");
+	auto* s1 = new Spreadsheet("s1", true);
+	auto* s2 = new Spreadsheet("s2", true);
+	project.addChild(s1);
+	project.addChild(f);
+	f->addChild(s2);
+	auto* x = new Column("x");
+	auto* y = new Column("y");
+	s1->addChild(x);
+	s1->addChild(y);
+	s2->addChild(new Column("u"));
+	checkChildren(project);
+
+	//append
+	auto* s3 = new Spreadsheet("s3", true);
+	project.addChild(s3);
+	s3->addChild(new Column("v"));
+	checkChildren(project);
+
+	//insert in the middle
+	auto* g = new Folder("g");
+	project.insertChildBefore(g, f);
+	checkChildren(project);
+
+	auto* z = new Column("z");
+	s1->insertChildBefore(z, y);
+	QCOMPARE(s1->children<Column>(), QVector<Column*>({x, z, y}));
+	checkChildren(project);
+
+	project.undoStack()->undo();
+	QCOMPARE(s1->children<Column>(), QVector<Column*>({x, y}));
+	checkChildren(project);
+
+	project.undoStack()->redo();
+	QCOMPARE(s1->children<Column>(), QVector<Column*>({x, z, y}));
+	checkChildren(project);
+
+	//move between the parents
+	s3->reparent(g);
+	checkChildren(project);
+
+	project.undoStack()->undo();
+	checkChildren(project);
+
+	project.undoStack()->redo();
+	checkChildren(project);
+
+	//remove
+	x->remove();
+	QCOMPARE(s1->children<Column>(), QVector<Column*>({z, y}));
+	checkChildren(project);
+
+	project.undoStack()->undo();
+	QCOMPARE(s1->children<Column>(), QVector<Column*>({x, z, y}));
+	checkChildren(project);
+
+	project.undoStack()->redo();
+	checkChildren(project);
+
+	//hide and show
+	z->setHidden(true);
+	QCOMPARE(s1->children<Column>(), QVector<Column*>({y}));
+	checkChildren(project);
+
+	f->setHidden(true);
+	checkChildren(project);
+
+	f->setHidden(false);
+	z->setHidden(false);
+	checkChildren(project);
+
+	s1->remove();
+	checkChildren(project);
+
+	project.undoStack()->undo();
+	checkChildren(project);
+}
+
+QTEST_MAIN(AspectTest)
@@ -0,0 +1,144 @@
+/***************************************************************************
+File                 : ParallelGzipDeviceTest.cpp
+Project              : LabPlot
+Description          : Tests for the parallel gzip compression
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "ParallelGzipDeviceTest.h"
+#include "backend/lib/ParallelGzipDevice.h"
+
+#include <KCompressionDevice>
+
+#include <zlib.h>
+
+#include <cstring>
+
+/*!
+ * \p size bytes of text-like data with repetitions, as in project files, and varying parts
+ */
+static QByteArray testData(int size) {
+	QByteArray data(size, Qt::Uninitialized);
+	quint32 state = 12345;
+	for (int i = 0; i < size; ++i) {
+		state = state * 1103515245 + 12345;
+		data[i] = (i % 64 < 32) ? static_cast<char>('a' + i % 26) : static_cast<char>(state >> 24);
+	}
+	return data;
+}
+
+/*!
+ * writes \p data with ParallelGzipDevice in pieces of \p pieceSize bytes
+ * and checks the file with KCompressionDevice and zlib
+ */
+static void checkCompression(const QByteArray& data, int pieceSize) {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString& fileName = dir.path() + QLatin1String("/test.gz");
+
+	ParallelGzipDevice device(fileName);
+	QVERIFY(device.open(QIODevice::WriteOnly));
+	for (int pos = 0; pos < data.size(); pos += pieceSize) {
+		const int size = qMin(pieceSize, data.size() - pos);
+		QCOMPARE(device.write(data.constData() + pos, size), static_cast<qint64>(size));
+	}
+	device.close();
+
+	QFile file(fileName);
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	const QByteArray compressed = file.readAll();
+	file.close();
+
+	//gzip header and trailer with CRC-32 and size of the uncompressed data
+	QVERIFY(compressed.size() >= 18);
+	QCOMPARE(static_cast<quint8>(compressed.at(0)), static_cast<quint8>(0x1f));
+	QCOMPARE(static_cast<quint8>(compressed.at(1)), static_cast<quint8>(0x8b));
+	const uchar* trailer = reinterpret_cast<const uchar*>(compressed.constData()) + compressed.size() - 8;
+	const quint32 crc = crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(data.constData()), static_cast<uInt>(data.size()));
+	QCOMPARE(qFromLittleEndian<quint32>(trailer), crc);
+	QCOMPARE(qFromLittleEndian<quint32>(trailer + 4), static_cast<quint32>(data.size()));
+
+	//decompression with KCompressionDevice as used when opening projects
+	KCompressionDevice reader(fileName, KCompressionDevice::GZip);
+	QVERIFY(reader.open(QIODevice::ReadOnly));
+	QVERIFY(reader.readAll() == data);
+	reader.close();
+
+	//decompression with zlib, also verifies the CRC-32 and the size in the trailer
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	QCOMPARE(inflateInit2(&stream, 16 + MAX_WBITS), Z_OK);
+	QByteArray uncompressed(data.size() + 1, Qt::Uninitialized);
+	stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.constData()));
+	stream.avail_in = static_cast<uInt>(compressed.size());
+	stream.next_out = reinterpret_cast<Bytef*>(uncompressed.data());
+	stream.avail_out = static_cast<uInt>(uncompressed.size());
+	const int rc = inflate(&stream, Z_FINISH);
+	const uLong size = stream.total_out;
+	const uInt unused = stream.avail_in;
+	inflateEnd(&stream);
+	QCOMPARE(rc, Z_STREAM_END);
+	QCOMPARE(unused, 0u);
+	QCOMPARE(static_cast<int>(size), data.size());
+	uncompressed.resize(data.size());
+	QVERIFY(uncompressed == data);
+}
+
+void ParallelGzipDeviceTest::testEmpty() {
+	checkCompression(QByteArray(), 1);
+}
+
+void ParallelGzipDeviceTest::testSmallerThanChunk() {
+	checkCompression(testData(1000), 1000);
+	checkCompression(testData(ParallelGzipDevice::CHUNK_SIZE - 1), 4096);
+}
+
+void ParallelGzipDeviceTest::testOneChunk() {
+	checkCompression(testData(ParallelGzipDevice::CHUNK_SIZE), ParallelGzipDevice::CHUNK_SIZE);
+	checkCompression(testData(ParallelGzipDevice::CHUNK_SIZE), 1000);
+}
+
+void ParallelGzipDeviceTest::testManyChunks() {
+	//more chunks than blocks in flight, written in pieces crossing the chunk boundaries
+	const int chunks = 4 * qMax(QThread::idealThreadCount(), 1) + 3;
+	checkCompression(testData(chunks * ParallelGzipDevice::CHUNK_SIZE + 123), 100000);
+	checkCompression(testData(3 * ParallelGzipDevice::CHUNK_SIZE), 3 * ParallelGzipDevice::CHUNK_SIZE);
+}
+
+void ParallelGzipDeviceTest::testWriteFailure() {
+	//every write to /dev/full fails with "No space left on device"
+	if (!QFile::exists(QLatin1String("/dev/full")))
+		QSKIP("/dev/full not available");
+
+	const QByteArray& data = testData(3 * ParallelGzipDevice::CHUNK_SIZE);
+	ParallelGzipDevice device(QLatin1String("/dev/full"));
+	QVERIFY(device.open(QIODevice::WriteOnly));
+	QVERIFY(!device.failed());
+	device.write(data);
+	device.close();
+	QVERIFY(device.failed());
+	QVERIFY(!device.errorString().isEmpty());
+}
+
+QTEST_MAIN(ParallelGzipDeviceTest)
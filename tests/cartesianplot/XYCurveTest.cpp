@@ -0,0 +1,158 @@
+/***************************************************************************
+File                 : XYCurveTest.cpp
+Project              : LabPlot
+Description          : Tests for XYCurve
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "XYCurveTest.h"
+#include "backend/core/Project.h"
+#include "backend/core/column/Column.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+#include "backend/worksheet/Worksheet.h"
+#include "backend/worksheet/plots/cartesian/CartesianCoordinateSystem.h"
+#include "backend/worksheet/plots/cartesian/CartesianPlot.h"
+#include "backend/worksheet/plots/cartesian/XYCurve.h"
+
+extern "C" {
+#include <gsl/gsl_math.h>
+}
+
+void XYCurveTest::initTestCase() {
+	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
+	//TODO: redesign/remove this
+	qRegisterMetaType<const AbstractAspect*>("const AbstractAspect*");
+	qRegisterMetaType<const AbstractColumn*>("const AbstractColumn*");
+}
+
+// distance of \c p to the line segment from \c p1 to \c p2
+static double distanceToSegment(QPointF p, QPointF p1, QPointF p2) {
+	const QPointF d = p2 - p1;
+	const double length2 = QPointF::dotProduct(d, d);
+	double t = (length2 > 0.) ? QPointF::dotProduct(p - p1, d)/length2 : 0.;
+	t = qBound(0., t, 1.);
+	const QPointF q = p1 + t*d;
+	return gsl_hypot(p.x() - q.x(), p.y() - q.y());
+}
+
+// non-monotonic x-data: a circle followed by a few long jumps through the plot
+static void createCurve(Project& project, XYCurve*& curve, CartesianPlot*& plot, QVector<QPointF>& points) {
+	auto* sheet = new Spreadsheet(QLatin1String("data"));
+	project.addChild(sheet);
+	auto* worksheet = new Worksheet(QLatin1String("worksheet"));
+	project.addChild(worksheet);
+	plot = new CartesianPlot(QLatin1String("plot"));
+	plot->setType(CartesianPlot::Type::TwoAxes);
+	worksheet->addChild(plot);
+
+	const int n = 400;
+	QVector<double> x, y;
+	for (int i = 0; i < n; ++i) {
+		x << cos(2.*M_PI*i/n);
+		y << sin(2.*M_PI*i/n);
+	}
+	x << -1. << 1. << 0. << 0.;
+	y << -1. << 1. << 1. << -1.;
+
+	sheet->setRowCount(x.size());
+	sheet->column(0)->replaceValues(0, x);
+	sheet->column(1)->replaceValues(0, y);
+
+	curve = new XYCurve(QLatin1String("curve"));
+	plot->addChild(curve);
+	curve->setXColumn(sheet->column(0));
+	curve->setYColumn(sheet->column(1));
+	plot->scaleAuto();
+
+	points.clear();
+	for (int i = 0; i < x.size(); ++i)
+		points << plot->coordinateSystem()->mapLogicalToScene(QPointF(x.at(i), y.at(i)));
+}
+
+/*!
+ * compares the hit-test of a curve with non-monotonic x-data with the distances to all lines,
+ * positions close to the lines have to activate the curve, positions far away not
+ */
+void XYCurveTest::testActivateCurveLines() {
+	Project project;
+	XYCurve* curve{nullptr};
+	CartesianPlot* plot{nullptr};
+	QVector<QPointF> points;
+	createCurve(project, curve, plot, points);
+	QCOMPARE(curve->lineType(), XYCurve::LineType::Line);
+
+	const double maxDist = 10.;
+	const QRectF rect = plot->dataRect();
+	int hits = 0, misses = 0;
+	for (int i = 0; i <= 50; ++i) {
+		for (int j = 0; j <= 50; ++j) {
+			const QPointF pos(rect.left() + i*rect.width()/50, rect.top() + j*rect.height()/50);
+			double dist = INFINITY;
+			for (int k = 1; k < points.size(); ++k)
+				dist = qMin(dist, distanceToSegment(pos, points.at(k - 1), points.at(k)));
+
+			// skip the positions close to maxDist, the lines might be simplified slightly for drawing
+			if (dist < maxDist/2) {
+				QVERIFY(curve->activateCurve(pos, maxDist));
+				++hits;
+			} else if (dist > 2*maxDist) {
+				QVERIFY(!curve->activateCurve(pos, maxDist));
+				++misses;
+			}
+		}
+	}
+	QVERIFY(hits > 0);
+	QVERIFY(misses > 0);
+}
+
+/*!
+ * compares the hit-test of a curve drawn with symbols only with the distances to all points
+ */
+void XYCurveTest::testActivateCurvePoints() {
+	Project project;
+	XYCurve* curve{nullptr};
+	CartesianPlot* plot{nullptr};
+	QVector<QPointF> points;
+	createCurve(project, curve, plot, points);
+	curve->setLineType(XYCurve::LineType::NoLine);
+	curve->setSymbolsStyle(Symbol::Style::Circle);
+
+	const double maxDist = 5.;
+	for (const auto& point : points)	// including the last point
+		QVERIFY(curve->activateCurve(point, maxDist));
+
+	const QRectF rect = plot->dataRect();
+	for (int i = 0; i <= 50; ++i) {
+		for (int j = 0; j <= 50; ++j) {
+			const QPointF pos(rect.left() + i*rect.width()/50, rect.top() + j*rect.height()/50);
+			double dist = INFINITY;
+			for (const auto& point : points)
+				dist = qMin(dist, gsl_hypot(pos.x() - point.x(), pos.y() - point.y()));
+			if (dist > 2*maxDist)
+				QVERIFY(!curve->activateCurve(pos, maxDist));
+		}
+	}
+}
+
+QTEST_MAIN(XYCurveTest)
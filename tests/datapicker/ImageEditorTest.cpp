@@ -0,0 +1,129 @@
+/***************************************************************************
+File                 : ImageEditorTest.cpp
+Project              : LabPlot
+Description          : Tests for the image processing of the data picker
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "ImageEditorTest.h"
+#include "backend/datapicker/ImageEditor.h"
+
+#include <QImage>
+
+Q_DECLARE_METATYPE(DatapickerImage::EditorSettings)
+
+/*!
+ * image with all hues, saturations and values and some pseudo random colors
+ */
+static QImage testImage(QImage::Format format) {
+	const int width = 360, height = 64;
+	QImage image(width, height, QImage::Format_ARGB32);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			if (y < height/2)
+				image.setPixel(x, y, QColor::fromHsv(x, 255 - 8*y, 255 - (x % 16)*16).rgb());
+			else {
+				const uint random = (x + 1) * 2654435761u ^ (y + 1) * 40503u;
+				image.setPixel(x, y, qRgb(random & 0xff, (random >> 8) & 0xff, (random >> 16) & 0xff));
+			}
+		}
+	}
+	// gray pixels without hue
+	for (int x = 0; x < 256; ++x)
+		image.setPixel(x, 0, qRgb(x, x, x));
+
+	return (format == QImage::Format_ARGB32) ? image : image.convertToFormat(format);
+}
+
+void ImageEditorTest::testDiscretize_data() {
+	QTest::addColumn<int>("format");
+	QTest::addColumn<DatapickerImage::EditorSettings>("settings");
+
+	const DatapickerImage::EditorSettings defaultSettings;
+	QTest::newRow("default") << static_cast<int>(QImage::Format_ARGB32) << defaultSettings;
+	QTest::newRow("default, 24 bit image") << static_cast<int>(QImage::Format_RGB888) << defaultSettings;
+
+	// the ranges wrap around if the low threshold is larger than the high threshold
+	DatapickerImage::EditorSettings settings;
+	settings.hueThresholdLow = 300;
+	settings.hueThresholdHigh = 60;
+	settings.intensityThresholdLow = 0;
+	settings.intensityThresholdHigh = 50;
+	settings.foregroundThresholdLow = 10;
+	settings.foregroundThresholdHigh = 100;
+	settings.saturationThresholdLow = 0;
+	settings.saturationThresholdHigh = 100;
+	settings.valueThresholdLow = 0;
+	settings.valueThresholdHigh = 100;
+	QTest::newRow("wrapped hue") << static_cast<int>(QImage::Format_RGB32) << settings;
+
+	settings = DatapickerImage::EditorSettings();
+	settings.saturationThresholdLow = 80;
+	settings.saturationThresholdHigh = 20;
+	settings.valueThresholdLow = 0;
+	settings.valueThresholdHigh = 100;
+	QTest::newRow("wrapped saturation") << static_cast<int>(QImage::Format_ARGB32) << settings;
+}
+
+/*!
+ * compares the discretized image with the thresholds applied to the single pixels
+ */
+void ImageEditorTest::testDiscretize() {
+	QFETCH(int, format);
+	QFETCH(DatapickerImage::EditorSettings, settings);
+
+	QImage originalImage = testImage(static_cast<QImage::Format>(format));
+	QImage plotImage(originalImage.size(), QImage::Format_RGB32);
+	const QColor background(Qt::white);
+	ImageEditor::discretize(&plotImage, &originalImage, settings, background);
+
+	const QVector<DatapickerImage::ColorAttributes> attributes{DatapickerImage::ColorAttributes::Intensity,
+		DatapickerImage::ColorAttributes::Foreground, DatapickerImage::ColorAttributes::Hue,
+		DatapickerImage::ColorAttributes::Saturation, DatapickerImage::ColorAttributes::Value};
+
+	int on = 0;
+	for (int y = 0; y < originalImage.height(); ++y) {
+		for (int x = 0; x < originalImage.width(); ++x) {
+			bool expected = true;
+			for (auto attribute : attributes) {
+				const int value = ImageEditor::discretizeValueForeground(x, y, attribute, background, &originalImage);
+				if (!ImageEditor::pixelIsOn(value, attribute, settings)) {
+					expected = false;
+					break;
+				}
+			}
+
+			if (ImageEditor::processedPixelIsOn(plotImage, x, y) != expected)
+				QFAIL(qPrintable(QString("pixel (%1, %2) with the color %3").arg(x).arg(y).arg(QColor(originalImage.pixel(x, y)).name())));
+			if (expected)
+				++on;
+		}
+	}
+
+	// both cases occur
+	QVERIFY(on > 0);
+	QVERIFY(on < originalImage.width() * originalImage.height());
+}
+
+QTEST_MAIN(ImageEditorTest)
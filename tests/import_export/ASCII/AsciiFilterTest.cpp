@@ -29,6 +29,8 @@
 #include "backend/datasources/filters/AsciiFilter.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
+#include <QTemporaryDir>
+
 void AsciiFilterTest::initTestCase() {
 	const QString currentDir = __FILE__;
 	m_dataDir = currentDir.left(currentDir.lastIndexOf(QDir::separator())) + QDir::separator() + QLatin1String("data") + QDir::separator();
@@ -973,4 +975,105 @@ void AsciiFilterTest::testDateTime00() {
 	QCOMPARE(spreadsheet.column(1)->valueAt(1), 14.8026);
 }
 
+//##############################################################################
+//#################################  export  ###################################
+//##############################################################################
+/*!
+ * export numeric, integer and text columns and read the file back, the numeric values have to be the same
+ */
+void AsciiFilterTest::testExport00() {
+	Spreadsheet source("source", false);
+	source.setColumnCount(3);
+	source.setRowCount(3);
+	source.column(0)->setName("x");
+	source.column(1)->setName("n");
+	source.column(2)->setName("text");
+	source.column(1)->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	source.column(2)->setColumnMode(AbstractColumn::ColumnMode::Text);
+	source.column(0)->setValueAt(0, 0.1 + 0.2);
+	source.column(0)->setValueAt(1, 1./3.);
+	source.column(0)->setValueAt(2, -1.e-300);
+	source.column(1)->setIntegerAt(0, 1);
+	source.column(1)->setIntegerAt(1, -2);
+	source.column(1)->setIntegerAt(2, 3);
+	source.column(2)->setTextAt(0, "a");
+	source.column(2)->setTextAt(1, "b c");
+	source.column(2)->setTextAt(2, "d");
+
+	QTemporaryDir dir;
+	const QString fileName = dir.path() + QLatin1String("/export.txt");
+	AsciiFilter filter;
+	filter.setSeparatingCharacter(",");
+	filter.setHeaderEnabled(true);
+	filter.write(fileName, &source);
+
+	Spreadsheet spreadsheet("test", false);
+	AsciiFilter readFilter;
+	readFilter.setSeparatingCharacter(",");
+	readFilter.setHeaderEnabled(true);
+	readFilter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	//spreadsheet size
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 3);
+
+	//column names
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("x"));
+	QCOMPARE(spreadsheet.column(1)->name(), QLatin1String("n"));
+	QCOMPARE(spreadsheet.column(2)->name(), QLatin1String("text"));
+
+	//data types
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Numeric);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Text);
+
+	//values
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 0.1 + 0.2);
+	QCOMPARE(spreadsheet.column(0)->valueAt(1), 1./3.);
+	QCOMPARE(spreadsheet.column(0)->valueAt(2), -1.e-300);
+	QCOMPARE(spreadsheet.column(1)->integerAt(1), -2);
+	QCOMPARE(spreadsheet.column(2)->textAt(1), QLatin1String("b c"));
+}
+
+/*!
+ * export a range of rows of a larger spreadsheet into a compressed file and read it back
+ */
+void AsciiFilterTest::testExport01() {
+	Spreadsheet source("source", false);
+	source.setColumnCount(2);
+	source.setRowCount(25000);
+	for (int i = 0; i < 25000; ++i) {
+		source.column(0)->setValueAt(i, i + 0.5);
+		source.column(1)->setValueAt(i, i/7.);
+	}
+
+	QTemporaryDir dir;
+	const QString fileName = dir.path() + QLatin1String("/export.txt.gz");
+	AsciiFilter filter;
+	filter.setSeparatingCharacter("TAB");
+	filter.setHeaderEnabled(false);
+	filter.setStartRow(11);
+	filter.setEndRow(24000);
+	filter.write(fileName, &source);
+
+	//gzip header
+	QFile file(fileName);
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	QCOMPARE(file.read(2), QByteArray("\x1f\x8b"));
+	file.close();
+
+	Spreadsheet spreadsheet("test", false);
+	AsciiFilter readFilter;
+	readFilter.setSeparatingCharacter("TAB");
+	readFilter.setHeaderEnabled(false);
+	readFilter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 23990);
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 10.5);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 10/7.);
+	QCOMPARE(spreadsheet.column(0)->valueAt(23989), 23999.5);
+	QCOMPARE(spreadsheet.column(1)->valueAt(23989), 23999/7.);
+}
+
 QTEST_MAIN(AsciiFilterTest)
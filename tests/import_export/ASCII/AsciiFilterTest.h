@@ -91,6 +91,10 @@ private slots:
 	//datetime data
 	void testDateTime00();
 
+	//export
+	void testExport00();
+	void testExport01();
+
 private:
 	QString m_dataDir;
 };
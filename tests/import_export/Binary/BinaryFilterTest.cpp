@@ -0,0 +1,119 @@
+/***************************************************************************
+File                 : BinaryFilterTest.cpp
+Project              : LabPlot
+Description          : Tests for the binary I/O-filter
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "BinaryFilterTest.h"
+#include "backend/core/column/Column.h"
+#include "backend/datasources/filters/BinaryFilter.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+#include <QTemporaryFile>
+
+void BinaryFilterTest::initTestCase() {
+	// the columns of large imports are stored in the cache directory, don't use the one of the user
+	QStandardPaths::setTestModeEnabled(true);
+
+	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
+	//TODO: redesign/remove this
+	qRegisterMetaType<const AbstractAspect*>("const AbstractAspect*");
+	qRegisterMetaType<const AbstractColumn*>("const AbstractColumn*");
+}
+
+/*!
+ * writes \p rows rows of two vectors of 16 bit integers in little endian to \p file, the values of the row i are i and -i
+ */
+static bool writeFile(QTemporaryFile& file, int rows) {
+	if (!file.open())
+		return false;
+
+	QDataStream out(&file);
+	out.setByteOrder(QDataStream::LittleEndian);
+	for (int i = 0; i < rows; ++i)
+		out << (qint16)i << (qint16)-i;
+	file.close();
+	return out.status() == QDataStream::Ok;
+}
+
+void BinaryFilterTest::testImport() {
+	QTemporaryFile file;
+	QVERIFY(writeFile(file, 100));
+
+	BinaryFilter filter;
+	filter.setAutoModeEnabled(false);
+	filter.setVectors(2);
+	filter.setDataType(BinaryFilter::DataType::INT16);
+	filter.setByteOrder(QDataStream::LittleEndian);
+	filter.setStartRow(3);
+	Spreadsheet spreadsheet("test", false);
+	filter.readDataFromFile(file.fileName(), &spreadsheet);
+
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 98);
+	QVERIFY(!spreadsheet.column(0)->isMapped());
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 2.);
+	QCOMPARE(spreadsheet.column(1)->valueAt(97), -99.);
+}
+
+/*!
+ * the columns of large imports are stored in files of LabPlot which are mapped into the columns
+ */
+void BinaryFilterTest::testImportLarge() {
+	const int rows = 8 * 1024 * 1024;	// 64 MiB of double values per column
+	QTemporaryFile file;
+	QVERIFY(writeFile(file, rows));
+	QDir dir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/columns"));
+	dir.removeRecursively();
+
+	BinaryFilter filter;
+	filter.setAutoModeEnabled(false);
+	filter.setVectors(2);
+	filter.setDataType(BinaryFilter::DataType::INT16);
+	filter.setByteOrder(QDataStream::LittleEndian);
+	auto* spreadsheet = new Spreadsheet("test", false);
+	filter.readDataFromFile(file.fileName(), spreadsheet);
+
+	QCOMPARE(spreadsheet->columnCount(), 2);
+	QCOMPARE(spreadsheet->rowCount(), rows);
+	const Column* x = spreadsheet->column(0);
+	const Column* y = spreadsheet->column(1);
+	QVERIFY(x->isMapped());
+	QVERIFY(y->isMapped());
+	for (int i = 0; i < rows; i += 4099) {
+		QCOMPARE(x->valueAt(i), (double)(qint16)i);
+		QCOMPARE(y->valueAt(i), (double)(qint16)-i);
+	}
+	QCOMPARE(x->valueAt(rows - 1), (double)(qint16)(rows - 1));
+
+	// the files are removed with the columns
+	dir.refresh();
+	QCOMPARE(dir.entryList(QDir::Files).size(), 2);
+	delete spreadsheet;
+	dir.refresh();
+	QCOMPARE(dir.entryList(QDir::Files).size(), 0);
+}
+
+QTEST_MAIN(BinaryFilterTest)
@@ -0,0 +1,189 @@
+/***************************************************************************
+File                 : FITSFilterTest.cpp
+Project              : LabPlot
+Description          : Tests for the FITS I/O-filter
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "FITSFilterTest.h"
+#include "backend/core/column/Column.h"
+#include "backend/datasources/filters/FITSFilter.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+#include <fitsio.h>
+
+#include <cmath>
+#include <limits>
+
+void FITSFilterTest::initTestCase() {
+	const QString currentDir = __FILE__;
+	m_dataDir = currentDir.left(currentDir.lastIndexOf(QDir::separator())) + QDir::separator() + QLatin1String("data") + QDir::separator();
+
+	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
+	//TODO: redesign/remove this
+	qRegisterMetaType<const AbstractAspect*>("const AbstractAspect*");
+	qRegisterMetaType<const AbstractColumn*>("const AbstractColumn*");
+}
+
+/*!
+ * the value in row \p row of the table column \p col as read by CFITSIO for a single cell,
+ * i.e. the first element for vector columns and NaN for undefined values
+ */
+static double cellValue(fitsfile* file, int col, long row) {
+	int status = 0;
+	int type;
+	long repeat;
+	fits_get_coltype(file, col, &type, &repeat, nullptr, &status);
+	double value = std::numeric_limits<double>::quiet_NaN();
+	if (repeat < 1)
+		return value;
+
+	double nullValue = std::numeric_limits<double>::quiet_NaN();
+	int anyNull;
+	fits_read_col(file, TDOUBLE, col, row, 1, 1, &nullValue, &value, &anyNull, &status);
+	return value;
+}
+
+/*!
+ * the value in row \p row of the table column \p col as formatted by CFITSIO (TDISPn etc.) for a single cell
+ */
+static QString cellString(fitsfile* file, int col, long row) {
+	int status = 0;
+	char value[FLEN_VALUE];
+	char* values[1] = {value};
+	char nullString[] = "";
+	int anyNull;
+	if (fits_read_col_str(file, col, row, 1, 1, nullString, values, &anyNull, &status))
+		return QLatin1String("NULL");
+
+	const QString str = QString::fromLatin1(value).simplified();
+	return str.isEmpty() ? QLatin1String("NULL") : str;
+}
+
+/*!
+ * compares the import of the table in \p fileName into a spreadsheet and the preview
+ * with reading the cells of the rows \p firstRow to \p lastRow one by one
+ */
+static void checkTable(const QString& fileName, long firstRow = 1, long lastRow = -1) {
+	fitsfile* file;
+	int status = 0;
+	QCOMPARE(fits_open_file(&file, fileName.toLatin1(), READONLY, &status), 0);
+	int cols;
+	long rows;
+	fits_get_num_cols(file, &cols, &status);
+	fits_get_num_rows(file, &rows, &status);
+	if (lastRow == -1)
+		lastRow = rows;
+	const long rowCount = lastRow - firstRow + 1;
+
+	FITSFilter filter;
+	filter.setStartRow(firstRow);
+	filter.setEndRow(lastRow);
+
+	//import
+	Spreadsheet spreadsheet("test", false);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), cols);
+	QCOMPARE(spreadsheet.rowCount(), static_cast<int>(rowCount));
+	for (int c = 0; c < cols; ++c) {
+		const Column* column = spreadsheet.column(c);
+		for (int r = 0; r < rowCount; ++r) {
+			if (column->columnMode() == AbstractColumn::ColumnMode::Numeric) {
+				const double expected = cellValue(file, c + 1, firstRow + r);
+				if (std::isnan(expected))
+					QVERIFY(std::isnan(column->valueAt(r)));
+				else
+					QCOMPARE(column->valueAt(r), expected);
+			} else
+				QCOMPARE(column->textAt(r), cellString(file, c + 1, firstRow + r));
+		}
+	}
+
+	//preview, all values are formatted by CFITSIO
+	const auto& preview = filter.readChdu(fileName);
+	QCOMPARE(preview.size(), static_cast<int>(rowCount));
+	for (int r = 0; r < rowCount; ++r) {
+		QCOMPARE(preview.at(r).size(), cols);
+		for (int c = 0; c < cols; ++c)
+			QCOMPARE(preview.at(r).at(c), cellString(file, c + 1, firstRow + r));
+	}
+
+	fits_close_file(file, &status);
+}
+
+void FITSFilterTest::testImportImage() {
+	const QString& fileName = m_dataDir + QLatin1String("WFPC2ASSNu5780205bx.fits");
+
+	FITSFilter filter;
+	Spreadsheet spreadsheet("test", false);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 100);
+	QCOMPARE(spreadsheet.rowCount(), 100);
+
+	fitsfile* file;
+	int status = 0;
+	QCOMPARE(fits_open_file(&file, fileName.toLatin1(), READONLY, &status), 0);
+	QVector<double> row(100);
+	for (long r = 0; r < 100; ++r) {
+		long first[2] = {1, r + 1};
+		fits_read_pix(file, TDOUBLE, first, 100, nullptr, row.data(), nullptr, &status);
+		QCOMPARE(status, 0);
+		for (int c = 0; c < 100; ++c)
+			QCOMPARE(spreadsheet.column(c)->valueAt(r), row.at(c));
+	}
+	fits_close_file(file, &status);
+
+	//preview
+	const auto& preview = filter.readChdu(fileName, nullptr, 10);
+	QCOMPARE(preview.size(), 10);
+	for (int r = 0; r < 10; ++r) {
+		QCOMPARE(preview.at(r).size(), 100);
+		for (int c = 0; c < 100; ++c)
+			QCOMPARE(preview.at(r).at(c), QString::number(spreadsheet.column(c)->valueAt(r)));
+	}
+}
+
+/*!
+ * ASCII table with numeric and text columns and display formats (TDISPn)
+ */
+void FITSFilterTest::testImportAsciiTable() {
+	checkTable(m_dataDir + QLatin1String("WFPC2u5780205r_c0fx.fits[1]"));
+}
+
+/*!
+ * binary table with vector columns, a column without elements and text columns
+ */
+void FITSFilterTest::testImportBinaryTable() {
+	checkTable(m_dataDir + QLatin1String("DDTSUVDATA.fits[1]"));
+	checkTable(m_dataDir + QLatin1String("IUElwp25637mxlo.fits[1]"));
+}
+
+void FITSFilterTest::testImportRowRange() {
+	checkTable(m_dataDir + QLatin1String("DDTSUVDATA.fits[1]"), 5, 20);
+	checkTable(m_dataDir + QLatin1String("HRSz0yd020fm_c2f.fits[1]"), 2, 3);
+}
+
+QTEST_MAIN(FITSFilterTest)
@@ -0,0 +1,290 @@
+/***************************************************************************
+File                 : HDF5FilterTest.cpp
+Project              : LabPlot
+Description          : Tests for the HDF5 I/O-filter
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "HDF5FilterTest.h"
+#include "backend/core/column/Column.h"
+#include "backend/datasources/filters/HDF5Filter.h"
+#include "backend/matrix/Matrix.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+#include <QTemporaryDir>
+#include <QTemporaryFile>
+
+#include <hdf5.h>
+
+#include <cmath>
+#include <limits>
+
+void HDF5FilterTest::initTestCase() {
+	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
+	//TODO: redesign/remove this
+	qRegisterMetaType<const AbstractAspect*>("const AbstractAspect*");
+	qRegisterMetaType<const AbstractColumn*>("const AbstractColumn*");
+}
+
+/*!
+ * reads the numeric data set \p dataSet of the file \p fileName
+ */
+static QVector<double> readValues(const QString& fileName, const QString& dataSet) {
+	HDF5Filter filter;
+	filter.setCurrentDataSetName(dataSet);
+	Spreadsheet spreadsheet("test", false);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QVector<double> values;
+	const Column* column = spreadsheet.column(0);
+	for (int i = 0; i < column->rowCount(); ++i)
+		values << column->valueAt(i);
+	return values;
+}
+
+/*!
+ * reads the text data set \p dataSet of the file \p fileName
+ */
+static QStringList readTexts(const QString& fileName, const QString& dataSet) {
+	HDF5Filter filter;
+	filter.setCurrentDataSetName(dataSet);
+	bool ok = true;
+	const auto& preview = filter.readCurrentDataSet(fileName, nullptr, ok);
+
+	QStringList texts;
+	for (const auto& line : preview)
+		texts << line.first();
+	return texts;
+}
+
+/*!
+ * reads the string attribute \p name of the data set \p dataSet of the file \p fileName
+ */
+static QString readStringAttribute(const QString& fileName, const QString& dataSet, const char* name) {
+	hid_t file = H5Fopen(fileName.toLatin1().constData(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	hid_t attr = H5Aopen_by_name(file, dataSet.toLatin1().constData(), name, H5P_DEFAULT, H5P_DEFAULT);
+	QString value;
+	if (attr >= 0) {
+		hid_t type = H5Aget_type(attr);
+		QByteArray buffer(H5Tget_size(type), '\0');
+		H5Aread(attr, type, buffer.data());
+		value = QString::fromLatin1(buffer);
+		H5Tclose(type);
+		H5Aclose(attr);
+	}
+	H5Fclose(file);
+	return value;
+}
+
+static void compareValues(const QVector<double>& values, const QVector<double>& expected) {
+	QCOMPARE(values.size(), expected.size());
+	for (int i = 0; i < values.size(); ++i) {
+		if (std::isnan(expected.at(i)))
+			QVERIFY(std::isnan(values.at(i)));
+		else
+			QCOMPARE(values.at(i), expected.at(i));
+	}
+}
+
+void HDF5FilterTest::testExportSpreadsheet() {
+	Spreadsheet spreadsheet("test", false);
+	spreadsheet.setColumnCount(5);
+	spreadsheet.setRowCount(4);
+
+	Column* x = spreadsheet.column(0);
+	x->setName("x");
+	x->replaceValues(0, {1.5, -2.25, std::numeric_limits<double>::quiet_NaN(), 1e300});
+
+	Column* i = spreadsheet.column(1);
+	i->setName("i");
+	i->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	i->replaceInteger(0, {1, -2, 2147483647, 0});
+
+	Column* b = spreadsheet.column(2);
+	b->setName("b");
+	b->setColumnMode(AbstractColumn::ColumnMode::BigInt);
+	for (int row = 0; row < 4; ++row)
+		b->setBigIntAt(row, (Q_INT64_C(1) << 50) * (row - 1));
+
+	Column* t = spreadsheet.column(3);
+	t->setName("t");
+	t->setColumnMode(AbstractColumn::ColumnMode::Text);
+	t->replaceTexts(0, {QLatin1String("a"), QString(), QString::fromUtf8("äöü €"), QLatin1String("a b")});
+
+	Column* d = spreadsheet.column(4);
+	d->setName("d");
+	d->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+	const QDateTime dateTime = QDateTime::fromString(QLatin1String("2020-02-29T12:34:56.789Z"), Qt::ISODateWithMs);
+	d->replaceDateTimes(0, {dateTime, dateTime.addDays(1), QDateTime(), dateTime.addMSecs(-1)});
+
+	QTemporaryDir dir;
+	const QString& fileName = dir.path() + QLatin1String("/test.h5");
+	HDF5Filter filter;
+	filter.write(fileName, &spreadsheet);
+	QCOMPARE(filter.lastError(), QString());
+
+	compareValues(readValues(fileName, "/x"), {1.5, -2.25, std::numeric_limits<double>::quiet_NaN(), 1e300});
+	compareValues(readValues(fileName, "/i"), {1., -2., 2147483647., 0.});
+
+	QVector<double> bigInts;
+	for (int row = 0; row < 4; ++row)
+		bigInts << static_cast<double>(b->bigIntAt(row));
+	compareValues(readValues(fileName, "/b"), bigInts);
+
+	QCOMPARE(readTexts(fileName, "/t"), QStringList({QLatin1String("a"), QString(), QString::fromUtf8("äöü €"), QLatin1String("a b")}));
+
+	// date and time values as milliseconds since the epoch, the invalid one as _FillValue
+	const auto& msecs = readValues(fileName, "/d");
+	QCOMPARE(msecs.size(), 4);
+	for (int row = 0; row < 4; ++row) {
+		if (row == 2)
+			QCOMPARE(msecs.at(row), static_cast<double>(AbstractColumn::invalidDateTime));
+		else
+			QCOMPARE(AbstractColumn::dateTimeFromMSecs(static_cast<qint64>(msecs.at(row)), Qt::UTC), d->dateTimeAt(row).toUTC());
+	}
+	QCOMPARE(readStringAttribute(fileName, "/d", "units"), QLatin1String("milliseconds since 1970-01-01 00:00:00 UTC"));
+	QVERIFY(!readStringAttribute(fileName, "/d", "time_spec").isEmpty());
+	QCOMPARE(readStringAttribute(fileName, "/x", "units"), QString());
+}
+
+/*!
+ * export columns with more rows than are converted at once, mapped numeric data is written without loading it
+ */
+void HDF5FilterTest::testExportLargeColumns() {
+	const int rows = 2 * 1024 * 1024 + 3;
+	QVector<double> xData(rows);
+	QVector<int> iData(rows);
+	QVector<double> iValues(rows);
+	for (int row = 0; row < rows; ++row) {
+		xData[row] = row / 2.;
+		iData[row] = -row;
+		iValues[row] = -row;
+	}
+
+	QTemporaryFile dataFile;
+	QVERIFY(dataFile.open());
+	dataFile.write(reinterpret_cast<const char*>(xData.constData()), rows * (qint64)sizeof(double));
+	dataFile.flush();
+
+	Spreadsheet spreadsheet("test", false);
+	spreadsheet.setColumnCount(2);
+	spreadsheet.setRowCount(rows);
+	Column* x = spreadsheet.column(0);
+	x->setName("x");
+	QVERIFY(x->mapData(dataFile.fileName(), 0, rows));
+	Column* i = spreadsheet.column(1);
+	i->setName("i");
+	i->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	i->replaceInteger(0, iData);
+
+	QTemporaryDir dir;
+	const QString& fileName = dir.path() + QLatin1String("/test.h5");
+	HDF5Filter filter;
+	filter.write(fileName, &spreadsheet);
+	QCOMPARE(filter.lastError(), QString());
+	QVERIFY(x->isMapped());
+
+	compareValues(readValues(fileName, "/x"), xData);
+	compareValues(readValues(fileName, "/i"), iValues);
+}
+
+void HDF5FilterTest::testExportMatrix() {
+	Matrix matrix(3, 4, "m");
+	for (int r = 0; r < 3; ++r)
+		for (int c = 0; c < 4; ++c)
+			matrix.setCell(r, c, r * 10. + c + 0.5);
+
+	QTemporaryDir dir;
+	const QString& fileName = dir.path() + QLatin1String("/test.h5");
+	HDF5Filter filter;
+	filter.write(fileName, &matrix);
+	QCOMPARE(filter.lastError(), QString());
+
+	HDF5Filter readFilter;
+	readFilter.setCurrentDataSetName("/m");
+	Spreadsheet spreadsheet("test", false);
+	readFilter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 4);
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	for (int r = 0; r < 3; ++r)
+		for (int c = 0; c < 4; ++c)
+			QCOMPARE(spreadsheet.column(c)->valueAt(r), matrix.cell<double>(r, c));
+}
+
+/*!
+ * matrices with other than numeric values are not supported, the user gets an error and no file is created
+ */
+void HDF5FilterTest::testExportTextMatrix() {
+	Matrix matrix(2, 2, "m", AbstractColumn::ColumnMode::Text);
+
+	QTemporaryDir dir;
+	const QString& fileName = dir.path() + QLatin1String("/test.h5");
+	HDF5Filter filter;
+	filter.write(fileName, &matrix);
+	QVERIFY(!filter.lastError().isEmpty());
+	QVERIFY(!QFile::exists(fileName));
+}
+
+/*!
+ * export the rows of a spreadsheet in two steps, the second time in the append mode
+ */
+void HDF5FilterTest::testAppend() {
+	Spreadsheet spreadsheet("test", false);
+	spreadsheet.setColumnCount(2);
+	spreadsheet.setRowCount(6);
+	Column* x = spreadsheet.column(0);
+	x->setName("x");
+	x->replaceValues(0, {1., 2., 3., 4., 5., 6.});
+	Column* t = spreadsheet.column(1);
+	t->setName("t");
+	t->setColumnMode(AbstractColumn::ColumnMode::Text);
+	t->replaceTexts(0, {"1", "2", "3", "4", "5", "6"});
+
+	QTemporaryDir dir;
+	const QString& fileName = dir.path() + QLatin1String("/test.h5");
+	HDF5Filter filter;
+	filter.setChunkSize(2);
+	filter.setEndRow(4);
+	filter.write(fileName, &spreadsheet);
+	QCOMPARE(filter.lastError(), QString());
+	compareValues(readValues(fileName, "/x"), {1., 2., 3., 4.});
+
+	filter.setAppendMode(true);
+	filter.setStartRow(5);
+	filter.setEndRow(-1);
+	filter.write(fileName, &spreadsheet);
+	QCOMPARE(filter.lastError(), QString());
+	compareValues(readValues(fileName, "/x"), {1., 2., 3., 4., 5., 6.});
+	QCOMPARE(readTexts(fileName, "/t"), QStringList({"1", "2", "3", "4", "5", "6"}));
+
+	// a data set with a different shape can't be extended
+	Matrix matrix(2, 2, "x");
+	filter.setStartRow(1);
+	filter.write(fileName, &matrix);
+	QVERIFY(!filter.lastError().isEmpty());
+	compareValues(readValues(fileName, "/x"), {1., 2., 3., 4., 5., 6.});
+}
+
+QTEST_MAIN(HDF5FilterTest)
@@ -0,0 +1,207 @@
+/***************************************************************************
+File                 : NgspiceRawBinaryFilterTest.cpp
+Project              : LabPlot
+Description          : Tests for the Ngspice raw binary I/O-filter
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "NgspiceRawBinaryFilterTest.h"
+#include "backend/core/column/Column.h"
+#include "backend/datasources/filters/NgspiceRawAsciiFilter.h"
+#include "backend/datasources/filters/NgspiceRawBinaryFilter.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+void NgspiceRawBinaryFilterTest::initTestCase() {
+	const QString currentDir = __FILE__;
+	m_dataDir = currentDir.left(currentDir.lastIndexOf(QDir::separator())) + QDir::separator() + QLatin1String("data") + QDir::separator();
+
+	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
+	//TODO: redesign/remove this
+	qRegisterMetaType<const AbstractAspect*>("const AbstractAspect*");
+	qRegisterMetaType<const AbstractColumn*>("const AbstractColumn*");
+}
+
+/*!
+ * reads the values of all points in the binary raw file \p fileName value by value,
+ * the values of one point are stored next to each other
+ */
+static QVector<double> readValues(const QString& fileName, int& vectors) {
+	QVector<double> values;
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return values;
+
+	bool complex = false;
+	int variables = 0;
+	int points = 0;
+	while (!file.atEnd()) {
+		const QString line = QString::fromLatin1(file.readLine()).simplified();
+		if (line.startsWith(QLatin1String("Flags:")))
+			complex = line.contains(QLatin1String("complex"));
+		else if (line.startsWith(QLatin1String("No. Variables:")))
+			variables = line.mid(14).toInt();
+		else if (line.startsWith(QLatin1String("No. Points:")))
+			points = line.mid(11).toInt();
+		else if (line == QLatin1String("Binary:"))
+			break;
+	}
+
+	vectors = complex ? 2 * variables : variables;
+	QDataStream in(&file);
+	in.setByteOrder(QDataStream::LittleEndian);
+	in.setFloatingPointPrecision(QDataStream::DoublePrecision);
+	values.resize(points * vectors);
+	for (auto& value : values)
+		in >> value;
+
+	return values;
+}
+
+/*!
+ * compares the import of the rows \p firstRow to \p lastRow of \p fileName with reading the values one by one
+ * and with the import of the ASCII version of the file
+ */
+static void checkImport(const QString& fileName, int firstRow = 1, int lastRow = -1) {
+	int vectors;
+	const auto& values = readValues(fileName, vectors);
+	QVERIFY(vectors > 0);
+	const int points = values.size() / vectors;
+	if (lastRow == -1)
+		lastRow = points;
+	const int rows = lastRow - firstRow + 1;
+
+	NgspiceRawBinaryFilter filter;
+	filter.setStartRow(firstRow);
+	filter.setEndRow(lastRow);
+	Spreadsheet spreadsheet("test", false);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), vectors);
+	QCOMPARE(spreadsheet.rowCount(), rows);
+	for (int c = 0; c < vectors; ++c) {
+		const Column* column = spreadsheet.column(c);
+		QCOMPARE(column->name(), filter.vectorNames().at(c));
+		QCOMPARE(column->columnMode(), AbstractColumn::ColumnMode::Numeric);
+		for (int r = 0; r < rows; ++r)
+			QCOMPARE(column->valueAt(r), values.at((firstRow - 1 + r) * vectors + c));
+	}
+
+	//the ASCII version of the file contains the same values with 16 significant digits
+	QString asciiFileName = fileName;
+	asciiFileName.replace(QLatin1String("_binary.raw"), QLatin1String("_ascii.raw"));
+	NgspiceRawAsciiFilter asciiFilter;
+	asciiFilter.setStartRow(firstRow);
+	asciiFilter.setEndRow(lastRow);
+	Spreadsheet asciiSpreadsheet("ascii", false);
+	asciiFilter.readDataFromFile(asciiFileName, &asciiSpreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(asciiFilter.vectorNames(), filter.vectorNames());
+	QCOMPARE(asciiSpreadsheet.columnCount(), vectors);
+	QCOMPARE(asciiSpreadsheet.rowCount(), rows);
+	for (int c = 0; c < vectors; ++c) {
+		for (int r = 0; r < rows; ++r) {
+			const double value = spreadsheet.column(c)->valueAt(r);
+			const double asciiValue = asciiSpreadsheet.column(c)->valueAt(r);
+			QVERIFY(qAbs(value - asciiValue) <= 1.e-14 * qMax(qAbs(value), qAbs(asciiValue)));
+		}
+	}
+}
+
+void NgspiceRawBinaryFilterTest::testImportAC() {
+	checkImport(m_dataDir + QLatin1String("ac_binary.raw"));
+}
+
+void NgspiceRawBinaryFilterTest::testImportDC() {
+	checkImport(m_dataDir + QLatin1String("dc_binary.raw"));
+}
+
+void NgspiceRawBinaryFilterTest::testImportDCDC() {
+	checkImport(m_dataDir + QLatin1String("dc_dc_binary.raw"));
+}
+
+void NgspiceRawBinaryFilterTest::testImportNoise() {
+	checkImport(m_dataDir + QLatin1String("noise_binary.raw"));
+}
+
+void NgspiceRawBinaryFilterTest::testImportTransient() {
+	checkImport(m_dataDir + QLatin1String("tran_binary.raw"));
+}
+
+void NgspiceRawBinaryFilterTest::testImportRowRange() {
+	checkImport(m_dataDir + QLatin1String("ac_binary.raw"), 10, 20);
+	checkImport(m_dataDir + QLatin1String("tran_binary.raw"), 1000, 1069);
+	checkImport(m_dataDir + QLatin1String("dc_binary.raw"), 501, 501);
+}
+
+/*!
+ * imports the vectors \p firstColumn to \p lastColumn (-1 = up to the last vector) of \p fileName
+ * and compares them with the values read one by one
+ */
+static void checkColumnRange(const QString& fileName, int firstColumn, int lastColumn) {
+	int vectors;
+	const auto& values = readValues(fileName, vectors);
+	QVERIFY(vectors > 0);
+	const int points = values.size() / vectors;
+	const int columns = (lastColumn == -1 ? vectors : lastColumn) - firstColumn + 1;
+
+	NgspiceRawBinaryFilter filter;
+	filter.setStartColumn(firstColumn);
+	filter.setEndColumn(lastColumn);
+	Spreadsheet spreadsheet("test", false);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(filter.vectorNames().size(), vectors);
+	QCOMPARE(spreadsheet.columnCount(), columns);
+	QCOMPARE(spreadsheet.rowCount(), points);
+	for (int c = 0; c < columns; ++c) {
+		const int vector = firstColumn - 1 + c;
+		const Column* column = spreadsheet.column(c);
+		QCOMPARE(column->name(), filter.vectorNames().at(vector));
+		for (int r = 0; r < points; ++r)
+			QCOMPARE(column->valueAt(r), values.at(r * vectors + vector));
+	}
+}
+
+void NgspiceRawBinaryFilterTest::testImportColumnRange() {
+	checkColumnRange(m_dataDir + QLatin1String("ac_binary.raw"), 3, 6);
+	checkColumnRange(m_dataDir + QLatin1String("tran_binary.raw"), 2, 2);
+	checkColumnRange(m_dataDir + QLatin1String("dc_binary.raw"), 5, -1);
+}
+
+void NgspiceRawBinaryFilterTest::testPreview() {
+	const QString& fileName = m_dataDir + QLatin1String("tran_binary.raw");
+	int vectors;
+	const auto& values = readValues(fileName, vectors);
+
+	NgspiceRawBinaryFilter filter;
+	const auto& preview = filter.preview(fileName, 10);
+	QCOMPARE(preview.size(), 10);
+	for (int r = 0; r < 10; ++r) {
+		QCOMPARE(preview.at(r).size(), vectors);
+		for (int c = 0; c < vectors; ++c)
+			QCOMPARE(preview.at(r).at(c), QString::number(values.at(r * vectors + c), 'e', 15));
+	}
+}
+
+QTEST_MAIN(NgspiceRawBinaryFilterTest)
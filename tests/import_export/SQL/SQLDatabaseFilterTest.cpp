@@ -0,0 +1,314 @@
+/***************************************************************************
+File                 : SQLDatabaseFilterTest.cpp
+Project              : LabPlot
+Description          : Tests for the SQL database I/O-filter.
+--------------------------------------------------------------------
+Copyright            : (C) 2020 LabPlot developers
+
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "SQLDatabaseFilterTest.h"
+#include "backend/datasources/filters/SQLDatabaseFilter.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+#include "backend/core/column/Column.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+void SQLDatabaseFilterTest::initTestCase() {
+	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
+	//TODO: redesign/remove this
+	qRegisterMetaType<const AbstractAspect*>("const AbstractAspect*");
+	qRegisterMetaType<const AbstractColumn*>("const AbstractColumn*");
+
+	QVERIFY(m_tempDir.isValid());
+}
+
+void SQLDatabaseFilterTest::testExport() {
+	Spreadsheet spreadsheet("test", true);
+	spreadsheet.setColumnCount(4);
+	spreadsheet.setRowCount(3);
+
+	Column* col = spreadsheet.column(0);
+	col->setName("double");
+	col->setColumnMode(AbstractColumn::ColumnMode::Numeric);
+	col->replaceValues(0, {1.5, NAN, -3.25});
+
+	col = spreadsheet.column(1);
+	col->setName("int");
+	col->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	col->replaceInteger(0, {1, 2, 3});
+
+	col = spreadsheet.column(2);
+	col->setName("text");
+	col->setColumnMode(AbstractColumn::ColumnMode::Text);
+	col->replaceTexts(0, {"a", "b \"c\"", "d'e"});
+
+	col = spreadsheet.column(3);
+	col->setName("date time");
+	col->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+	const QDateTime dateTime(QDate(2020, 5, 17), QTime(12, 30, 15, 250));
+	col->replaceDateTimes(0, {dateTime, dateTime.addDays(1), QDateTime()});
+
+	const QString fileName = m_tempDir.filePath("export.db");
+	SQLDatabaseFilter filter;
+	QVERIFY(filter.write(fileName, &spreadsheet));
+
+	//read the values back and check the stored types
+	{
+	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testExport");
+	db.setDatabaseName(fileName);
+	QVERIFY(db.open());
+	QSqlQuery q(db);
+	QVERIFY(q.exec("SELECT \"double\", typeof(\"double\"), \"int\", typeof(\"int\"), \"text\", \"date time\" FROM \"test\""));
+
+	QVERIFY(q.next());
+	QCOMPARE(q.value(0).toDouble(), 1.5);
+	QCOMPARE(q.value(1).toString(), QLatin1String("real"));
+	QCOMPARE(q.value(2).toInt(), 1);
+	QCOMPARE(q.value(3).toString(), QLatin1String("integer"));
+	QCOMPARE(q.value(4).toString(), QLatin1String("a"));
+	QCOMPARE(q.value(5).toString(), QLatin1String("2020-05-17 12:30:15.250"));
+
+	QVERIFY(q.next());
+	QCOMPARE(q.value(1).toString(), QLatin1String("null"));
+	QCOMPARE(q.value(4).toString(), QLatin1String("b \"c\""));
+
+	QVERIFY(q.next());
+	QCOMPARE(q.value(0).toDouble(), -3.25);
+	QCOMPARE(q.value(2).toInt(), 3);
+	QCOMPARE(q.value(4).toString(), QLatin1String("d'e"));
+	QVERIFY(q.value(5).isNull());
+
+	QVERIFY(!q.next());
+	db.close();
+	}
+	QSqlDatabase::removeDatabase("testExport");
+}
+
+void SQLDatabaseFilterTest::testExportBatches() {
+	Spreadsheet spreadsheet("test", true);
+	spreadsheet.setColumnCount(1);
+	spreadsheet.setRowCount(1000);
+	Column* col = spreadsheet.column(0);
+	col->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	QVector<int> values(1000);
+	for (int i = 0; i < values.size(); ++i)
+		values[i] = i;
+	col->replaceInteger(0, values);
+
+	const QString fileName = m_tempDir.filePath("batches.db");
+	SQLDatabaseFilter filter;
+	filter.setBatchSize(128);
+	filter.setEndRow(899);
+	QVERIFY(filter.write(fileName, &spreadsheet));
+
+	{
+	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testExportBatches");
+	db.setDatabaseName(fileName);
+	QVERIFY(db.open());
+	QSqlQuery q(db);
+	QVERIFY(q.exec("SELECT count(*), sum(\"" + col->name() + "\") FROM \"test\""));
+	QVERIFY(q.next());
+	QCOMPARE(q.value(0).toInt(), 900);
+	QCOMPARE(q.value(1).toLongLong(), 899LL*900/2);
+	db.close();
+	}
+	QSqlDatabase::removeDatabase("testExportBatches");
+}
+
+void SQLDatabaseFilterTest::testImport() {
+	const QString fileName = m_tempDir.filePath("import.db");
+	{
+	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testImport");
+	db.setDatabaseName(fileName);
+	QVERIFY(db.open());
+	QSqlQuery q(db);
+	QVERIFY(q.exec("CREATE TABLE data (x REAL, n INTEGER, name TEXT)"));
+	QVERIFY(q.exec("INSERT INTO data VALUES (1.5, 1, 'a'), (NULL, 2, 'b'), (-2.25, 3000000000, 'c')"));
+
+	Spreadsheet spreadsheet("test", false);
+	SQLDatabaseFilter filter;
+	QCOMPARE(filter.read(db, "SELECT x, n, name FROM data", &spreadsheet), 3);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("x"));
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Numeric);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Text);
+
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 1.5);
+	QVERIFY(std::isnan(spreadsheet.column(0)->valueAt(1)));
+	QCOMPARE(spreadsheet.column(0)->valueAt(2), -2.25);
+	QCOMPARE(spreadsheet.column(1)->bigIntAt(0), 1LL);
+	QCOMPARE(spreadsheet.column(1)->bigIntAt(2), 3000000000LL);
+	QCOMPARE(spreadsheet.column(2)->textAt(1), QLatin1String("b"));
+
+	//invalid query
+	QCOMPARE(filter.read(db, "SELECT * FROM nonexisting", &spreadsheet), -1);
+	QVERIFY(!filter.lastError().isEmpty());
+	db.close();
+	}
+	QSqlDatabase::removeDatabase("testImport");
+}
+
+void SQLDatabaseFilterTest::testImportColumnModes() {
+	const QString fileName = m_tempDir.filePath("import_modes.db");
+	{
+	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testImportColumnModes");
+	db.setDatabaseName(fileName);
+	QVERIFY(db.open());
+	QSqlQuery q(db);
+	QVERIFY(q.exec("CREATE TABLE data (x TEXT, n INTEGER, t TEXT)"));
+	QVERIFY(q.exec("INSERT INTO data VALUES ('1,5', 1, '2020-05-17 12:30:15'), ('2,5', 2, '2020-05-18 08:00:00')"));
+
+	//numbers and date-time values stored as text are parsed with the given formats
+	Spreadsheet spreadsheet("test", false);
+	SQLDatabaseFilter filter;
+	filter.setColumnModes({AbstractColumn::ColumnMode::Numeric, AbstractColumn::ColumnMode::Numeric, AbstractColumn::ColumnMode::DateTime});
+	filter.setNumberFormat(QLocale::German);
+	filter.setDateTimeFormat("yyyy-MM-dd hh:mm:ss");
+	QCOMPARE(filter.read(db, "SELECT * FROM data", &spreadsheet), 2);
+
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Numeric);
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 1.5);
+	QCOMPARE(spreadsheet.column(0)->valueAt(1), 2.5);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 2.);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(spreadsheet.column(2)->dateTimeAt(1), QDateTime(QDate(2020, 5, 18), QTime(8, 0, 0)));
+	db.close();
+	}
+	QSqlDatabase::removeDatabase("testImportColumnModes");
+}
+
+void SQLDatabaseFilterTest::testImportBatches() {
+	const QString fileName = m_tempDir.filePath("import_batches.db");
+	{
+	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testImportBatches");
+	db.setDatabaseName(fileName);
+	QVERIFY(db.open());
+	QSqlQuery q(db);
+	QVERIFY(q.exec("CREATE TABLE data (n INTEGER, x REAL, name TEXT)"));
+	QVERIFY(db.transaction());
+	QVERIFY(q.prepare("INSERT INTO data VALUES (?, ?, ?)"));
+	for (int i = 0; i < 1000; ++i) {
+		q.addBindValue(i);
+		q.addBindValue(0.5*i);
+		q.addBindValue(QString::number(i));
+		QVERIFY(q.exec());
+	}
+	QVERIFY(db.commit());
+
+	//the result is fetched in batches that don't divide the number of rows
+	Spreadsheet spreadsheet("test", false);
+	SQLDatabaseFilter filter;
+	filter.setBatchSize(128);
+	QCOMPARE(filter.read(db, "SELECT * FROM data", &spreadsheet), 1000);
+
+	QCOMPARE(spreadsheet.rowCount(), 1000);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Numeric);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Text);
+	for (int i : {0, 127, 128, 129, 255, 256, 999}) {
+		QCOMPARE(spreadsheet.column(0)->integerAt(i), i);
+		QCOMPARE(spreadsheet.column(1)->valueAt(i), 0.5*i);
+		QCOMPARE(spreadsheet.column(2)->textAt(i), QString::number(i));
+	}
+	db.close();
+	}
+	QSqlDatabase::removeDatabase("testImportBatches");
+}
+
+//##############################################################################
+//#########################  performance  ######################################
+//##############################################################################
+
+void SQLDatabaseFilterTest::testPerformance_export() {
+	const int rows = 1000000;
+	Spreadsheet spreadsheet("test", true);
+	spreadsheet.setColumnCount(3);
+	spreadsheet.setRowCount(rows);
+	QVector<double> values(rows);
+	for (int j = 0; j < 3; ++j) {
+		for (int i = 0; i < rows; ++i)
+			values[i] = i + 0.1*j;
+		Column* col = spreadsheet.column(j);
+		col->setColumnMode(AbstractColumn::ColumnMode::Numeric);
+		col->replaceValues(0, values);
+	}
+
+	const QString fileName = m_tempDir.filePath("performance.db");
+	SQLDatabaseFilter filter;
+	QBENCHMARK {
+		QVERIFY(filter.write(fileName, &spreadsheet));
+	}
+
+	{
+	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testPerformance_export");
+	db.setDatabaseName(fileName);
+	QVERIFY(db.open());
+	QSqlQuery query("SELECT COUNT(*) FROM test", db);
+	QVERIFY(query.next());
+	QCOMPARE(query.value(0).toInt(), rows);
+	db.close();
+	}
+	QSqlDatabase::removeDatabase("testPerformance_export");
+}
+
+void SQLDatabaseFilterTest::testPerformance_import() {
+	const int rows = 1000000;
+	const QString fileName = m_tempDir.filePath("performance_import.db");
+	{
+	Spreadsheet spreadsheet("test", true);
+	spreadsheet.setColumnCount(3);
+	spreadsheet.setRowCount(rows);
+	QVector<double> values(rows);
+	for (int j = 0; j < 3; ++j) {
+		for (int i = 0; i < rows; ++i)
+			values[i] = i + 0.1*j;
+		Column* col = spreadsheet.column(j);
+		col->setColumnMode(AbstractColumn::ColumnMode::Numeric);
+		col->replaceValues(0, values);
+	}
+	SQLDatabaseFilter filter;
+	QVERIFY(filter.write(fileName, &spreadsheet));
+	}
+
+	{
+	QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testPerformance_import");
+	db.setDatabaseName(fileName);
+	QVERIFY(db.open());
+
+	Spreadsheet spreadsheet("test", false);
+	SQLDatabaseFilter filter;
+	QBENCHMARK {
+		QCOMPARE(filter.read(db, "SELECT * FROM test", &spreadsheet), rows);
+	}
+	QCOMPARE(spreadsheet.rowCount(), rows);
+	QCOMPARE(spreadsheet.column(2)->valueAt(rows - 1), rows - 1 + 0.2);
+	db.close();
+	}
+	QSqlDatabase::removeDatabase("testPerformance_import");
+}
+
+QTEST_MAIN(SQLDatabaseFilterTest)
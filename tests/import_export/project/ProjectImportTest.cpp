@@ -30,11 +30,20 @@
 #include "backend/datasources/projects/OriginProjectParser.h"
 #endif
 #include "backend/core/Project.h"
+#include "backend/core/ProjectContainer.h"
 #include "backend/core/Workbook.h"
+#include "backend/core/column/Column.h"
 #include "backend/matrix/Matrix.h"
 #include "backend/worksheet/Worksheet.h"
 #include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 #include "backend/spreadsheet/Spreadsheet.h"
+#include "backend/lib/XmlStreamReader.h"
+
+#include <QBuffer>
+#include <QPixmap>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QXmlStreamWriter>
 
 void ProjectImportTest::initTestCase() {
 	const QString currentDir = __FILE__;
@@ -49,6 +58,228 @@ void ProjectImportTest::initTestCase() {
 //##############################################################################
 //#####################  import of LabPlot projects ############################
 //##############################################################################
+void ProjectImportTest::testLabPlotContainer() {
+	QTemporaryDir dir;
+	const QString& path = dir.path() + QLatin1String("/test.lml.autosave");
+
+	Project project;
+	auto* spreadsheet = new Spreadsheet(QLatin1String("spreadsheet"));
+	project.addChild(spreadsheet);
+	spreadsheet->setRowCount(1000);
+	QVector<double> x(1000), y(1000);
+	for (int i = 0; i < 1000; ++i) {
+		x[i] = i;
+		y[i] = 2.*i;
+	}
+	auto* column1 = spreadsheet->column(0);
+	auto* column2 = spreadsheet->column(1);
+	column1->replaceValues(0, x);
+	column2->replaceValues(0, y);
+
+	ProjectContainer container(path);
+	QVERIFY(container.save(&project));
+	QVERIFY(ProjectContainer::isContainer(path));
+	const QString& dataPath = ProjectContainer::dataDirectory(path);
+	QCOMPARE(QDir(dataPath).entryList(QDir::Files).size(), 2);
+
+	//modify one column, only the data of this column is replaced in the container
+	const QString hash1 = column1->dataHash();
+	const QString hash2 = column2->dataHash();
+	column2->setValueAt(0, -1.);
+	QVERIFY(column2->dataHash() != hash2);
+	QCOMPARE(column1->dataHash(), hash1);
+
+	QVERIFY(container.save(&project));
+	const QStringList& files = QDir(dataPath).entryList(QDir::Files);
+	QCOMPARE(files.size(), 2);
+	QVERIFY(files.contains(hash1));
+	QVERIFY(files.contains(column2->dataHash()));
+	QVERIFY(!files.contains(hash2));
+
+	//load the container
+	Project project2;
+	QVERIFY(project2.load(path));
+	const auto* spreadsheet2 = project2.child<Spreadsheet>(0);
+	QVERIFY(spreadsheet2 != nullptr);
+	QCOMPARE(spreadsheet2->rowCount(), 1000);
+	QCOMPARE(spreadsheet2->column(0)->valueAt(10), 10.);
+	QCOMPARE(spreadsheet2->column(1)->valueAt(0), -1.);
+	QCOMPARE(spreadsheet2->column(1)->valueAt(999), 1998.);
+}
+
+/*!
+ * loads the project container \p path into \p project (or a temporary project),
+ * without the message box shown by Project::load() on errors
+ */
+static bool loadContainer(const QString& path, Project* project = nullptr) {
+	QFile file(ProjectContainer::manifestFileName(path));
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	Project tempProject;
+	if (!project)
+		project = &tempProject;
+	XmlStreamReader reader(&file);
+	reader.setDataDirectory(ProjectContainer::dataDirectory(path));
+	return project->load(&reader, false);
+}
+
+void ProjectImportTest::testLabPlotContainerCorrupted() {
+	QTemporaryDir dir;
+	const QString& path = dir.path() + QLatin1String("/test.lml.autosave");
+
+	Project project;
+	auto* spreadsheet = new Spreadsheet(QLatin1String("spreadsheet"));
+	project.addChild(spreadsheet);
+	spreadsheet->setRowCount(1000);
+	QVector<double> x(1000);
+	for (int i = 0; i < 1000; ++i)
+		x[i] = i;
+	auto* column = spreadsheet->column(0);
+	column->replaceValues(0, x);
+
+	ProjectContainer container(path);
+	QVERIFY(container.save(&project));
+	QVERIFY(loadContainer(path));
+
+	const QString& fileName = ProjectContainer::dataDirectory(path) + QLatin1Char('/') + column->dataHash();
+	QFile file(fileName);
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	const QByteArray data = file.readAll();
+	file.close();
+
+	//modified value
+	QByteArray modified = data;
+	modified[10] = static_cast<char>(modified.at(10) ^ 1);
+	QVERIFY(file.open(QIODevice::WriteOnly));
+	file.write(modified);
+	file.close();
+	QVERIFY(!loadContainer(path));
+
+	//truncated file
+	QVERIFY(file.open(QIODevice::WriteOnly));
+	file.write(data.left(data.size() - 8));
+	file.close();
+	QVERIFY(!loadContainer(path));
+
+	//missing file
+	QVERIFY(QFile::remove(fileName));
+	QVERIFY(!loadContainer(path));
+}
+
+void ProjectImportTest::testLabPlotContainerCorruptedMapped() {
+	QTemporaryDir dir;
+	const QString& path = dir.path() + QLatin1String("/test.lml.autosave");
+
+	//the data of numeric columns with 64 MiB and more is mapped on load
+	const int rows = 8 * 1024 * 1024;
+	Project project;
+	auto* spreadsheet = new Spreadsheet(QLatin1String("spreadsheet"));
+	project.addChild(spreadsheet);
+	spreadsheet->setColumnCount(1);
+	spreadsheet->setRowCount(rows);
+	QVector<double> x(rows);
+	for (int i = 0; i < rows; ++i)
+		x[i] = i;
+	auto* column = spreadsheet->column(0);
+	column->replaceValues(0, x);
+
+	ProjectContainer container(path);
+	QVERIFY(container.save(&project));
+
+	//modified value
+	QFile file(ProjectContainer::dataDirectory(path) + QLatin1Char('/') + column->dataHash());
+	QVERIFY(file.open(QIODevice::ReadWrite));
+	QVERIFY(file.seek(8 * sizeof(double)));
+	const double value = -1.;
+	QCOMPARE(file.write(reinterpret_cast<const char*>(&value), sizeof(double)), static_cast<qint64>(sizeof(double)));
+	file.close();
+
+	//the load doesn't wait for the check of the content of the mapped file
+	Project project2;
+	QVERIFY(loadContainer(path, &project2));
+	const auto* column2 = project2.child<Spreadsheet>(0)->column(0);
+	QCOMPARE(column2->rowCount(), rows);
+	QVERIFY(column2->isMapped());
+	QCOMPARE(column2->valueAt(8), -1.);
+
+	//the check in the background invalidates the values
+	QTRY_VERIFY_WITH_TIMEOUT(!column2->isMapped(), 60000);
+	QCOMPARE(column2->rowCount(), rows);
+	QVERIFY(std::isnan(column2->valueAt(0)));
+	QVERIFY(std::isnan(column2->valueAt(rows - 1)));
+}
+
+void ProjectImportTest::testLabPlotDateTime() {
+	const QDateTime dateTime1(QDate(2020, 5, 17), QTime(12, 30, 15, 250), Qt::UTC);
+	const QDateTime dateTime2(QDate(1969, 12, 31), QTime(23, 59, 59), Qt::UTC);
+
+	Project project;
+	auto* spreadsheet = new Spreadsheet(QLatin1String("spreadsheet"));
+	project.addChild(spreadsheet);
+	spreadsheet->setColumnCount(2);
+	spreadsheet->setRowCount(3);
+	auto* column = spreadsheet->column(0);
+	column->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+	column->setTimeSpec(Qt::UTC);
+	column->setDateTimeAt(0, dateTime1);
+	column->setDateTimeAt(1, QDateTime());
+	column->setDateTimeAt(2, dateTime2);
+	column = spreadsheet->column(1);
+	column->setColumnMode(AbstractColumn::ColumnMode::Month);
+	column->setDateTimeAt(0, dateTime1);
+
+	QByteArray data;
+	QBuffer buffer(&data);
+	QVERIFY(buffer.open(QIODevice::WriteOnly));
+	QXmlStreamWriter writer(&buffer);
+	project.save(QPixmap(), &writer);
+	buffer.close();
+	QVERIFY(data.contains("xmlVersion=\"" + QByteArray::number(Project::currentXmlVersion) + '"'));
+
+	Project project2;
+	XmlStreamReader reader(data);
+	project2.setIsLoading(true);
+	QVERIFY(project2.load(&reader, false));
+	project2.setIsLoading(false);
+	QCOMPARE(project2.xmlVersion(), Project::currentXmlVersion);
+
+	const auto* spreadsheet2 = project2.child<Spreadsheet>(0);
+	QVERIFY(spreadsheet2 != nullptr);
+	QCOMPARE(spreadsheet2->rowCount(), 3);
+	const auto* column2 = spreadsheet2->column(0);
+	QCOMPARE(column2->columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(column2->timeSpec(), Qt::UTC);
+	QCOMPARE(column2->dateTimeAt(0), dateTime1);
+	QVERIFY(!column2->dateTimeAt(1).isValid());
+	QCOMPARE(column2->dateTimeAt(2), dateTime2);
+	column2 = spreadsheet2->column(1);
+	QCOMPARE(column2->columnMode(), AbstractColumn::ColumnMode::Month);
+	QCOMPARE(column2->dateTimeMSecsAt(0), dateTime1.toMSecsSinceEpoch());
+}
+
+/*!
+ * date-time columns of projects without the format version contain "row" elements
+ */
+void ProjectImportTest::testLabPlotDateTimeRows() {
+	const QByteArray data = "<column name=\"x\" creation_time=\"2020-17-05 12:00:00:000\" designation=\"1\" mode=\"2\" rows=\"3\" width=\"0\">"
+		"<row index=\"0\">2020-17-05 12:30:15:250</row>"
+		"<row index=\"2\">1969-31-12 23:59:59:000</row>"
+		"</column>";
+
+	Column column(QLatin1String("x"));
+	XmlStreamReader reader(data);
+	QVERIFY(reader.skipToNextTag());
+	QVERIFY(column.load(&reader, false));
+	QThreadPool::globalInstance()->waitForDone();
+
+	QCOMPARE(column.columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(column.rowCount(), 3);
+	QCOMPARE(column.dateTimeAt(0), QDateTime(QDate(2020, 5, 17), QTime(12, 30, 15, 250)));
+	QVERIFY(!column.dateTimeAt(1).isValid());
+	QCOMPARE(column.dateTimeAt(2), QDateTime(QDate(1969, 12, 31), QTime(23, 59, 59)));
+}
+
 
 
 #ifdef HAVE_LIBORIGIN
@@ -36,6 +36,11 @@ private slots:
 	void initTestCase();
 
 	//import of LabPlot projects
+	void testLabPlotContainer();
+	void testLabPlotContainerCorrupted();
+	void testLabPlotContainerCorruptedMapped();
+	void testLabPlotDateTime();
+	void testLabPlotDateTimeRows();
 
 #ifdef HAVE_LIBORIGIN
 	//import of Origin projects
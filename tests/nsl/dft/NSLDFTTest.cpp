@@ -244,6 +244,44 @@ void NSLDFTTest::testTwosided_normdB() {
 		QCOMPARE(data[i], result[i]);
 }
 
+//##############################################################################
+//#################  plan cache
+//##############################################################################
+
+void NSLDFTTest::testPlanCache() {
+	const double orig[] = {1, 1, 3, 3, 1, -1, 0, 1, 1, 0};
+	double result[] = {10, 2, -5.85410196624968, 2, 0.854101966249685};
+
+	// the first call creates the plan, the following ones use the cached plan
+	for (int run = 0; run < 3; run++) {
+		if (run == 2)
+			nsl_dft_plan_cache_clear();
+
+		double data[N];
+		for (int i = 0; i < N; i++)
+			data[i] = orig[i];
+		nsl_dft_transform(data, 1, N, ONESIDED, nsl_dft_result_real);
+		for (unsigned int i = 0; i < N/2; i++)
+			QCOMPARE(data[i], result[i]);
+	}
+}
+
+void NSLDFTTest::testPlanCache_unaligned() {
+	const double orig[] = {1, 1, 3, 3, 1, -1, 0, 1, 1, 0};
+	double result[] = {10, 2, -5.85410196624968, 2, 0.854101966249685};
+
+	// transform the same size on an aligned and a misaligned array
+	double buffer[N + 1];
+	for (int offset = 0; offset < 2; offset++) {
+		double* data = buffer + offset;
+		for (int i = 0; i < N; i++)
+			data[i] = orig[i];
+		nsl_dft_transform(data, 1, N, ONESIDED, nsl_dft_result_real);
+		for (unsigned int i = 0; i < N/2; i++)
+			QCOMPARE(data[i], result[i]);
+	}
+}
+
 //##############################################################################
 //#################  performance
 //##############################################################################
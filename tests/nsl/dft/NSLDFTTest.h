@@ -55,6 +55,9 @@ private slots:
 	void testTwosided_squaremagnitude();
 	void testTwosided_squareamplitude();
 	void testTwosided_normdB();
+	// plan cache
+	void testPlanCache();
+	void testPlanCache_unaligned();
 	// performance
 	void testPerformance_onesided();
 	void testPerformance_twosided();
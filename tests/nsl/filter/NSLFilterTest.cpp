@@ -82,6 +82,15 @@ void NSLFilterTest::testForm() {
 	nsl_filter_fourier(data, N, nsl_filter_type_band_pass, nsl_filter_form_butterworth, 2, 2, 2);
 }
 
+void NSLFilterTest::testFourierFailure() {
+	double data[] = {1, 2, 3, 4};
+
+	/* the transform of no data fails, the failure is returned and the data is not changed */
+	QVERIFY(nsl_filter_fourier(data, 0, nsl_filter_type_low_pass, nsl_filter_form_ideal, 0, 1, 1) != 0);
+	QCOMPARE(data[0], 1.);
+	QCOMPARE(data[3], 4.);
+}
+
 //##############################################################################
 //#################  performance
 //##############################################################################
@@ -36,6 +36,7 @@ private slots:
 	void initTestCase();
 
 	void testForm();
+	void testFourierFailure();
 	// performance
 	//void testPerformance();
 private:
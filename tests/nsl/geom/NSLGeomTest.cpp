@@ -286,4 +286,61 @@ void NSLGeomTest::testLineSimMorse() {
 //#################  performance
 //##############################################################################
 
+// reads the morse code data set used for the performance tests
+static bool readMorseData(const QString& fileName, double* xdata, double* ydata, const int N) {
+	FILE *file;
+	if((file = fopen(fileName.toLocal8Bit().constData(), "r")) == nullptr) {
+		printf("ERROR reading %s. Giving up.\n", fileName.toLocal8Bit().constData());
+		return false;
+	}
+
+	for (int i = 0; i < N; i++) {
+		int num = fscanf(file,"%lf %lf", &xdata[i], &ydata[i]);
+		if (num != 2) {	// failed to read two values
+			printf("ERROR reading data\n");
+			fclose(file);
+			return false;
+		}
+	}
+	fclose(file);
+
+	return true;
+}
+
+void NSLGeomTest::testPerformanceDouglasPeucker() {
+	const int N = 152000;
+	QScopedArrayPointer<double> xdata(new double[N]);
+	QScopedArrayPointer<double> ydata(new double[N]);
+	if (!readMorseData(m_dataDir + "morse_code.dat", xdata.data(), ydata.data(), N))
+		return;
+
+	const double tol = nsl_geom_linesim_clip_diag_perpoint(xdata.data(), ydata.data(), N);
+	QScopedArrayPointer<size_t> index(new size_t[N]);
+	size_t nout;
+	QBENCHMARK {
+		nout = nsl_geom_linesim_douglas_peucker(xdata.data(), ydata.data(), N, tol, index.data());
+	}
+	QCOMPARE(nout, (size_t)99971);
+	QCOMPARE(index[0], (size_t)0);
+	QCOMPARE(index[nout - 1], (size_t)(N - 1));
+}
+
+void NSLGeomTest::testPerformanceVisvalingamWhyatt() {
+	const int N = 152000;
+	QScopedArrayPointer<double> xdata(new double[N]);
+	QScopedArrayPointer<double> ydata(new double[N]);
+	if (!readMorseData(m_dataDir + "morse_code.dat", xdata.data(), ydata.data(), N))
+		return;
+
+	const double tol = nsl_geom_linesim_clip_area_perpoint(xdata.data(), ydata.data(), N);
+	QScopedArrayPointer<size_t> index(new size_t[N]);
+	size_t nout;
+	QBENCHMARK {
+		nout = nsl_geom_linesim_visvalingam_whyatt(xdata.data(), ydata.data(), N, tol, index.data());
+	}
+	QCOMPARE(nout, (size_t)23640);
+	QCOMPARE(index[0], (size_t)0);
+	QCOMPARE(index[nout - 1], (size_t)(N - 1));
+}
+
 QTEST_MAIN(NSLGeomTest)
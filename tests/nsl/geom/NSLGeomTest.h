@@ -39,7 +39,8 @@ private slots:
 	void testLineSim();
 	void testLineSimMorse();
 	// performance
-	//void testPerformance();
+	void testPerformanceDouglasPeucker();
+	void testPerformanceVisvalingamWhyatt();
 private:
 	QString m_dataDir;
 };
@@ -199,6 +199,16 @@ void NSLSmoothTest::testPercentile_padperiodic() {
 		QCOMPARE(data[i], result[i]);
 }
 
+void NSLSmoothTest::testPercentile_evenpoints() {
+	double data[] = {2, 2, 5, 2, 1, 0, 1, 4, 9};
+	double result[] = {2, 2, 1.6, 0.6, 0.6, 0.6, 0.6, 2.8, 7};
+
+	int status = nsl_smooth_percentile(data, N, 4, 0.4, nsl_smooth_pad_nearest);
+	QCOMPARE(status, 0);
+	for(int i = 0; i < N; i++)
+		QCOMPARE(data[i], result[i]);
+}
+
 //##############################################################################
 //#################  Savitzky-Golay coeff tests
 //##############################################################################
@@ -430,4 +440,15 @@ void NSLSmoothTest::testPerformance_periodic() {
 	}
 }
 
+void NSLSmoothTest::testPerformance_percentile() {
+	QScopedArrayPointer<double> data(new double[nn]);
+
+	QBENCHMARK {
+		for (int i = 0;  i < nn; i++)
+			data[i] = (i * 7919) % 1000;
+		int status = nsl_smooth_percentile(data.data(), nn, 1001, percentile, nsl_smooth_pad_mirror);
+		QCOMPARE(status, 0);
+	}
+}
+
 QTEST_MAIN(NSLSmoothTest)
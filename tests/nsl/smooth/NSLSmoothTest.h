@@ -51,6 +51,7 @@ private slots:
 	void testPercentile_padnearest();
 	void testPercentile_padconstant();
 	void testPercentile_padperiodic();
+	void testPercentile_evenpoints();
 	// Savivitzky-Golay coeff tests
 	void testSG_coeff31();
 	void testSG_coeff51();
@@ -73,6 +74,7 @@ private slots:
 	void testPerformance_nearest();
 	void testPerformance_constant();
 	void testPerformance_periodic();
+	void testPerformance_percentile();
 private:
 	QString m_dataDir;
 };
@@ -28,11 +28,15 @@
 #include "SpreadsheetTest.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 #include "backend/core/Project.h"
+#include "backend/lib/XmlStreamReader.h"
 #include "commonfrontend/spreadsheet/SpreadsheetView.h"
 
 #include <QApplication>
 #include <QClipboard>
+#include <QTemporaryFile>
+#include <QThreadPool>
 #include <QUndoStack>
+#include <QXmlStreamWriter>
 #if QT_VERSION >= 0x051000
 #include <QRandomGenerator>
 #endif
@@ -345,6 +349,92 @@ void SpreadsheetTest::testCopyPasteSizeChange01() {
 	QCOMPARE(sheet.column(2)->valueAt(2), 4.4);
 }
 
+//**********************************************************
+//************* Copy&Paste between spreadsheets ************
+//**********************************************************
+/*!
+   copy a selection with columns of different modes and paste it into another spreadsheet,
+   the values are pasted without converting them to text and the column modes are taken over.
+*/
+void SpreadsheetTest::testCopyPasteColumnData00() {
+	Spreadsheet source("source", false);
+	source.setColumnCount(3);
+	source.setRowCount(2);
+	source.column(1)->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	source.column(2)->setColumnMode(AbstractColumn::ColumnMode::Text);
+	source.column(0)->setValueAt(0, 1.5);
+	source.column(0)->setValueAt(1, 0.1 + 0.2);
+	source.column(1)->setIntegerAt(0, 1);
+	source.column(1)->setIntegerAt(1, 2);
+	source.column(2)->setTextAt(0, "a");
+	source.column(2)->setTextAt(1, "b c");
+
+	SpreadsheetView sourceView(&source, false);
+	sourceView.setCellsSelected(0, 0, 1, 2);
+	sourceView.copySelection();
+
+	//text representation
+	const QStringList rows = QApplication::clipboard()->text().split('\n');
+	QCOMPARE(rows.size(), 2);
+	QCOMPARE(rows.at(0), QLatin1String("1.5\t1\ta"));
+	QCOMPARE(rows.at(1).split('\t').at(2), QLatin1String("b c"));
+
+	Spreadsheet sheet("test", false);
+	sheet.setColumnCount(2);
+	sheet.setRowCount(100);
+
+	SpreadsheetView view(&sheet, false);
+	view.pasteIntoSelection();
+
+	//spreadsheet size
+	QCOMPARE(sheet.columnCount(), 3);
+	QCOMPARE(sheet.rowCount(), 100);
+
+	//column modes
+	QCOMPARE(sheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Numeric);
+	QCOMPARE(sheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(sheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Text);
+
+	//values, the double value is not rounded
+	QCOMPARE(sheet.column(0)->valueAt(0), 1.5);
+	QCOMPARE(sheet.column(0)->valueAt(1), 0.1 + 0.2);
+	QCOMPARE(sheet.column(1)->integerAt(0), 1);
+	QCOMPARE(sheet.column(1)->integerAt(1), 2);
+	QCOMPARE(sheet.column(2)->textAt(0), QLatin1String("a"));
+	QCOMPARE(sheet.column(2)->textAt(1), QLatin1String("b c"));
+	QCOMPARE((bool)std::isnan(sheet.column(0)->valueAt(2)), true);
+}
+
+/*!
+   copied data cannot be pasted without conversion into a column with values of a different mode,
+   the text representation is pasted instead.
+*/
+void SpreadsheetTest::testCopyPasteColumnData01() {
+	Spreadsheet source("source", false);
+	source.setColumnCount(1);
+	source.setRowCount(2);
+	source.column(0)->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	source.column(0)->setIntegerAt(0, 1);
+	source.column(0)->setIntegerAt(1, 2);
+
+	SpreadsheetView sourceView(&source, false);
+	sourceView.setCellsSelected(0, 0, 1, 0);
+	sourceView.copySelection();
+
+	Spreadsheet sheet("test", false);
+	sheet.setColumnCount(1);
+	sheet.setRowCount(3);
+	sheet.column(0)->setValueAt(2, 3.5);
+
+	SpreadsheetView view(&sheet, false);
+	view.pasteIntoSelection();
+
+	QCOMPARE(sheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Numeric);
+	QCOMPARE(sheet.column(0)->valueAt(0), 1.);
+	QCOMPARE(sheet.column(0)->valueAt(1), 2.);
+	QCOMPARE(sheet.column(0)->valueAt(2), 3.5);
+}
+
 /////////////////////////////// Sorting tests ////////////////////////////
 // single column
 
@@ -1005,6 +1095,318 @@ void SpreadsheetTest::testSortDateTime2() {
 	QCOMPARE(col1->integerAt(6), 7);
 }
 
+//////////////////////////////////////////////////////////////////
+// date-time storage
+//////////////////////////////////////////////////////////////////
+
+/*
+ * check that date-time values are stored as milliseconds since epoch and invalid values are preserved
+ */
+void SpreadsheetTest::testDateTimeStorage() {
+	const QVector<QDateTime> xData{
+		QDateTime(QDate(2020, 02, 29), QTime(12, 12, 12, 123)),
+		QDateTime(QDate(2019, 02, 29), QTime(12, 12, 12)),	// invalid
+		QDateTime(QDate(1900, 01, 01), QTime(0, 0, 0)),
+		};
+
+	Project project;
+	auto* sheet = new Spreadsheet("test", false);
+	project.addChild(sheet);
+	sheet->setColumnCount(1);
+	sheet->setRowCount(5);
+	auto* col = sheet->column(0);
+	col->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+	col->replaceDateTimes(0, xData);
+
+	QCOMPARE(col->dateTimeAt(0), xData.at(0));
+	QCOMPARE(col->dateTimeMSecsAt(0), xData.at(0).toMSecsSinceEpoch());
+	QVERIFY(!col->isValid(1));
+	QVERIFY(!col->dateTimeAt(1).isValid());
+	QCOMPARE(col->dateTimeMSecsAt(1), AbstractColumn::invalidDateTime);
+	QCOMPARE(col->dateTimeAt(2), xData.at(2));
+	// new rows are invalid
+	QVERIFY(!col->isValid(3));
+	QVERIFY(!col->isValid(4));
+
+	col->setDateAt(0, QDate(2021, 01, 01));
+	QCOMPARE(col->dateTimeAt(0), QDateTime(QDate(2021, 01, 01), QTime(12, 12, 12, 123)));
+
+	// min/max work on the stored values directly
+	QCOMPARE(col->minimum(), (double)xData.at(2).toMSecsSinceEpoch());
+	QCOMPARE(col->maximum(), (double)QDateTime(QDate(2021, 01, 01), QTime(12, 12, 12, 123)).toMSecsSinceEpoch());
+
+	// undo restores the old values
+	project.undoStack()->undo();
+	QCOMPARE(col->dateTimeAt(0), xData.at(0));
+}
+
+/*
+ * check that the time spec of the column is used to convert the stored values
+ */
+void SpreadsheetTest::testDateTimeTimeSpec() {
+	const QDateTime utc(QDate(2020, 02, 29), QTime(12, 0, 0), Qt::UTC);
+	Column col("x", QVector<QDateTime>{utc});
+
+	QCOMPARE(col.timeSpec(), Qt::UTC);
+	QCOMPARE(col.dateTimeAt(0), utc);
+	QCOMPARE(col.dateTimeAt(0).time(), QTime(12, 0, 0));
+
+	col.setTimeSpec(Qt::LocalTime);
+	QCOMPARE(col.dateTimeMSecsAt(0), utc.toMSecsSinceEpoch());
+	QCOMPARE(col.dateTimeAt(0), utc.toLocalTime());
+}
+
+//////////////////////////////////////////////////////////////////
+// dictionary encoded text
+//////////////////////////////////////////////////////////////////
+
+/*
+ * check dictionary encoding of a text column with few distinct values
+ */
+void SpreadsheetTest::testTextEncoding() {
+	const QStringList status{"ok", "warning", "error"};
+	QVector<QString> xData;
+	for (int i = 0; i < 99; i++)
+		xData << status.at(i % 3);
+	xData << QString();
+
+	Column column("x", AbstractColumn::ColumnMode::Text);
+	auto* col = &column;
+	col->replaceTexts(0, xData);
+
+	QVERIFY(col->encodeText());
+	QVERIFY(col->isTextEncoded());
+	QCOMPARE(col->textDictionary().size(), 3);
+	QCOMPARE(col->textCodeAt(0), col->textCodeAt(3));
+	QCOMPARE(col->textCodeAt(99), -1);	// empty row
+	QCOMPARE(col->textAt(4), QLatin1String("warning"));
+
+	// changing values keeps the encoding
+	col->setTextAt(99, "unknown");
+	QVERIFY(col->isTextEncoded());
+	QCOMPARE(col->textDictionary().size(), 4);
+	QCOMPARE(col->textAt(99), QLatin1String("unknown"));
+	QCOMPARE(col->textDictionary().at(col->textCodeAt(99)), QLatin1String("unknown"));
+
+	col->insertRows(0, 1);
+	QCOMPARE(col->textCodeAt(0), -1);
+	QCOMPARE(col->textAt(1), QLatin1String("ok"));
+	QCOMPARE(col->textDictionary().at(col->textCodeAt(1)), QLatin1String("ok"));
+
+	// direct access to the data drops the encoding
+	col->data();
+	QVERIFY(!col->isTextEncoded());
+	QCOMPARE(col->textAt(1), QLatin1String("ok"));
+
+	// no encoding for many distinct values
+	for (int i = 0; i < 100; i++)
+		xData[i] = QString::number(i);
+	col->replaceTexts(0, xData);
+	QVERIFY(!col->encodeText());
+}
+
+/*
+ * check sorting of a dictionary encoded text column
+ */
+void SpreadsheetTest::testTextEncodingSort() {
+	const QVector<QString> xData{"ba", "aa", "", "ca", "aa", "ba", "ca", "aa"};
+
+	Spreadsheet sheet("test", false);
+	sheet.setColumnCount(1);
+	sheet.setRowCount(8);
+	auto* col = sheet.column(0);
+	col->setColumnMode(AbstractColumn::ColumnMode::Text);
+	col->replaceTexts(0, xData);
+	QVERIFY(col->encodeText());
+
+	sheet.sortColumns(nullptr, {col}, true);
+
+	QVERIFY(col->isTextEncoded());
+	QCOMPARE(col->textAt(0), QLatin1String("aa"));
+	QCOMPARE(col->textAt(1), QLatin1String("aa"));
+	QCOMPARE(col->textAt(2), QLatin1String("aa"));
+	QCOMPARE(col->textAt(3), QLatin1String("ba"));
+	QCOMPARE(col->textAt(4), QLatin1String("ba"));
+	QCOMPARE(col->textAt(5), QLatin1String("ca"));
+	QCOMPARE(col->textAt(6), QLatin1String("ca"));
+	QCOMPARE(col->textAt(7), QLatin1String(""));
+	QCOMPARE(col->textDictionary().at(col->textCodeAt(5)), QLatin1String("ca"));
+}
+
+// saves \c column and loads it into \c loaded
+static bool saveLoadColumn(const Column& column, Column& loaded) {
+	QByteArray data;
+	QXmlStreamWriter writer(&data);
+	column.save(&writer);
+
+	XmlStreamReader reader(data);
+	if (!reader.skipToNextTag() || !loaded.load(&reader, false))
+		return false;
+	QThreadPool::globalInstance()->waitForDone();
+	return true;
+}
+
+/*
+ * check saving and loading of text columns with and without dictionary encoding
+ */
+void SpreadsheetTest::testTextEncodingSaveLoad() {
+	const QVector<QString> xData{"a", "b", "a", QString(), "b", "a"};
+
+	// not encoded
+	Column column("x", AbstractColumn::ColumnMode::Text);
+	column.replaceTexts(0, xData);
+	QVERIFY(!column.isTextEncoded());
+	Column loaded("x", AbstractColumn::ColumnMode::Text);
+	QVERIFY(saveLoadColumn(column, loaded));
+	QVERIFY(!loaded.isTextEncoded());
+	QCOMPARE(loaded.rowCount(), xData.size());
+	for (int i = 0; i < xData.size(); i++)
+		QCOMPARE(loaded.textAt(i), column.textAt(i));
+
+	// encoded
+	QVERIFY(column.encodeText());
+	Column loadedEncoded("x", AbstractColumn::ColumnMode::Text);
+	QVERIFY(saveLoadColumn(column, loadedEncoded));
+	QVERIFY(loadedEncoded.isTextEncoded());
+	QCOMPARE(loadedEncoded.rowCount(), xData.size());
+	QCOMPARE(loadedEncoded.textDictionary().size(), 2);
+	for (int i = 0; i < xData.size(); i++)
+		QCOMPARE(loadedEncoded.textAt(i), xData.at(i));
+
+	// encoded with empty rows only, the dictionary is empty
+	Column empty("y", AbstractColumn::ColumnMode::Text);
+	empty.replaceTexts(0, QVector<QString>(5));
+	QVERIFY(empty.encodeText());
+	QVERIFY(empty.textDictionary().isEmpty());
+	Column loadedEmpty("y", AbstractColumn::ColumnMode::Text);
+	QVERIFY(saveLoadColumn(empty, loadedEmpty));
+	QVERIFY(loadedEmpty.isTextEncoded());
+	QCOMPARE(loadedEmpty.rowCount(), 5);
+	QCOMPARE(loadedEmpty.textCodeAt(4), -1);
+	QVERIFY(loadedEmpty.textAt(4).isEmpty());
+
+	// reading doesn't drop the encoding, modifying the data directly does
+	QCOMPARE(loadedEncoded.textAt(1), QLatin1String("b"));
+	QVERIFY(loadedEncoded.isTextEncoded());
+	auto* data = static_cast<QVector<QString>*>(loadedEncoded.data());
+	QVERIFY(!loadedEncoded.isTextEncoded());
+	QCOMPARE(data->size(), xData.size());
+	QCOMPARE(data->at(5), QLatin1String("a"));
+}
+
+/*
+ * check saving and loading of a numeric column with more data than is encoded in one block
+ */
+void SpreadsheetTest::testNumericSaveLoadBlocks() {
+	const int rows = 7000000;
+	QVector<double> xData(rows);
+	for (int i = 0; i < rows; i++)
+		xData[i] = i/10.;
+
+	Column column("x", AbstractColumn::ColumnMode::Numeric);
+	column.replaceValues(0, xData);
+	QVERIFY(column.encodedData().isEmpty());	// written in blocks
+
+	Column loaded("x", AbstractColumn::ColumnMode::Numeric);
+	QVERIFY(saveLoadColumn(column, loaded));
+	QCOMPARE(loaded.rowCount(), rows);
+	for (int i = 0; i < rows; i += 9999)
+		QCOMPARE(loaded.valueAt(i), xData.at(i));
+	QCOMPARE(loaded.valueAt(rows - 1), xData.at(rows - 1));
+	QCOMPARE(loaded.dataHash(), column.dataHash());
+}
+
+//////////////////////////////////////////////////////////////////
+// memory mapped data
+//////////////////////////////////////////////////////////////////
+
+/*
+ * check the access to a numeric column mapped from a file and the loading of the data on modification
+ */
+void SpreadsheetTest::testMappedData() {
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	QVector<double> data(1001);
+	for (int i = 0; i < data.size(); i++)
+		data[i] = i/10.;
+	file.write(reinterpret_cast<const char*>(data.constData()), data.size() * (int)sizeof(double));
+	file.flush();
+
+	Column column("x", AbstractColumn::ColumnMode::Numeric);
+	auto* col = &column;
+
+	// skip the first value, the offset has to be aligned
+	QVERIFY(!col->mapData(file.fileName(), 4, 100));
+	QVERIFY(!col->mapData(file.fileName(), sizeof(double), 1001));	// beyond the end of the file
+	QVERIFY(col->mapData(file.fileName(), sizeof(double), 1000));
+	QVERIFY(col->isMapped());
+	QCOMPARE(col->rowCount(), 1000);
+	QCOMPARE(col->valueAt(0), 0.1);
+	QCOMPARE(col->valueAt(999), 100.);
+	QVERIFY(std::isnan(col->valueAt(1000)));
+	QCOMPARE(col->minimum(), 0.1);
+	QCOMPARE(col->maximum(), 100.);
+	QCOMPARE(col->statistics().size, 1000);
+
+	// reading doesn't load the data
+	QVERIFY(col->isMapped());
+	QCOMPARE(col->numericData()[999], 100.);
+	const auto& values = col->numericValues();
+	QVERIFY(col->isMapped());
+	QCOMPARE(values.size(), 1000);
+
+	// the data is loaded on modification
+	col->setValueAt(0, -1.);
+	QVERIFY(!col->isMapped());
+	QCOMPARE(col->rowCount(), 1000);
+	QCOMPARE(col->valueAt(0), -1.);
+	QCOMPARE(col->valueAt(999), 100.);
+
+	// the values read before stay valid
+	QCOMPARE(values.data()[0], 0.1);
+	QCOMPARE(values.data()[999], 100.);
+	const auto& loadedValues = col->numericValues();
+	col->setValueAt(1, -2.);
+	QCOMPARE(loadedValues.data()[0], -1.);
+	QCOMPARE(loadedValues.data()[1], 0.2);
+
+	// and on direct access to the data
+	QVERIFY(col->mapData(file.fileName(), 0, 10));
+	QCOMPARE(col->rowCount(), 10);
+	auto* vec = static_cast<QVector<double>*>(col->data());
+	QVERIFY(!col->isMapped());
+	QCOMPARE(vec->size(), 10);
+	QCOMPARE(vec->at(9), 0.9);
+}
+
+/*
+ * check that mapped data exceeding the size of QVector is not loaded into memory and not modified
+ */
+void SpreadsheetTest::testMappedDataTooLarge() {
+	if (sizeof(void*) < 8)
+		QSKIP("more than 2GB can't be mapped");
+
+	// sparse file with 2.4GB of zeros
+	const int rows = 300000000;
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	QVERIFY(file.resize(rows * (qint64)sizeof(double)));
+
+	Column column("x", AbstractColumn::ColumnMode::Numeric);
+	QVERIFY(column.mapData(file.fileName(), 0, rows));
+	QCOMPARE(column.rowCount(), rows);
+	QCOMPARE(column.valueAt(rows - 1), 0.);
+	QCOMPARE(column.numericValues().size(), rows);
+
+	// the modification is refused
+	column.setValueAt(0, 1.);
+	QVERIFY(column.isMapped());
+	QCOMPARE(column.rowCount(), rows);
+	QCOMPARE(column.valueAt(0), 0.);
+	QVERIFY(static_cast<QVector<double>*>(column.data())->isEmpty());
+	QVERIFY(column.isMapped());
+}
+
 // performance
 
 /*
@@ -1064,4 +1466,58 @@ void SpreadsheetTest::testSortPerformanceNumeric2() {
 	}
 }
 
+/*
+ * check performance of sorting date-time values in single column
+ */
+void SpreadsheetTest::testSortPerformanceDateTime() {
+	Spreadsheet sheet("test", false);
+	sheet.setColumnCount(1);
+	sheet.setRowCount(100000);
+
+	const QDateTime start(QDate(2020, 01, 01), QTime(0, 0, 0));
+	QVector<QDateTime> xData;
+	for (int i = 0; i < sheet.rowCount(); i++)
+#if QT_VERSION >= 0x051000
+		xData << start.addSecs(QRandomGenerator::global()->bounded(1000000));
+#else
+		xData << start.addSecs(qrand() % 1000000);
+#endif
+
+	auto* col = sheet.column(0);
+	col->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+	col->replaceDateTimes(0, xData);
+
+	// sort
+	QBENCHMARK {
+		sheet.sortColumns(nullptr, {col}, true);
+	}
+}
+
+/*
+ * check performance of sorting a dictionary encoded text column
+ */
+void SpreadsheetTest::testSortPerformanceTextEncoded() {
+	Spreadsheet sheet("test", false);
+	sheet.setColumnCount(1);
+	sheet.setRowCount(100000);
+
+	QVector<QString> xData;
+	for (int i = 0; i < sheet.rowCount(); i++)
+#if QT_VERSION >= 0x051000
+		xData << QLatin1String("status ") + QString::number(QRandomGenerator::global()->bounded(20));
+#else
+		xData << QLatin1String("status ") + QString::number(qrand() % 20);
+#endif
+
+	auto* col = sheet.column(0);
+	col->setColumnMode(AbstractColumn::ColumnMode::Text);
+	col->replaceTexts(0, xData);
+	col->encodeText();
+
+	// sort
+	QBENCHMARK {
+		sheet.sortColumns(nullptr, {col}, true);
+	}
+}
+
 QTEST_MAIN(SpreadsheetTest)
@@ -48,6 +48,10 @@ private slots:
 	void testCopyPasteSizeChange00();
 	void testCopyPasteSizeChange01();
 
+	//copy and paste between spreadsheets
+	void testCopyPasteColumnData00();
+	void testCopyPasteColumnData01();
+
 	// sorting tests
 	void testSortSingleNumeric1();
 	void testSortSingleNumeric2();
@@ -71,8 +75,24 @@ private slots:
 	void testSortDateTime1();
 	void testSortDateTime2();
 
+	// date-time storage
+	void testDateTimeStorage();
+	void testDateTimeTimeSpec();
+
+	// dictionary encoded text
+	void testTextEncoding();
+	void testTextEncodingSort();
+	void testTextEncodingSaveLoad();
+	void testNumericSaveLoadBlocks();
+
+	// memory mapped data
+	void testMappedData();
+	void testMappedDataTooLarge();
+
 	void testSortPerformanceNumeric1();
 	void testSortPerformanceNumeric2();
+	void testSortPerformanceDateTime();
+	void testSortPerformanceTextEncoded();
 };
 
 #endif